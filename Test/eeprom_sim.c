@@ -0,0 +1,348 @@
+/*
+ * eeprom_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "typedef.h"
+#include "stub_hal.h"
+#include "eeprom_sim.h"
+
+/********** Define **********/
+
+/* 25LC080Cの命令 */
+#define EEPROM_SIM_READ			(0x03)
+#define EEPROM_SIM_WRITE		(0x02)
+#define EEPROM_SIM_WRDI			(0x04)
+#define EEPROM_SIM_WREN			(0x06)
+#define EEPROM_SIM_RDSR			(0x05)
+
+/* STATUSレジスタ */
+#define EEPROM_SIM_STATUS_WIP	(0x01)
+#define EEPROM_SIM_STATUS_WEL	(0x02)
+
+/* 書き込みサイクル時間 [us](データシート最大値) */
+#define EEPROM_SIM_WRITE_TIME	(5000)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/* 不揮発(RestartEepromSimで保持) */
+static uint8_t eeprom_memory[EEPROM_SIM_SIZE];
+static uint32_t eeprom_page_cycle_num[EEPROM_SIM_PAGE_NUM];
+static uint32_t eeprom_cycle_num;
+static uint32_t eeprom_write_byte_num;
+static uint32_t eeprom_power_cut;
+static uint32_t eeprom_error_num;
+
+/* 揮発(RestartEepromSimで初期化) */
+static bool_t eeprom_selected;
+static bool_t eeprom_write_enable;
+static uint32_t eeprom_write_start;
+static bool_t eeprom_writing;
+static uint32_t eeprom_byte_index;
+static uint8_t eeprom_instruction;
+static uint16_t eeprom_address;
+static uint8_t eeprom_latch[EEPROM_SIM_PAGE_SIZE];
+static bool_t eeprom_latch_valid[EEPROM_SIM_PAGE_SIZE];
+
+/********** Function Prototype **********/
+
+static void selectEeprom(void);
+static void deselectEeprom(void);
+static void transferEeprom(const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);
+static bool_t isWriting(void);
+static void programPage(void);
+
+static const stub_spi_device_t eeprom_device = {
+	selectEeprom,
+	deselectEeprom,
+	transferEeprom,
+	0
+};
+
+/********** Function **********/
+
+/*
+ * Function: 25LC080C模擬初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : メモリを消去状態(0xFF)にして記録を消去し、SPI3に接続する(StubInit後に実行すること)
+ */
+void InitEepromSim(void)
+{
+	for (uint32_t index=0; index<EEPROM_SIM_SIZE; index++) {
+		eeprom_memory[index] = 0xFF;
+	}
+	for (uint32_t index=0; index<EEPROM_SIM_PAGE_NUM; index++) {
+		eeprom_page_cycle_num[index] = 0;
+	}
+	eeprom_cycle_num = 0;
+	eeprom_write_byte_num = 0;
+	eeprom_error_num = 0;
+
+	RestartEepromSim();
+}
+
+/*
+ * Function: 25LC080C模擬の電源再投入
+ * Argument: なし
+ * Return  : なし
+ * Note    : メモリと記録は保持し、書き込み許可、書き込み中、電源断設定を解除してSPI3に接続する(StubInit後に実行すること)
+ */
+void RestartEepromSim(void)
+{
+	eeprom_power_cut = EEPROM_SIM_POWER_CUT_NONE;
+	eeprom_selected = FALSE;
+	eeprom_write_enable = FALSE;
+	eeprom_write_start = 0;
+	eeprom_writing = FALSE;
+	eeprom_byte_index = 0;
+	eeprom_instruction = 0;
+	eeprom_address = 0;
+
+	StubSetSpiDevice(STUB_SPI_EEPROM, &eeprom_device);
+}
+
+/*
+ * Function: 電源断設定
+ * Argument: 電源断までに書き込むbyte数(InitEepromSimからの累計、EEPROM_SIM_POWER_CUT_NONEで電源断なし)
+ * Return  : なし
+ * Note    : 電源断時に書き込み中のbyteは不定値(新旧データのどちらとも異なる値)となり、以降の書き込みは反映しない
+ */
+void SetEepromSimPowerCut(uint32_t write_byte_num)
+{
+	eeprom_power_cut = write_byte_num;
+}
+
+/*
+ * Function: メモリ取得
+ * Argument: なし
+ * Return  : メモリ先頭アドレス(EEPROM_SIM_SIZE byte)
+ * Note    : テストから直接初期値を設定、確認する
+ */
+uint8_t* GetEepromSimMemory(void)
+{
+	return eeprom_memory;
+}
+
+/*
+ * Function: 書き込みサイクル数取得
+ * Argument: なし
+ * Return  : InitEepromSimからの書き込みサイクル数
+ * Note    : なし
+ */
+uint32_t GetEepromSimWriteCycleNum(void)
+{
+	return eeprom_cycle_num;
+}
+
+/*
+ * Function: ページ毎の書き込みサイクル数取得
+ * Argument: ページ番号
+ * Return  : InitEepromSimからの書き込みサイクル数
+ * Note    : なし
+ */
+uint32_t GetEepromSimPageWriteCycleNum(uint32_t page)
+{
+	uint32_t cycle_num = 0;
+
+	if (page < EEPROM_SIM_PAGE_NUM) {
+		cycle_num = eeprom_page_cycle_num[page];
+	}
+
+	return cycle_num;
+}
+
+/*
+ * Function: 書き込みbyte数取得
+ * Argument: なし
+ * Return  : InitEepromSimからメモリへ書き込んだbyte数(電源断の指定に使用)
+ * Note    : なし
+ */
+uint32_t GetEepromSimWriteByteNum(void)
+{
+	return eeprom_write_byte_num;
+}
+
+/*
+ * Function: 通信手順違反数取得
+ * Argument: なし
+ * Return  : 書き込み中の命令、書き込み許可なしの書き込み、ページ外への書き込みの回数
+ * Note    : なし
+ */
+uint32_t GetEepromSimErrorNum(void)
+{
+	return eeprom_error_num;
+}
+
+/*
+ * Function: CS有効
+ * Argument: なし
+ * Return  : なし
+ * Note    : 次の1byteを命令として扱う
+ */
+static void selectEeprom(void)
+{
+	eeprom_selected = TRUE;
+	eeprom_byte_index = 0;
+	eeprom_instruction = 0;
+	for (uint32_t index=0; index<EEPROM_SIM_PAGE_SIZE; index++) {
+		eeprom_latch_valid[index] = FALSE;
+	}
+}
+
+/*
+ * Function: CS無効
+ * Argument: なし
+ * Return  : なし
+ * Note    : 書き込み許可、書き込み命令はCSの立ち上がりで実行する
+ */
+static void deselectEeprom(void)
+{
+	eeprom_selected = FALSE;
+
+	if (eeprom_byte_index == 0) {
+		/* 処理なし */
+	} else if ((isWriting() == TRUE) && (eeprom_instruction != EEPROM_SIM_RDSR)) {
+		/* 書き込み中はSTATUS読み出し以外を受け付けない */
+		eeprom_error_num ++;
+	} else if (eeprom_instruction == EEPROM_SIM_WREN) {
+		eeprom_write_enable = TRUE;
+	} else if (eeprom_instruction == EEPROM_SIM_WRDI) {
+		eeprom_write_enable = FALSE;
+	} else if ((eeprom_instruction == EEPROM_SIM_WRITE) && (eeprom_byte_index > 3)) {
+		if (eeprom_write_enable == TRUE) {
+			programPage();
+		} else {
+			eeprom_error_num ++;
+		}
+	} else {
+		/* 処理なし */
+	}
+}
+
+/*
+ * Function: SPI転送
+ * Argument: 送信データ、受信バッファ、長さ
+ * Return  : なし
+ * Note    : 書き込みデータはページ内で折り返してラッチに格納する
+ */
+static void transferEeprom(const uint8_t* tx_data, uint8_t* rx_data, uint16_t length)
+{
+	uint8_t tx;
+	uint8_t rx;
+
+	if (eeprom_selected == FALSE) {
+		fprintf(stderr, "eeprom_sim: transfer without CS\n");
+		exit(1);
+	}
+
+	for (uint16_t index=0; index<length; index++) {
+		tx = 0xFF;
+		if (tx_data != NULL) {
+			tx = tx_data[index];
+		}
+		rx = 0xFF;
+
+		if (eeprom_byte_index == 0) {
+			eeprom_instruction = tx;
+		} else if (eeprom_instruction == EEPROM_SIM_RDSR) {
+			rx = 0;
+			if (isWriting() == TRUE) {
+				rx |= EEPROM_SIM_STATUS_WIP;
+			}
+			if (eeprom_write_enable == TRUE) {
+				rx |= EEPROM_SIM_STATUS_WEL;
+			}
+		} else if ((eeprom_instruction == EEPROM_SIM_READ) || (eeprom_instruction == EEPROM_SIM_WRITE)) {
+			if (eeprom_byte_index == 1) {
+				eeprom_address = (uint16_t)tx << 8;
+			} else if (eeprom_byte_index == 2) {
+				eeprom_address = (eeprom_address | tx) % EEPROM_SIM_SIZE;
+			} else if (eeprom_instruction == EEPROM_SIM_READ) {
+				/* 読み出しは全体で折り返す(書き込み中は読み出せない) */
+				if (isWriting() == FALSE) {
+					rx = eeprom_memory[eeprom_address];
+				}
+				eeprom_address = (eeprom_address + 1) % EEPROM_SIM_SIZE;
+			} else {
+				if (eeprom_byte_index - 3 >= EEPROM_SIM_PAGE_SIZE) {
+					/* ページサイズを超えるとラッチを上書きする(ドライバの誤り) */
+					eeprom_error_num ++;
+				}
+				eeprom_latch[eeprom_address % EEPROM_SIM_PAGE_SIZE] = tx;
+				eeprom_latch_valid[eeprom_address % EEPROM_SIM_PAGE_SIZE] = TRUE;
+				eeprom_address = (eeprom_address - (eeprom_address % EEPROM_SIM_PAGE_SIZE)) + ((eeprom_address + 1) % EEPROM_SIM_PAGE_SIZE);
+			}
+		} else {
+			/* 処理なし */
+		}
+
+		if (rx_data != NULL) {
+			rx_data[index] = rx;
+		}
+		eeprom_byte_index ++;
+	}
+}
+
+/*
+ * Function: 書き込み中判定
+ * Argument: なし
+ * Return  : TRUE:書き込み中(WIP)、FALSE:書き込み完了
+ * Note    : なし
+ */
+static bool_t isWriting(void)
+{
+	if ((eeprom_writing == TRUE) && ((StubGetTimeUs() - eeprom_write_start) >= EEPROM_SIM_WRITE_TIME)) {
+		eeprom_writing = FALSE;
+	}
+
+	return eeprom_writing;
+}
+
+/*
+ * Function: ページ書き込み
+ * Argument: なし
+ * Return  : なし
+ * Note    : ラッチ済みのbyteのみ書き込む、書き込み許可は解除される
+ */
+static void programPage(void)
+{
+	uint16_t page_start = eeprom_address - (eeprom_address % EEPROM_SIM_PAGE_SIZE);
+	uint8_t data;
+
+	for (uint32_t offset=0; offset<EEPROM_SIM_PAGE_SIZE; offset++) {
+		if (eeprom_latch_valid[offset] == TRUE) {
+			data = eeprom_latch[offset];
+			if (eeprom_write_byte_num == eeprom_power_cut) {
+				/* 電源断時に書き込み中のbyteは新旧どちらとも異なる値 */
+				data = (uint8_t)~data;
+				if (data == eeprom_memory[page_start + offset]) {
+					data ^= 0x01;
+				}
+			}
+			if (eeprom_write_byte_num <= eeprom_power_cut) {
+				eeprom_memory[page_start + offset] = data;
+				eeprom_write_byte_num ++;
+			}
+		}
+	}
+
+	eeprom_page_cycle_num[page_start / EEPROM_SIM_PAGE_SIZE] ++;
+	eeprom_cycle_num ++;
+	eeprom_write_enable = FALSE;
+	eeprom_writing = TRUE;
+	eeprom_write_start = StubGetTimeUs();
+}
@@ -0,0 +1,47 @@
+/*
+ * eeprom_sim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  SPI3に接続する25LC080Cの模擬(ページ毎の書き込みサイクル数を記録し、書き込み途中の電源断を再現する)
+ */
+
+
+#ifndef EEPROM_SIM_H_
+#define EEPROM_SIM_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 25LC080Cの容量、ページサイズ [byte] */
+#define EEPROM_SIM_SIZE			(1024)
+#define EEPROM_SIM_PAGE_SIZE	(16)
+#define EEPROM_SIM_PAGE_NUM		(EEPROM_SIM_SIZE / EEPROM_SIM_PAGE_SIZE)
+
+/* 電源断なし */
+#define EEPROM_SIM_POWER_CUT_NONE	(0xFFFFFFFF)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitEepromSim(void);
+void RestartEepromSim(void);
+void SetEepromSimPowerCut(uint32_t write_byte_num);
+uint8_t* GetEepromSimMemory(void);
+uint32_t GetEepromSimWriteCycleNum(void);
+uint32_t GetEepromSimPageWriteCycleNum(uint32_t page);
+uint32_t GetEepromSimWriteByteNum(void);
+uint32_t GetEepromSimErrorNum(void);
+
+#endif /* EEPROM_SIM_H_ */
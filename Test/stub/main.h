@@ -0,0 +1,280 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  ホストビルド用のmain.h(CubeMX生成ファイルの代替)
+ *  User/以下が参照するHALの型、マクロ、関数のみを定義し、関数の実体はstub_hal.cで模擬する
+ */
+
+
+#ifndef MAIN_H
+#define MAIN_H
+
+/********** Include **********/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********** Define **********/
+
+#define ENABLE		(1)
+#define DISABLE		(0)
+
+/* GPIO */
+#define SW_A_Pin				(0x4000U)
+#define SW_A_GPIO_Port			(GPIOC)
+#define SW_B_Pin				(0x8000U)
+#define SW_B_GPIO_Port			(GPIOC)
+#define SW_C_Pin				(0x0001U)
+#define SW_C_GPIO_Port			(GPIOH)
+#define SW_D_Pin				(0x0002U)
+#define SW_D_GPIO_Port			(GPIOH)
+#define TFT_DC_Pin				(0x0010U)
+#define TFT_DC_GPIO_Port		(GPIOA)
+#define TFT_CS_Pin				(0x0020U)
+#define TFT_CS_GPIO_Port		(GPIOA)
+#define SOUND_CS_Pin			(0x0040U)
+#define SOUND_CS_GPIO_Port		(GPIOB)
+#define EEPROM_CS_Pin			(0x0080U)
+#define EEPROM_CS_GPIO_Port		(GPIOB)
+#define AUDIO_SW_Pin			(0x0100U)
+#define AUDIO_SW_GPIO_Port		(GPIOB)
+#define TOUCH_INT_Pin			(0x0200U)
+#define TOUCH_INT_GPIO_Port		(GPIOB)
+
+#define GPIOA					(&stub_gpio[0])
+#define GPIOB					(&stub_gpio[1])
+#define GPIOC					(&stub_gpio[2])
+#define GPIOH					(&stub_gpio[3])
+#define STUB_GPIO_NUM			(4)
+
+#define GPIO_MODE_IT_RISING_FALLING		(0x10310000U)
+#define GPIO_PULLUP						(1U)
+#define EXTI0_IRQn						(11)
+
+/* TIM */
+#define TIM_CHANNEL_1					(0x00U)
+#define TIM_CHANNEL_3					(0x08U)
+#define TIM_IT_CC1						(0x02U)
+#define TIM_EVENTSOURCE_CC1				(0x02U)
+#define __HAL_TIM_SET_COMPARE(h, c, v)	((h)->Instance->CCR1 = (v))
+#define __HAL_TIM_ENABLE_IT(h, i)		((h)->Instance->DIER |= (i))
+#define __HAL_TIM_DISABLE_IT(h, i)		((h)->Instance->DIER &= ~(i))
+
+/* I2C */
+#define I2C_FIRST_FRAME					(0x00U)
+#define I2C_FIRST_AND_NEXT_FRAME		(0x01U)
+#define I2C_NEXT_FRAME					(0x02U)
+#define I2C_FIRST_AND_LAST_FRAME		(0x03U)
+#define I2C_LAST_FRAME					(0x04U)
+#define I2C_LAST_FRAME_NO_STOP			(0x05U)
+
+/* ADC */
+#define ADC_INJECTED_RANK_1				(1U)
+#define ADC_INJECTED_RANK_2				(2U)
+#define ADC_INJECTED_RANK_3				(3U)
+#define ADC_REGULAR_RANK_1				(1U)
+#define ADC_REGULAR_RANK_2				(2U)
+#define ADC_REGULAR_RANK_3				(3U)
+#define ADC_CHANNEL_5					(5U)
+#define ADC_CHANNEL_6					(6U)
+#define ADC_CHANNEL_9					(9U)
+#define ADC_SCAN_ENABLE					(1U)
+#define ADC_CONVERSIONDATA_DMA_CIRCULAR	(3U)
+#define ADC_RIGHTBITSHIFT_4				(4U)
+#define ADC_TRIGGEREDMODE_SINGLE_TRIGGER	(0U)
+#define ADC_REGOVERSAMPLING_CONTINUED_MODE	(0U)
+#define ADC_SAMPLETIME_814CYCLES		(7U)
+#define ADC_SINGLE_ENDED				(0U)
+#define ADC_OFFSET_NONE					(0U)
+#define ADC_CALIB_OFFSET				(0U)
+
+/* DMA */
+#define DMA_IT_TC						(0x0100U)
+#define DMA_IT_HT						(0x0200U)
+#define __HAL_DMA_DISABLE_IT(h, i)		((h)->IER &= ~(i))
+
+/* DMA2D */
+#define DMA2D_R2M						(0U)
+#define DMA2D_OUTPUT_RGB565				(2U)
+#define DMA2D_RB_REGULAR				(0U)
+#define DMA2D_LOM_PIXELS				(0U)
+#define DMA2D_BYTES_REGULAR				(0U)
+#define DMA2D_REGULAR_ALPHA				(0U)
+
+/********** Enum **********/
+
+typedef enum {
+	HAL_OK = 0,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef int IRQn_Type;
+
+/********** Type **********/
+
+/* GPIO */
+typedef struct {
+	uint16_t IDR;		/* 入力レベル */
+	uint16_t ODR;		/* 出力レベル */
+	uint16_t EXTI;		/* 両エッジ割り込み有効 */
+} GPIO_TypeDef;
+
+typedef struct {
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+/* TIM */
+/* CNTの読み書きで模擬時刻を参照させるため、CNTはカウンタへの参照を返す関数を経由する */
+#define CNT		cnt_ref()[0]
+
+typedef struct {
+	uint32_t* (*cnt_ref)(void);
+	uint32_t CCR1;
+	uint32_t ARR;
+	uint32_t DIER;
+	uint32_t EGR;
+} TIM_TypeDef;
+
+typedef struct {
+	TIM_TypeDef* Instance;
+} TIM_HandleTypeDef;
+
+/* SPI */
+typedef struct {
+	uint32_t channel;	/* 0:SPI1、1:SPI2、2:SPI3 */
+} SPI_HandleTypeDef;
+
+/* I2C */
+typedef struct {
+	uint32_t channel;
+} I2C_HandleTypeDef;
+
+/* DMA */
+typedef struct {
+	uint32_t IER;		/* 割り込み有効 */
+} DMA_HandleTypeDef;
+
+/* ADC */
+typedef struct {
+	uint32_t Ratio;
+	uint32_t RightBitShift;
+	uint32_t TriggeredMode;
+	uint32_t OversamplingStopReset;
+} ADC_OversamplingTypeDef;
+
+typedef struct {
+	uint32_t ScanConvMode;
+	uint32_t ContinuousConvMode;
+	uint32_t NbrOfConversion;
+	uint32_t ConversionDataManagement;
+	uint32_t OversamplingMode;
+	ADC_OversamplingTypeDef Oversampling;
+} ADC_InitTypeDef;
+
+typedef struct {
+	ADC_InitTypeDef Init;
+	DMA_HandleTypeDef* DMA_Handle;
+} ADC_HandleTypeDef;
+
+typedef struct {
+	uint32_t Channel;
+	uint32_t Rank;
+	uint32_t SamplingTime;
+	uint32_t SingleDiff;
+	uint32_t OffsetNumber;
+	uint32_t Offset;
+} ADC_ChannelConfTypeDef;
+
+/* UART */
+typedef struct {
+	uint32_t channel;
+} UART_HandleTypeDef;
+
+/* DMA2D */
+typedef struct {
+	uint32_t Mode;
+	uint32_t ColorMode;
+	uint32_t OutputOffset;
+	uint32_t AlphaInverted;
+	uint32_t RedBlueSwap;
+	uint32_t LineOffsetMode;
+	uint32_t BytesSwap;
+} DMA2D_InitTypeDef;
+
+typedef struct {
+	DMA2D_InitTypeDef Init;
+} DMA2D_HandleTypeDef;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+extern GPIO_TypeDef stub_gpio[STUB_GPIO_NUM];
+
+/********** Function Prototype **********/
+
+/* CMSIS */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+void __enable_irq(void);
+void __WFI(void);
+
+/* GPIO */
+void HAL_GPIO_Init(GPIO_TypeDef* gpio, GPIO_InitTypeDef* init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* gpio, uint16_t pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state);
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub);
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+
+/* TIM */
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef* htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Stop(TIM_HandleTypeDef* htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef* htim, uint32_t event_source);
+
+/* SPI */
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, const uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size);
+
+/* I2C */
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t option);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t option);
+
+/* ADC */
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart_IT(ADC_HandleTypeDef* hadc);
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef* hadc, uint32_t rank);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* config);
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t mode, uint32_t single_diff);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, const uint32_t* data, uint32_t length);
+
+/* UART */
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size, uint32_t timeout);
+
+/* DMA2D */
+HAL_StatusTypeDef HAL_DMA2D_Init(DMA2D_HandleTypeDef* hdma2d);
+HAL_StatusTypeDef HAL_DMA2D_Start_IT(DMA2D_HandleTypeDef* hdma2d, uint32_t color, uint32_t destination, uint32_t width, uint32_t height);
+
+#endif /* MAIN_H */
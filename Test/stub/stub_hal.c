@@ -0,0 +1,931 @@
+/*
+ * stub_hal.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  ホストビルド用のHAL模擬
+ *  割り込みは全て同じ優先度(多重割り込みなし)とし、PRIMASK解除時、時刻経過時、CNT読み出し時に
+ *  発生済みの割り込みを実行する
+ */
+
+
+/********** Include **********/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "mcal_spi.h"
+#include "mcal_i2c.h"
+#include "mcal_adc.h"
+#include "mcal_dio.h"
+#include "mcal_dma2d.h"
+#include "stub_hal.h"
+
+/********** Define **********/
+
+/* 時刻計測用タイマー(TIM4) */
+#define STUB_TIM_NUM			(6)
+#define STUB_TIM_TIME			(3)
+
+/* 時刻を進めずにCNTを読み続けた場合にビジーウェイトと判定する回数 */
+#define STUB_SPIN_LIMIT			(64)
+
+/* 完了待ちイベント数 */
+#define STUB_EVENT_NUM			(32)
+
+/* デバイス未設定時の転送時間 */
+#define STUB_SPI_BYTE_TIME_NS	(1000)
+#define STUB_I2C_BYTE_TIME_NS	(25000)
+#define STUB_ADC_TIME_NS		(50000)
+#define STUB_DMA2D_TIME_NS		(100000)
+
+/* UART出力保持サイズ */
+#define STUB_UART_SIZE			(65536)
+
+/********** Enum **********/
+
+typedef enum {
+	STUB_EVENT_SPI = 0,
+	STUB_EVENT_I2C_SEND,
+	STUB_EVENT_I2C_RECEIVE,
+	STUB_EVENT_I2C_ERROR,
+	STUB_EVENT_ADC,
+	STUB_EVENT_DMA2D
+} stub_event_type_t;
+
+/********** Type **********/
+
+typedef struct {
+	bool_t active;
+	uint64_t time_ns;
+	stub_event_type_t type;
+	uint32_t param;
+} stub_event_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+GPIO_TypeDef stub_gpio[STUB_GPIO_NUM];
+static TIM_TypeDef stub_tim[STUB_TIM_NUM];
+
+TIM_HandleTypeDef htim1 = {&stub_tim[0]};
+TIM_HandleTypeDef htim2 = {&stub_tim[1]};
+TIM_HandleTypeDef htim3 = {&stub_tim[2]};
+TIM_HandleTypeDef htim4 = {&stub_tim[3]};
+TIM_HandleTypeDef htim5 = {&stub_tim[4]};
+TIM_HandleTypeDef htim6 = {&stub_tim[5]};
+SPI_HandleTypeDef hspi1 = {STUB_SPI_TFT};
+SPI_HandleTypeDef hspi2 = {STUB_SPI_SOUND};
+SPI_HandleTypeDef hspi3 = {STUB_SPI_EEPROM};
+I2C_HandleTypeDef hi2c1;
+DMA_HandleTypeDef handle_GPDMA1_Channel0;
+ADC_HandleTypeDef hadc1 = {.DMA_Handle = &handle_GPDMA1_Channel0};
+UART_HandleTypeDef huart2;
+DMA2D_HandleTypeDef hdma2d;
+
+static uint64_t stub_time_ns;
+static uint32_t stub_time_cnt;
+static uint32_t stub_other_cnt;
+static uint32_t stub_spin_count;
+
+static uint32_t stub_primask;
+static bool_t stub_in_isr;
+static bool_t stub_cc1_pending;
+static uint16_t stub_pin_pending[STUB_GPIO_NUM];
+static uint32_t stub_interrupt_count;
+
+static stub_event_t stub_event[STUB_EVENT_NUM];
+
+static const stub_spi_device_t* stub_spi_device[STUB_SPI_NUM];
+static const stub_i2c_device_t* stub_i2c_device;
+
+static uint32_t stub_adc_value[STUB_ADC_NUM];
+static uint32_t* stub_adc_dma_buffer;
+
+static char stub_uart_output[STUB_UART_SIZE];
+static uint32_t stub_uart_length;
+
+/********** Function Prototype **********/
+
+static void serviceInterrupt(void);
+static bool_t runPendingInterrupt(void);
+static void advanceTo(uint64_t target_ns);
+static uint64_t nextEventTime(uint64_t limit_ns);
+static void addEvent(uint64_t delay_ns, stub_event_type_t type, uint32_t param);
+static void dispatchEvent(stub_event_type_t type, uint32_t param);
+static int32_t spiChannelFromCs(GPIO_TypeDef* gpio, uint16_t pin);
+static void transferSpi(SPI_HandleTypeDef* hspi, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size);
+static HAL_StatusTypeDef transferI2c(const uint8_t* tx_data, uint8_t* rx_data, uint16_t address, uint16_t size, stub_event_type_t complete);
+static uint32_t* stubTimeCntRef(void);
+static uint32_t* stubOtherCntRef(void);
+
+/********** Function **********/
+
+/*
+ * Function: HAL模擬初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 各テストの先頭で実行する、デバイス模擬は解除する
+ */
+void StubInit(void)
+{
+	for (uint32_t index=0; index<STUB_TIM_NUM; index++) {
+		stub_tim[index].cnt_ref = stubOtherCntRef;
+		stub_tim[index].CCR1 = 0;
+		stub_tim[index].ARR = 0;
+		stub_tim[index].DIER = 0;
+		stub_tim[index].EGR = 0;
+	}
+	stub_tim[STUB_TIM_TIME].cnt_ref = stubTimeCntRef;
+
+	for (uint32_t index=0; index<STUB_GPIO_NUM; index++) {
+		/* スイッチ、CSはプルアップ(非アクティブ) */
+		stub_gpio[index].IDR = 0xFFFF;
+		stub_gpio[index].ODR = 0xFFFF;
+		stub_gpio[index].EXTI = 0;
+		stub_pin_pending[index] = 0;
+	}
+
+	stub_time_ns = 0;
+	stub_time_cnt = 0;
+	stub_other_cnt = 0;
+	stub_spin_count = 0;
+	stub_primask = 0;
+	stub_in_isr = FALSE;
+	stub_cc1_pending = FALSE;
+	stub_interrupt_count = 0;
+
+	for (uint32_t index=0; index<STUB_EVENT_NUM; index++) {
+		stub_event[index].active = FALSE;
+	}
+	for (uint32_t index=0; index<STUB_SPI_NUM; index++) {
+		stub_spi_device[index] = NULL;
+	}
+	stub_i2c_device = NULL;
+	for (uint32_t index=0; index<STUB_ADC_NUM; index++) {
+		stub_adc_value[index] = 0;
+	}
+	stub_adc_dma_buffer = NULL;
+	StubClearUartOutput();
+}
+
+/*
+ * Function: 模擬時刻取得
+ * Argument: なし
+ * Return  : 時刻計測用タイマーのカウンタ [us]
+ * Note    : CNT読み出しと異なり、割り込み実行、ビジーウェイト判定を行わない
+ */
+uint32_t StubGetTimeUs(void)
+{
+	return stub_time_cnt;
+}
+
+/*
+ * Function: 模擬時刻経過
+ * Argument: 経過時間 [us]
+ * Return  : なし
+ * Note    : 経過中に発生する割り込みは発生時刻に実行する
+ */
+void StubAdvanceUs(uint32_t us)
+{
+	advanceTo(stub_time_ns + ((uint64_t)us * 1000));
+}
+
+/*
+ * Function: 条件成立まで模擬時刻経過
+ * Argument: 条件判定関数、タイムアウト時間 [us]
+ * Return  : TRUE:条件成立、FALSE:タイムアウト
+ * Note    : 割り込みの発生毎に条件を判定する
+ */
+bool_t StubRunUntil(bool_t (*condition)(void), uint32_t timeout_us)
+{
+	uint64_t deadline = stub_time_ns + ((uint64_t)timeout_us * 1000);
+	bool_t result = condition();
+
+	while ((result == FALSE) && (stub_time_ns < deadline)) {
+		advanceTo(nextEventTime(deadline));
+		result = condition();
+	}
+
+	return result;
+}
+
+/*
+ * Function: 割り込み実行回数取得
+ * Argument: なし
+ * Return  : StubInitからの割り込み実行回数
+ * Note    : なし
+ */
+uint32_t StubGetInterruptCount(void)
+{
+	return stub_interrupt_count;
+}
+
+/*
+ * Function: 入力端子レベル設定
+ * Argument: GPIO、端子、レベル
+ * Return  : なし
+ * Note    : EXTI有効な端子はレベル変化でエッジ割り込みを発生させる
+ */
+void StubSetPinLevel(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state)
+{
+	uint16_t previous = gpio->IDR;
+
+	if (state == GPIO_PIN_SET) {
+		gpio->IDR |= pin;
+	} else {
+		gpio->IDR &= (uint16_t)~pin;
+	}
+
+	if (((previous ^ gpio->IDR) & gpio->EXTI & pin) != 0) {
+		stub_pin_pending[gpio - stub_gpio] |= pin;
+		serviceInterrupt();
+	}
+}
+
+/*
+ * Function: 出力端子レベル取得
+ * Argument: GPIO、端子
+ * Return  : 出力レベル
+ * Note    : なし
+ */
+GPIO_PinState StubGetPinOutput(GPIO_TypeDef* gpio, uint16_t pin)
+{
+	GPIO_PinState state;
+
+	if ((gpio->ODR & pin) != 0) {
+		state = GPIO_PIN_SET;
+	} else {
+		state = GPIO_PIN_RESET;
+	}
+
+	return state;
+}
+
+/*
+ * Function: SPI接続デバイス模擬設定
+ * Argument: SPIチャネル、デバイス模擬(NULL:送信データを破棄、受信データは0)
+ * Return  : なし
+ * Note    : なし
+ */
+void StubSetSpiDevice(uint32_t channel, const stub_spi_device_t* device)
+{
+	if (channel < STUB_SPI_NUM) {
+		stub_spi_device[channel] = device;
+	}
+}
+
+/*
+ * Function: I2C接続デバイス模擬設定
+ * Argument: デバイス模擬(NULL:全アドレスNACK)
+ * Return  : なし
+ * Note    : なし
+ */
+void StubSetI2cDevice(const stub_i2c_device_t* device)
+{
+	stub_i2c_device = device;
+}
+
+/*
+ * Function: AD変換値設定
+ * Argument: AD値ID、変換値
+ * Return  : なし
+ * Note    : DMA連続変換中はDMA転送先にも反映する
+ */
+void StubSetAdcValue(uint32_t index, uint32_t value)
+{
+	if (index < STUB_ADC_NUM) {
+		stub_adc_value[index] = value;
+		if (stub_adc_dma_buffer != NULL) {
+			stub_adc_dma_buffer[index] = value;
+		}
+	}
+}
+
+/*
+ * Function: UART出力取得
+ * Argument: なし
+ * Return  : StubClearUartOutputからの出力文字列
+ * Note    : なし
+ */
+const char* StubGetUartOutput(void)
+{
+	return stub_uart_output;
+}
+
+/*
+ * Function: UART出力消去
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void StubClearUartOutput(void)
+{
+	stub_uart_length = 0;
+	stub_uart_output[0] = '\0';
+}
+
+/*
+ * Function: 割り込み実行
+ * Argument: なし
+ * Return  : なし
+ * Note    : 割り込み禁止中、割り込み処理中は実行しない(発生済みとして保持)
+ */
+static void serviceInterrupt(void)
+{
+	if ((stub_primask == 0) && (stub_in_isr == FALSE)) {
+		stub_in_isr = TRUE;
+		while (runPendingInterrupt() == TRUE) {
+			stub_interrupt_count ++;
+		}
+		stub_in_isr = FALSE;
+	}
+}
+
+/*
+ * Function: 発生済み割り込みを1つ実行
+ * Argument: なし
+ * Return  : TRUE:実行した、FALSE:発生済み割り込みなし
+ * Note    : なし
+ */
+static bool_t runPendingInterrupt(void)
+{
+	TIM_TypeDef* tim = &stub_tim[STUB_TIM_TIME];
+	int32_t found = -1;
+
+	if (stub_cc1_pending == TRUE) {
+		stub_cc1_pending = FALSE;
+		if ((tim->DIER & TIM_IT_CC1) != 0) {
+			InterruptTimerAlarm();
+			return TRUE;
+		}
+	}
+
+	for (uint32_t index=0; index<STUB_GPIO_NUM; index++) {
+		for (uint32_t bit=0; bit<16; bit++) {
+			if ((stub_pin_pending[index] & (1U << bit)) != 0) {
+				stub_pin_pending[index] &= (uint16_t)~(1U << bit);
+				InterruptPinEdge((uint16_t)(1U << bit));
+				return TRUE;
+			}
+		}
+	}
+
+	for (uint32_t index=0; index<STUB_EVENT_NUM; index++) {
+		if ((stub_event[index].active == TRUE) && (stub_event[index].time_ns <= stub_time_ns)) {
+			if ((found < 0) || (stub_event[index].time_ns < stub_event[found].time_ns)) {
+				found = (int32_t)index;
+			}
+		}
+	}
+	if (found >= 0) {
+		stub_event[found].active = FALSE;
+		dispatchEvent(stub_event[found].type, stub_event[found].param);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*
+ * Function: 模擬時刻を指定時刻まで進める
+ * Argument: 目標時刻 [ns]
+ * Return  : なし
+ * Note    : 途中のイベント、コンペアマッチの時刻で停止して割り込みを実行する
+ */
+static void advanceTo(uint64_t target_ns)
+{
+	TIM_TypeDef* tim = &stub_tim[STUB_TIM_TIME];
+	uint64_t next_ns;
+	uint32_t previous_cnt;
+	uint32_t elapsed_us;
+
+	stub_spin_count = 0;
+	while (stub_time_ns < target_ns) {
+		next_ns = nextEventTime(target_ns);
+
+		previous_cnt = stub_time_cnt;
+		elapsed_us = (uint32_t)((next_ns / 1000) - (stub_time_ns / 1000));
+		stub_time_ns = next_ns;
+		stub_time_cnt += elapsed_us;
+
+		/* CCR1をまたいだ場合にコンペアマッチ */
+		if (((tim->DIER & TIM_IT_CC1) != 0) && (elapsed_us > 0)
+		 && ((uint32_t)(tim->CCR1 - previous_cnt - 1) < elapsed_us)) {
+			stub_cc1_pending = TRUE;
+		}
+
+		serviceInterrupt();
+	}
+}
+
+/*
+ * Function: 次のイベント時刻取得
+ * Argument: 上限時刻 [ns]
+ * Return  : 次のイベント、コンペアマッチの時刻と上限時刻の早い方
+ * Note    : なし
+ */
+static uint64_t nextEventTime(uint64_t limit_ns)
+{
+	TIM_TypeDef* tim = &stub_tim[STUB_TIM_TIME];
+	uint64_t next_ns = limit_ns;
+	uint64_t match_ns;
+	uint32_t delta_us;
+
+	for (uint32_t index=0; index<STUB_EVENT_NUM; index++) {
+		if ((stub_event[index].active == TRUE) && (stub_event[index].time_ns < next_ns)) {
+			next_ns = stub_event[index].time_ns;
+		}
+	}
+
+	if ((tim->DIER & TIM_IT_CC1) != 0) {
+		delta_us = tim->CCR1 - stub_time_cnt;
+		if (delta_us == 0) {
+			/* 一致済みは1周後 */
+			match_ns = ((stub_time_ns / 1000) + 0x100000000ULL) * 1000;
+		} else {
+			match_ns = ((stub_time_ns / 1000) + delta_us) * 1000;
+		}
+		if (match_ns < next_ns) {
+			next_ns = match_ns;
+		}
+	}
+
+	if (next_ns <= stub_time_ns) {
+		/* 発生済みのイベントは時刻を進めずに実行できるよう、最小単位だけ進める */
+		next_ns = stub_time_ns + 1;
+	}
+
+	return next_ns;
+}
+
+/*
+ * Function: 完了イベント追加
+ * Argument: 発生までの時間 [ns]、種類、引数
+ * Return  : なし
+ * Note    : なし
+ */
+static void addEvent(uint64_t delay_ns, stub_event_type_t type, uint32_t param)
+{
+	for (uint32_t index=0; index<STUB_EVENT_NUM; index++) {
+		if (stub_event[index].active == FALSE) {
+			stub_event[index].active = TRUE;
+			stub_event[index].time_ns = stub_time_ns + delay_ns;
+			stub_event[index].type = type;
+			stub_event[index].param = param;
+			return;
+		}
+	}
+
+	fprintf(stderr, "stub: event overflow\n");
+	exit(1);
+}
+
+/*
+ * Function: 完了イベント通知
+ * Argument: 種類、引数
+ * Return  : なし
+ * Note    : main.cのHALコールバックと同じ振り分けを行う
+ */
+static void dispatchEvent(stub_event_type_t type, uint32_t param)
+{
+	switch (type) {
+	case STUB_EVENT_SPI:
+		InterruptSpiComplete((spi_ch_t)param);
+		break;
+	case STUB_EVENT_I2C_SEND:
+		InterruptI2cSendComplete();
+		break;
+	case STUB_EVENT_I2C_RECEIVE:
+		InterruptI2cReceiveComplete();
+		break;
+	case STUB_EVENT_I2C_ERROR:
+		InterruptI2cError();
+		break;
+	case STUB_EVENT_ADC:
+		InterruptAdcComplete();
+		break;
+	case STUB_EVENT_DMA2D:
+		InterruptDma2dTransferComplete();
+		break;
+	default:
+		/* 処理なし */
+		break;
+	}
+}
+
+/*
+ * Function: CSに対応するSPIチャネル取得
+ * Argument: GPIO、端子
+ * Return  : SPIチャネル(CS以外は-1)
+ * Note    : なし
+ */
+static int32_t spiChannelFromCs(GPIO_TypeDef* gpio, uint16_t pin)
+{
+	int32_t channel = -1;
+
+	if ((gpio == TFT_CS_GPIO_Port) && (pin == TFT_CS_Pin)) {
+		channel = STUB_SPI_TFT;
+	} else if ((gpio == SOUND_CS_GPIO_Port) && (pin == SOUND_CS_Pin)) {
+		channel = STUB_SPI_SOUND;
+	} else if ((gpio == EEPROM_CS_GPIO_Port) && (pin == EEPROM_CS_Pin)) {
+		channel = STUB_SPI_EEPROM;
+	} else {
+		/* 処理なし */
+	}
+
+	return channel;
+}
+
+/*
+ * Function: SPI転送模擬
+ * Argument: SPIハンドル、送信データ、受信バッファ、長さ
+ * Return  : なし
+ * Note    : データは開始時にデバイスへ渡し、転送時間後に完了割り込みを発生させる
+ */
+static void transferSpi(SPI_HandleTypeDef* hspi, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size)
+{
+	const stub_spi_device_t* device = stub_spi_device[hspi->channel];
+	uint32_t byte_time_ns = STUB_SPI_BYTE_TIME_NS;
+
+	stub_spin_count = 0;
+	if (device != NULL) {
+		if (device->byte_time_ns > 0) {
+			byte_time_ns = device->byte_time_ns;
+		}
+		if (device->transfer != NULL) {
+			device->transfer(tx_data, rx_data, size);
+		}
+	} else if (rx_data != NULL) {
+		memset(rx_data, 0, size);
+	} else {
+		/* 処理なし */
+	}
+
+	addEvent((uint64_t)byte_time_ns * size, STUB_EVENT_SPI, hspi->channel);
+}
+
+/*
+ * Function: I2C転送模擬
+ * Argument: 送信データ(受信時はNULL)、受信バッファ(送信時はNULL)、アドレス、長さ、完了イベント
+ * Return  : HAL_OK
+ * Note    : デバイスがNACKした場合はエラー割り込みを発生させる
+ */
+static HAL_StatusTypeDef transferI2c(const uint8_t* tx_data, uint8_t* rx_data, uint16_t address, uint16_t size, stub_event_type_t complete)
+{
+	uint32_t byte_time_ns = STUB_I2C_BYTE_TIME_NS;
+	bool_t ack = FALSE;
+
+	stub_spin_count = 0;
+	if (stub_i2c_device != NULL) {
+		if (stub_i2c_device->byte_time_ns > 0) {
+			byte_time_ns = stub_i2c_device->byte_time_ns;
+		}
+		if ((tx_data != NULL) && (stub_i2c_device->write != NULL)) {
+			ack = stub_i2c_device->write(address >> 1, tx_data, size);
+		} else if ((rx_data != NULL) && (stub_i2c_device->read != NULL)) {
+			ack = stub_i2c_device->read(address >> 1, rx_data, size);
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	if (ack == TRUE) {
+		addEvent((uint64_t)byte_time_ns * (size + 1), complete, 0);
+	} else {
+		addEvent(byte_time_ns, STUB_EVENT_I2C_ERROR, 0);
+	}
+
+	return HAL_OK;
+}
+
+/*
+ * Function: 時刻計測用タイマーのCNT参照
+ * Argument: なし
+ * Return  : カウンタ
+ * Note    : 読み出し時に発生済みの割り込みを実行する
+ *           時刻を進めずに読み続けた場合はビジーウェイトとみなして1us進める
+ */
+static uint32_t* stubTimeCntRef(void)
+{
+	serviceInterrupt();
+
+	stub_spin_count ++;
+	if (stub_spin_count > STUB_SPIN_LIMIT) {
+		advanceTo(stub_time_ns + 1000);
+	}
+
+	return &stub_time_cnt;
+}
+
+/*
+ * Function: 時刻計測用以外のタイマーのCNT参照
+ * Argument: なし
+ * Return  : カウンタ
+ * Note    : 時刻計測用以外のカウンタは模擬しない
+ */
+static uint32_t* stubOtherCntRef(void)
+{
+	return &stub_other_cnt;
+}
+
+/* CMSIS */
+
+uint32_t __get_PRIMASK(void)
+{
+	return stub_primask;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+	stub_primask = primask;
+	serviceInterrupt();
+}
+
+void __disable_irq(void)
+{
+	stub_primask = 1;
+}
+
+void __enable_irq(void)
+{
+	stub_primask = 0;
+	serviceInterrupt();
+}
+
+void __WFI(void)
+{
+	bool_t pending = stub_cc1_pending;
+
+	for (uint32_t index=0; index<STUB_GPIO_NUM; index++) {
+		if (stub_pin_pending[index] != 0) {
+			pending = TRUE;
+		}
+	}
+	if (pending == FALSE) {
+		/* 割り込み禁止中でも次の割り込み発生(最長1秒)で起床する */
+		advanceTo(nextEventTime(stub_time_ns + 1000000000ULL));
+	}
+}
+
+/* GPIO */
+
+void HAL_GPIO_Init(GPIO_TypeDef* gpio, GPIO_InitTypeDef* init)
+{
+	if (init->Mode == GPIO_MODE_IT_RISING_FALLING) {
+		gpio->EXTI |= (uint16_t)init->Pin;
+	} else {
+		gpio->EXTI &= (uint16_t)~init->Pin;
+	}
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* gpio, uint16_t pin)
+{
+	GPIO_PinState state;
+
+	stub_spin_count = 0;
+	if ((gpio->IDR & pin) != 0) {
+		state = GPIO_PIN_SET;
+	} else {
+		state = GPIO_PIN_RESET;
+	}
+
+	return state;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state)
+{
+	int32_t channel = spiChannelFromCs(gpio, pin);
+	GPIO_PinState previous = StubGetPinOutput(gpio, pin);
+	const stub_spi_device_t* device = NULL;
+
+	stub_spin_count = 0;
+	if (state == GPIO_PIN_SET) {
+		gpio->ODR |= pin;
+	} else {
+		gpio->ODR &= (uint16_t)~pin;
+	}
+
+	if (channel >= 0) {
+		device = stub_spi_device[channel];
+	}
+	if ((device != NULL) && (previous != state)) {
+		if ((state == GPIO_PIN_RESET) && (device->select != NULL)) {
+			device->select();
+		} else if ((state == GPIO_PIN_SET) && (device->deselect != NULL)) {
+			device->deselect();
+		} else {
+			/* 処理なし */
+		}
+	}
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub)
+{
+	(void)irq;
+	(void)preempt;
+	(void)sub;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq)
+{
+	(void)irq;
+}
+
+/* TIM */
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t channel)
+{
+	(void)htim;
+	(void)channel;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t channel)
+{
+	(void)htim;
+	(void)channel;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef* htim, uint32_t channel)
+{
+	(void)htim;
+	(void)channel;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Stop(TIM_HandleTypeDef* htim, uint32_t channel)
+{
+	(void)htim;
+	(void)channel;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef* htim, uint32_t event_source)
+{
+	if ((htim == &htim4) && ((event_source & TIM_EVENTSOURCE_CC1) != 0)) {
+		stub_cc1_pending = TRUE;
+		serviceInterrupt();
+	}
+
+	return HAL_OK;
+}
+
+/* SPI */
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, const uint8_t* data, uint16_t size)
+{
+	transferSpi(hspi, data, NULL, size);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* data, uint16_t size)
+{
+	transferSpi(hspi, NULL, data, size);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size)
+{
+	transferSpi(hspi, tx_data, rx_data, size);
+	return HAL_OK;
+}
+
+/* I2C */
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t option)
+{
+	(void)hi2c;
+	(void)option;
+	return transferI2c(data, NULL, address, size, STUB_EVENT_I2C_SEND);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t option)
+{
+	(void)hi2c;
+	(void)option;
+	return transferI2c(NULL, data, address, size, STUB_EVENT_I2C_RECEIVE);
+}
+
+/* ADC */
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart_IT(ADC_HandleTypeDef* hadc)
+{
+	(void)hadc;
+	addEvent(STUB_ADC_TIME_NS, STUB_EVENT_ADC, 0);
+	return HAL_OK;
+}
+
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef* hadc, uint32_t rank)
+{
+	uint32_t value = 0;
+
+	(void)hadc;
+	if ((rank >= ADC_INJECTED_RANK_1) && (rank < ADC_INJECTED_RANK_1 + STUB_ADC_NUM)) {
+		value = stub_adc_value[rank - ADC_INJECTED_RANK_1];
+	}
+
+	return value;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc)
+{
+	(void)hadc;
+	stub_adc_dma_buffer = NULL;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef* hadc)
+{
+	(void)hadc;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* config)
+{
+	(void)hadc;
+	(void)config;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* hadc, uint32_t mode, uint32_t single_diff)
+{
+	(void)hadc;
+	(void)mode;
+	(void)single_diff;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, const uint32_t* data, uint32_t length)
+{
+	/* HALと同様にハーフ転送/転送完了割り込みを有効にして開始する */
+	hadc->DMA_Handle->IER |= DMA_IT_HT | DMA_IT_TC;
+	stub_adc_dma_buffer = (uint32_t*)data;
+	for (uint32_t index=0; (index<length) && (index<STUB_ADC_NUM); index++) {
+		stub_adc_dma_buffer[index] = stub_adc_value[index];
+	}
+	return HAL_OK;
+}
+
+/* UART */
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size, uint32_t timeout)
+{
+	(void)huart;
+	(void)timeout;
+	for (uint16_t index=0; (index<size) && (stub_uart_length<STUB_UART_SIZE-1); index++) {
+		stub_uart_output[stub_uart_length] = (char)data[index];
+		stub_uart_length ++;
+	}
+	stub_uart_output[stub_uart_length] = '\0';
+	return HAL_OK;
+}
+
+/* DMA2D */
+
+HAL_StatusTypeDef HAL_DMA2D_Init(DMA2D_HandleTypeDef* hdma2d_handle)
+{
+	(void)hdma2d_handle;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA2D_Start_IT(DMA2D_HandleTypeDef* hdma2d_handle, uint32_t color, uint32_t destination, uint32_t width, uint32_t height)
+{
+	/* 転送先アドレスは32bitのため、ホストでは塗りつぶしを行わない */
+	(void)hdma2d_handle;
+	(void)color;
+	(void)destination;
+	(void)width;
+	(void)height;
+	addEvent(STUB_DMA2D_TIME_NS, STUB_EVENT_DMA2D, 0);
+	return HAL_OK;
+}
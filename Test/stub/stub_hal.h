@@ -0,0 +1,69 @@
+/*
+ * stub_hal.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  ホストビルド用のHAL模擬
+ *  時刻計測用タイマー(TIM4)を模擬時刻とし、SPI/I2C/ADC/DMA2Dの完了、コンペアマッチ、端子エッジを
+ *  模擬時刻の経過に合わせて割り込み処理(main.cと同じ振り分け先)として呼び出す
+ */
+
+
+#ifndef STUB_HAL_H_
+#define STUB_HAL_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* SPIチャネル番号(hspiX.channel) */
+#define STUB_SPI_TFT		(0)
+#define STUB_SPI_SOUND		(1)
+#define STUB_SPI_EEPROM		(2)
+#define STUB_SPI_NUM		(3)
+
+/* ADC変換値の数 */
+#define STUB_ADC_NUM		(3)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/* SPI接続デバイスの模擬 */
+typedef struct {
+	void (*select)(void);				/* CS有効(Low) */
+	void (*deselect)(void);				/* CS無効(High) */
+	void (*transfer)(const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);	/* 送受信(送信のみ/受信のみの場合は他方がNULL) */
+	uint32_t byte_time_ns;				/* 1byteの転送時間 [ns] */
+} stub_spi_device_t;
+
+/* I2C接続デバイスの模擬 */
+typedef struct {
+	bool_t (*write)(uint16_t device_address, const uint8_t* data, uint16_t length);	/* FALSE:NACK */
+	bool_t (*read)(uint16_t device_address, uint8_t* data, uint16_t length);			/* FALSE:NACK */
+	uint32_t byte_time_ns;				/* 1byteの転送時間 [ns] */
+} stub_i2c_device_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void StubInit(void);
+uint32_t StubGetTimeUs(void);
+void StubAdvanceUs(uint32_t us);
+bool_t StubRunUntil(bool_t (*condition)(void), uint32_t timeout_us);
+uint32_t StubGetInterruptCount(void);
+void StubSetPinLevel(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state);
+GPIO_PinState StubGetPinOutput(GPIO_TypeDef* gpio, uint16_t pin);
+void StubSetSpiDevice(uint32_t channel, const stub_spi_device_t* device);
+void StubSetI2cDevice(const stub_i2c_device_t* device);
+void StubSetAdcValue(uint32_t index, uint32_t value);
+const char* StubGetUartOutput(void);
+void StubClearUartOutput(void);
+
+#endif /* STUB_HAL_H_ */
@@ -0,0 +1,197 @@
+/*
+ * test_eeprom.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  DRV EEPROM のページ書き込みのテスト
+ *  25LC080Cの模擬で書き込みサイクル数を数え、書き込み待ちがページ単位の1回の書き込みにまとまることを確認する
+ */
+
+
+/********** Include **********/
+
+#include <stdlib.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "drv_eeprom.h"
+#include "stub_hal.h"
+#include "eeprom_sim.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 書き込み完了待ちの上限 [us] */
+#define FLUSH_TIMEOUT			(200000)
+
+/* SAVEDATA領域の先頭ページ(0x100) */
+#define SAVEDATA_PAGE			(0x100 / EEPROM_PAGE_SIZE)
+
+/* 1件の記録のサイズ [byte] */
+#define RECORD_SIZE				(64)
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static uint8_t record[RECORD_SIZE];
+
+/********** Function Prototype **********/
+
+static bool_t isEepromReady(void);
+static void startEeprom(void);
+static void fillRecord(uint8_t seed);
+
+/********** Function **********/
+
+/*
+ * 64byteの記録の書き込みは4ページ分の4回の書き込みサイクルで完了する
+ */
+static void testPageWrite(void)
+{
+	uint32_t start_time;
+
+	startEeprom();
+	fillRecord(0x10);
+	start_time = StubGetTimeUs();
+	TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, 0, record, RECORD_SIZE));
+	TEST_ASSERT_EQUAL(RESULT_OK, FlushEeprom(FLUSH_TIMEOUT));
+	printf("    %u cycles, %u us\n", GetEepromSimWriteCycleNum(), StubGetTimeUs() - start_time);
+
+	TEST_ASSERT_EQUAL(RECORD_SIZE / EEPROM_PAGE_SIZE, GetEepromSimWriteCycleNum());
+	for (uint32_t page=0; page<RECORD_SIZE/EEPROM_PAGE_SIZE; page++) {
+		TEST_ASSERT_EQUAL(1, GetEepromSimPageWriteCycleNum(SAVEDATA_PAGE + page));
+	}
+	for (uint32_t index=0; index<RECORD_SIZE; index++) {
+		TEST_ASSERT_EQUAL(record[index], GetEepromSimMemory()[0x100 + index]);
+	}
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 1byte毎の書き込み、同じアドレスへの繰り返し書き込みもページ単位にまとまる
+ */
+static void testByteWrite(void)
+{
+	uint8_t data;
+
+	startEeprom();
+	fillRecord(0x20);
+	for (uint32_t index=0; index<RECORD_SIZE; index++) {
+		TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, index, &record[index], 1));
+	}
+	for (uint32_t count=0; count<10; count++) {
+		data = (uint8_t)count;
+		TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, 0, &data, 1));
+	}
+	record[0] = data;
+	TEST_ASSERT_EQUAL(RESULT_OK, FlushEeprom(FLUSH_TIMEOUT));
+
+	TEST_ASSERT_EQUAL(RECORD_SIZE / EEPROM_PAGE_SIZE, GetEepromSimWriteCycleNum());
+	for (uint32_t index=0; index<RECORD_SIZE; index++) {
+		TEST_ASSERT_EQUAL(record[index], GetEepromSimMemory()[0x100 + index]);
+	}
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * ページ境界を跨ぐ書き込みはページ毎に分割する
+ */
+static void testPageBoundary(void)
+{
+	startEeprom();
+	fillRecord(0x30);
+	TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, 8, record, 20));
+	TEST_ASSERT_EQUAL(RESULT_OK, FlushEeprom(FLUSH_TIMEOUT));
+
+	TEST_ASSERT_EQUAL(2, GetEepromSimWriteCycleNum());
+	TEST_ASSERT_EQUAL(1, GetEepromSimPageWriteCycleNum(SAVEDATA_PAGE));
+	TEST_ASSERT_EQUAL(1, GetEepromSimPageWriteCycleNum(SAVEDATA_PAGE + 1));
+	for (uint32_t index=0; index<20; index++) {
+		TEST_ASSERT_EQUAL(record[index], GetEepromSimMemory()[0x100 + 8 + index]);
+	}
+	/* 範囲外は消去状態のまま */
+	TEST_ASSERT_EQUAL(0xFF, GetEepromSimMemory()[0x100 + 7]);
+	TEST_ASSERT_EQUAL(0xFF, GetEepromSimMemory()[0x100 + 28]);
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 書き込みサイクル中に同じページを更新した場合は、完了後に最新の値で再度書き込む
+ */
+static void testWriteDuringCycle(void)
+{
+	uint8_t data = 0xA5;
+
+	startEeprom();
+	fillRecord(0x40);
+	TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, 0, record, EEPROM_PAGE_SIZE));
+	MainEeprom();
+	StubAdvanceUs(1000);
+	TEST_ASSERT_EQUAL(1, GetEepromSimWriteCycleNum());
+	TEST_ASSERT(IsEepromWritten(EEPROM_DATA_ID_SAVEDATA, 0, EEPROM_PAGE_SIZE) == FALSE);
+
+	TEST_ASSERT_EQUAL(RESULT_OK, WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, 3, &data, 1));
+	record[3] = data;
+	TEST_ASSERT_EQUAL(RESULT_OK, FlushEeprom(FLUSH_TIMEOUT));
+
+	TEST_ASSERT_EQUAL(2, GetEepromSimWriteCycleNum());
+	TEST_ASSERT(IsEepromWritten(EEPROM_DATA_ID_SAVEDATA, 0, EEPROM_PAGE_SIZE) == TRUE);
+	for (uint32_t index=0; index<EEPROM_PAGE_SIZE; index++) {
+		TEST_ASSERT_EQUAL(record[index], GetEepromSimMemory()[0x100 + index]);
+	}
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 起動時の全データ読み出し完了判定
+ */
+static bool_t isEepromReady(void)
+{
+	return IsEepromReady();
+}
+
+/*
+ * 模擬を初期化してDRV EEPROMを全データ読み出し完了まで進める
+ */
+static void startEeprom(void)
+{
+	StubInit();
+	InitEepromSim();
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitEeprom();
+	if (StubRunUntil(isEepromReady, 100000) == FALSE) {
+		printf("    eeprom load timeout\n");
+		exit(1);
+	}
+}
+
+/*
+ * 書き込みデータ作成
+ */
+static void fillRecord(uint8_t seed)
+{
+	for (uint32_t index=0; index<RECORD_SIZE; index++) {
+		record[index] = (uint8_t)(seed + index);
+	}
+}
+
+int main(void)
+{
+	TEST_RUN(testPageWrite);
+	TEST_RUN(testByteWrite);
+	TEST_RUN(testPageBoundary);
+	TEST_RUN(testWriteDuringCycle);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,181 @@
+/*
+ * test_i2c.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  MCAL I2C のエラーリトライのテスト
+ *  NACKするデバイス模擬で、リトライ間隔が延びること、打ち切り時間でRESULT_NGを通知すること、
+ *  復帰したデバイスとは通信を続けることを確認する
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_i2c.h"
+#include "mcal_timer.h"
+#include "stub_hal.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* デバイスアドレス */
+#define DEVICE_ADDRESS			(0x5D)
+
+/* 通信試行時刻の記録数 */
+#define RECORD_NUM				(32)
+
+/* リトライの打ち切り時間 [us] (mcal_i2c.cのI2C_RETRY_TIMEOUT) */
+#define RETRY_TIMEOUT			(10000)
+
+/* 通知待ちの上限 [us] */
+#define WAIT_TIMEOUT			(50000)
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static uint32_t attempt_time[RECORD_NUM];
+static uint32_t attempt_num;
+static uint32_t nack_num;
+
+static uint32_t callback_num;
+static result_t callback_result[2];
+static uint32_t callback_time[2];
+
+/********** Function Prototype **********/
+
+static void startI2c(uint32_t nack);
+static void addJob(void);
+static bool_t writeDevice(uint16_t address, const uint8_t* data, uint16_t length);
+static void callbackJob(result_t result);
+
+/********** Function **********/
+
+/*
+ * NACKが続く場合はリトライ間隔を延ばし、打ち切り時間内にRESULT_NGを通知して次のジョブに進む
+ */
+static void testRetryTimeout(void)
+{
+	uint32_t start_time;
+	uint32_t first_num;
+
+	startI2c(0xFFFFFFFF);
+	start_time = StubGetTimeUs();
+	addJob();
+	addJob();
+	StubAdvanceUs(WAIT_TIMEOUT);
+
+	TEST_ASSERT_EQUAL(2, callback_num);
+	TEST_ASSERT_EQUAL(RESULT_NG, callback_result[0]);
+	TEST_ASSERT(callback_time[0] - start_time <= RETRY_TIMEOUT);
+
+	/* 即座に再試行せず、間隔を延ばして数回に抑える */
+	first_num = 0;
+	while ((first_num < attempt_num) && (attempt_time[first_num] < callback_time[0])) {
+		first_num ++;
+	}
+	TEST_ASSERT(first_num > 3);
+	TEST_ASSERT(first_num < 16);
+	for (uint32_t index=2; index<first_num; index++) {
+		TEST_ASSERT(attempt_time[index] - attempt_time[index - 1] >= attempt_time[index - 1] - attempt_time[index - 2]);
+	}
+	TEST_ASSERT(attempt_time[1] - attempt_time[0] >= 100);
+
+	/* 打ち切り時間はジョブ毎に数える */
+	TEST_ASSERT_EQUAL(RESULT_NG, callback_result[1]);
+	TEST_ASSERT(callback_time[1] - callback_time[0] <= RETRY_TIMEOUT);
+}
+
+/*
+ * 途中でNACKしなくなったデバイスとはリトライで通信を完了する
+ */
+static void testRetryRecover(void)
+{
+	startI2c(2);
+	addJob();
+	StubAdvanceUs(WAIT_TIMEOUT);
+
+	TEST_ASSERT_EQUAL(1, callback_num);
+	TEST_ASSERT_EQUAL(RESULT_OK, callback_result[0]);
+	TEST_ASSERT_EQUAL(3, attempt_num);
+}
+
+/*
+ * 模擬とMCALを初期化して記録を消去
+ */
+static void startI2c(uint32_t nack)
+{
+	static const stub_i2c_device_t device = {writeDevice, NULL, 0};
+
+	StubInit();
+	StubSetI2cDevice(&device);
+	InitI2c();
+	InitTimer();
+	attempt_num = 0;
+	nack_num = nack;
+	callback_num = 0;
+}
+
+/*
+ * 1バイト書き込みジョブを追加
+ */
+static void addJob(void)
+{
+	static const uint8_t data[1] = {0x00};
+	i2c_job_t job = {0};
+
+	job.device_address = DEVICE_ADDRESS;
+	job.write_data = data;
+	job.write_length = sizeof(data);
+	job.callback = callbackJob;
+	TEST_ASSERT_EQUAL(RESULT_OK, AddI2cJob(&job));
+}
+
+/*
+ * デバイス模擬の書き込み(指定回数NACKする)
+ */
+static bool_t writeDevice(uint16_t address, const uint8_t* data, uint16_t length)
+{
+	bool_t ack = TRUE;
+
+	(void)data;
+	(void)length;
+
+	if (attempt_num < RECORD_NUM) {
+		attempt_time[attempt_num] = StubGetTimeUs();
+	}
+	attempt_num ++;
+
+	if ((address != DEVICE_ADDRESS) || (nack_num > 0)) {
+		if (nack_num > 0) {
+			nack_num --;
+		}
+		ack = FALSE;
+	}
+
+	return ack;
+}
+
+/*
+ * ジョブ完了通知の記録
+ */
+static void callbackJob(result_t result)
+{
+	if (callback_num < 2) {
+		callback_result[callback_num] = result;
+		callback_time[callback_num] = StubGetTimeUs();
+	}
+	callback_num ++;
+}
+
+int main(void)
+{
+	TEST_RUN(testRetryTimeout);
+	TEST_RUN(testRetryRecover);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,399 @@
+/*
+ * test_replay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  SYS REPLAY の記録、再生のテスト
+ *  記録した入力(SW、AD変換値、タッチ、入力イベント)が再生で同じフレームに同じ値として得られること、
+ *  途切れた、または壊れた記録を範囲外まで読まずに終了することを確認する
+ */
+
+
+/********** Include **********/
+
+#include <stdlib.h>
+#include <string.h>
+#include "typedef.h"
+#include "mcal_adc.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "sys_replay.h"
+#include "drv_eeprom.h"
+#include "drv_controller.h"
+#include "drv_touch.h"
+#include "stub_hal.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 記録フレーム数(変化なしフレームの連続数上限127を超える区間を含む) */
+#define RECORD_FRAME_NUM			(300)
+/* 1フレームあたりのUpdateSwInput呼び出し数(5ms×3) */
+#define FRAME_SW_UPDATE_NUM			(3)
+#define SW_UPDATE_PERIOD			(5000)
+/* 1フレームで比較する入力イベント数の上限 */
+#define FRAME_EVENT_NUM_MAX			(16)
+/* 記録の後ろを埋める値(全項目変化のフレームヘッダ) */
+#define FILL_DATA					(0x1F)
+/* 壊れた記録の試行数 */
+#define CORRUPT_TRIAL_NUM			(200)
+
+/********** Type **********/
+
+/* 1フレームで観測した入力 */
+typedef struct {
+	input_state_t input_state[INPUT_ID_NUM];
+	uint32_t ad[AD_ID_NUM];
+	touch_state_t touch_state;
+	point_t touch_point;
+	uint32_t event_num;
+	input_id_t event_id[FRAME_EVENT_NUM_MAX];
+	input_event_type_t event_type[FRAME_EVENT_NUM_MAX];
+} observed_frame_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static observed_frame_t recorded_frame[RECORD_FRAME_NUM];
+static uint8_t record_data[REPLAY_BUFFER_SIZE];
+static uint32_t record_length;
+static uint8_t load_data[REPLAY_BUFFER_SIZE];
+
+/********** Function Prototype **********/
+
+static void recordScript(void);
+static void setLiveInput(uint32_t frame);
+static void runFrame(void);
+static void observeFrame(observed_frame_t* frame);
+static bool_t isSameFrame(const observed_frame_t* a, const observed_frame_t* b);
+static uint32_t playRecording(uint32_t frame_max, uint32_t* mismatch_num);
+static void readDump(void);
+static bool_t isEepromReady(void);
+static void startReplay(void);
+
+/********** Function **********/
+
+/*
+ * 記録した入力が再生で同じフレームに得られる
+ */
+static void testRecordPlay(void)
+{
+	uint32_t play_num;
+	uint32_t mismatch_num;
+	uint32_t event_total = 0;
+
+	startReplay();
+	recordScript();
+
+	TEST_ASSERT_EQUAL(RECORD_FRAME_NUM, GetReplayFrameNum());
+	for (uint32_t frame=0; frame<RECORD_FRAME_NUM; frame++) {
+		event_total += recorded_frame[frame].event_num;
+	}
+	printf("    %u frames, %u events\n", RECORD_FRAME_NUM, event_total);
+	TEST_ASSERT(event_total >= 4);
+
+	/* 再生中は実入力(SW_C押下、AD値0)を使用しない */
+	StubSetPinLevel(SW_C_GPIO_Port, SW_C_Pin, GPIO_PIN_RESET);
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		StubSetAdcValue(ad_id, 0);
+	}
+	StartReplayPlay();
+	play_num = playRecording(RECORD_FRAME_NUM + 1, &mismatch_num);
+	TEST_ASSERT_EQUAL(RECORD_FRAME_NUM, play_num);
+	TEST_ASSERT_EQUAL(0, mismatch_num);
+	TEST_ASSERT_EQUAL(REPLAY_STATE_IDLE, GetReplayState());
+
+	/* 再生終了後は実入力に戻る */
+	runFrame();
+	TEST_ASSERT(GetInputState(INPUT_ID_SW_C) != INPUT_OFF);
+	TEST_ASSERT_EQUAL(0, GetAdRaw(AD_ID_POS_H));
+}
+
+/*
+ * 途中で途切れた記録は完全なフレームまで再生して終了する
+ */
+static void testTruncatedRecording(void)
+{
+	uint32_t play_num;
+	uint32_t play_num_last = 0;
+	uint32_t mismatch_num;
+	uint32_t mismatch_total = 0;
+	bool_t monotonic = TRUE;
+
+	startReplay();
+	recordScript();
+	readDump();
+	TEST_ASSERT(record_length > 0);
+
+	/* 記録の後ろは範囲外を読んだ場合に検出できる値で埋める */
+	memset(load_data, FILL_DATA, sizeof(load_data));
+
+	for (uint32_t length=0; length<=record_length; length++) {
+		LoadReplay(load_data, REPLAY_BUFFER_SIZE);
+		LoadReplay(record_data, length);
+		StartReplayPlay();
+		play_num = playRecording(RECORD_FRAME_NUM + 1, &mismatch_num);
+		mismatch_total += mismatch_num;
+		if (play_num < play_num_last) {
+			monotonic = FALSE;
+		}
+		play_num_last = play_num;
+		TEST_ASSERT(play_num <= RECORD_FRAME_NUM);
+		TEST_ASSERT_EQUAL(REPLAY_STATE_IDLE, GetReplayState());
+	}
+
+	TEST_ASSERT_EQUAL(0, mismatch_total);
+	TEST_ASSERT(monotonic == TRUE);
+	TEST_ASSERT_EQUAL(RECORD_FRAME_NUM, play_num_last);
+}
+
+/*
+ * 壊れた記録でも範囲内で再生を終了する
+ */
+static void testCorruptRecording(void)
+{
+	uint32_t seed = 1;
+	uint32_t position;
+	uint32_t play_num;
+	uint32_t mismatch_num;
+	uint32_t frame_max;
+
+	startReplay();
+	recordScript();
+	readDump();
+
+	/* 記録の全バイトが変化なしフレーム(上限127)でも超えないフレーム数 */
+	frame_max = record_length * 0x7F;
+	for (uint32_t trial=0; trial<CORRUPT_TRIAL_NUM; trial++) {
+		memcpy(load_data, record_data, record_length);
+		for (uint32_t count=0; count<4; count++) {
+			seed = seed * 1103515245 + 12345;
+			position = (seed >> 8) % record_length;
+			load_data[position] ^= (uint8_t)(seed >> 24) | 0x01;
+		}
+		LoadReplay(load_data, record_length);
+		StartReplayPlay();
+		play_num = playRecording(frame_max + 1, &mismatch_num);
+		TEST_ASSERT(play_num <= frame_max);
+		TEST_ASSERT_EQUAL(REPLAY_STATE_IDLE, GetReplayState());
+	}
+}
+
+/*
+ * 入力を変化させながらRECORD_FRAME_NUMフレーム記録する
+ */
+static void recordScript(void)
+{
+	/* タッチは差し替え値を実入力として記録する(GT911の模擬なし) */
+	SetTouchInject(TRUE);
+	StartReplayRecord();
+	for (uint32_t frame=0; frame<RECORD_FRAME_NUM; frame++) {
+		setLiveInput(frame);
+		runFrame();
+		observeFrame(&recorded_frame[frame]);
+	}
+	StopReplay();
+	SetTouchInject(FALSE);
+}
+
+/*
+ * フレーム毎の実入力
+ */
+static void setLiveInput(uint32_t frame)
+{
+	point_t point;
+	touch_state_t touch_state;
+
+	/* SW_A長押し、SW_B短押し */
+	if ((frame >= 10) && (frame < 30)) {
+		StubSetPinLevel(SW_A_GPIO_Port, SW_A_Pin, GPIO_PIN_RESET);
+	} else {
+		StubSetPinLevel(SW_A_GPIO_Port, SW_A_Pin, GPIO_PIN_SET);
+	}
+	if ((frame >= 20) && (frame < 22)) {
+		StubSetPinLevel(SW_B_GPIO_Port, SW_B_Pin, GPIO_PIN_RESET);
+	} else {
+		StubSetPinLevel(SW_B_GPIO_Port, SW_B_Pin, GPIO_PIN_SET);
+	}
+
+	/* AD値は差分で表せる変化と、絶対値が必要な変化 */
+	if (frame < 50) {
+		StubSetAdcValue(AD_ID_POS_H, (AD_VALUE_MAX / 2) + (frame * 20));
+	} else if (frame < 60) {
+		StubSetAdcValue(AD_ID_POS_H, AD_VALUE_MAX);
+	} else {
+		StubSetAdcValue(AD_ID_POS_H, AD_VALUE_MAX / 2);
+	}
+	StubSetAdcValue(AD_ID_POS_V, AD_VALUE_MAX / 2);
+	if ((frame >= 65) && (frame < 75)) {
+		StubSetAdcValue(AD_ID_LEVER, 0);
+	} else {
+		StubSetAdcValue(AD_ID_LEVER, AD_VALUE_MAX / 2);
+	}
+
+	/* タッチしてなぞる */
+	point.x = (float)(frame * 2);
+	point.y = 100.0f;
+	if (frame == 40) {
+		touch_state = TOUCH_START;
+	} else if ((frame > 40) && (frame < 60)) {
+		touch_state = TOUCH_ON;
+	} else if (frame == 60) {
+		touch_state = TOUCH_END;
+	} else {
+		touch_state = TOUCH_OFF;
+		point.x = 0.0f;
+	}
+	InjectTouch(touch_state, point);
+}
+
+/*
+ * 1フレーム分の処理(cyclicMainEventの入力系と同じ順序)
+ */
+static void runFrame(void)
+{
+	for (uint32_t index=0; index<FRAME_SW_UPDATE_NUM; index++) {
+		StubAdvanceUs(SW_UPDATE_PERIOD);
+		UpdateSwInput();
+	}
+
+	MainReplay();
+	MainAdc();
+	MainController();
+	RecordReplay();
+}
+
+/*
+ * 入力系ドライバから見える入力を取得
+ */
+static void observeFrame(observed_frame_t* frame)
+{
+	input_event_t event;
+
+	memset(frame, 0, sizeof(observed_frame_t));
+	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+		frame->input_state[input_id] = GetInputState(input_id);
+	}
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		frame->ad[ad_id] = GetAdRaw(ad_id);
+	}
+	frame->touch_state = GetTouchState();
+	frame->touch_point = GetTouchPoint();
+	for (uint32_t index=0; (index<GetInputEventNum()) && (index<FRAME_EVENT_NUM_MAX); index++) {
+		event = GetInputEvent(index);
+		frame->event_id[index] = event.input_id;
+		frame->event_type[index] = event.type;
+		frame->event_num ++;
+	}
+}
+
+/*
+ * 観測した入力の比較(入力イベントの発生時刻は比較しない)
+ */
+static bool_t isSameFrame(const observed_frame_t* a, const observed_frame_t* b)
+{
+	bool_t same = FALSE;
+
+	if (memcmp(a, b, sizeof(observed_frame_t)) == 0) {
+		same = TRUE;
+	}
+
+	return same;
+}
+
+/*
+ * 再生終了まで実行し、記録時と異なるフレーム数を数える
+ * 戻り値は再生したフレーム数(最終フレームの読み出しで終了した場合、そのフレームは含まない)
+ */
+static uint32_t playRecording(uint32_t frame_max, uint32_t* mismatch_num)
+{
+	observed_frame_t frame;
+	uint32_t play_num = 0;
+
+	*mismatch_num = 0;
+	while ((GetReplayState() == REPLAY_STATE_PLAY) && (play_num < frame_max)) {
+		runFrame();
+		if (GetReplayState() == REPLAY_STATE_PLAY) {
+			observeFrame(&frame);
+			if ((play_num >= RECORD_FRAME_NUM) || (isSameFrame(&frame, &recorded_frame[play_num]) == FALSE)) {
+				(*mismatch_num) ++;
+			}
+			play_num ++;
+		}
+	}
+
+	return play_num;
+}
+
+/*
+ * DumpReplayのUART出力から記録データを復元
+ */
+static void readDump(void)
+{
+	const char* text;
+	char hex[3] = {0};
+
+	StubClearUartOutput();
+	DumpReplay();
+	text = StubGetUartOutput();
+
+	/* 1行目は"REPLAY,フレーム数,バイト数" */
+	TEST_ASSERT(strncmp(text, "REPLAY,", 7) == 0);
+	text = strchr(text, '\n') + 1;
+
+	record_length = 0;
+	while ((text[0] != '\0') && (record_length < REPLAY_BUFFER_SIZE)) {
+		if ((text[0] == '\r') || (text[0] == '\n')) {
+			text ++;
+		} else {
+			hex[0] = text[0];
+			hex[1] = text[1];
+			record_data[record_length] = (uint8_t)strtoul(hex, NULL, 16);
+			record_length ++;
+			text += 2;
+		}
+	}
+}
+
+/*
+ * 起動時のEEPROM読み出し完了判定
+ */
+static bool_t isEepromReady(void)
+{
+	return IsEepromReady();
+}
+
+/*
+ * 模擬を初期化して入力系ドライバとSYS REPLAYを初期化する
+ */
+static void startReplay(void)
+{
+	StubInit();
+	InitDio();
+	InitAdc();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitReplay();
+	InitEeprom();
+	if (StubRunUntil(isEepromReady, 100000) == FALSE) {
+		printf("    eeprom load timeout\n");
+		exit(1);
+	}
+	InitController();
+}
+
+int main(void)
+{
+	TEST_RUN(testRecordPlay);
+	TEST_RUN(testTruncatedRecording);
+	TEST_RUN(testCorruptRecording);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,362 @@
+/*
+ * test_savedata.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  DRV SAVEDATA のスロット書き込みの電源断テスト
+ *  25LC080Cの模擬で1回の保存の書き込みを1byte毎に電源断し、再起動後に直前の保存または今回の保存が読み出せることを確認する
+ *  書き込み分散記録は周回の境界(エントリ0)を含む追記で同様に確認する
+ */
+
+
+/********** Include **********/
+
+#include <stdlib.h>
+#include <string.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "drv_eeprom.h"
+#include "drv_savedata.h"
+#include "stub_hal.h"
+#include "eeprom_sim.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 保存完了待ちの上限 [us] */
+#define SAVE_TIMEOUT			(500000)
+/* 周期処理の間隔 [us] */
+#define MAIN_PERIOD				(1000)
+
+/* 書き込み分散記録の確認に使用する記録(8エントリ)と、1周 + 途中までの追記回数 */
+#define RING_ID					(SAVERING_ID_BOOT_COUNT)
+#define RING_ENTRY_NUM			(8)
+#define RING_APPEND_NUM			(RING_ENTRY_NUM + 4)
+
+/* 保存前の状態(事前の保存回数)の数: 未保存、1回(空きスロットへ書き込み)、2回(古いスロットを上書き) */
+#define PRE_SAVE_NUM_MAX		(2)
+
+/********** Type **********/
+
+/********** Constant **********/
+
+static const uint16_t savedata_size_table[SAVEDATA_ID_NUM] = {
+	SAVEDATA_SIZE_SETTING,
+	SAVEDATA_SIZE_GAME
+};
+
+/********** Variable **********/
+
+static uint8_t snapshot[EEPROM_SIM_SIZE];
+
+/********** Function Prototype **********/
+
+static void runSave(savedata_id_t savedata_id, uint8_t seed);
+static void runAppend(uint32_t count);
+static uint32_t readRing(void);
+static bool_t checkData(const uint8_t* data, uint16_t size, uint8_t seed);
+static bool_t isEepromReady(void);
+static void startSavedata(bool_t erase);
+
+/********** Function **********/
+
+/*
+ * 保存と再起動後の読み出し(保存毎に別のスロットを使用する)
+ */
+static void testSaveLoad(void)
+{
+	uint8_t data[SAVEDATA_SIZE_GAME];
+
+	startSavedata(TRUE);
+	TEST_ASSERT_EQUAL(RESULT_NG, LoadSavedata(SAVEDATA_ID_GAME, data));
+
+	for (uint8_t count=1; count<=3; count++) {
+		runSave(SAVEDATA_ID_GAME, count);
+		startSavedata(FALSE);
+		TEST_ASSERT_EQUAL(RESULT_OK, LoadSavedata(SAVEDATA_ID_GAME, data));
+		TEST_ASSERT(checkData(data, SAVEDATA_SIZE_GAME, count) == TRUE);
+	}
+
+	/* 他の記録は未保存のまま */
+	TEST_ASSERT_EQUAL(RESULT_NG, LoadSavedata(SAVEDATA_ID_SETTING, data));
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 保存中の全てのbyteでの電源断
+ * 再起動後は直前の保存(未保存の場合は有効なデータなし)または今回の保存のどちらかが読み出せる
+ */
+static void testPowerCut(void)
+{
+	uint8_t data[SAVEDATA_SIZE_GAME];
+	uint16_t size;
+	uint32_t write_byte_num;
+	uint32_t old_num;
+	uint32_t new_num;
+	result_t result;
+
+	for (uint32_t id=0; id<SAVEDATA_ID_NUM; id++) {
+		size = savedata_size_table[id];
+		for (uint32_t pre_save_num=0; pre_save_num<=PRE_SAVE_NUM_MAX; pre_save_num++) {
+			/* 保存前の状態を作成 */
+			startSavedata(TRUE);
+			for (uint32_t count=1; count<=pre_save_num; count++) {
+				runSave(id, (uint8_t)count);
+			}
+			memcpy(snapshot, GetEepromSimMemory(), EEPROM_SIM_SIZE);
+
+			/* 電源断なしの保存で書き込むbyte数 */
+			startSavedata(TRUE);
+			memcpy(GetEepromSimMemory(), snapshot, EEPROM_SIM_SIZE);
+			startSavedata(FALSE);
+			write_byte_num = GetEepromSimWriteByteNum();
+			runSave(id, 0x80);
+			write_byte_num = GetEepromSimWriteByteNum() - write_byte_num;
+
+			old_num = 0;
+			new_num = 0;
+			for (uint32_t cut=0; cut<=write_byte_num; cut++) {
+				startSavedata(TRUE);
+				memcpy(GetEepromSimMemory(), snapshot, EEPROM_SIM_SIZE);
+				startSavedata(FALSE);
+				SetEepromSimPowerCut(GetEepromSimWriteByteNum() + cut);
+				runSave(id, 0x80);
+
+				/* 再起動 */
+				startSavedata(FALSE);
+				result = LoadSavedata(id, data);
+				if ((result == RESULT_OK) && (checkData(data, size, 0x80) == TRUE)) {
+					new_num ++;
+				} else if ((pre_save_num == 0) && (result == RESULT_NG)) {
+					old_num ++;
+				} else if ((pre_save_num > 0) && (result == RESULT_OK) && (checkData(data, size, (uint8_t)pre_save_num) == TRUE)) {
+					old_num ++;
+				} else {
+					printf("    id %u, pre save %u, cut %u: torn data\n", id, pre_save_num, cut);
+					TEST_ASSERT(FALSE);
+				}
+			}
+			printf("    id %u, pre save %u: %u bytes, old %u, new %u\n", id, pre_save_num, write_byte_num, old_num, new_num);
+
+			/* データ、ヘッダの全byteの書き込み前は直前の保存、全byteの書き込み後は今回の保存 */
+			TEST_ASSERT_EQUAL(write_byte_num + 1, old_num + new_num);
+			TEST_ASSERT(old_num >= size);
+			TEST_ASSERT(new_num >= 1);
+		}
+	}
+}
+
+/*
+ * 書き込み分散記録の追記中の全てのbyteでの電源断
+ * 再起動後は直前の追記または今回の追記の値が読み出せる(エントリ0の破損で全体が未使用扱いにならない)
+ */
+static void testRingPowerCut(void)
+{
+	uint32_t write_byte_num;
+	uint32_t value;
+	uint32_t old_num;
+	uint32_t new_num;
+
+	for (uint32_t count=1; count<=RING_APPEND_NUM; count++) {
+		/* count-1回追記した状態を作成 */
+		startSavedata(TRUE);
+		for (uint32_t append=1; append<count; append++) {
+			runAppend(append);
+		}
+		memcpy(snapshot, GetEepromSimMemory(), EEPROM_SIM_SIZE);
+		write_byte_num = GetEepromSimWriteByteNum();
+		runAppend(count);
+		write_byte_num = GetEepromSimWriteByteNum() - write_byte_num;
+
+		old_num = 0;
+		new_num = 0;
+		for (uint32_t cut=0; cut<=write_byte_num; cut++) {
+			startSavedata(TRUE);
+			memcpy(GetEepromSimMemory(), snapshot, EEPROM_SIM_SIZE);
+			startSavedata(FALSE);
+			SetEepromSimPowerCut(GetEepromSimWriteByteNum() + cut);
+			runAppend(count);
+
+			startSavedata(FALSE);
+			value = readRing();
+			if (value == count) {
+				new_num ++;
+			} else if (value == count - 1) {
+				old_num ++;
+			} else {
+				printf("    append %u, cut %u: read %u\n", count, cut, value);
+				TEST_ASSERT(FALSE);
+			}
+		}
+		TEST_ASSERT_EQUAL(write_byte_num + 1, old_num + new_num);
+		TEST_ASSERT(new_num >= 1);
+
+		/* 電源断なしの追記後の書き換え回数の推定 */
+		startSavedata(TRUE);
+		memcpy(GetEepromSimMemory(), snapshot, EEPROM_SIM_SIZE);
+		startSavedata(FALSE);
+		runAppend(count);
+		TEST_ASSERT_EQUAL((count - 1) / RING_ENTRY_NUM + 1, GetSaveRingWear(RING_ID));
+	}
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 初期化までにEEPROMの読み出しが完了しなかった起動(起動時の完了待ちのタイムアウト)
+ * 読み出し完了までは保存を受け付けず、完了後に最新のスロット、エントリを探索して続きから保存する
+ */
+static void testLateLoad(void)
+{
+	uint8_t data[SAVEDATA_SIZE_GAME] = {0};
+
+	startSavedata(TRUE);
+	runSave(SAVEDATA_ID_GAME, 1);
+	runSave(SAVEDATA_ID_GAME, 2);
+	runAppend(1);
+	runAppend(2);
+
+	/* 読み出し完了の割り込みを止めて初期化 */
+	StubInit();
+	RestartEepromSim();
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitEeprom();
+	__disable_irq();
+	InitSavedata();
+	TEST_ASSERT(IsEepromReady() == FALSE);
+	TEST_ASSERT_EQUAL(RESULT_NG, LoadSavedata(SAVEDATA_ID_GAME, data));
+	TEST_ASSERT_EQUAL(RESULT_NG, SaveSavedata(SAVEDATA_ID_GAME, data));
+	TEST_ASSERT_EQUAL(RESULT_NG, AppendSaveRing(RING_ID, data));
+	__enable_irq();
+
+	/* 読み出し完了後の周期処理で探索 */
+	TEST_ASSERT(StubRunUntil(isEepromReady, 100000) == TRUE);
+	MainSavedata();
+	TEST_ASSERT_EQUAL(RESULT_OK, LoadSavedata(SAVEDATA_ID_GAME, data));
+	TEST_ASSERT(checkData(data, SAVEDATA_SIZE_GAME, 2) == TRUE);
+	TEST_ASSERT_EQUAL(2, readRing());
+
+	/* 探索したスロット、エントリの続きへ保存し、再起動後も最新の保存が読み出せる */
+	runSave(SAVEDATA_ID_GAME, 3);
+	runAppend(3);
+	startSavedata(FALSE);
+	TEST_ASSERT_EQUAL(RESULT_OK, LoadSavedata(SAVEDATA_ID_GAME, data));
+	TEST_ASSERT(checkData(data, SAVEDATA_SIZE_GAME, 3) == TRUE);
+	TEST_ASSERT_EQUAL(3, readRing());
+	TEST_ASSERT_EQUAL(0, GetEepromSimErrorNum());
+}
+
+/*
+ * 書き込み分散記録へ値を追記して書き込み完了まで周期処理を実行
+ */
+static void runAppend(uint32_t count)
+{
+	uint8_t data[SAVERING_DATA_SIZE] = {0};
+
+	data[0] = (uint8_t)count;
+	TEST_ASSERT_EQUAL(RESULT_OK, AppendSaveRing(RING_ID, data));
+	TEST_ASSERT_EQUAL(RESULT_OK, FlushEeprom(SAVE_TIMEOUT));
+}
+
+/*
+ * 書き込み分散記録の最新の値(有効なデータなしの場合は0)
+ */
+static uint32_t readRing(void)
+{
+	uint8_t data[SAVERING_DATA_SIZE] = {0};
+	uint32_t value = 0;
+
+	if (ReadSaveRing(RING_ID, data) == RESULT_OK) {
+		value = data[0];
+	}
+
+	return value;
+}
+
+/*
+ * 保存して書き込み完了まで周期処理を実行
+ */
+static void runSave(savedata_id_t savedata_id, uint8_t seed)
+{
+	uint8_t data[SAVEDATA_SIZE_GAME];
+	uint32_t start_time = StubGetTimeUs();
+
+	for (uint32_t index=0; index<savedata_size_table[savedata_id]; index++) {
+		data[index] = (uint8_t)(seed + index * 7);
+	}
+	TEST_ASSERT_EQUAL(RESULT_OK, SaveSavedata(savedata_id, data));
+
+	while ((IsSavedataBusy(savedata_id) == TRUE) && ((StubGetTimeUs() - start_time) < SAVE_TIMEOUT)) {
+		MainSavedata();
+		MainEeprom();
+		StubAdvanceUs(MAIN_PERIOD);
+	}
+	TEST_ASSERT(IsSavedataBusy(savedata_id) == FALSE);
+}
+
+/*
+ * 読み出しデータ確認
+ */
+static bool_t checkData(const uint8_t* data, uint16_t size, uint8_t seed)
+{
+	bool_t match = TRUE;
+
+	for (uint32_t index=0; index<size; index++) {
+		if (data[index] != (uint8_t)(seed + index * 7)) {
+			match = FALSE;
+		}
+	}
+
+	return match;
+}
+
+/*
+ * 起動時の全データ読み出し完了判定
+ */
+static bool_t isEepromReady(void)
+{
+	return IsEepromReady();
+}
+
+/*
+ * 起動(EEPROMの全データ読み出しとセーブデータ初期化)
+ * erase:TRUEの場合はEEPROMを消去状態にする、FALSEの場合は内容を保持した電源再投入
+ */
+static void startSavedata(bool_t erase)
+{
+	StubInit();
+	if (erase == TRUE) {
+		InitEepromSim();
+	} else {
+		RestartEepromSim();
+	}
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitEeprom();
+	if (StubRunUntil(isEepromReady, 100000) == FALSE) {
+		printf("    eeprom load timeout\n");
+		exit(1);
+	}
+	InitSavedata();
+}
+
+int main(void)
+{
+	TEST_RUN(testSaveLoad);
+	TEST_RUN(testPowerCut);
+	TEST_RUN(testRingPowerCut);
+	TEST_RUN(testLateLoad);
+
+	return TEST_RESULT();
+}
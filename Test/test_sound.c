@@ -0,0 +1,402 @@
+/*
+ * test_sound.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  DRV SOUND のYMF825レジスタ書き込み記録と音声化の回帰テスト
+ */
+
+
+/********** Include **********/
+
+#include <stdlib.h>
+#include <math.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "drv_sound.h"
+#include "stub_hal.h"
+#include "ymf825_sim.h"
+#include "ymf825_emu.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 初期化手順の書き込み数(基本設定18、トーンデータ35、ボイス設定6×16) */
+#define INIT_REGISTER_WRITE_NUM		(18)
+#define INIT_TONE_WRITE_NUM			(35)
+#define INIT_VOICE_WRITE_NUM		(6 * 16)
+#define INIT_WRITE_NUM				(INIT_REGISTER_WRITE_NUM + INIT_TONE_WRITE_NUM + INIT_VOICE_WRITE_NUM)
+
+/* 音声化の長さ [サンプル] */
+#define RENDER_SAMPLE_NUM			(YMF825_EMU_SAMPLE_RATE * 2)
+
+/* A4(440Hz): FNUM = 440 × 2^19 / (48000 × 2^3) */
+#define KEY_BLOCK					(4)
+#define KEY_FNUM					(601)
+#define KEY_FREQUENCY				(440.2)
+
+/* ビブラート波形テーブルの要素数、振幅(drv_sound.cのVIBRATO_TABLE_SIZEと同じ値、vibrato_tableの最大値) */
+#define VIBRATO_TABLE_SIZE			(64)
+#define VIBRATO_AMPLITUDE			(127)
+/* ビブラート波形テーブルの値がそのままピッチ [1/8半音] となる深さ */
+#define VIBRATO_DEPTH_UNITY			(128)
+/* ビブラート波形テーブルの要素を1周期に1つ進める速さ */
+#define VIBRATO_RATE_STEP			(256 / VIBRATO_TABLE_SIZE)
+
+/********** Type **********/
+
+typedef struct {
+	uint8_t address;
+	uint8_t data;
+} register_write_t;
+
+/********** Constant **********/
+
+/* 電源投入からトーンデータ設定前までの期待値 */
+static const register_write_t expected_init_register[INIT_REGISTER_WRITE_NUM] = {
+	{0x1D, 0x01}, {0x02, 0x0E}, {0x00, 0x01}, {0x01, 0x00}, {0x1A, 0xA3}, {0x1A, 0x00},
+	{0x02, 0x04}, {0x02, 0x00}, {0x03, 0x01}, {0x19, 0x60}, {0x1B, 0x3F}, {0x14, 0x00},
+	{0x08, 0xF6}, {0x08, 0x00}, {0x09, 0xF9}, {0x0A, 0x00}, {0x17, 0x40}, {0x18, 0x00},
+};
+
+/* KeyOn(0, 4, 601)の期待値 */
+static const register_write_t expected_keyon[] = {
+	{0x0B, 0x00}, {0x0C, 0x54}, {0x0D, 0x24}, {0x0E, 0x59}, {0x0F, 0x40},
+};
+
+/********** Variable **********/
+
+static int16_t render_samples[RENDER_SAMPLE_NUM];
+static int16_t reference_samples[RENDER_SAMPLE_NUM];
+static ymf825_write_t reference_trace[YMF825_SIM_TRACE_SIZE];
+static uint32_t multiplier_scan_index;
+static uint16_t multiplier_written;
+
+/********** Function Prototype **********/
+
+static bool_t isSoundReady(void);
+static void startSound(void);
+static uint32_t findWrite(uint32_t start, uint8_t address, uint8_t data);
+static uint32_t toSample(uint32_t time_us);
+static uint16_t getWrittenMultiplier(void);
+static int32_t toPitch(uint16_t multiplier);
+
+/********** Function **********/
+
+/*
+ * 初期化手順の書き込み順、書き込み後の待機時間
+ */
+static void testInitTrace(void)
+{
+	const ymf825_write_t* trace;
+	uint32_t sftrst_index;
+
+	startSound();
+	trace = GetYmf825SimTrace();
+
+	TEST_ASSERT_EQUAL(INIT_WRITE_NUM, GetYmf825SimWriteNum());
+	for (uint32_t index=0; index<INIT_REGISTER_WRITE_NUM; index++) {
+		TEST_ASSERT_EQUAL(expected_init_register[index].address, trace[index].address);
+		TEST_ASSERT_EQUAL(expected_init_register[index].data, trace[index].data);
+	}
+
+	/* トーンデータはContents Data Write Portへ連続して書き込む */
+	for (uint32_t index=0; index<INIT_TONE_WRITE_NUM; index++) {
+		TEST_ASSERT_EQUAL(0x07, trace[INIT_REGISTER_WRITE_NUM + index].address);
+	}
+	TEST_ASSERT_EQUAL(0x81, trace[INIT_REGISTER_WRITE_NUM].data);
+
+	/* Synthesizer blockリセット解除後30ms以上待ってからアナログ部を有効化 */
+	sftrst_index = 5;
+	TEST_ASSERT((trace[sftrst_index + 1].time - trace[sftrst_index].time) >= 30000);
+	/* AP0有効化後1ms以上待ってからクロック有効化 */
+	TEST_ASSERT((trace[2].time - trace[1].time) >= 1000);
+
+	/* 全ボイスをミュート状態で初期化 */
+	for (uint32_t voice=0; voice<16; voice++) {
+		const ymf825_write_t* voice_write = &trace[INIT_REGISTER_WRITE_NUM + INIT_TONE_WRITE_NUM + (voice * 6)];
+		TEST_ASSERT_EQUAL(0x0B, voice_write[0].address);
+		TEST_ASSERT_EQUAL(voice, voice_write[0].data);
+		TEST_ASSERT_EQUAL(0x0F, voice_write[1].address);
+		TEST_ASSERT_EQUAL(0x30, voice_write[1].data);
+	}
+
+	TEST_ASSERT(GetBootStepTime(BOOT_STEP_SOUND_READY) != BOOT_TIME_INVALID);
+}
+
+/*
+ * アラーム割り込みの初期化手順の実行時に送信ジョブキューが満杯の場合は、空き待ちせずに手順を再実行する
+ */
+static void testInitQueueFull(void)
+{
+	const ymf825_write_t* trace;
+	uint32_t queued_num = 0;
+
+	StubInit();
+	InitYmf825Sim();
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitSound();
+
+	/* AP0有効化後の待機(1ms)の終了直前に送信ジョブキューを満杯にして、送信完了より先にアラームを発生させる */
+	StubAdvanceUs(990);
+	__disable_irq();
+	while (GetSoundQueueSpace() > 0) {
+		ChangeSoundOutputDevice(SOUND_OUTPUT_SPEAKER);
+		queued_num ++;
+	}
+	StubAdvanceUs(20);
+	__enable_irq();
+
+	TEST_ASSERT(StubRunUntil(isSoundReady, 200000) == TRUE);
+	trace = GetYmf825SimTrace();
+	TEST_ASSERT_EQUAL(INIT_WRITE_NUM + queued_num, GetYmf825SimWriteNum());
+	/* 見合わせた手順(クロック有効化)は追加した書き込みの後に送信する */
+	TEST_ASSERT_EQUAL(0x02, trace[2 + queued_num - 1].address);
+	TEST_ASSERT_EQUAL(expected_init_register[2].address, trace[2 + queued_num].address);
+	TEST_ASSERT_EQUAL(expected_init_register[2].data, trace[2 + queued_num].data);
+}
+
+/*
+ * KeyOn、KeyOffの書き込みと音声化した音程、減衰
+ */
+static void testKeyOnRender(void)
+{
+	const ymf825_write_t* trace;
+	uint32_t keyon_index;
+	uint32_t keyoff_index;
+	uint32_t keyon_sample;
+	uint32_t keyoff_sample;
+	double pitch;
+	double rms_on;
+	double rms_off;
+
+	startSound();
+	KeyOn(0, KEY_BLOCK, KEY_FNUM);
+	StubAdvanceUs(500000);
+	KeyOff(0);
+	StubAdvanceUs(1000000);
+
+	trace = GetYmf825SimTrace();
+	TEST_ASSERT_EQUAL(INIT_WRITE_NUM + 5 + 2, GetYmf825SimWriteNum());
+	for (uint32_t index=0; index<sizeof(expected_keyon)/sizeof(expected_keyon[0]); index++) {
+		TEST_ASSERT_EQUAL(expected_keyon[index].address, trace[INIT_WRITE_NUM + index].address);
+		TEST_ASSERT_EQUAL(expected_keyon[index].data, trace[INIT_WRITE_NUM + index].data);
+	}
+	keyon_index = findWrite(INIT_WRITE_NUM, 0x0F, 0x40);
+	keyoff_index = findWrite(keyon_index + 1, 0x0F, 0x00);
+	TEST_ASSERT(keyoff_index < GetYmf825SimWriteNum());
+
+	RenderYmf825Trace(trace, GetYmf825SimWriteNum(), render_samples, RENDER_SAMPLE_NUM);
+	TEST_ASSERT_EQUAL(RESULT_OK, WriteWavFile("sound_keyon.wav", render_samples, RENDER_SAMPLE_NUM));
+
+	/* 初期化中は無音 */
+	keyon_sample = toSample(trace[keyon_index].time);
+	TEST_ASSERT(GetAudioRms(render_samples, keyon_sample) == 0.0);
+
+	/* 発音中の音程 */
+	pitch = EstimatePitch(&render_samples[keyon_sample + 4800], 9600);
+	printf("    pitch %.1f Hz\n", pitch);
+	TEST_ASSERT((pitch > KEY_FREQUENCY * 0.99) && (pitch < KEY_FREQUENCY * 1.01));
+
+	/* KeyOff後はリリースで減衰する */
+	keyoff_sample = toSample(trace[keyoff_index].time);
+	rms_on = GetAudioRms(&render_samples[keyoff_sample - 4800], 4800);
+	rms_off = GetAudioRms(&render_samples[RENDER_SAMPLE_NUM - 4800], 4800);
+	printf("    rms on %.0f, off %.0f\n", rms_on, rms_off);
+	TEST_ASSERT(rms_on > 1000.0);
+	TEST_ASSERT(rms_off < rms_on * 0.1);
+}
+
+/*
+ * 書き込み時刻の揺らぎに対する類似度、音程変化の検出
+ */
+static void testRenderSimilarity(void)
+{
+	uint32_t trace_num;
+	double similarity;
+
+	startSound();
+	KeyOn(0, KEY_BLOCK, KEY_FNUM);
+	StubAdvanceUs(500000);
+	trace_num = GetYmf825SimWriteNum();
+	RenderYmf825Trace(GetYmf825SimTrace(), trace_num, render_samples, RENDER_SAMPLE_NUM / 4);
+
+	/* 1サンプル未満の送信時刻のずれは同じ音声とみなせる */
+	for (uint32_t index=0; index<trace_num; index++) {
+		reference_trace[index] = GetYmf825SimTrace()[index];
+		if (index >= INIT_WRITE_NUM) {
+			reference_trace[index].time += 15;
+		}
+	}
+	RenderYmf825Trace(reference_trace, trace_num, reference_samples, RENDER_SAMPLE_NUM / 4);
+	similarity = CompareAudio(render_samples, reference_samples, RENDER_SAMPLE_NUM / 4);
+	printf("    jitter similarity %.4f\n", similarity);
+	TEST_ASSERT(similarity > 0.99);
+
+	/* ピッチベンドで1オクターブ上げると類似度が下がり、音程が倍になる */
+	startSound();
+	KeyOn(0, KEY_BLOCK, KEY_FNUM);
+	SetPitchBend(0, SOUND_PITCH_BEND_MAX, 0);
+	MainSound();
+	StubAdvanceUs(500000);
+	TEST_ASSERT_EQUAL(trace_num + 3, GetYmf825SimWriteNum());
+	RenderYmf825Trace(GetYmf825SimTrace(), GetYmf825SimWriteNum(), reference_samples, RENDER_SAMPLE_NUM / 4);
+	similarity = CompareAudio(render_samples, reference_samples, RENDER_SAMPLE_NUM / 4);
+	printf("    pitch bend similarity %.4f\n", similarity);
+	TEST_ASSERT(similarity < 0.5);
+	TEST_ASSERT(EstimatePitch(&reference_samples[RENDER_SAMPLE_NUM / 8], 9600) > KEY_FREQUENCY * 2 * 0.99);
+}
+
+/*
+ * 初期化完了判定
+ */
+static bool_t isSoundReady(void)
+{
+	return IsSoundReady();
+}
+
+/*
+ * 書き込み済みの周波数倍率(INT 2bit + FRA 9bit)
+ * 前回からの書き込み記録のINT、FRAで更新する
+ */
+static uint16_t getWrittenMultiplier(void)
+{
+	const ymf825_write_t* trace = GetYmf825SimTrace();
+
+	for (; multiplier_scan_index<GetYmf825SimWriteNum(); multiplier_scan_index++) {
+		if (trace[multiplier_scan_index].address == 0x12) {
+			multiplier_written = (uint16_t)((multiplier_written & 0x3F) | ((trace[multiplier_scan_index].data >> 3) << 9) | ((trace[multiplier_scan_index].data & 0x07) << 6));
+		} else if (trace[multiplier_scan_index].address == 0x13) {
+			multiplier_written = (uint16_t)((multiplier_written & ~0x3F) | (trace[multiplier_scan_index].data >> 1));
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	return multiplier_written;
+}
+
+/*
+ * 周波数倍率の期待値からピッチ [1/8半音] への変換(該当なしの場合は範囲外の値)
+ */
+static int32_t toPitch(uint16_t multiplier)
+{
+	int32_t pitch;
+
+	for (pitch=-SOUND_PITCH_BEND_MAX; pitch<=SOUND_PITCH_BEND_MAX; pitch++) {
+		if (lround(512.0 * pow(2.0, (double)pitch / (12 * SOUND_PITCH_STEP))) == multiplier) {
+			break;
+		}
+	}
+
+	return pitch;
+}
+
+/*
+ * 模擬を初期化してDRV SOUNDを初期化完了まで進める
+ */
+static void startSound(void)
+{
+	StubInit();
+	InitYmf825Sim();
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitSound();
+	if (StubRunUntil(isSoundReady, 200000) == FALSE) {
+		printf("    sound init timeout\n");
+		exit(1);
+	}
+	multiplier_scan_index = 0;
+	multiplier_written = 0;
+}
+
+/*
+ * 書き込み記録の検索
+ */
+static uint32_t findWrite(uint32_t start, uint8_t address, uint8_t data)
+{
+	const ymf825_write_t* trace = GetYmf825SimTrace();
+	uint32_t index;
+
+	for (index=start; index<GetYmf825SimWriteNum(); index++) {
+		if ((trace[index].address == address) && (trace[index].data == data)) {
+			break;
+		}
+	}
+
+	return index;
+}
+
+/*
+ * 時刻からサンプル位置への変換
+ */
+static uint32_t toSample(uint32_t time_us)
+{
+	return (uint32_t)(((uint64_t)time_us * YMF825_EMU_SAMPLE_RATE) / 1000000) + 1;
+}
+
+/*
+ * ピッチベンドの周波数倍率テーブル、ビブラート波形テーブルの全要素を計算式と比較する
+ * 書き込んだINT、FRAから周波数倍率を求めて、512 × 2^(ピッチ / 96)、127 × sin(2π × i / 64)の丸め値と一致することを確認する
+ */
+static void testModulationTable(void)
+{
+	int32_t pitch;
+	int32_t expected;
+	int32_t bend_table[2] = {-31, 31};
+	uint32_t checked_num = 0;
+
+	startSound();
+	TEST_ASSERT_EQUAL(512, getWrittenMultiplier());
+	for (int32_t bend=-SOUND_PITCH_BEND_MAX; bend<=SOUND_PITCH_BEND_MAX; bend++) {
+		SetPitchBend(0, (int16_t)bend, 0);
+		MainSound();
+		StubAdvanceUs(1000);
+		TEST_ASSERT_EQUAL(lround(512.0 * pow(2.0, (double)bend / (12 * SOUND_PITCH_STEP))), getWrittenMultiplier());
+	}
+
+	/* 深さVIBRATO_DEPTH_UNITYでは波形テーブルの値がピッチに加算される
+	 * ピッチベンド範囲に収まるよう、正負それぞれに寄せたピッチベンドで半分ずつ確認する */
+	for (uint32_t pass=0; pass<2; pass++) {
+		SetVibrato(0, 0, 0);
+		SetPitchBend(0, (int16_t)bend_table[pass], 0);
+		MainSound();
+		SetVibrato(0, VIBRATO_DEPTH_UNITY, VIBRATO_RATE_STEP);
+		for (uint32_t step=1; step<=VIBRATO_TABLE_SIZE; step++) {
+			MainSound();
+			StubAdvanceUs(1000);
+			expected = lround(VIBRATO_AMPLITUDE * sin(2.0 * M_PI * (double)(step % VIBRATO_TABLE_SIZE) / VIBRATO_TABLE_SIZE));
+			if (((bend_table[pass] + expected) >= -SOUND_PITCH_BEND_MAX) && ((bend_table[pass] + expected) <= SOUND_PITCH_BEND_MAX)) {
+				pitch = toPitch(getWrittenMultiplier());
+				TEST_ASSERT_EQUAL(expected, pitch - bend_table[pass]);
+				checked_num ++;
+			}
+		}
+	}
+	/* 全要素を少なくとも1回確認 */
+	TEST_ASSERT(checked_num >= VIBRATO_TABLE_SIZE);
+	SetVibrato(0, 0, 0);
+}
+
+int main(void)
+{
+	TEST_RUN(testInitTrace);
+	TEST_RUN(testInitQueueFull);
+	TEST_RUN(testKeyOnRender);
+	TEST_RUN(testRenderSimilarity);
+	TEST_RUN(testModulationTable);
+
+	return TEST_RESULT();
+}
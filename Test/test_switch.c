@@ -0,0 +1,327 @@
+/*
+ * test_switch.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  DRV CONTROLLER のSW入力チャタリング除去のテスト
+ *  チャタリングを含む端子波形を入力し、検出遅延と誤検出(期待数を超えるイベント)を計測する
+ *  test_switch:SW_INPUT_EXTI_ENABLE=0(5ms周期ポーリング)、test_switch_exti:SW_INPUT_EXTI_ENABLE=1(EXTI割り込み)
+ */
+
+
+/********** Include **********/
+
+#include <stdlib.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "drv_eeprom.h"
+#include "drv_controller.h"
+#include "stub_hal.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 波形入力、MainController呼び出しの刻み [us] */
+#define STEP_TIME					(50)
+/* UpdateSwInputの呼び出し周期 [us](cyclic5msEvent) */
+#define SW_UPDATE_PERIOD			(5000)
+/* 1波形の計測時間 [us] */
+#define WAVE_TIME					(120000)
+
+/* 無視時間(drv_controller.cのSW_LOCKOUT_TIMEと同じ値) */
+#define SW_LOCKOUT_TIME				(10000)
+/* ポーリングで入力確定に必要な連続一致回数(drv_controller.cのSW_INPUT_BUFFER_NUMと同じ値) */
+#define SW_INPUT_BUFFER_NUM			(3)
+
+/* 押下、解放それぞれの検出遅延の上限 [us](チャタリング期間 + 方式毎の確定時間) */
+#if SW_INPUT_EXTI_ENABLE
+#define DETECT_TIME(bounce)			(STEP_TIME)
+#else
+#define DETECT_TIME(bounce)			((bounce) + (SW_UPDATE_PERIOD * SW_INPUT_BUFFER_NUM))
+#endif
+
+/********** Type **********/
+
+typedef struct {
+	uint32_t time;					/* 波形先頭からの時刻 [us] */
+	GPIO_PinState level;			/* SW_Aの端子レベル(Low:押下) */
+} wave_edge_t;
+
+typedef struct {
+	const char* name;
+	const wave_edge_t* edge;
+	uint32_t edge_num;
+	uint32_t release_index;			/* 解放開始のエッジ */
+	uint32_t push_num;				/* 期待する押下イベント数 */
+	uint32_t release_num;			/* 期待する解放イベント数 */
+	uint32_t push_latency_max;		/* 押下開始から押下イベント取得までの上限 [us] */
+	uint32_t release_latency_max;	/* 解放開始から解放イベント取得までの上限 [us] */
+} wave_info_t;
+
+typedef struct {
+	uint32_t push_num;
+	uint32_t release_num;
+	uint32_t push_time;				/* 最初の押下イベントを取得した時刻(波形先頭から) */
+	uint32_t release_time;			/* 最初の解放イベントを取得した時刻(波形先頭から) */
+} wave_result_t;
+
+/********** Constant **********/
+
+/* チャタリングなし */
+static const wave_edge_t wave_clean[] = {
+	{1200, GPIO_PIN_RESET}, {60200, GPIO_PIN_SET},
+};
+
+/* 押下、解放ともに1.5ms程度のチャタリング */
+static const wave_edge_t wave_bounce[] = {
+	{1200, GPIO_PIN_RESET}, {1350, GPIO_PIN_SET}, {1600, GPIO_PIN_RESET}, {2000, GPIO_PIN_SET}, {2700, GPIO_PIN_RESET},
+	{60200, GPIO_PIN_SET}, {60400, GPIO_PIN_RESET}, {60800, GPIO_PIN_SET}, {61700, GPIO_PIN_RESET}, {62500, GPIO_PIN_SET},
+};
+
+/* 無視時間に近い8msのチャタリング */
+static const wave_edge_t wave_long_bounce[] = {
+	{1200, GPIO_PIN_RESET}, {2200, GPIO_PIN_SET}, {3200, GPIO_PIN_RESET}, {4200, GPIO_PIN_SET}, {5200, GPIO_PIN_RESET},
+	{6200, GPIO_PIN_SET}, {7200, GPIO_PIN_RESET}, {8200, GPIO_PIN_SET}, {9200, GPIO_PIN_RESET},
+	{80200, GPIO_PIN_SET},
+};
+
+/* 無視時間内に離す短い押下(解放エッジは無視時間経過後の整合で補正される) */
+static const wave_edge_t wave_short_tap[] = {
+	{1200, GPIO_PIN_RESET}, {4200, GPIO_PIN_SET},
+};
+
+/* 1周期の間に押下、解放、押下(各エッジは検出方式によらず確定する間隔) */
+static const wave_edge_t wave_push_release_push[] = {
+	{1200, GPIO_PIN_RESET}, {26200, GPIO_PIN_SET}, {51200, GPIO_PIN_RESET},
+};
+
+/* 1周期の間に解放、押下、解放 */
+static const wave_edge_t wave_release_push_release[] = {
+	{1200, GPIO_PIN_SET}, {26200, GPIO_PIN_RESET}, {51200, GPIO_PIN_SET},
+};
+
+/* 1周期の間の押下、解放、押下の後の入力状態の遷移(最後は押したまま) */
+static const input_state_t state_push_release_push[] = {
+	INPUT_PUSH, INPUT_RELEASE, INPUT_PUSH, INPUT_ON, INPUT_ON,
+};
+
+/* 1周期の間の解放、押下、解放の後の入力状態の遷移(最後は離したまま) */
+static const input_state_t state_release_push_release[] = {
+	INPUT_RELEASE, INPUT_PUSH, INPUT_RELEASE, INPUT_OFF, INPUT_OFF,
+};
+
+static const wave_info_t wave_info_table[] = {
+	{"clean", wave_clean, 2, 1, 1, 1, DETECT_TIME(0), DETECT_TIME(0)},
+	{"bounce", wave_bounce, 10, 5, 1, 1, DETECT_TIME(1500), DETECT_TIME(2300)},
+	{"long bounce", wave_long_bounce, 10, 9, 1, 1, DETECT_TIME(8000), DETECT_TIME(0)},
+#if SW_INPUT_EXTI_ENABLE
+	{"short tap", wave_short_tap, 2, 1, 1, 1, DETECT_TIME(0), (1200 + SW_LOCKOUT_TIME + SW_UPDATE_PERIOD) - 4200},
+#else
+	/* ポーリングでは3ms間の押下は連続一致回数に届かず検出できない */
+	{"short tap", wave_short_tap, 2, 1, 0, 0, 0, 0},
+#endif
+};
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+static void runWave(const wave_info_t* info, wave_result_t* result);
+static void runEdgeWithoutFrame(const wave_edge_t* edge, uint32_t edge_num);
+static void runFrame(void);
+static bool_t isEepromReady(void);
+static void startController(void);
+
+/********** Function **********/
+
+/*
+ * チャタリング波形毎の検出遅延、誤検出
+ */
+static void testBounceWaveform(void)
+{
+	const wave_info_t* info;
+	wave_result_t result;
+	uint32_t push_latency;
+	uint32_t release_latency;
+
+	for (uint32_t index=0; index<sizeof(wave_info_table)/sizeof(wave_info_table[0]); index++) {
+		info = &wave_info_table[index];
+		startController();
+		runWave(info, &result);
+
+		push_latency = 0;
+		if (result.push_num > 0) {
+			push_latency = result.push_time - info->edge[0].time;
+		}
+		release_latency = 0;
+		if (result.release_num > 0) {
+			release_latency = result.release_time - info->edge[info->release_index].time;
+		}
+		printf("    %-12s push %u (%5u us), release %u (%5u us)\n", info->name,
+				result.push_num, push_latency, result.release_num, release_latency);
+
+		/* 誤検出なし */
+		TEST_ASSERT_EQUAL(info->push_num, result.push_num);
+		TEST_ASSERT_EQUAL(info->release_num, result.release_num);
+		TEST_ASSERT(push_latency <= info->push_latency_max);
+		TEST_ASSERT(release_latency <= info->release_latency_max);
+		TEST_ASSERT_EQUAL(INPUT_OFF, GetInputState(INPUT_ID_SW_A));
+	}
+}
+
+/*
+ * 1周期の間の複数エッジ
+ * 押下/解放の1周期のパルスは全て出力し、最終状態は最後のエッジの入力レベルに一致する
+ */
+static void testMultipleEdgesInFrame(void)
+{
+	uint32_t state_num = sizeof(state_push_release_push) / sizeof(state_push_release_push[0]);
+
+	/* 離した状態から押下、解放、押下 */
+	startController();
+	runEdgeWithoutFrame(wave_push_release_push, 3);
+	MainController();
+	TEST_ASSERT_EQUAL(3, GetInputEventNum());
+	TEST_ASSERT_EQUAL(INPUT_EVENT_PUSH, GetInputEvent(0).type);
+	TEST_ASSERT_EQUAL(INPUT_EVENT_RELEASE, GetInputEvent(1).type);
+	TEST_ASSERT_EQUAL(INPUT_EVENT_PUSH, GetInputEvent(2).type);
+	for (uint32_t index=0; index<state_num; index++) {
+		if (index > 0) {
+			runFrame();
+		}
+		TEST_ASSERT_EQUAL(state_push_release_push[index], GetInputState(INPUT_ID_SW_A));
+	}
+
+	/* 押した状態から解放、押下、解放 */
+	runEdgeWithoutFrame(wave_release_push_release, 3);
+	MainController();
+	TEST_ASSERT_EQUAL(3, GetInputEventNum());
+	for (uint32_t index=0; index<state_num; index++) {
+		if (index > 0) {
+			runFrame();
+		}
+		TEST_ASSERT_EQUAL(state_release_push_release[index], GetInputState(INPUT_ID_SW_A));
+	}
+}
+
+/*
+ * MainControllerを呼び出さずにエッジを入力
+ * SW_UPDATE_PERIOD毎にUpdateSwInputを呼び出し、最後のエッジが確定するまで進める
+ */
+static void runEdgeWithoutFrame(const wave_edge_t* edge, uint32_t edge_num)
+{
+	uint32_t edge_index = 0;
+	uint32_t end_time = edge[edge_num - 1].time + (SW_UPDATE_PERIOD * (SW_INPUT_BUFFER_NUM + 1));
+
+	for (uint32_t time=0; time<end_time; time+=STEP_TIME) {
+		while ((edge_index < edge_num) && (edge[edge_index].time <= time)) {
+			StubSetPinLevel(SW_A_GPIO_Port, SW_A_Pin, edge[edge_index].level);
+			edge_index ++;
+		}
+		if ((time % SW_UPDATE_PERIOD) == 0) {
+			UpdateSwInput();
+		}
+		StubAdvanceUs(STEP_TIME);
+	}
+}
+
+/*
+ * 端子レベルを保持したまま1周期(SW_UPDATE_PERIOD)進めてMainControllerを呼び出す
+ */
+static void runFrame(void)
+{
+	StubAdvanceUs(SW_UPDATE_PERIOD);
+	UpdateSwInput();
+	MainController();
+}
+
+/*
+ * 波形入力
+ * STEP_TIME毎に端子レベルを更新してMainControllerを呼び出し、SW_UPDATE_PERIOD毎にUpdateSwInputを呼び出す
+ */
+static void runWave(const wave_info_t* info, wave_result_t* result)
+{
+	uint32_t edge_index = 0;
+	input_event_t event;
+
+	result->push_num = 0;
+	result->release_num = 0;
+	result->push_time = 0;
+	result->release_time = 0;
+
+	for (uint32_t time=0; time<WAVE_TIME; time+=STEP_TIME) {
+		while ((edge_index < info->edge_num) && (info->edge[edge_index].time <= time)) {
+			StubSetPinLevel(SW_A_GPIO_Port, SW_A_Pin, info->edge[edge_index].level);
+			edge_index ++;
+		}
+
+		if ((time % SW_UPDATE_PERIOD) == 0) {
+			UpdateSwInput();
+		}
+
+		MainController();
+		for (uint32_t index=0; index<GetInputEventNum(); index++) {
+			event = GetInputEvent(index);
+			if (event.input_id != INPUT_ID_SW_A) {
+				/* 処理なし */
+			} else if (event.type == INPUT_EVENT_PUSH) {
+				if (result->push_num == 0) {
+					result->push_time = time;
+				}
+				result->push_num ++;
+			} else {
+				if (result->release_num == 0) {
+					result->release_time = time;
+				}
+				result->release_num ++;
+			}
+		}
+
+		StubAdvanceUs(STEP_TIME);
+	}
+}
+
+/*
+ * 起動時のEEPROM読み出し完了判定
+ */
+static bool_t isEepromReady(void)
+{
+	return IsEepromReady();
+}
+
+/*
+ * 模擬を初期化してDRV CONTROLLERを初期化する
+ */
+static void startController(void)
+{
+	StubInit();
+	InitDio();
+	InitSpi();
+	InitTimer();
+	InitBootTrace();
+	InitLatency();
+	InitEeprom();
+	if (StubRunUntil(isEepromReady, 100000) == FALSE) {
+		printf("    eeprom load timeout\n");
+		exit(1);
+	}
+	InitController();
+}
+
+int main(void)
+{
+#if SW_INPUT_EXTI_ENABLE
+	printf("  SW input: EXTI\n");
+#else
+	printf("  SW input: polling\n");
+#endif
+	TEST_RUN(testBounceWaveform);
+	TEST_RUN(testMultipleEdgesInFrame);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,220 @@
+/*
+ * test_timer.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  MCAL TIMER のアラームのテスト
+ *  模擬時刻で単発/周期アラームの通知時刻、解除、遅延実行、32bit時刻の周回を確認する
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "stub_hal.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* 通知時刻の記録数 */
+#define RECORD_NUM				(64)
+
+/* 周回直前の時刻 [us] */
+#define WRAP_START_TIME			(0xFFFFFF00)
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static uint32_t record_time[RECORD_NUM];
+static uint32_t record_num;
+static uint32_t notify_num;
+
+/********** Function Prototype **********/
+
+static void startTimer(void);
+static void callbackRecord(void);
+static void callbackNotify(void);
+
+/********** Function **********/
+
+/*
+ * 単発アラームは設定時刻に1回だけ通知する
+ */
+static void testOneShot(void)
+{
+	startTimer();
+	StubAdvanceUs(100);
+	SetTimerAlarm(ALARM_ID_TFT, 1000, callbackRecord);
+	StubAdvanceUs(999);
+	TEST_ASSERT_EQUAL(0, record_num);
+	StubAdvanceUs(5000);
+	TEST_ASSERT_EQUAL(1, record_num);
+	TEST_ASSERT_EQUAL(1100, record_time[0]);
+
+	/* 通知までの時間0は即時に通知する */
+	SetTimerAlarm(ALARM_ID_TFT, 0, callbackRecord);
+	StubAdvanceUs(1);
+	TEST_ASSERT_EQUAL(2, record_num);
+	TEST_ASSERT_EQUAL(6099, record_time[1]);
+}
+
+/*
+ * 周期アラームは初回時刻から通知周期毎に通知する(通知時刻がずれて蓄積しない)
+ */
+static void testPeriodic(void)
+{
+	startTimer();
+	SetTimerAlarmPeriodic(ALARM_ID_SOUND, 1000, 250, callbackRecord);
+	StubAdvanceUs(1000 + 250 * 20);
+	TEST_ASSERT_EQUAL(21, record_num);
+	for (uint32_t index=0; index<record_num; index++) {
+		TEST_ASSERT_EQUAL(1000 + 250 * index, record_time[index]);
+	}
+
+	/* 複数のアラームは互いの通知時刻に影響しない */
+	startTimer();
+	SetTimerAlarmPeriodic(ALARM_ID_SOUND, 300, 300, callbackRecord);
+	SetTimerAlarmPeriodic(ALARM_ID_TFT, 200, 200, callbackRecord);
+	StubAdvanceUs(1200);
+	TEST_ASSERT_EQUAL(10, record_num);
+	TEST_ASSERT_EQUAL(200, record_time[0]);
+	TEST_ASSERT_EQUAL(300, record_time[1]);
+	TEST_ASSERT_EQUAL(400, record_time[2]);
+	TEST_ASSERT_EQUAL(600, record_time[3]);
+	TEST_ASSERT_EQUAL(600, record_time[4]);
+}
+
+/*
+ * 割り込み禁止で過ぎた周期は1回にまとめて通知し、以降は通知時刻から周期毎に通知する
+ */
+static void testPeriodicOverdue(void)
+{
+	startTimer();
+	SetTimerAlarmPeriodic(ALARM_ID_SOUND, 100, 100, callbackRecord);
+	__disable_irq();
+	StubAdvanceUs(350);
+	TEST_ASSERT_EQUAL(0, record_num);
+	__enable_irq();
+	TEST_ASSERT_EQUAL(1, record_num);
+	StubAdvanceUs(200);
+	TEST_ASSERT_EQUAL(3, record_num);
+	TEST_ASSERT_EQUAL(350, record_time[0]);
+	TEST_ASSERT_EQUAL(450, record_time[1]);
+	TEST_ASSERT_EQUAL(550, record_time[2]);
+}
+
+/*
+ * 解除したアラームは通知しない、再設定は前回の設定を上書きする
+ */
+static void testCancel(void)
+{
+	startTimer();
+	SetTimerAlarmPeriodic(ALARM_ID_SOUND, 100, 100, callbackRecord);
+	StubAdvanceUs(250);
+	TEST_ASSERT_EQUAL(2, record_num);
+	CancelTimerAlarm(ALARM_ID_SOUND);
+	StubAdvanceUs(1000);
+	TEST_ASSERT_EQUAL(2, record_num);
+
+	SetTimerAlarm(ALARM_ID_TFT, 100, callbackRecord);
+	SetTimerAlarm(ALARM_ID_TFT, 500, callbackRecord);
+	StubAdvanceUs(1000);
+	TEST_ASSERT_EQUAL(3, record_num);
+	TEST_ASSERT_EQUAL(1750, record_time[2]);
+}
+
+/*
+ * 遅延実行のアラームは割り込み処理内で通知のみ行い、MainTimerAlarmで1回にまとめて実行する
+ * (ALARM_ID_EEPROMを遅延実行としてビルドしたMCAL TIMERで確認する、Makefile参照)
+ */
+static void testDeferred(void)
+{
+	startTimer();
+	SetTimerAlarmPeriodic(ALARM_ID_EEPROM, 100, 100, callbackRecord);
+	StubAdvanceUs(350);
+	TEST_ASSERT_EQUAL(3, notify_num);
+	TEST_ASSERT_EQUAL(0, record_num);
+
+	MainTimerAlarm();
+	TEST_ASSERT_EQUAL(1, record_num);
+	TEST_ASSERT_EQUAL(350, record_time[0]);
+	MainTimerAlarm();
+	TEST_ASSERT_EQUAL(1, record_num);
+
+	/* 通知済みで実行前に解除した場合は実行しない */
+	StubAdvanceUs(100);
+	TEST_ASSERT_EQUAL(4, notify_num);
+	CancelTimerAlarm(ALARM_ID_EEPROM);
+	MainTimerAlarm();
+	TEST_ASSERT_EQUAL(1, record_num);
+	StubAdvanceUs(1000);
+	TEST_ASSERT_EQUAL(4, notify_num);
+}
+
+/*
+ * 時刻の周回(0xFFFFFFFF→0)をまたぐアラームは周回後の時刻に通知する
+ */
+static void testWrap(void)
+{
+	startTimer();
+	SetTimerCounter(TIMER_CH4, WRAP_START_TIME);
+	SetTimerAlarm(ALARM_ID_TFT, 0x200, callbackRecord);
+	SetTimerAlarmPeriodic(ALARM_ID_SOUND, 0x80, 0x80, callbackRecord);
+	StubAdvanceUs(0x1FF);
+	TEST_ASSERT_EQUAL(3, record_num);
+	TEST_ASSERT_EQUAL(WRAP_START_TIME + 0x80, record_time[0]);
+	TEST_ASSERT_EQUAL(0x00000000, record_time[1]);
+	TEST_ASSERT_EQUAL(0x00000080, record_time[2]);
+	StubAdvanceUs(1);
+	TEST_ASSERT_EQUAL(5, record_num);
+	TEST_ASSERT_EQUAL(0x00000100, record_time[3]);
+	TEST_ASSERT_EQUAL(0x00000100, record_time[4]);
+}
+
+/*
+ * 模擬とMCAL TIMERを初期化して記録を消去
+ */
+static void startTimer(void)
+{
+	StubInit();
+	InitTimer();
+	SetTimerAlarmDeferredNotify(callbackNotify);
+	record_num = 0;
+	notify_num = 0;
+}
+
+/*
+ * 通知時刻の記録
+ */
+static void callbackRecord(void)
+{
+	if (record_num < RECORD_NUM) {
+		record_time[record_num] = StubGetTimeUs();
+		record_num ++;
+	}
+}
+
+/*
+ * 遅延実行の通知回数の記録
+ */
+static void callbackNotify(void)
+{
+	notify_num ++;
+}
+
+int main(void)
+{
+	TEST_RUN(testOneShot);
+	TEST_RUN(testPeriodic);
+	TEST_RUN(testPeriodicOverdue);
+	TEST_RUN(testCancel);
+	TEST_RUN(testDeferred);
+	TEST_RUN(testWrap);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,426 @@
+/*
+ * test_touch.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  DRV TOUCH の座標予測のテスト
+ *  記録した指の軌跡をGT911の模擬から読み出させ、表示時刻の指の位置に対する予測座標の誤差を計測する
+ */
+
+
+/********** Include **********/
+
+#include <math.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_i2c.h"
+#include "mcal_timer.h"
+#include "drv_tft.h"
+#include "drv_touch.h"
+#include "stub_hal.h"
+#include "test_util.h"
+
+/********** Define **********/
+
+/* GT911 */
+#define GT911_I2C_DEVICE_ADDRESS	(0x5D)
+#define GT911_REGISTER_BASE			(0x8140)
+#define GT911_REGISTER_SIZE			(0x40)
+#define GT911_STATUS_REGISTER		(0x814E)
+
+/* フレーム周期 [us](60FPS) */
+#define FRAME_PERIOD				(16667)
+/* 周期処理から表示までの時間 [us](次の垂直同期で表示) */
+#define DISPLAY_DELAY				(FRAME_PERIOD)
+/* 接触開始直後に誤差の計測から除くフレーム数(速度推定の収束待ち) */
+#define WARMUP_FRAME_NUM			(3)
+/* GT911の走査周期 [us](0:読み出し時刻の位置を返す) */
+#define GT911_SCAN_PERIOD			(8000)
+/* 円軌跡の点数 */
+#define CIRCLE_POINT_NUM			(25)
+
+/********** Type **********/
+
+/* 記録した指の軌跡(同じtrack idの連続した点が1回の接触、点の間は直線補間) */
+typedef struct {
+	uint32_t time;			/* 軌跡先頭からの時刻 [ms] */
+	uint8_t track_id;
+	float x;
+	float y;
+} trace_point_t;
+
+typedef struct {
+	const char* name;
+	const trace_point_t* point;
+	uint32_t point_num;
+} trace_t;
+
+/* 予測誤差 [px] */
+typedef struct {
+	uint32_t sample_num;
+	float raw_mean;				/* 予測なし(最後に読み出した座標) */
+	float predicted_mean;		/* 予測座標 */
+} trace_error_t;
+
+/********** Constant **********/
+
+/* 一定速度のドラッグ(約0.67px/ms) */
+static const trace_point_t trace_drag[] = {
+	{0, 1, 20.0f, 160.0f}, {300, 1, 220.0f, 160.0f},
+};
+
+/* 加速して払うフリック */
+static const trace_point_t trace_flick[] = {
+	{0, 2, 120.0f, 300.0f}, {100, 2, 120.0f, 285.0f}, {200, 2, 120.0f, 230.0f}, {300, 2, 120.0f, 130.0f}, {360, 2, 120.0f, 40.0f},
+};
+
+/* 速く動かした後に離し、別の指で止まったまま触れる */
+static const trace_point_t trace_new_track[] = {
+	{0, 3, 20.0f, 100.0f}, {200, 3, 220.0f, 100.0f},
+	{300, 4, 60.0f, 250.0f}, {500, 4, 60.0f, 250.0f},
+};
+
+/********** Variable **********/
+
+/* 円軌跡(実行時に作成) */
+static trace_point_t trace_circle[CIRCLE_POINT_NUM];
+
+/* GT911の模擬 */
+static uint8_t gt911_register[GT911_REGISTER_SIZE];
+static uint16_t gt911_pointer;
+static const trace_t* gt911_trace;
+static uint32_t gt911_trace_start;
+static uint32_t gt911_scan_period;
+static uint32_t gt911_scan_time_last;
+static uint32_t gt911_clear_count;
+
+/********** Function Prototype **********/
+
+static void runTrace(const trace_t* trace, uint32_t smoothing, bool_t read_frame, trace_error_t* error);
+static bool_t getTracePoint(const trace_t* trace, uint32_t time, uint8_t* track_id, point_t* point);
+static bool_t findContact(touch_contact_t* contact);
+static float getDistance(point_t a, point_t b);
+static bool_t writeGt911(uint16_t device_address, const uint8_t* data, uint16_t length);
+static bool_t readGt911(uint16_t device_address, uint8_t* data, uint16_t length);
+static void scanGt911(void);
+static bool_t isClearStarted(void);
+static void startTouch(const trace_t* trace, uint32_t scan_period);
+
+/********** Function **********/
+
+/*
+ * 記録した軌跡毎の予測誤差(予測なしより小さいこと)
+ */
+static void testPredictionError(void)
+{
+	const trace_t trace_table[] = {
+		{"drag", trace_drag, sizeof(trace_drag) / sizeof(trace_drag[0])},
+		{"flick", trace_flick, sizeof(trace_flick) / sizeof(trace_flick[0])},
+		{"circle", trace_circle, CIRCLE_POINT_NUM},
+	};
+	trace_error_t error;
+
+	/* 半径80px、600msで1周 */
+	for (uint32_t index=0; index<CIRCLE_POINT_NUM; index++) {
+		trace_circle[index].time = index * 25;
+		trace_circle[index].track_id = 5;
+		trace_circle[index].x = 120.0f + 80.0f * cosf(index * 2.0f * 3.14159265f / (CIRCLE_POINT_NUM - 1));
+		trace_circle[index].y = 160.0f + 80.0f * sinf(index * 2.0f * 3.14159265f / (CIRCLE_POINT_NUM - 1));
+	}
+
+	for (uint32_t index=0; index<sizeof(trace_table)/sizeof(trace_table[0]); index++) {
+		startTouch(&trace_table[index], GT911_SCAN_PERIOD);
+		runTrace(&trace_table[index], 128, FALSE, &error);
+		printf("    %-8s raw %5.1f px, predicted %5.1f px (%u frames)\n", trace_table[index].name,
+				error.raw_mean, error.predicted_mean, error.sample_num);
+		TEST_ASSERT(error.sample_num >= 10);
+		TEST_ASSERT(error.predicted_mean < error.raw_mean * 0.6f);
+	}
+}
+
+/*
+ * 座標読み出しの途中(Buffer status読み出し後、クリア前)に周期処理が来ても速度推定が崩れない
+ */
+static void testReadFrame(void)
+{
+	const trace_t trace = {"drag", trace_drag, sizeof(trace_drag) / sizeof(trace_drag[0])};
+	trace_error_t error;
+
+	/* 走査周期0、平滑化なしでは一定速度のドラッグをほぼ誤差なく予測できる */
+	startTouch(&trace, 0);
+	runTrace(&trace, 256, TRUE, &error);
+	printf("    raw %5.1f px, predicted %5.1f px (%u frames)\n", error.raw_mean, error.predicted_mean, error.sample_num);
+	TEST_ASSERT(error.sample_num >= 10);
+	TEST_ASSERT(error.predicted_mean < 2.0f);
+}
+
+/*
+ * 新しいtrack idの接触は速度0から予測を開始する
+ */
+static void testNewTrack(void)
+{
+	const trace_t trace = {"new track", trace_new_track, sizeof(trace_new_track) / sizeof(trace_new_track[0])};
+	touch_contact_t contact;
+	uint32_t start_frame_num = 0;
+	uint32_t offset_frame_num = 0;
+
+	startTouch(&trace, GT911_SCAN_PERIOD);
+	SetTouchPrediction(DISPLAY_DELAY, 128);
+	while (StubGetTimeUs() < gt911_trace_start + 600000) {
+		StubAdvanceUs(FRAME_PERIOD);
+		MainTouch();
+		if ((findContact(&contact) == TRUE) && (contact.start_point.x == 60.0f)) {
+			if (contact.state == TOUCH_CONTACT_START) {
+				start_frame_num ++;
+			}
+			if (getDistance(contact.predicted_point, contact.point) >= 1.0f) {
+				offset_frame_num ++;
+			}
+		}
+	}
+
+	TEST_ASSERT_EQUAL(1, start_frame_num);
+	TEST_ASSERT_EQUAL(0, offset_frame_num);
+}
+
+/*
+ * 軌跡の再生
+ * フレーム毎にMainTouchを呼び出し、表示時刻の指の位置と読み出し座標、予測座標の距離を集計する
+ * read_frame:TRUEの場合、各フレームの座標読み出し途中にもMainTouchを呼び出す
+ */
+static void runTrace(const trace_t* trace, uint32_t smoothing, bool_t read_frame, trace_error_t* error)
+{
+	touch_contact_t contact;
+	point_t finger;
+	uint8_t track_id;
+	uint32_t contact_frame_num = 0;
+	uint32_t end_time = trace->point[trace->point_num - 1].time * 1000;
+	float raw_sum = 0.0f;
+	float predicted_sum = 0.0f;
+
+	SetTouchPrediction(DISPLAY_DELAY, smoothing);
+	error->sample_num = 0;
+
+	while (StubGetTimeUs() < gt911_trace_start + end_time + 100000) {
+		StubAdvanceUs(FRAME_PERIOD);
+		MainTouch();
+
+		if (findContact(&contact) == TRUE) {
+			contact_frame_num ++;
+			if ((contact_frame_num > WARMUP_FRAME_NUM)
+			 && (getTracePoint(trace, StubGetTimeUs() + DISPLAY_DELAY, &track_id, &finger) == TRUE)) {
+				raw_sum += getDistance(contact.point, finger);
+				predicted_sum += getDistance(contact.predicted_point, finger);
+				error->sample_num ++;
+			}
+		}
+
+		if (read_frame == TRUE) {
+			/* Buffer statusの読み出し完了後、クリア完了前に周期処理を実行 */
+			gt911_clear_count = 0;
+			if (StubRunUntil(isClearStarted, FRAME_PERIOD / 2) == TRUE) {
+				MainTouch();
+			}
+		}
+	}
+
+	error->raw_mean = 0.0f;
+	error->predicted_mean = 0.0f;
+	if (error->sample_num > 0) {
+		error->raw_mean = raw_sum / error->sample_num;
+		error->predicted_mean = predicted_sum / error->sample_num;
+	}
+}
+
+/*
+ * 軌跡の時刻の指の位置
+ * 戻り値 TRUE:接触中
+ */
+static bool_t getTracePoint(const trace_t* trace, uint32_t time, uint8_t* track_id, point_t* point)
+{
+	const trace_point_t* a;
+	const trace_point_t* b;
+	float ratio;
+	float time_ms;
+	bool_t contact = FALSE;
+
+	time_ms = (float)(time - gt911_trace_start) / 1000.0f;
+	if (time < gt911_trace_start) {
+		time_ms = -1.0f;
+	}
+
+	for (uint32_t index=0; index+1<trace->point_num; index++) {
+		a = &trace->point[index];
+		b = &trace->point[index + 1];
+		if ((a->track_id == b->track_id) && (time_ms >= a->time) && (time_ms < b->time)) {
+			ratio = (time_ms - a->time) / (float)(b->time - a->time);
+			point->x = a->x + (b->x - a->x) * ratio;
+			point->y = a->y + (b->y - a->y) * ratio;
+			*track_id = a->track_id;
+			contact = TRUE;
+			break;
+		}
+	}
+
+	return contact;
+}
+
+/*
+ * 接触中の接触を検索
+ */
+static bool_t findContact(touch_contact_t* contact)
+{
+	bool_t found = FALSE;
+
+	for (uint32_t index=0; index<TOUCH_CONTACT_NUM; index++) {
+		*contact = GetTouchContact(index);
+		if ((contact->state == TOUCH_CONTACT_START)
+		 || (contact->state == TOUCH_CONTACT_MOVE)
+		 || (contact->state == TOUCH_CONTACT_STAY)) {
+			found = TRUE;
+			break;
+		}
+	}
+
+	return found;
+}
+
+/*
+ * 2点間の距離
+ */
+static float getDistance(point_t a, point_t b)
+{
+	return sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+}
+
+/*
+ * GT911模擬: 書き込み(先頭2byteはレジスタアドレス、Buffer statusへの書き込みはクリア)
+ */
+static bool_t writeGt911(uint16_t device_address, const uint8_t* data, uint16_t length)
+{
+	bool_t ack = FALSE;
+
+	if ((device_address == GT911_I2C_DEVICE_ADDRESS) && (length >= 2)) {
+		ack = TRUE;
+		gt911_pointer = ((uint16_t)data[0] << 8) | data[1];
+		if ((length == 3) && (gt911_pointer == GT911_STATUS_REGISTER)) {
+			gt911_register[GT911_STATUS_REGISTER - GT911_REGISTER_BASE] = data[2];
+			gt911_clear_count ++;
+		}
+	}
+
+	return ack;
+}
+
+/*
+ * GT911模擬: 読み出し(Buffer statusの読み出し時に最新の走査結果を反映)
+ */
+static bool_t readGt911(uint16_t device_address, uint8_t* data, uint16_t length)
+{
+	bool_t ack = FALSE;
+	uint32_t offset;
+
+	if ((device_address == GT911_I2C_DEVICE_ADDRESS)
+	 && (gt911_pointer >= GT911_REGISTER_BASE)
+	 && (gt911_pointer + length <= GT911_REGISTER_BASE + GT911_REGISTER_SIZE)) {
+		ack = TRUE;
+		if (gt911_pointer == GT911_STATUS_REGISTER) {
+			scanGt911();
+		}
+		offset = gt911_pointer - GT911_REGISTER_BASE;
+		for (uint32_t index=0; index<length; index++) {
+			data[index] = gt911_register[offset + index];
+		}
+	}
+
+	return ack;
+}
+
+/*
+ * GT911模擬: 前回の報告以降に走査していれば、走査時刻の指の位置を座標レジスタに設定
+ */
+static void scanGt911(void)
+{
+	uint8_t* status = &gt911_register[GT911_STATUS_REGISTER - GT911_REGISTER_BASE];
+	uint32_t now = StubGetTimeUs();
+	uint32_t scan_time = now;
+	uint8_t track_id;
+	point_t point;
+
+	if (gt911_scan_period > 0) {
+		scan_time = now - (now % gt911_scan_period);
+	}
+
+	if ((gt911_trace != NULL) && (scan_time != gt911_scan_time_last)) {
+		gt911_scan_time_last = scan_time;
+		if (getTracePoint(gt911_trace, scan_time, &track_id, &point) == TRUE) {
+			status[0] = 0x81;
+			status[1] = track_id;
+			status[2] = (uint8_t)((uint16_t)lroundf(point.x) & 0xFF);
+			status[3] = (uint8_t)((uint16_t)lroundf(point.x) >> 8);
+			status[4] = (uint8_t)((uint16_t)lroundf(point.y) & 0xFF);
+			status[5] = (uint8_t)((uint16_t)lroundf(point.y) >> 8);
+			status[6] = 20;
+			status[7] = 0;
+		} else {
+			status[0] = 0x80;
+		}
+	}
+}
+
+/*
+ * Buffer statusのクリア開始判定
+ */
+static bool_t isClearStarted(void)
+{
+	bool_t started = FALSE;
+
+	if (gt911_clear_count > 0) {
+		started = TRUE;
+	}
+
+	return started;
+}
+
+/*
+ * 模擬を初期化してDRV TOUCHを初期化する(軌跡は初期化の50ms後に開始)
+ */
+static void startTouch(const trace_t* trace, uint32_t scan_period)
+{
+	static const stub_i2c_device_t gt911 = {writeGt911, readGt911, 0};
+
+	StubInit();
+	for (uint32_t index=0; index<GT911_REGISTER_SIZE; index++) {
+		gt911_register[index] = 0;
+	}
+	/* 0x8140: Product ID "911"、0x8146: X/Y解像度 */
+	gt911_register[0] = '9';
+	gt911_register[1] = '1';
+	gt911_register[2] = '1';
+	gt911_register[6] = (uint8_t)(TFT_WIDTH & 0xFF);
+	gt911_register[7] = (uint8_t)(TFT_WIDTH >> 8);
+	gt911_register[8] = (uint8_t)(TFT_HEIGHT & 0xFF);
+	gt911_register[9] = (uint8_t)(TFT_HEIGHT >> 8);
+	gt911_pointer = 0;
+	gt911_trace = trace;
+	gt911_trace_start = 50000;
+	gt911_scan_period = scan_period;
+	gt911_scan_time_last = 0xFFFFFFFF;
+	gt911_clear_count = 0;
+	StubSetI2cDevice(&gt911);
+
+	InitDio();
+	InitI2c();
+	InitTimer();
+	InitTouch();
+}
+
+int main(void)
+{
+	TEST_RUN(testPredictionError);
+	TEST_RUN(testReadFrame);
+	TEST_RUN(testNewTrack);
+
+	return TEST_RESULT();
+}
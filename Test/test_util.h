@@ -0,0 +1,51 @@
+/*
+ * test_util.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  ホストテスト用の判定マクロ
+ */
+
+
+#ifndef TEST_UTIL_H_
+#define TEST_UTIL_H_
+
+/********** Include **********/
+
+#include <stdio.h>
+
+/********** Define **********/
+
+/* 条件判定(失敗しても以降の判定を続ける) */
+#define TEST_ASSERT(condition)	do { \
+		if (!(condition)) { \
+			printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #condition); \
+			test_fail_count ++; \
+		} \
+	} while (0)
+
+/* 整数の一致判定(不一致時に値を表示) */
+#define TEST_ASSERT_EQUAL(expected, actual)	do { \
+		long long test_expected = (long long)(expected); \
+		long long test_actual = (long long)(actual); \
+		if (test_expected != test_actual) { \
+			printf("%s:%d: FAIL: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #expected, #actual, test_expected, test_actual); \
+			test_fail_count ++; \
+		} \
+	} while (0)
+
+/* テスト関数実行 */
+#define TEST_RUN(test)	do { \
+		printf("  %s\n", #test); \
+		test(); \
+	} while (0)
+
+/* 終了コード(0:全て成功) */
+#define TEST_RESULT()	(printf("  %s\n", (test_fail_count == 0) ? "OK" : "FAILED"), (test_fail_count == 0) ? 0 : 1)
+
+/********** Variable **********/
+
+static int test_fail_count;
+
+#endif /* TEST_UTIL_H_ */
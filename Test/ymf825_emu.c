@@ -0,0 +1,632 @@
+/*
+ * ymf825_emu.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  YMF825の簡易モデル
+ *  - 正弦波オペレータ4個、アルゴリズム0～7、フィードバック、MULTI、TLを模擬する
+ *  - エンベロープはdB単位の直線変化で近似し、DT、KSL、KSR、LFO、波形選択(WS)は模擬しない
+ *  実機と同じ波形にはならないため、同じモデルでの回帰比較に使用すること
+ */
+
+
+/********** Include **********/
+
+#include <stdio.h>
+#include <math.h>
+#include "typedef.h"
+#include "ymf825_emu.h"
+
+/********** Define **********/
+
+#define YMF825_EMU_VOICE_NUM		(16)
+#define YMF825_EMU_TONE_NUM			(16)
+#define YMF825_EMU_OPERATOR_NUM		(4)
+
+/* トーンデータ(1音色あたり) */
+#define TONE_SIZE					(30)
+#define TONE_OPERATOR_OFFSET		(2)
+#define TONE_OPERATOR_SIZE			(7)
+/* トーンデータ書き込み後のフッター */
+#define TONE_FOOTER_SIZE			(4)
+
+/* エンベロープの無音レベル [dB] */
+#define ENVELOPE_SILENT_DB			(96.0)
+
+#define REG_CONTENTS				(0x07)
+#define REG_CRGD_VNO				(0x0B)
+#define REG_VOVOL					(0x0C)
+#define REG_BLOCK					(0x0D)
+#define REG_FNUM					(0x0E)
+#define REG_KEYON					(0x0F)
+#define REG_CHVOL					(0x10)
+#define REG_INT						(0x12)
+#define REG_FRA						(0x13)
+#define REG_MASTER_VOL				(0x19)
+
+/********** Enum **********/
+
+typedef enum {
+	ENVELOPE_OFF = 0,
+	ENVELOPE_ATTACK,
+	ENVELOPE_DECAY,
+	ENVELOPE_SUSTAIN,
+	ENVELOPE_RELEASE
+} envelope_stage_t;
+
+typedef enum {
+	CONTENTS_HEADER = 0,	/* 音色数待ち */
+	CONTENTS_TONE,			/* トーンデータ受信中 */
+	CONTENTS_FOOTER			/* フッター受信中 */
+} contents_state_t;
+
+/********** Type **********/
+
+typedef struct {
+	double phase;				/* 位相 [周期] */
+	double envelope_db;			/* エンベロープ減衰量 [dB] */
+	envelope_stage_t stage;
+	double feedback[2];			/* 直近2サンプルの出力(フィードバック用) */
+} operator_state_t;
+
+typedef struct {
+	bool_t key;
+	uint8_t tone;
+	uint8_t block;
+	uint16_t fnum;
+	uint16_t multiplier;		/* INT 2bit + FRA 9bit (512 = 1.0倍) */
+	uint8_t chvol;
+	uint8_t vovol;
+	operator_state_t op[YMF825_EMU_OPERATOR_NUM];
+} voice_state_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static uint8_t tone_memory[YMF825_EMU_TONE_NUM][TONE_SIZE];
+static voice_state_t voice_state[YMF825_EMU_VOICE_NUM];
+static uint8_t selected_voice;
+static uint8_t master_volume;
+
+static contents_state_t contents_state;
+static uint32_t contents_tone_num;
+static uint32_t contents_index;
+
+/********** Function Prototype **********/
+
+static void writeContents(uint8_t data);
+static void writeKeyOn(voice_state_t* voice, uint8_t data);
+static double rateTime(uint8_t rate);
+static void updateEnvelope(operator_state_t* op, const uint8_t* param);
+static double renderOperator(operator_state_t* op, const uint8_t* param, double frequency, double modulation);
+static double renderVoice(voice_state_t* voice);
+
+/********** Function **********/
+
+/*
+ * Function: 模擬初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 全ボイス停止、トーンデータ消去
+ */
+void InitYmf825Emu(void)
+{
+	for (uint32_t tone=0; tone<YMF825_EMU_TONE_NUM; tone++) {
+		for (uint32_t index=0; index<TONE_SIZE; index++) {
+			tone_memory[tone][index] = 0;
+		}
+	}
+	for (uint32_t voice=0; voice<YMF825_EMU_VOICE_NUM; voice++) {
+		voice_state[voice].key = FALSE;
+		voice_state[voice].tone = 0;
+		voice_state[voice].block = 0;
+		voice_state[voice].fnum = 0;
+		voice_state[voice].multiplier = 512;
+		voice_state[voice].chvol = 0;
+		voice_state[voice].vovol = 0;
+		for (uint32_t op=0; op<YMF825_EMU_OPERATOR_NUM; op++) {
+			voice_state[voice].op[op].phase = 0.0;
+			voice_state[voice].op[op].envelope_db = ENVELOPE_SILENT_DB;
+			voice_state[voice].op[op].stage = ENVELOPE_OFF;
+			voice_state[voice].op[op].feedback[0] = 0.0;
+			voice_state[voice].op[op].feedback[1] = 0.0;
+		}
+	}
+	selected_voice = 0;
+	master_volume = 0;
+	contents_state = CONTENTS_HEADER;
+	contents_tone_num = 0;
+	contents_index = 0;
+}
+
+/*
+ * Function: レジスタ書き込み
+ * Argument: レジスタアドレス、書き込みデータ
+ * Return  : なし
+ * Note    : 音源に影響しないレジスタは無視する
+ */
+void WriteYmf825Emu(uint8_t address, uint8_t data)
+{
+	voice_state_t* voice = &voice_state[selected_voice];
+
+	switch (address) {
+	case REG_CONTENTS:
+		writeContents(data);
+		break;
+	case REG_CRGD_VNO:
+		selected_voice = data & 0x0F;
+		break;
+	case REG_VOVOL:
+		voice->vovol = (data >> 2) & 0x1F;
+		break;
+	case REG_BLOCK:
+		voice->block = data & 0x07;
+		voice->fnum = (voice->fnum & 0x007F) | ((uint16_t)((data >> 3) & 0x07) << 7);
+		break;
+	case REG_FNUM:
+		voice->fnum = (voice->fnum & 0x0380) | (data & 0x7F);
+		break;
+	case REG_KEYON:
+		writeKeyOn(voice, data);
+		break;
+	case REG_CHVOL:
+		voice->chvol = (data >> 2) & 0x1F;
+		break;
+	case REG_INT:
+		voice->multiplier = (voice->multiplier & 0x003F) | ((uint16_t)((data >> 3) & 0x03) << 9) | ((uint16_t)(data & 0x07) << 6);
+		break;
+	case REG_FRA:
+		voice->multiplier = (voice->multiplier & 0x07C0) | ((data >> 1) & 0x3F);
+		break;
+	case REG_MASTER_VOL:
+		master_volume = (data >> 2) & 0x3F;
+		break;
+	default:
+		/* 処理なし */
+		break;
+	}
+}
+
+/*
+ * Function: 音声生成
+ * Argument: 出力先、サンプル数
+ * Return  : なし
+ * Note    : 現在のレジスタ状態のまま指定サンプル数を生成する
+ */
+void RenderYmf825Emu(int16_t* samples, uint32_t sample_num)
+{
+	double mix;
+
+	for (uint32_t index=0; index<sample_num; index++) {
+		mix = 0.0;
+		for (uint32_t voice=0; voice<YMF825_EMU_VOICE_NUM; voice++) {
+			mix += renderVoice(&voice_state[voice]);
+		}
+		mix *= (double)master_volume / 63.0;
+
+		mix *= 16384.0;
+		if (mix > 32767.0) {
+			mix = 32767.0;
+		} else if (mix < -32768.0) {
+			mix = -32768.0;
+		} else {
+			/* 処理なし */
+		}
+		samples[index] = (int16_t)lrint(mix);
+	}
+}
+
+/*
+ * Function: 書き込み記録の音声化
+ * Argument: 書き込み記録、記録数、出力先、サンプル数
+ * Return  : なし
+ * Note    : 模擬を初期化し、時刻0から各書き込みをその時刻のサンプルで反映しながら生成する
+ */
+void RenderYmf825Trace(const ymf825_write_t* trace, uint32_t trace_num, int16_t* samples, uint32_t sample_num)
+{
+	uint32_t trace_index = 0;
+	uint64_t sample_time;
+
+	InitYmf825Emu();
+
+	for (uint32_t index=0; index<sample_num; index++) {
+		sample_time = ((uint64_t)index * 1000000) / YMF825_EMU_SAMPLE_RATE;
+		while ((trace_index < trace_num) && (trace[trace_index].time <= sample_time)) {
+			WriteYmf825Emu(trace[trace_index].address, trace[trace_index].data);
+			trace_index ++;
+		}
+		RenderYmf825Emu(&samples[index], 1);
+	}
+}
+
+/*
+ * Function: WAVファイル出力
+ * Argument: ファイルパス、音声データ、サンプル数
+ * Return  : RESULT_OK:成功、RESULT_NG:ファイル書き込み失敗
+ * Note    : 16bitモノラルPCM
+ */
+result_t WriteWavFile(const char* path, const int16_t* samples, uint32_t sample_num)
+{
+	FILE* file;
+	uint8_t header[44];
+	uint32_t data_size = sample_num * 2;
+	const uint32_t field[][2] = {
+		/* オフセット、値(リトルエンディアン4byte) */
+		{4, 36 + data_size},
+		{16, 16},								/* fmtチャンクサイズ */
+		{24, YMF825_EMU_SAMPLE_RATE},			/* サンプリング周波数 */
+		{28, YMF825_EMU_SAMPLE_RATE * 2},		/* バイトレート */
+		{40, data_size},
+	};
+	result_t result = RESULT_NG;
+
+	for (uint32_t index=0; index<sizeof(header); index++) {
+		header[index] = 0;
+	}
+	header[0] = 'R'; header[1] = 'I'; header[2] = 'F'; header[3] = 'F';
+	header[8] = 'W'; header[9] = 'A'; header[10] = 'V'; header[11] = 'E';
+	header[12] = 'f'; header[13] = 'm'; header[14] = 't'; header[15] = ' ';
+	header[20] = 1;		/* PCM */
+	header[22] = 1;		/* モノラル */
+	header[32] = 2;		/* ブロックサイズ */
+	header[34] = 16;	/* ビット数 */
+	header[36] = 'd'; header[37] = 'a'; header[38] = 't'; header[39] = 'a';
+	for (uint32_t index=0; index<sizeof(field)/sizeof(field[0]); index++) {
+		for (uint32_t byte=0; byte<4; byte++) {
+			header[field[index][0] + byte] = (uint8_t)(field[index][1] >> (byte * 8));
+		}
+	}
+
+	file = fopen(path, "wb");
+	if (file != NULL) {
+		if ((fwrite(header, 1, sizeof(header), file) == sizeof(header))
+		 && (fwrite(samples, 2, sample_num, file) == sample_num)) {
+			result = RESULT_OK;
+		}
+		fclose(file);
+	}
+
+	return result;
+}
+
+/*
+ * Function: 音声類似度算出
+ * Argument: 音声データA、音声データB、サンプル数
+ * Return  : 正規化相互相関(1.0:一致、両方無音の場合も1.0)
+ * Note    : なし
+ */
+double CompareAudio(const int16_t* samples_a, const int16_t* samples_b, uint32_t sample_num)
+{
+	double sum_ab = 0.0;
+	double sum_aa = 0.0;
+	double sum_bb = 0.0;
+	double similarity;
+
+	for (uint32_t index=0; index<sample_num; index++) {
+		sum_ab += (double)samples_a[index] * samples_b[index];
+		sum_aa += (double)samples_a[index] * samples_a[index];
+		sum_bb += (double)samples_b[index] * samples_b[index];
+	}
+
+	if ((sum_aa == 0.0) && (sum_bb == 0.0)) {
+		similarity = 1.0;
+	} else if ((sum_aa == 0.0) || (sum_bb == 0.0)) {
+		similarity = 0.0;
+	} else {
+		similarity = sum_ab / sqrt(sum_aa * sum_bb);
+	}
+
+	return similarity;
+}
+
+/*
+ * Function: 基本周波数推定
+ * Argument: 音声データ、サンプル数
+ * Return  : 基本周波数 [Hz] (50～2000Hz、推定できない場合は0)
+ * Note    : 自己相関が最大値の95%以上となる最短の周期を基本周期とする
+ */
+double EstimatePitch(const int16_t* samples, uint32_t sample_num)
+{
+	const uint32_t lag_min = YMF825_EMU_SAMPLE_RATE / 2000;
+	const uint32_t lag_max = YMF825_EMU_SAMPLE_RATE / 50;
+	double correlation[YMF825_EMU_SAMPLE_RATE / 50 + 1];
+	double correlation_max = 0.0;
+	double pitch = 0.0;
+	double previous;
+	double next;
+	double offset;
+
+	if (sample_num <= lag_max * 2) {
+		return 0.0;
+	}
+
+	for (uint32_t lag=lag_min; lag<=lag_max; lag++) {
+		correlation[lag] = 0.0;
+		for (uint32_t index=0; index+lag<sample_num; index++) {
+			correlation[lag] += (double)samples[index] * samples[index + lag];
+		}
+		correlation[lag] /= (double)(sample_num - lag);
+		if (correlation[lag] > correlation_max) {
+			correlation_max = correlation[lag];
+		}
+	}
+
+	for (uint32_t lag=lag_min+1; (lag<lag_max) && (pitch == 0.0); lag++) {
+		if ((correlation[lag] >= correlation_max * 0.95)
+		 && (correlation[lag] >= correlation[lag - 1]) && (correlation[lag] >= correlation[lag + 1])) {
+			/* 放物線補間で周期を求める */
+			previous = correlation[lag - 1];
+			next = correlation[lag + 1];
+			offset = 0.0;
+			if ((previous - 2.0 * correlation[lag] + next) != 0.0) {
+				offset = 0.5 * (previous - next) / (previous - 2.0 * correlation[lag] + next);
+			}
+			pitch = (double)YMF825_EMU_SAMPLE_RATE / ((double)lag + offset);
+		}
+	}
+
+	return pitch;
+}
+
+/*
+ * Function: 実効値算出
+ * Argument: 音声データ、サンプル数
+ * Return  : 実効値
+ * Note    : なし
+ */
+double GetAudioRms(const int16_t* samples, uint32_t sample_num)
+{
+	double sum = 0.0;
+
+	for (uint32_t index=0; index<sample_num; index++) {
+		sum += (double)samples[index] * samples[index];
+	}
+
+	return (sample_num > 0) ? sqrt(sum / sample_num) : 0.0;
+}
+
+/*
+ * Function: Contents Data Write Port 書き込み
+ * Argument: 書き込みデータ
+ * Return  : なし
+ * Note    : ヘッダー(0x80 + 音色数)、音色数×30byte、フッター4byteの順に受信する
+ */
+static void writeContents(uint8_t data)
+{
+	switch (contents_state) {
+	case CONTENTS_HEADER:
+		if ((data & 0x80) != 0) {
+			contents_tone_num = data & 0x0F;
+			contents_index = 0;
+			if (contents_tone_num > 0) {
+				contents_state = CONTENTS_TONE;
+			} else {
+				contents_state = CONTENTS_FOOTER;
+			}
+		}
+		break;
+	case CONTENTS_TONE:
+		tone_memory[contents_index / TONE_SIZE][contents_index % TONE_SIZE] = data;
+		contents_index ++;
+		if (contents_index >= contents_tone_num * TONE_SIZE) {
+			contents_state = CONTENTS_FOOTER;
+			contents_index = 0;
+		}
+		break;
+	case CONTENTS_FOOTER:
+		contents_index ++;
+		if (contents_index >= TONE_FOOTER_SIZE) {
+			contents_state = CONTENTS_HEADER;
+		}
+		break;
+	default:
+		/* 処理なし */
+		break;
+	}
+}
+
+/*
+ * Function: KEYON書き込み
+ * Argument: ボイス、書き込みデータ(bit6:KeyOn、bit5:Mute、bit4:EG_RST、bit3-0:音色番号)
+ * Return  : なし
+ * Note    : なし
+ */
+static void writeKeyOn(voice_state_t* voice, uint8_t data)
+{
+	bool_t key = ((data & 0x40) != 0) ? TRUE : FALSE;
+
+	voice->tone = data & 0x0F;
+	for (uint32_t op=0; op<YMF825_EMU_OPERATOR_NUM; op++) {
+		if (((data & 0x20) != 0) || ((data & 0x10) != 0)) {
+			/* ミュート、エンベロープリセット */
+			voice->op[op].envelope_db = ENVELOPE_SILENT_DB;
+			voice->op[op].stage = ENVELOPE_OFF;
+		}
+		if ((key == TRUE) && (voice->key == FALSE)) {
+			voice->op[op].phase = 0.0;
+			voice->op[op].stage = ENVELOPE_ATTACK;
+		} else if ((key == FALSE) && (voice->op[op].stage != ENVELOPE_OFF)) {
+			voice->op[op].stage = ENVELOPE_RELEASE;
+		} else {
+			/* 処理なし */
+		}
+	}
+	voice->key = key;
+}
+
+/*
+ * Function: エンベロープレートの変化時間
+ * Argument: レート(0～15)
+ * Return  : 96dB変化する時間 [s] (0:変化しない)
+ * Note    : レート1段で時間が半分になる(レート15で約2.4ms)
+ */
+static double rateTime(uint8_t rate)
+{
+	double time = 0.0;
+
+	if (rate > 0) {
+		time = 78.0 / (double)(1U << rate);
+	}
+
+	return time;
+}
+
+/*
+ * Function: エンベロープ更新
+ * Argument: オペレータ状態、オペレータのトーンデータ
+ * Return  : なし
+ * Note    : 1サンプル分進める
+ */
+static void updateEnvelope(operator_state_t* op, const uint8_t* param)
+{
+	const uint8_t sr = param[0] >> 4;
+	const uint8_t rr = param[1] >> 4;
+	const uint8_t dr = param[1] & 0x0F;
+	const uint8_t ar = param[2] >> 4;
+	const double sl_db = (double)(param[2] & 0x0F) * 3.0;
+	double step;
+
+	switch (op->stage) {
+	case ENVELOPE_ATTACK:
+		if (ar >= 15) {
+			op->envelope_db = 0.0;
+		} else if (ar > 0) {
+			/* アタックは減衰の8倍速 */
+			op->envelope_db -= (ENVELOPE_SILENT_DB * 8.0) / (rateTime(ar) * YMF825_EMU_SAMPLE_RATE);
+		} else {
+			/* 処理なし */
+		}
+		if (op->envelope_db <= 0.0) {
+			op->envelope_db = 0.0;
+			op->stage = ENVELOPE_DECAY;
+		}
+		break;
+	case ENVELOPE_DECAY:
+		if (dr > 0) {
+			op->envelope_db += ENVELOPE_SILENT_DB / (rateTime(dr) * YMF825_EMU_SAMPLE_RATE);
+		}
+		if (op->envelope_db >= sl_db) {
+			op->envelope_db = sl_db;
+			op->stage = ENVELOPE_SUSTAIN;
+		}
+		break;
+	case ENVELOPE_SUSTAIN:
+	case ENVELOPE_RELEASE:
+		if (op->stage == ENVELOPE_SUSTAIN) {
+			step = (sr > 0) ? ENVELOPE_SILENT_DB / (rateTime(sr) * YMF825_EMU_SAMPLE_RATE) : 0.0;
+		} else {
+			step = (rr > 0) ? ENVELOPE_SILENT_DB / (rateTime(rr) * YMF825_EMU_SAMPLE_RATE) : 0.0;
+		}
+		op->envelope_db += step;
+		if (op->envelope_db >= ENVELOPE_SILENT_DB) {
+			op->envelope_db = ENVELOPE_SILENT_DB;
+			op->stage = ENVELOPE_OFF;
+		}
+		break;
+	default:
+		/* 処理なし */
+		break;
+	}
+}
+
+/*
+ * Function: オペレータ出力
+ * Argument: オペレータ状態、オペレータのトーンデータ、ボイス周波数 [Hz]、変調入力 [rad]
+ * Return  : 出力(±1.0)
+ * Note    : 1サンプル分進める
+ */
+static double renderOperator(operator_state_t* op, const uint8_t* param, double frequency, double modulation)
+{
+	const uint8_t multi = param[5] >> 4;
+	const double tl_db = (double)(param[3] >> 2) * 0.75;
+	const uint8_t fb = param[6] & 0x07;
+	double output;
+
+	updateEnvelope(op, param);
+	if (op->stage == ENVELOPE_OFF) {
+		return 0.0;
+	}
+
+	if (fb > 0) {
+		modulation += ((op->feedback[0] + op->feedback[1]) / 2.0) * M_PI / (double)(1U << (7 - fb));
+	}
+
+	output = sin((2.0 * M_PI * op->phase) + modulation) * pow(10.0, -(op->envelope_db + tl_db) / 20.0);
+	op->feedback[1] = op->feedback[0];
+	op->feedback[0] = output;
+
+	if (multi == 0) {
+		op->phase += (frequency * 0.5) / YMF825_EMU_SAMPLE_RATE;
+	} else {
+		op->phase += (frequency * multi) / YMF825_EMU_SAMPLE_RATE;
+	}
+	op->phase -= floor(op->phase);
+
+	return output;
+}
+
+/*
+ * Function: ボイス出力
+ * Argument: ボイス状態
+ * Return  : 出力
+ * Note    : アルゴリズム(→:変調、+:加算出力)
+ *           0:1→2、1:1+2、2:1+2+3+4、3:(1+(2→3))→4、4:1→2→3→4、5:(1→2)+(3→4)、6:1+(2→3→4)、7:1+(2→3)+4
+ */
+static double renderVoice(voice_state_t* voice)
+{
+	const uint8_t* tone = tone_memory[voice->tone];
+	const uint8_t algorithm = tone[1] & 0x07;
+	double frequency;
+	double out[YMF825_EMU_OPERATOR_NUM];
+	double output;
+	const double mod = 2.0 * M_PI;
+
+	/* FNUM = f × 2^19 / (48000 × 2^(BLOCK-1)) */
+	frequency = (double)voice->fnum * pow(2.0, (double)voice->block - 1.0) * YMF825_EMU_SAMPLE_RATE / 524288.0;
+	frequency *= (double)voice->multiplier / 512.0;
+
+#define OP(n, m)	renderOperator(&voice->op[n], &tone[TONE_OPERATOR_OFFSET + (n) * TONE_OPERATOR_SIZE], frequency, (m))
+	switch (algorithm) {
+	case 0:
+		out[0] = OP(0, 0.0);
+		output = OP(1, out[0] * mod);
+		break;
+	case 1:
+		output = OP(0, 0.0) + OP(1, 0.0);
+		break;
+	case 2:
+		output = OP(0, 0.0) + OP(1, 0.0) + OP(2, 0.0) + OP(3, 0.0);
+		break;
+	case 3:
+		out[0] = OP(0, 0.0);
+		out[1] = OP(1, 0.0);
+		out[2] = OP(2, out[1] * mod);
+		output = OP(3, (out[0] + out[2]) * mod);
+		break;
+	case 4:
+		out[0] = OP(0, 0.0);
+		out[1] = OP(1, out[0] * mod);
+		out[2] = OP(2, out[1] * mod);
+		output = OP(3, out[2] * mod);
+		break;
+	case 5:
+		out[0] = OP(0, 0.0);
+		out[2] = OP(2, 0.0);
+		output = OP(1, out[0] * mod) + OP(3, out[2] * mod);
+		break;
+	case 6:
+		out[1] = OP(1, 0.0);
+		out[2] = OP(2, out[1] * mod);
+		output = OP(0, 0.0) + OP(3, out[2] * mod);
+		break;
+	default:
+		out[1] = OP(1, 0.0);
+		output = OP(0, 0.0) + OP(2, out[1] * mod) + OP(3, 0.0);
+		break;
+	}
+#undef OP
+
+	return output * ((double)voice->chvol / 31.0) * ((double)voice->vovol / 31.0);
+}
@@ -0,0 +1,43 @@
+/*
+ * ymf825_emu.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  YMF825レジスタ書き込み記録の音声化(回帰比較用の簡易4オペレータFM音源モデル)
+ */
+
+
+#ifndef YMF825_EMU_H_
+#define YMF825_EMU_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "ymf825_sim.h"
+
+/********** Define **********/
+
+/* サンプリング周波数 [Hz] */
+#define YMF825_EMU_SAMPLE_RATE	(48000)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitYmf825Emu(void);
+void WriteYmf825Emu(uint8_t address, uint8_t data);
+void RenderYmf825Emu(int16_t* samples, uint32_t sample_num);
+void RenderYmf825Trace(const ymf825_write_t* trace, uint32_t trace_num, int16_t* samples, uint32_t sample_num);
+result_t WriteWavFile(const char* path, const int16_t* samples, uint32_t sample_num);
+double CompareAudio(const int16_t* samples_a, const int16_t* samples_b, uint32_t sample_num);
+double EstimatePitch(const int16_t* samples, uint32_t sample_num);
+double GetAudioRms(const int16_t* samples, uint32_t sample_num);
+
+#endif /* YMF825_EMU_H_ */
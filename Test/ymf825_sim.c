@@ -0,0 +1,147 @@
+/*
+ * ymf825_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "typedef.h"
+#include "stub_hal.h"
+#include "ymf825_sim.h"
+
+/********** Define **********/
+
+/* SPI2 10MHz */
+#define YMF825_SIM_BYTE_TIME_NS		(800)
+
+/* アドレスバイトの読み出しフラグ */
+#define YMF825_SIM_READ_FLAG		(0x80)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static ymf825_write_t ymf825_trace[YMF825_SIM_TRACE_SIZE];
+static uint32_t ymf825_trace_num;
+
+static bool_t ymf825_selected;
+static uint32_t ymf825_byte_index;
+static uint8_t ymf825_address;
+
+/********** Function Prototype **********/
+
+static void selectYmf825(void);
+static void deselectYmf825(void);
+static void transferYmf825(const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);
+
+static const stub_spi_device_t ymf825_device = {
+	selectYmf825,
+	deselectYmf825,
+	transferYmf825,
+	YMF825_SIM_BYTE_TIME_NS
+};
+
+/********** Function **********/
+
+/*
+ * Function: YMF825模擬初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 記録を消去し、SPI2に接続する(StubInit後に実行すること)
+ */
+void InitYmf825Sim(void)
+{
+	ymf825_trace_num = 0;
+	ymf825_selected = FALSE;
+	ymf825_byte_index = 0;
+	ymf825_address = 0;
+
+	StubSetSpiDevice(STUB_SPI_SOUND, &ymf825_device);
+}
+
+/*
+ * Function: レジスタ書き込み記録数取得
+ * Argument: なし
+ * Return  : 記録数
+ * Note    : なし
+ */
+uint32_t GetYmf825SimWriteNum(void)
+{
+	return ymf825_trace_num;
+}
+
+/*
+ * Function: レジスタ書き込み記録取得
+ * Argument: なし
+ * Return  : 記録先頭アドレス
+ * Note    : なし
+ */
+const ymf825_write_t* GetYmf825SimTrace(void)
+{
+	return ymf825_trace;
+}
+
+/*
+ * Function: CS有効
+ * Argument: なし
+ * Return  : なし
+ * Note    : 次の1byteをアドレスとして扱う
+ */
+static void selectYmf825(void)
+{
+	ymf825_selected = TRUE;
+	ymf825_byte_index = 0;
+}
+
+/*
+ * Function: CS無効
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void deselectYmf825(void)
+{
+	ymf825_selected = FALSE;
+}
+
+/*
+ * Function: SPI転送
+ * Argument: 送信データ、受信バッファ、長さ
+ * Return  : なし
+ * Note    : アドレスに続くデータを全て同じアドレスへの書き込みとして記録する
+ */
+static void transferYmf825(const uint8_t* tx_data, uint8_t* rx_data, uint16_t length)
+{
+	if (ymf825_selected == FALSE) {
+		fprintf(stderr, "ymf825_sim: transfer without CS\n");
+		exit(1);
+	}
+
+	for (uint16_t index=0; index<length; index++) {
+		if (rx_data != NULL) {
+			rx_data[index] = 0;
+		}
+		if (tx_data != NULL) {
+			if (ymf825_byte_index == 0) {
+				ymf825_address = tx_data[index];
+			} else if (((ymf825_address & YMF825_SIM_READ_FLAG) == 0) && (ymf825_trace_num < YMF825_SIM_TRACE_SIZE)) {
+				ymf825_trace[ymf825_trace_num].time = StubGetTimeUs();
+				ymf825_trace[ymf825_trace_num].address = ymf825_address;
+				ymf825_trace[ymf825_trace_num].data = tx_data[index];
+				ymf825_trace_num ++;
+			} else {
+				/* 処理なし */
+			}
+			ymf825_byte_index ++;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+/*
+ * ymf825_sim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ *
+ *  SPI2に接続するYMF825の模擬(レジスタ書き込みを時刻付きで記録する)
+ */
+
+
+#ifndef YMF825_SIM_H_
+#define YMF825_SIM_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* レジスタ書き込み記録数 */
+#define YMF825_SIM_TRACE_SIZE	(8192)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/* レジスタ書き込み(複数データ書き込みはデータ1byte毎) */
+typedef struct {
+	uint32_t time;		/* 書き込み時刻 [us] */
+	uint8_t address;	/* レジスタアドレス */
+	uint8_t data;		/* 書き込みデータ */
+} ymf825_write_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitYmf825Sim(void);
+uint32_t GetYmf825SimWriteNum(void);
+const ymf825_write_t* GetYmf825SimTrace(void);
+
+#endif /* YMF825_SIM_H_ */
@@ -1,38 +1,38 @@
-/*
- * drv_backlight.c
- *
- *  Created on: Jun 24, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_timer.h"
-#include "drv_backlight.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-/********** Function **********/
-
-/*
- * Function: 
- * Argument: 
- * Return  : 
- * Note    : 
- */
-void InitBacklight(void)
-{
-	StartTimer(TIMER_CH3);
+/*
+ * drv_backlight.c
+ *
+ *  Created on: Jun 24, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "drv_backlight.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+/********** Function **********/
+
+/*
+ * Function: 
+ * Argument: 
+ * Return  : 
+ * Note    : 
+ */
+void InitBacklight(void)
+{
+	StartTimer(TIMER_CH3);
 }
\ No newline at end of file
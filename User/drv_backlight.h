@@ -1,30 +1,30 @@
-/*
- * drv_backlight.h
- *
- *  Created on: Jun 24, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_BACKLIGHT_H_
-#define DRV_BACKLIGHT_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitBacklight(void);
-
-#endif /* DRV_BACKLIGHT_H_ */
+/*
+ * drv_backlight.h
+ *
+ *  Created on: Jun 24, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_BACKLIGHT_H_
+#define DRV_BACKLIGHT_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitBacklight(void);
+
+#endif /* DRV_BACKLIGHT_H_ */
@@ -1,275 +1,934 @@
-/*
- * drv_controller.c
- *
- *  Created on: Jul 8, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_adc.h"
-#include "mcal_dio.h"
-#include "drv_controller.h"
-
-/********** Define **********/
-
-/* チャタリング除去対象のSW数 */
-#define SW_NUM					(4)
-/* チャタリング除去用のバッファ数 */
-#define SW_INPUT_BUFFER_NUM		(3)
-
-/* ジョイスティック入力の閾値(上側) */
-#define POS_THRESHOLD_UPPER		(0.8f)
-/* ジョイスティック入力の閾値(下側) */
-#define POS_THRESHOLD_LOWER		(0.2f)
-/* ジョイススティック入力ニュートラルの閾値(上側) */
-#define POS_THRESHOLD_NEUTRAL_UPPER	(0.65f)
-/* ジョイススティック入力ニュートラルの閾値(下側) */
-#define POS_THRESHOLD_NEUTRAL_LOWER	(0.35f)
-
-/********** Enum **********/
-
-/********** Type **********/
-
-typedef struct {
-	pin_id_t pin_id;
-	input_id_t input_id;
-	pin_level_t active_level;
-} sw_info_t;
-
-/********** Constant **********/
-
-static const sw_info_t sw_info_table[SW_NUM] =
-{
-	{PIN_ID_SW_A,	INPUT_ID_SW_A,	PIN_LEVEL_LOW},
-	{PIN_ID_SW_B,	INPUT_ID_SW_B,	PIN_LEVEL_LOW},
-	{PIN_ID_SW_C,	INPUT_ID_SW_C,	PIN_LEVEL_LOW},
-	{PIN_ID_SW_D,	INPUT_ID_SW_D,	PIN_LEVEL_LOW},
-};
-
-/********** Variable **********/
-
-static input_state_t input_state[INPUT_ID_NUM];
-static pin_level_t sw_input_buffer[SW_NUM][SW_INPUT_BUFFER_NUM];
-static uint32_t sw_input_buffer_index;
-
-/********** Function Prototype **********/
-
-static void judgeSwInputState(input_state_t current_input_state[]);
-static void judgePosInputState(input_state_t current_input_state[]);
-static void judgeLeverInputState(input_state_t current_input_state[]);
-static void updateInputState(input_state_t current_input_state[]);
-
-/********** Function **********/
-
-/*
- * Function: DRV CONTROLLER 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitController(void)
-{
-	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
-		input_state[input_id] = INPUT_OFF;
-	}
-
-	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
-		for (uint32_t buffer_index=0; buffer_index<SW_INPUT_BUFFER_NUM; buffer_index++) {
-			/* SW入力の初期値はSW非アクティブ */
-			sw_input_buffer[sw_id][buffer_index] = ~sw_info_table[sw_id].active_level;
-		}
-	}
-
-	sw_input_buffer_index = 0;
-}
-
-/*
- * Function: DRV CONTROLLER 周期処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void MainController(void)
-{
-	input_state_t current_input_state[INPUT_ID_NUM];
-
-	/* 各種入力状態判定 */
-	judgeSwInputState(current_input_state);
-	judgePosInputState(current_input_state);
-	judgeLeverInputState(current_input_state);
-
-	/* 入力状態更新 */
-	updateInputState(current_input_state);
-}
-
-/*
- * Function: SW入力更新
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void UpdateSwInput(void)
-{
-	/* SW端子の状態を取得*/
-	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
-		sw_input_buffer[sw_id][sw_input_buffer_index] = ReadPin(sw_info_table[sw_id].pin_id);
-	}
-
-	if (sw_input_buffer_index < SW_INPUT_BUFFER_NUM - 1) {
-		sw_input_buffer_index ++;
-	} else {
-		sw_input_buffer_index = 0;
-	}
-}
-
-/*
- * Function: 入力状態取得
- * Argument: 入力ID
- * Return  : 入力状態
- * Note    : なし
- */
-input_state_t GetInputState(input_id_t input_id)
-{
-	return input_state[input_id];
-}
-
-/*
- * Function: SW入力状態判定
- * Argument: 現在入力状態
- * Return  : なし
- * Note    : なし
- */
-static void judgeSwInputState(input_state_t current_input_state[])
-{
-	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
-		uint32_t count = 0;
-		for (uint32_t buffer_index=1; buffer_index<SW_INPUT_BUFFER_NUM; buffer_index++) {
-			if (sw_input_buffer[sw_id][buffer_index - 1] == sw_input_buffer[sw_id][buffer_index]) {
-				count ++;
-			}
-		}
-
-		if (count == (SW_INPUT_BUFFER_NUM - 1)) {
-			/* バッファ内の値がすべて一致しているので、入力確定 */
-			if (sw_input_buffer[sw_id][0] == sw_info_table[sw_id].active_level) {
-				current_input_state[sw_info_table[sw_id].input_id] = INPUT_ON;
-			} else {
-				current_input_state[sw_info_table[sw_id].input_id] = INPUT_OFF;
-			}
-		} else {
-			/* バッファ内の値に変化があるので、前周期の値を採用 */
-			current_input_state[sw_info_table[sw_id].input_id] = input_state[sw_info_table[sw_id].input_id];
-		}
-	}
-}
-
-/*
- * Function: ジョイスティック入力状態判定
- * Argument: 現在入力状態
- * Return  : なし
- * Note    : なし
- */
-static void judgePosInputState(input_state_t current_input_state[])
-{
-	float ad_value;
-
-	/* ジョイスティック横方向判定 */
-	ad_value = GetAd(AD_ID_POS_H);
-	if (ad_value > POS_THRESHOLD_UPPER) {
-		current_input_state[INPUT_ID_POS_LEFT] = INPUT_OFF;
-		current_input_state[INPUT_ID_POS_RIGHT] = INPUT_ON;
-	} else if (ad_value < POS_THRESHOLD_LOWER) {
-		current_input_state[INPUT_ID_POS_LEFT] = INPUT_ON;
-		current_input_state[INPUT_ID_POS_RIGHT] = INPUT_OFF;
-	} else if ((ad_value < POS_THRESHOLD_NEUTRAL_UPPER) && (ad_value > POS_THRESHOLD_NEUTRAL_LOWER)) {
-		current_input_state[INPUT_ID_POS_LEFT] = INPUT_OFF;
-		current_input_state[INPUT_ID_POS_RIGHT] = INPUT_OFF;
-	} else {
-		/* 途中位置は前回値保持 */
-		current_input_state[INPUT_ID_POS_LEFT] = input_state[INPUT_ID_POS_LEFT];
-		current_input_state[INPUT_ID_POS_RIGHT] = input_state[INPUT_ID_POS_RIGHT];
-	}
-	
-	/* ジョイスティック縦方向判定 */
-	ad_value = GetAd(AD_ID_POS_V);
-	if (ad_value > POS_THRESHOLD_UPPER) {
-		current_input_state[INPUT_ID_POS_UP] = INPUT_OFF;
-		current_input_state[INPUT_ID_POS_DOWN] = INPUT_ON;
-	} else if (ad_value < POS_THRESHOLD_LOWER) {
-		current_input_state[INPUT_ID_POS_UP] = INPUT_ON;
-		current_input_state[INPUT_ID_POS_DOWN] = INPUT_OFF;
-	} else if ((ad_value < POS_THRESHOLD_NEUTRAL_UPPER) && (ad_value > POS_THRESHOLD_NEUTRAL_LOWER)) {
-		current_input_state[INPUT_ID_POS_UP] = INPUT_OFF;
-		current_input_state[INPUT_ID_POS_DOWN] = INPUT_OFF;
-	} else {
-		/* 途中位置は前回値保持 */
-		current_input_state[INPUT_ID_POS_UP] = input_state[INPUT_ID_POS_UP];
-		current_input_state[INPUT_ID_POS_DOWN] = input_state[INPUT_ID_POS_DOWN];
-	}
-}
-
-/*
- * Function: レバー入力状態判定
- * Argument: 現在入力状態
- * Return  : なし
- * Note    : なし
- */
-static void judgeLeverInputState(input_state_t current_input_state[])
-{
-	float ad_value = GetAd(AD_ID_LEVER);
-
-	/* レバー位置判定 */
-	if (ad_value < 0.15f) {
-		current_input_state[INPUT_ID_LEVER_SW] = INPUT_ON;
-		current_input_state[INPUT_ID_LEVER_LEFT] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_RIGHT] = INPUT_OFF;
-	} else if ((ad_value > 0.2f) && (ad_value < 0.5f)) {
-		current_input_state[INPUT_ID_LEVER_SW] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_LEFT] = INPUT_ON;
-		current_input_state[INPUT_ID_LEVER_RIGHT] = INPUT_OFF;
-	} else if ((ad_value > 0.5f) && (ad_value < 0.7f)) {
-		current_input_state[INPUT_ID_LEVER_SW] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_LEFT] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_RIGHT] = INPUT_ON;
-	} else {
-		current_input_state[INPUT_ID_LEVER_SW] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_LEFT] = INPUT_OFF;
-		current_input_state[INPUT_ID_LEVER_RIGHT] = INPUT_OFF;
-	}
-}
-
-/*
- * Function: 入力状態更新
- * Argument: 現在入力状態
- * Return  : なし
- * Note    : なし
- */
-static void updateInputState(input_state_t current_input_state[])
-{
-	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
-		switch (input_state[input_id]) {
-		case INPUT_OFF:				/* INPUT_OFFとINPUT_RELEASEは同じ処理 */
-		case INPUT_RELEASE:
-			if (current_input_state[input_id] == INPUT_ON) {
-				input_state[input_id] = INPUT_PUSH;
-			} else {
-				input_state[input_id] = INPUT_OFF;
-			}
-			break;
-		case INPUT_ON:				/* INPUT_ONとINPUT_PUSHは同じ処理 */
-		case INPUT_PUSH:
-			if (current_input_state[input_id] == INPUT_OFF) {
-				input_state[input_id] = INPUT_RELEASE;
-			} else {
-				input_state[input_id] = INPUT_ON;
-			}
-			break;
-		default:
-			input_state[input_id] = INPUT_OFF;
-			break;
-		}
-	}
-}
+/*
+ * drv_controller.c
+ *
+ *  Created on: Jul 8, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_adc.h"
+#include "mcal_dio.h"
+#include "mcal_timer.h"
+#include "sys_latency.h"
+#include "drv_eeprom.h"
+#include "drv_controller.h"
+
+/********** Define **********/
+
+/* チャタリング除去対象のSW数 */
+#define SW_NUM					(4)
+/* チャタリング除去用の一致サンプル数(ポーリング時) */
+#define SW_INPUT_BUFFER_NUM		(3)
+/* エッジ検出後のチャタリング無視時間 [us](EXTI割り込み時) */
+#define SW_LOCKOUT_TIME			(10000)
+
+/* 入力遅延計測対象のSW(sw_info_tableのインデックス) */
+#define LATENCY_SW_ID			(0)		/* SW_A */
+
+/* 入力イベントキューサイズ(1周期の最大イベント数に対して十分な数) */
+#define INPUT_EVENT_QUEUE_SIZE	(64)
+
+/* ジョイスティック方向入力の閾値(ベクトル成分) */
+#define POS_THRESHOLD_ON		(STICK_VECTOR_MAX * 60 / 100)
+/* ジョイスティック方向入力解除の閾値(ベクトル成分) */
+#define POS_THRESHOLD_OFF		(STICK_VECTOR_MAX * 30 / 100)
+
+/* ジョイスティックの円形デッドゾーン半径(ベクトル長) */
+#define STICK_DEADZONE			(STICK_VECTOR_MAX * 15 / 100)
+/* キャリブレーションデータの識別値 */
+#define STICK_CALIB_MAGIC		(0xCA1B)
+/* キャリブレーションで必要な中心からの最小振れ幅(AD変換値) */
+#define STICK_CALIB_RANGE_MIN	(AD_VALUE_MAX / 8)
+/* 線形変換の係数の小数部ビット数 */
+#define STICK_SCALE_SHIFT		(16)
+
+/********** Enum **********/
+
+typedef enum {
+	STICK_AXIS_H = 0,
+	STICK_AXIS_V,
+	STICK_AXIS_NUM
+} stick_axis_t;
+
+/********** Type **********/
+
+typedef struct {
+	ad_id_t ad_id;
+} stick_axis_info_t;
+
+/* キャリブレーション値(AD変換値) */
+typedef struct {
+	uint32_t min;
+	uint32_t center;
+	uint32_t max;
+} stick_calib_t;
+
+/* 軸毎の線形変換(AD変換値→ベクトル成分) */
+typedef struct {
+	int32_t center;
+	int32_t scale_negative;		/* 中心より小さい側の係数 */
+	int32_t scale_positive;		/* 中心より大きい側の係数 */
+} stick_map_t;
+
+typedef struct {
+	pin_id_t pin_id;
+	input_id_t input_id;
+	pin_level_t active_level;
+} sw_info_t;
+
+/********** Constant **********/
+
+static const sw_info_t sw_info_table[SW_NUM] =
+{
+	{PIN_ID_SW_A,	INPUT_ID_SW_A,	PIN_LEVEL_LOW},
+	{PIN_ID_SW_B,	INPUT_ID_SW_B,	PIN_LEVEL_LOW},
+	{PIN_ID_SW_C,	INPUT_ID_SW_C,	PIN_LEVEL_LOW},
+	{PIN_ID_SW_D,	INPUT_ID_SW_D,	PIN_LEVEL_LOW},
+};
+
+static const stick_axis_info_t stick_axis_info_table[STICK_AXIS_NUM] =
+{
+	{AD_ID_POS_H},
+	{AD_ID_POS_V},
+};
+
+/********** Variable **********/
+
+/* 周期処理(メインループ)側 */
+static input_state_t input_state[INPUT_ID_NUM];
+static bool_t input_push_pending[INPUT_ID_NUM];
+static bool_t input_release_pending[INPUT_ID_NUM];
+static bool_t input_event_level[INPUT_ID_NUM];		/* 最後に取り出したイベント後の入力レベル */
+static input_event_t frame_event[INPUT_EVENT_QUEUE_SIZE];
+static uint32_t frame_event_num;
+static bool_t input_inject_enable;
+static input_event_t inject_event[INPUT_EVENT_QUEUE_SIZE];
+static uint32_t inject_event_num;
+
+/* 割り込み処理側 */
+static bool_t input_level[INPUT_ID_NUM];
+static pin_level_t sw_level_stable[SW_NUM];
+#if SW_INPUT_EXTI_ENABLE
+static bool_t sw_lockout[SW_NUM];
+static uint32_t sw_lockout_time[SW_NUM];
+#else
+static pin_level_t sw_level_last[SW_NUM];
+static uint32_t sw_level_count[SW_NUM];
+static uint32_t sw_edge_time[SW_NUM];
+#endif
+
+/* ジョイスティック変換(割り込み処理で参照中の面と更新用の面を切り替え) */
+static stick_map_t stick_map[2][STICK_AXIS_NUM];
+static uint32_t stick_map_index;
+static bool_t stick_calibrating;
+static stick_calib_t stick_calib[STICK_AXIS_NUM];
+/* EEPROMが書き込みを受け付けなかったキャリブレーション値(周期処理で再試行) */
+static bool_t stick_calib_save_pending;
+static eeprom_stick_calib_t stick_calib_record;
+/* EEPROMからキャリブレーション値を読み出し済み(起動時の全データ読み出しが未完了の場合は完了後に読み出す) */
+static bool_t stick_calib_loaded;
+
+/* 入力イベントキュー(書き込み:割り込み処理(5ms周期、AD変換完了、EXTI)、読み出し:周期処理) */
+static input_event_t input_event_queue[INPUT_EVENT_QUEUE_SIZE];
+static uint32_t input_event_queue_index_top;
+static uint32_t input_event_queue_index_end;
+
+/********** Function Prototype **********/
+
+#if SW_INPUT_EXTI_ENABLE
+static void callbackSwEdge(pin_id_t pin_id);
+static void reconcileSwInput(void);
+#else
+static void debounceSwInput(void);
+#endif
+static void acceptSwLevel(uint32_t sw_id, pin_level_t level, uint32_t time);
+static void loadStickCalibration(void);
+static void updateStickMap(const stick_calib_t calib[]);
+static stick_vector_t calculateStickVector(void);
+static int32_t mapStickAxis(const stick_map_t* map, uint32_t ad_raw);
+static uint32_t sqrtInteger(uint32_t value);
+static void callbackAdComplete(void);
+static void judgePosInputState(uint32_t time);
+static void judgeLeverInputState(uint32_t time);
+static void changeInputLevel(input_id_t input_id, bool_t level, uint32_t time);
+static void pushInputEvent(input_id_t input_id, input_event_type_t type, uint32_t time);
+static void updateInputState(void);
+
+/********** Function **********/
+
+/*
+ * Function: DRV CONTROLLER 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitController(void)
+{
+	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+		input_state[input_id] = INPUT_OFF;
+		input_push_pending[input_id] = FALSE;
+		input_release_pending[input_id] = FALSE;
+		input_event_level[input_id] = FALSE;
+		input_level[input_id] = FALSE;
+	}
+	input_inject_enable = FALSE;
+	inject_event_num = 0;
+
+	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
+		/* SW入力の初期値はSW非アクティブ */
+		if (sw_info_table[sw_id].active_level == PIN_LEVEL_LOW) {
+			sw_level_stable[sw_id] = PIN_LEVEL_HIGH;
+		} else {
+			sw_level_stable[sw_id] = PIN_LEVEL_LOW;
+		}
+#if SW_INPUT_EXTI_ENABLE
+		sw_lockout[sw_id] = FALSE;
+		sw_lockout_time[sw_id] = 0;
+		EnablePinInterrupt(sw_info_table[sw_id].pin_id, callbackSwEdge);
+#else
+		sw_level_last[sw_id] = sw_level_stable[sw_id];
+		sw_level_count[sw_id] = SW_INPUT_BUFFER_NUM;
+		sw_edge_time[sw_id] = 0;
+#endif
+	}
+
+	frame_event_num = 0;
+	input_event_queue_index_top = 0;
+	input_event_queue_index_end = 0;
+
+	/* ジョイスティックのキャリブレーション値を読み出し */
+	stick_calibrating = FALSE;
+	stick_calib_save_pending = FALSE;
+	stick_calib_loaded = FALSE;
+	stick_map_index = 0;
+	loadStickCalibration();
+
+	/* AD変換完了時にジョイスティック、レバーの入力を判定 */
+	SetAdCallback(callbackAdComplete);
+}
+
+/*
+ * Function: DRV CONTROLLER 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : 前周期以降の入力イベントを取り出し、入力状態を更新する
+ */
+void MainController(void)
+{
+	input_event_t* event;
+	uint32_t ad_raw;
+
+	/* キャリブレーション中は振れ幅を記録 */
+	if (stick_calibrating == TRUE) {
+		for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+			ad_raw = GetAdRaw(stick_axis_info_table[axis].ad_id);
+			if (ad_raw < stick_calib[axis].min) {
+				stick_calib[axis].min = ad_raw;
+			}
+			if (ad_raw > stick_calib[axis].max) {
+				stick_calib[axis].max = ad_raw;
+			}
+		}
+	}
+
+	/* 初期化時に読み出せなかったキャリブレーション値を読み出し(読み出し前に新しいキャリブレーションを行った場合はそちらを優先) */
+	if ((stick_calib_loaded == FALSE) && (stick_calibrating == FALSE) && (IsEepromReady() == TRUE)) {
+		if (stick_calib_save_pending == FALSE) {
+			loadStickCalibration();
+		} else {
+			stick_calib_loaded = TRUE;
+		}
+	}
+
+	/* 保存できなかったキャリブレーション値を再度書き込み(読み出し完了待ちで周期処理を止めないよう、完了後のみ) */
+	if ((stick_calib_save_pending == TRUE) && (IsEepromReady() == TRUE)) {
+		if (WRITE_EEPROM_RECORD(STICK_CALIB, &stick_calib_record) == RESULT_OK) {
+			stick_calib_save_pending = FALSE;
+		}
+	}
+
+	/* 入力イベント取り出し */
+	frame_event_num = 0;
+	while (input_event_queue_index_end != input_event_queue_index_top) {
+		event = &input_event_queue[input_event_queue_index_end];
+		frame_event[frame_event_num] = *event;
+		frame_event_num ++;
+
+		if (event->type == INPUT_EVENT_PUSH) {
+			input_push_pending[event->input_id] = TRUE;
+			input_event_level[event->input_id] = TRUE;
+		} else {
+			input_release_pending[event->input_id] = TRUE;
+			input_event_level[event->input_id] = FALSE;
+		}
+
+		if (input_event_queue_index_end < INPUT_EVENT_QUEUE_SIZE - 1) {
+			input_event_queue_index_end ++;
+		} else {
+			input_event_queue_index_end = 0;
+		}
+	}
+
+	if (input_inject_enable == TRUE) {
+		/* 差し替え中は実入力を破棄し、InjectInputState、InjectInputEventの値をそのまま使用する */
+		for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+			input_push_pending[input_id] = FALSE;
+			input_release_pending[input_id] = FALSE;
+		}
+		for (uint32_t index=0; index<inject_event_num; index++) {
+			frame_event[index] = inject_event[index];
+		}
+		frame_event_num = inject_event_num;
+		inject_event_num = 0;
+	} else {
+		/* 入力状態更新 */
+		updateInputState();
+	}
+}
+
+/*
+ * Function: SW入力更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 5ms周期の割り込み処理
+ */
+void UpdateSwInput(void)
+{
+#if SW_INPUT_EXTI_ENABLE
+	reconcileSwInput();
+#else
+	debounceSwInput();
+#endif
+}
+
+/*
+ * Function: 入力状態取得
+ * Argument: 入力ID
+ * Return  : 入力状態
+ * Note    : なし
+ */
+input_state_t GetInputState(input_id_t input_id)
+{
+	return input_state[input_id];
+}
+
+/*
+ * Function: 入力状態差し替え有効/無効設定
+ * Argument: TRUE:InjectInputStateの値を使用、FALSE:実入力を使用
+ * Return  : なし
+ * Note    : 無効に戻した場合、現在の実入力レベルから状態遷移をやり直す
+ */
+void SetInputInject(bool_t enable)
+{
+	if ((input_inject_enable == TRUE) && (enable == FALSE)) {
+		for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+			input_state[input_id] = INPUT_OFF;
+			input_push_pending[input_id] = input_level[input_id];
+			input_release_pending[input_id] = FALSE;
+			input_event_level[input_id] = input_level[input_id];
+		}
+	}
+	input_inject_enable = enable;
+	inject_event_num = 0;
+}
+
+/*
+ * Function: 入力状態差し替え
+ * Argument: 入力ID、入力状態
+ * Return  : なし
+ * Note    : MainControllerの前に呼び出す
+ */
+void InjectInputState(input_id_t input_id, input_state_t state)
+{
+	input_state[input_id] = state;
+}
+
+/*
+ * Function: 入力イベント差し替え
+ * Argument: 入力ID、イベント種別
+ * Return  : なし
+ * Note    : MainControllerの前に呼び出す、発生時刻は呼び出し時刻とする
+ *           次のMainControllerでGetInputEventから取得できる
+ */
+void InjectInputEvent(input_id_t input_id, input_event_type_t type)
+{
+	if (inject_event_num < INPUT_EVENT_QUEUE_SIZE) {
+		inject_event[inject_event_num].input_id = input_id;
+		inject_event[inject_event_num].type = type;
+		inject_event[inject_event_num].time = GetTimeUs();
+		inject_event_num ++;
+	}
+}
+
+/*
+ * Function: 入力イベント数取得
+ * Argument: なし
+ * Return  : 今周期に取り出した入力イベント数
+ * Note    : なし
+ */
+uint32_t GetInputEventNum(void)
+{
+	return frame_event_num;
+}
+
+/*
+ * Function: 入力イベント取得
+ * Argument: イベントインデックス(発生順)
+ * Return  : 入力イベント
+ * Note    : 周期間に押して離した入力もイベントとして取得できる
+ */
+input_event_t GetInputEvent(uint32_t index)
+{
+	input_event_t event = {INPUT_ID_NUM, INPUT_EVENT_PUSH, 0};
+
+	if (index < frame_event_num) {
+		event = frame_event[index];
+	}
+
+	return event;
+}
+
+#if SW_INPUT_EXTI_ENABLE
+/*
+ * Function: SWエッジ検出コールバック
+ * Argument: 端子ID
+ * Return  : なし
+ * Note    : EXTI割り込み処理
+ *           最初のエッジで即座に入力確定し、以降SW_LOCKOUT_TIMEの間のエッジはチャタリングとして無視する
+ */
+static void callbackSwEdge(pin_id_t pin_id)
+{
+	uint32_t time = GetTimeUs();
+	pin_level_t level;
+
+	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
+		if (sw_info_table[sw_id].pin_id == pin_id) {
+			if ((sw_lockout[sw_id] == TRUE) && ((time - sw_lockout_time[sw_id]) >= SW_LOCKOUT_TIME)) {
+				sw_lockout[sw_id] = FALSE;
+			}
+
+			if (sw_lockout[sw_id] == FALSE) {
+				level = ReadPin(pin_id);
+				if (level != sw_level_stable[sw_id]) {
+					if ((sw_id == LATENCY_SW_ID) && (level == sw_info_table[sw_id].active_level)) {
+						RECORD_LATENCY_STAGE(LATENCY_STAGE_PIN_EDGE);
+					}
+					acceptSwLevel(sw_id, level, time);
+					sw_lockout[sw_id] = TRUE;
+					sw_lockout_time[sw_id] = time;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Function: SW入力整合
+ * Argument: なし
+ * Return  : なし
+ * Note    : 5ms周期の割り込み処理
+ *           無視時間中に端子が変化したままエッジが来ない場合に備え、無視時間経過後の端子レベルで入力を補正する
+ *           EXTI割り込み(callbackSwEdge)が割り込んで同じSWの状態を更新しないよう、SW毎の判定は割り込み禁止で行う
+ */
+static void reconcileSwInput(void)
+{
+	uint32_t time;
+	uint32_t primask;
+	pin_level_t level;
+
+	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+
+		/* 割り込み禁止前にEXTIで記録された無視開始時刻より前の時刻で判定しないよう、禁止後に取得 */
+		time = GetTimeUs();
+
+		if ((sw_lockout[sw_id] == TRUE) && ((time - sw_lockout_time[sw_id]) >= SW_LOCKOUT_TIME)) {
+			sw_lockout[sw_id] = FALSE;
+		}
+
+		if (sw_lockout[sw_id] == FALSE) {
+			level = ReadPin(sw_info_table[sw_id].pin_id);
+			if (level != sw_level_stable[sw_id]) {
+				acceptSwLevel(sw_id, level, time);
+				sw_lockout[sw_id] = TRUE;
+				sw_lockout_time[sw_id] = time;
+			}
+		}
+
+		__set_PRIMASK(primask);
+	}
+}
+#else
+/*
+ * Function: SW入力チャタリング除去
+ * Argument: なし
+ * Return  : なし
+ * Note    : 5ms周期の割り込み処理
+ *           SW_INPUT_BUFFER_NUM回連続で同じ値を取得したら入力確定し、最初に変化を検出した時刻でイベントを追加する
+ */
+static void debounceSwInput(void)
+{
+	uint32_t time = GetTimeUs();
+	pin_level_t level;
+
+	for (uint32_t sw_id=0; sw_id<SW_NUM; sw_id++) {
+		/* SW端子の状態を取得*/
+		level = ReadPin(sw_info_table[sw_id].pin_id);
+
+		if (level != sw_level_last[sw_id]) {
+			/* 端子変化 */
+			sw_level_last[sw_id] = level;
+			sw_level_count[sw_id] = 1;
+			sw_edge_time[sw_id] = time;
+			if ((sw_id == LATENCY_SW_ID) && (level == sw_info_table[sw_id].active_level)) {
+				/* 端子変化の時刻ではなく、変化を検出したポーリングの時刻(最大5ms遅れ)を記録 */
+				RECORD_LATENCY_STAGE(LATENCY_STAGE_PIN_EDGE);
+			}
+		} else if (sw_level_count[sw_id] < SW_INPUT_BUFFER_NUM) {
+			sw_level_count[sw_id] ++;
+		} else {
+			/* 処理なし */
+		}
+
+		if ((sw_level_count[sw_id] == SW_INPUT_BUFFER_NUM) && (level != sw_level_stable[sw_id])) {
+			/* チャタリング除去確定 */
+			acceptSwLevel(sw_id, level, sw_edge_time[sw_id]);
+		}
+	}
+}
+#endif
+
+/*
+ * Function: SW入力確定
+ * Argument: SWインデックス、確定した端子レベル、変化時刻
+ * Return  : なし
+ * Note    : なし
+ */
+static void acceptSwLevel(uint32_t sw_id, pin_level_t level, uint32_t time)
+{
+	sw_level_stable[sw_id] = level;
+	if (level == sw_info_table[sw_id].active_level) {
+		changeInputLevel(sw_info_table[sw_id].input_id, TRUE, time);
+		if (sw_id == LATENCY_SW_ID) {
+			RECORD_LATENCY_STAGE(LATENCY_STAGE_DEBOUNCE);
+		}
+	} else {
+		changeInputLevel(sw_info_table[sw_id].input_id, FALSE, time);
+	}
+}
+
+/*
+ * Function: ジョイスティック入力ベクトル取得
+ * Argument: なし
+ * Return  : 入力ベクトル(各成分-STICK_VECTOR_MAX～STICK_VECTOR_MAX、右・下が正)
+ * Note    : キャリブレーション値で補正し、円形デッドゾーン内は0とする
+ */
+stick_vector_t GetStickVector(void)
+{
+	return calculateStickVector();
+}
+
+/*
+ * Function: ジョイスティックキャリブレーション開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : ジョイスティックを中心に置いた状態で開始し、FinishStickCalibrationまでに全方向へ倒す
+ */
+void StartStickCalibration(void)
+{
+	uint32_t ad_raw;
+
+	for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+		ad_raw = GetAdRaw(stick_axis_info_table[axis].ad_id);
+		stick_calib[axis].min = ad_raw;
+		stick_calib[axis].center = ad_raw;
+		stick_calib[axis].max = ad_raw;
+	}
+	stick_calibrating = TRUE;
+}
+
+/*
+ * Function: ジョイスティックキャリブレーション終了
+ * Argument: なし
+ * Return  : RESULT_OK:キャリブレーション値を保存、RESULT_NG:振れ幅不足のため破棄
+ * Note    : 保存した値は即座に入力判定へ反映する
+ *           EEPROMが書き込みを受け付けない場合(起動時の読み出し未完了)は、周期処理で受け付けられるまで再試行する
+ */
+result_t FinishStickCalibration(void)
+{
+	result_t result = RESULT_OK;
+
+	if (stick_calibrating == FALSE) {
+		result = RESULT_NG;
+	}
+
+	for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+		if (((stick_calib[axis].center - stick_calib[axis].min) < STICK_CALIB_RANGE_MIN)
+		 || ((stick_calib[axis].max - stick_calib[axis].center) < STICK_CALIB_RANGE_MIN)) {
+			result = RESULT_NG;
+		}
+	}
+
+	if (result == RESULT_OK) {
+		stick_calib_record.magic = STICK_CALIB_MAGIC;
+		for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+			stick_calib_record.axis[axis].min = stick_calib[axis].min;
+			stick_calib_record.axis[axis].center = stick_calib[axis].center;
+			stick_calib_record.axis[axis].max = stick_calib[axis].max;
+		}
+		/* 識別値とキャリブレーション値は同じページにあり、1回の書き込みで完了する */
+		if (WRITE_EEPROM_RECORD(STICK_CALIB, &stick_calib_record) == RESULT_OK) {
+			stick_calib_save_pending = FALSE;
+		} else {
+			stick_calib_save_pending = TRUE;
+		}
+		updateStickMap(stick_calib);
+	}
+
+	stick_calibrating = FALSE;
+
+	return result;
+}
+
+/*
+ * Function: ジョイスティックキャリブレーション値読み出し
+ * Argument: なし
+ * Return  : なし
+ * Note    : 未キャリブレーションまたは不正な値の場合はAD変換値の全範囲を使用する
+ *           起動時の全データ読み出しが未完了の場合は読み出しを待たずに全範囲を使用する(完了後に周期処理で再度読み出す)
+ */
+static void loadStickCalibration(void)
+{
+	stick_calib_t calib[STICK_AXIS_NUM];
+	eeprom_stick_calib_t record;
+	bool_t valid = FALSE;
+
+	if (IsEepromReady() == TRUE) {
+		stick_calib_loaded = TRUE;
+	} else {
+		/* 処理なし */
+	}
+
+	if ((stick_calib_loaded == TRUE)
+	 && (READ_EEPROM_RECORD(STICK_CALIB, &record) == RESULT_OK)
+	 && (record.magic == STICK_CALIB_MAGIC)) {
+		valid = TRUE;
+		for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+			calib[axis].min = record.axis[axis].min;
+			calib[axis].center = record.axis[axis].center;
+			calib[axis].max = record.axis[axis].max;
+			if ((calib[axis].max > AD_VALUE_MAX)
+			 || (calib[axis].center < calib[axis].min + STICK_CALIB_RANGE_MIN)
+			 || (calib[axis].max < calib[axis].center + STICK_CALIB_RANGE_MIN)) {
+				valid = FALSE;
+			}
+		}
+	}
+
+	if (valid == FALSE) {
+		for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+			calib[axis].min = 0;
+			calib[axis].center = AD_VALUE_MAX / 2;
+			calib[axis].max = AD_VALUE_MAX;
+		}
+	}
+
+	updateStickMap(calib);
+}
+
+/*
+ * Function: ジョイスティック変換更新
+ * Argument: キャリブレーション値
+ * Return  : なし
+ * Note    : 未使用の面に係数を計算してから面を切り替えるため、割り込み処理が更新途中の値を参照しない
+ */
+static void updateStickMap(const stick_calib_t calib[])
+{
+	uint32_t next_index = stick_map_index ^ 1;
+	stick_map_t* map;
+
+	for (stick_axis_t axis=0; axis<STICK_AXIS_NUM; axis++) {
+		map = &stick_map[next_index][axis];
+		map->center = calib[axis].center;
+		map->scale_negative = ((int32_t)STICK_VECTOR_MAX << STICK_SCALE_SHIFT) / (int32_t)(calib[axis].center - calib[axis].min);
+		map->scale_positive = ((int32_t)STICK_VECTOR_MAX << STICK_SCALE_SHIFT) / (int32_t)(calib[axis].max - calib[axis].center);
+	}
+
+	stick_map_index = next_index;
+}
+
+/*
+ * Function: ジョイスティック入力ベクトル計算
+ * Argument: なし
+ * Return  : 入力ベクトル
+ * Note    : 割り込み処理、周期処理の両方から呼び出される
+ */
+static stick_vector_t calculateStickVector(void)
+{
+	const stick_map_t* map = stick_map[stick_map_index];
+	stick_vector_t vector;
+	int32_t length;
+	int32_t scaled_length;
+
+	vector.x = mapStickAxis(&map[STICK_AXIS_H], GetAdRaw(AD_ID_POS_H));
+	vector.y = mapStickAxis(&map[STICK_AXIS_V], GetAdRaw(AD_ID_POS_V));
+
+	length = sqrtInteger(vector.x * vector.x + vector.y * vector.y);
+	if (length <= STICK_DEADZONE) {
+		/* デッドゾーン内 */
+		vector.x = 0;
+		vector.y = 0;
+	} else {
+		/* デッドゾーン外周を0、STICK_VECTOR_MAXを最大とする長さに変換 */
+		if (length < STICK_VECTOR_MAX) {
+			scaled_length = (length - STICK_DEADZONE) * STICK_VECTOR_MAX / (STICK_VECTOR_MAX - STICK_DEADZONE);
+		} else {
+			scaled_length = STICK_VECTOR_MAX;
+		}
+		vector.x = vector.x * scaled_length / length;
+		vector.y = vector.y * scaled_length / length;
+	}
+
+	return vector;
+}
+
+/*
+ * Function: ジョイスティック軸変換
+ * Argument: 軸の変換係数、AD変換値
+ * Return  : ベクトル成分(-STICK_VECTOR_MAX～STICK_VECTOR_MAX)
+ * Note    : なし
+ */
+static int32_t mapStickAxis(const stick_map_t* map, uint32_t ad_raw)
+{
+	int32_t diff = (int32_t)ad_raw - map->center;
+	int32_t value;
+
+	if (diff >= 0) {
+		value = (diff * map->scale_positive) >> STICK_SCALE_SHIFT;
+		if (value > STICK_VECTOR_MAX) {
+			value = STICK_VECTOR_MAX;
+		}
+	} else {
+		value = -((-diff * map->scale_negative) >> STICK_SCALE_SHIFT);
+		if (value < -STICK_VECTOR_MAX) {
+			value = -STICK_VECTOR_MAX;
+		}
+	}
+
+	return value;
+}
+
+/*
+ * Function: 整数平方根
+ * Argument: 値
+ * Return  : 平方根(切り捨て)
+ * Note    : なし
+ */
+static uint32_t sqrtInteger(uint32_t value)
+{
+	uint32_t result = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (value >= result + bit) {
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		} else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return result;
+}
+
+/*
+ * Function: AD変換完了コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : 割り込み処理
+ */
+static void callbackAdComplete(void)
+{
+	uint32_t time = GetTimeUs();
+
+	judgePosInputState(time);
+	judgeLeverInputState(time);
+}
+
+/*
+ * Function: ジョイスティック入力状態判定
+ * Argument: AD変換完了時刻
+ * Return  : なし
+ * Note    : なし
+ */
+static void judgePosInputState(uint32_t time)
+{
+	stick_vector_t vector = calculateStickVector();
+
+	/* ジョイスティック横方向判定 */
+	if (vector.x > POS_THRESHOLD_ON) {
+		changeInputLevel(INPUT_ID_POS_LEFT, FALSE, time);
+		changeInputLevel(INPUT_ID_POS_RIGHT, TRUE, time);
+	} else if (vector.x < -POS_THRESHOLD_ON) {
+		changeInputLevel(INPUT_ID_POS_LEFT, TRUE, time);
+		changeInputLevel(INPUT_ID_POS_RIGHT, FALSE, time);
+	} else if ((vector.x < POS_THRESHOLD_OFF) && (vector.x > -POS_THRESHOLD_OFF)) {
+		changeInputLevel(INPUT_ID_POS_LEFT, FALSE, time);
+		changeInputLevel(INPUT_ID_POS_RIGHT, FALSE, time);
+	} else {
+		/* 途中位置は前回値保持 */
+	}
+	
+	/* ジョイスティック縦方向判定 */
+	if (vector.y > POS_THRESHOLD_ON) {
+		changeInputLevel(INPUT_ID_POS_UP, FALSE, time);
+		changeInputLevel(INPUT_ID_POS_DOWN, TRUE, time);
+	} else if (vector.y < -POS_THRESHOLD_ON) {
+		changeInputLevel(INPUT_ID_POS_UP, TRUE, time);
+		changeInputLevel(INPUT_ID_POS_DOWN, FALSE, time);
+	} else if ((vector.y < POS_THRESHOLD_OFF) && (vector.y > -POS_THRESHOLD_OFF)) {
+		changeInputLevel(INPUT_ID_POS_UP, FALSE, time);
+		changeInputLevel(INPUT_ID_POS_DOWN, FALSE, time);
+	} else {
+		/* 途中位置は前回値保持 */
+	}
+}
+
+/*
+ * Function: レバー入力状態判定
+ * Argument: AD変換完了時刻
+ * Return  : なし
+ * Note    : なし
+ */
+static void judgeLeverInputState(uint32_t time)
+{
+	float ad_value = GetAd(AD_ID_LEVER);
+
+	/* レバー位置判定 */
+	if (ad_value < 0.15f) {
+		changeInputLevel(INPUT_ID_LEVER_SW, TRUE, time);
+		changeInputLevel(INPUT_ID_LEVER_LEFT, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_RIGHT, FALSE, time);
+	} else if ((ad_value > 0.2f) && (ad_value < 0.5f)) {
+		changeInputLevel(INPUT_ID_LEVER_SW, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_LEFT, TRUE, time);
+		changeInputLevel(INPUT_ID_LEVER_RIGHT, FALSE, time);
+	} else if ((ad_value > 0.5f) && (ad_value < 0.7f)) {
+		changeInputLevel(INPUT_ID_LEVER_SW, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_LEFT, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_RIGHT, TRUE, time);
+	} else {
+		changeInputLevel(INPUT_ID_LEVER_SW, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_LEFT, FALSE, time);
+		changeInputLevel(INPUT_ID_LEVER_RIGHT, FALSE, time);
+	}
+}
+
+/*
+ * Function: 入力レベル変更
+ * Argument: 入力ID、入力レベル(TRUE:入力あり)、変化時刻
+ * Return  : なし
+ * Note    : 入力レベルが変化した場合のみイベントを追加する
+ *           優先度の異なる割り込み処理から呼び出すため、レベルの判定とイベント追加は割り込み禁止で行う
+ */
+static void changeInputLevel(input_id_t input_id, bool_t level, uint32_t time)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (input_level[input_id] != level) {
+		input_level[input_id] = level;
+		if (level == TRUE) {
+			pushInputEvent(input_id, INPUT_EVENT_PUSH, time);
+		} else {
+			pushInputEvent(input_id, INPUT_EVENT_RELEASE, time);
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Function: 入力イベント追加
+ * Argument: 入力ID、イベント種別、発生時刻
+ * Return  : なし
+ * Note    : 書き込みは割り込み処理(5ms周期、AD変換完了、EXTI割り込み方式ではSWエッジのEXTIも)から行う
+ *           EXTIは5ms周期、AD変換完了の割り込みと優先度が異なり割り込み処理中に割り込むため、書き込み位置の確保から
+ *           インデックス更新までを割り込み禁止で行う(読み出しはメインループのみのため、読み出し側の排他制御は不要)
+ *           キューが満杯の場合は追加しない
+ */
+static void pushInputEvent(input_id_t input_id, input_event_type_t type, uint32_t time)
+{
+	uint32_t input_event_queue_index_next;
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (input_event_queue_index_top < INPUT_EVENT_QUEUE_SIZE - 1) {
+		input_event_queue_index_next = input_event_queue_index_top + 1;
+	} else {
+		input_event_queue_index_next = 0;
+	}
+
+	if (input_event_queue_index_next != input_event_queue_index_end) {
+		input_event_queue[input_event_queue_index_top].input_id = input_id;
+		input_event_queue[input_event_queue_index_top].type = type;
+		input_event_queue[input_event_queue_index_top].time = time;
+		/* データ書き込み後にインデックスを更新 */
+		input_event_queue_index_top = input_event_queue_index_next;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Function: 入力状態更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 周期間に押して離された入力は、今周期INPUT_PUSH、次周期INPUT_RELEASEとする
+ *           押下/解放の保留は1周期のINPUT_PUSH/INPUT_RELEASEを出力するためにのみ使用し、
+ *           最終的な状態は最後のイベントの入力レベルに合わせる(周期間に押下、解放、押下の場合はINPUT_ONに至る)
+ */
+static void updateInputState(void)
+{
+	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+		switch (input_state[input_id]) {
+		case INPUT_OFF:				/* INPUT_OFFとINPUT_RELEASEは同じ処理 */
+		case INPUT_RELEASE:
+			if ((input_push_pending[input_id] == TRUE) || (input_event_level[input_id] == TRUE)) {
+				input_push_pending[input_id] = FALSE;
+				input_state[input_id] = INPUT_PUSH;
+				if (input_id == sw_info_table[LATENCY_SW_ID].input_id) {
+					RECORD_LATENCY_STAGE(LATENCY_STAGE_STATE_UPDATE);
+				}
+			} else {
+				input_release_pending[input_id] = FALSE;
+				input_state[input_id] = INPUT_OFF;
+			}
+			break;
+		case INPUT_ON:				/* INPUT_ONとINPUT_PUSHは同じ処理 */
+		case INPUT_PUSH:
+			if ((input_release_pending[input_id] == TRUE) || (input_event_level[input_id] == FALSE)) {
+				input_release_pending[input_id] = FALSE;
+				input_state[input_id] = INPUT_RELEASE;
+			} else {
+				input_push_pending[input_id] = FALSE;
+				input_state[input_id] = INPUT_ON;
+			}
+			break;
+		default:
+			input_state[input_id] = INPUT_OFF;
+			break;
+		}
+	}
+}
@@ -1,55 +1,89 @@
-/*
- * drv_controller.h
- *
- *  Created on: Jul 8, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_CONTROLLER_H_
-#define DRV_CONTROLLER_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	INPUT_ID_SW_A = 0,
-	INPUT_ID_SW_B,
-	INPUT_ID_SW_C,
-	INPUT_ID_SW_D,
-	INPUT_ID_POS_UP,
-	INPUT_ID_POS_DOWN,
-	INPUT_ID_POS_LEFT,
-	INPUT_ID_POS_RIGHT,
-	INPUT_ID_LEVER_SW,
-	INPUT_ID_LEVER_LEFT,
-	INPUT_ID_LEVER_RIGHT,
-	INPUT_ID_NUM
-} input_id_t;
-
-typedef enum {
-	INPUT_OFF = 0,
-	INPUT_PUSH,
-	INPUT_ON,
-	INPUT_RELEASE
-} input_state_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitController(void);
-void MainController(void);
-void UpdateSwInput(void);
-input_state_t GetInputState(input_id_t input_id);
-
-#endif /* DRV_CONTROLLER_H_ */
+/*
+ * drv_controller.h
+ *
+ *  Created on: Jul 8, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_CONTROLLER_H_
+#define DRV_CONTROLLER_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* SW入力をEXTI割り込みで検出(0:5ms周期ポーリング、1:EXTI割り込み) */
+#ifndef SW_INPUT_EXTI_ENABLE
+#define SW_INPUT_EXTI_ENABLE	(0)
+#endif
+
+/* ジョイスティック入力ベクトルの最大長 */
+#define STICK_VECTOR_MAX		(1024)
+
+/********** Enum **********/
+
+typedef enum {
+	INPUT_ID_SW_A = 0,
+	INPUT_ID_SW_B,
+	INPUT_ID_SW_C,
+	INPUT_ID_SW_D,
+	INPUT_ID_POS_UP,
+	INPUT_ID_POS_DOWN,
+	INPUT_ID_POS_LEFT,
+	INPUT_ID_POS_RIGHT,
+	INPUT_ID_LEVER_SW,
+	INPUT_ID_LEVER_LEFT,
+	INPUT_ID_LEVER_RIGHT,
+	INPUT_ID_NUM
+} input_id_t;
+
+typedef enum {
+	INPUT_OFF = 0,
+	INPUT_PUSH,
+	INPUT_ON,
+	INPUT_RELEASE
+} input_state_t;
+
+typedef enum {
+	INPUT_EVENT_PUSH = 0,
+	INPUT_EVENT_RELEASE
+} input_event_type_t;
+
+/********** Type **********/
+
+/* 入力イベント */
+typedef struct {
+	input_id_t input_id;		/* 入力ID */
+	input_event_type_t type;	/* イベント種別 */
+	uint32_t time;				/* 発生時刻 [us] */
+} input_event_t;
+
+/* ジョイスティック入力ベクトル */
+typedef struct {
+	int32_t x;		/* 横方向(右が正) */
+	int32_t y;		/* 縦方向(下が正) */
+} stick_vector_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitController(void);
+void MainController(void);
+void UpdateSwInput(void);
+input_state_t GetInputState(input_id_t input_id);
+void SetInputInject(bool_t enable);
+void InjectInputState(input_id_t input_id, input_state_t state);
+void InjectInputEvent(input_id_t input_id, input_event_type_t type);
+uint32_t GetInputEventNum(void);
+input_event_t GetInputEvent(uint32_t index);
+stick_vector_t GetStickVector(void);
+void StartStickCalibration(void);
+result_t FinishStickCalibration(void);
+
+#endif /* DRV_CONTROLLER_H_ */
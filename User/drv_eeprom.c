@@ -1,377 +1,598 @@
-/*
- * drv_eeprom.c
- *
- *  Created on: Jul 18, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_dio.h"
-#include "mcal_spi.h"
-#include "drv_eeprom.h"
-
-/********** Define **********/
-
-#define SPI_EEPROM			(SPI_CH3)
-
-#define PIN_CS_OFF			(PIN_LEVEL_HIGH)
-#define PIN_CS_ON			(PIN_LEVEL_LOW)
-
-/* EEPROM(25LC080C)の容量 [byte] */
-#define EEPROM_SIZE			(1024)
-
-/* EEPROM(25LC080C)の命令 */
-#define INSTRUCTION_READ	(0x03)	/* Read data from memory array beginning at selected address */
-#define INSTRUCTION_WRITE	(0x02)	/* Write data to memory array beginning at selected address */
-#define INSTRUCTION_WRDI	(0x04)	/* Reset the write enable latch (disable write operations) */
-#define INSTRUCTION_WREN	(0x06)	/* Set the write enable latch (enable write operations) */
-#define INSTRUCTION_RDSR	(0x05)	/* Read STATUS register */
-#define INSTRUCTION_WRSR	(0x01)	/* Write STATUS register */
-
-/* 通信バッファサイズ [byte] */
-#define BUFFER_SIZE			(7)		/* 通常通信最大データ長 命令(1byte) + アドレス(2byte) + 書き込みデータ(4byte) */
-
-/* EEPROM書き込みジョブキューサイズ */
-#define EEPROM_WRITE_JOB_QUEUE_SIZE	(16)
-
-/********** Enum **********/
-
-typedef enum {
-	EEPROM_STATE_IDLE = 0,
-	EEPROM_STATE_WRITE_ENABLE,
-	EEPROM_STATE_WRITE,
-	EEPROM_STATE_READ_STATUS,
-	EEPROM_STATE_WAIT_WRITING
-} eeprom_state_t;
-
-typedef enum {
-	COM_STATE_IDLE = 0,
-	COM_STATE_BUSY
-} com_state_t;
-
-/********** Type **********/
-
-typedef struct {
-	uint16_t address;
-	uint8_t size;
-} eeprom_write_job_t;
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-extern SPI_HandleTypeDef hspi3;
-
-static uint8_t eeprom_buffer[EEPROM_SIZE];
-static uint8_t send_buffer[BUFFER_SIZE];
-static uint8_t receive_buffer[BUFFER_SIZE];
-
-static eeprom_state_t eeprom_state;
-static com_state_t com_state;
-
-static eeprom_write_job_t eeprom_write_job_queue[EEPROM_WRITE_JOB_QUEUE_SIZE];
-static uint32_t eeprom_write_job_queue_index_top;
-static uint32_t eeprom_write_job_queue_index_end;
-
-/********** Function Prototype **********/
-
-static void waitComComplete(void);
-static void callbackComComplete(void);
-static void addWriteJob(uint16_t address, uint8_t size);
-static void eepromWriteEnable(void);
-static void callbackEepromWriteEnable(void);
-static void eepromWrite(void);
-static void callbackEepromWrite(void);
-static void eepromReadStatus(void);
-static void callbackEepromReadStatus(void);
-
-/********** Function **********/
-
-/*
- * Function: DRV EEPROM 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitEeprom(void)
-{
-	/* 変数初期化 */
-	eeprom_state = EEPROM_STATE_IDLE;
-	com_state = COM_STATE_IDLE;
-	eeprom_write_job_queue_index_top = 0;
-	eeprom_write_job_queue_index_end = 0;
-
-	/* 初回通信確立のためダミーのステータス読み出し */
-	send_buffer[0] = INSTRUCTION_RDSR;
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
-	com_state = COM_STATE_BUSY;
-	SendReceiveSpi(SPI_EEPROM, send_buffer, receive_buffer, 2, callbackComComplete);
-	waitComComplete();
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
-
-	/* EEPROMから全データを読み出す */
-	send_buffer[0] = INSTRUCTION_READ;
-	send_buffer[1] = 0x00;
-	send_buffer[2] = 0x00;
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
-	com_state = COM_STATE_BUSY;
-	SendSpi(SPI_EEPROM, send_buffer, 3, callbackComComplete);
-	waitComComplete();
-	/* 通信を継続するのでCSピンは落とさない */
-	com_state = COM_STATE_BUSY;
-	ReceiveSpi(SPI_EEPROM, eeprom_buffer, EEPROM_SIZE, callbackComComplete);
-	waitComComplete();
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
-}
-
-/*
- * Function: DRV EEPROM 周期処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void MainEeprom(void)
-{
-	/* 書き込み中のジョブが無く、新しい書き込みジョブがある場合は書き込み実行 */
-	if ((eeprom_state == EEPROM_STATE_IDLE)
-	 && (eeprom_write_job_queue_index_top != eeprom_write_job_queue_index_end)) {
-		eepromWriteEnable();
-	}
-
-	/* 書き込み完了待ちの場合は再度ステータス読み出し実行 */
-	if (eeprom_state == EEPROM_STATE_WAIT_WRITING) {
-		eepromReadStatus();
-	}
-}
-
-/*
- * Function: EEPROMデータ1byte読み出し
- * Argument: EEPROMデータID
- * Return  : 読み出しデータ
- * Note    : なし
- */
-uint8_t ReadEeprom1byte(eeprom_data_id_t eeprom_data_id)
-{
-	return eeprom_buffer[eeprom_data_id];
-}
-
-/*
- * Function: EEPROMデータ2byte読み出し
- * Argument: EEPROMデータID
- * Return  : 読み出しデータ
- * Note    : なし
- */
-uint16_t ReadEeprom2byte(eeprom_data_id_t eeprom_data_id)
-{
-	return (((uint16_t)eeprom_buffer[eeprom_data_id + 0] << 8) +
-			((uint16_t)eeprom_buffer[eeprom_data_id + 1] << 0));
-}
-
-/*
- * Function: EEPROMデータ4byte読み出し
- * Argument: EEPROMデータID
- * Return  : 読み出しデータ
- * Note    : なし
- */
-uint32_t ReadEeprom4byte(eeprom_data_id_t eeprom_data_id)
-{
-	return (((uint32_t)eeprom_buffer[eeprom_data_id + 0] << 24) +
-			((uint32_t)eeprom_buffer[eeprom_data_id + 1] << 16) +
-			((uint32_t)eeprom_buffer[eeprom_data_id + 2] <<  8) +
-			((uint32_t)eeprom_buffer[eeprom_data_id + 3] <<  0));
-}
-
-/*
- * Function: EEPROMデータ1byte書き込み
- * Argument: EEPROMデータID、書き込みデータ
- * Return  : なし
- * Note    : なし
- */
-void WriteEeprom1byte(eeprom_data_id_t eeprom_data_id, uint8_t write_data)
-{
-	eeprom_buffer[eeprom_data_id] = write_data;
-
-	addWriteJob(eeprom_data_id, 1);
-}
-
-/*
- * Function: EEPROMデータ2byte書き込み
- * Argument: EEPROMデータID、書き込みデータ
- * Return  : なし
- * Note    : なし
- */
-void WriteEeprom2byte(eeprom_data_id_t eeprom_data_id, uint16_t write_data)
-{
-	eeprom_buffer[eeprom_data_id + 0] = (write_data & 0xFF00) >> 8;
-	eeprom_buffer[eeprom_data_id + 1] = (write_data & 0x00FF) >> 0;
-
-	addWriteJob(eeprom_data_id, 2);
-}
-
-/*
- * Function: EEPROMデータ4byte書き込み
- * Argument: EEPROMデータID、書き込みデータ
- * Return  : なし
- * Note    : なし
- */
-void WriteEeprom4byte(eeprom_data_id_t eeprom_data_id, uint32_t write_data)
-{
-	eeprom_buffer[eeprom_data_id + 0] = (write_data & 0xFF000000) >> 24;
-	eeprom_buffer[eeprom_data_id + 1] = (write_data & 0x00FF0000) >> 16;
-	eeprom_buffer[eeprom_data_id + 2] = (write_data & 0x0000FF00) >>  8;
-	eeprom_buffer[eeprom_data_id + 3] = (write_data & 0x000000FF) >>  0;
-
-	addWriteJob(eeprom_data_id, 4);
-}
-
-/*
- * Function: 通信完了待ち
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void waitComComplete(void)
-{
-	while(com_state == COM_STATE_BUSY) {
-		/* 通信完了待ち */
-	}
-}
-
-/*
- * Function: 通信完了コールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackComComplete(void)
-{
-	/* 通信完了 */
-	com_state = COM_STATE_IDLE;
-}
-
-/*
- * Function: EEPROM書き込みジョブ追加
- * Argument: 書き込みアドレス、書き込みサイズ
- * Return  : なし
- * Note    : なし
- */
-static void addWriteJob(uint16_t address, uint8_t size)
-{
-	eeprom_write_job_queue[eeprom_write_job_queue_index_top].address = address;
-	eeprom_write_job_queue[eeprom_write_job_queue_index_top].size = size;
-
-	if (eeprom_write_job_queue_index_top < EEPROM_WRITE_JOB_QUEUE_SIZE - 1) {
-		eeprom_write_job_queue_index_top ++;
-	} else {
-		eeprom_write_job_queue_index_top = 0;
-	}
-}
-
-/*
- * Function: EEPROM書き込み許可送信
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void eepromWriteEnable(void)
-{
-	eeprom_state = EEPROM_STATE_WRITE_ENABLE;
-
-	/* 書き込み許可を送信 */
-	send_buffer[0] = INSTRUCTION_WREN;
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
-	SendSpi(SPI_EEPROM, send_buffer, 1, callbackEepromWriteEnable);
-}
-
-/*
- * Function: EEPROM書き込み許可送信コールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackEepromWriteEnable(void)
-{
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
-
-	/* 書き込み許可が完了したので、書き込みを実行 */
-	eepromWrite();
-}
-
-/*
- * Function: EEPROM書き込み送信
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void eepromWrite(void)
-{
-	eeprom_state = EEPROM_STATE_WRITE;
-
-	/* 書き込みデータを送信 */
-	send_buffer[0] = INSTRUCTION_WRITE;
-	send_buffer[1] = (eeprom_write_job_queue[eeprom_write_job_queue_index_end].address & 0xFF00) >> 8;
-	send_buffer[2] = (eeprom_write_job_queue[eeprom_write_job_queue_index_end].address & 0x00FF) >> 0;
-	for (uint8_t index=0; index<eeprom_write_job_queue[eeprom_write_job_queue_index_end].size; index++) {
-		send_buffer[3 + index] = eeprom_buffer[eeprom_write_job_queue[eeprom_write_job_queue_index_end].address + index];
-	}
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
-	SendSpi(SPI_EEPROM, send_buffer, 3 + eeprom_write_job_queue[eeprom_write_job_queue_index_end].size, callbackEepromWrite);
-}
-
-/*
- * Function: EEPROM書き込み送信コールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackEepromWrite(void)
-{
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
-
-	/* 書き込みデータを送信したので、次の周期処理でステータスを確認 */
-	eeprom_state = EEPROM_STATE_WAIT_WRITING;
-}
-
-/*
- * Function: EEPROMステータス読み出し
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void eepromReadStatus(void)
-{
-	eeprom_state = EEPROM_STATE_READ_STATUS;
-
-	/* ステータス読み出し */
-	send_buffer[0] = INSTRUCTION_READ;
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
-	SendReceiveSpi(SPI_EEPROM, send_buffer, receive_buffer, 2, callbackEepromReadStatus);
-}
-
-/*
- * Function: EEPROMステータス読み出しコールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackEepromReadStatus(void)
-{
-	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
-
-	/* Write-In-Process (WIP) bitを確認 */
-	if ((receive_buffer[1] & 0x01) != 1) {
-		/* 書き込み完了 */
-		eeprom_state = EEPROM_STATE_IDLE;
-		if (eeprom_write_job_queue_index_end < EEPROM_WRITE_JOB_QUEUE_SIZE - 1) {
-			eeprom_write_job_queue_index_end ++;
-		} else {
-			eeprom_write_job_queue_index_end = 0;
-		}
-	} else {
-		/* 書き込み処理中 */
-		eeprom_state = EEPROM_STATE_WAIT_WRITING;
-	}
-}
+/*
+ * drv_eeprom.c
+ *
+ *  Created on: Jul 18, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include <stddef.h>
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "drv_eeprom.h"
+
+/********** Define **********/
+
+#define SPI_EEPROM			(SPI_CH3)
+
+#define PIN_CS_OFF			(PIN_LEVEL_HIGH)
+#define PIN_CS_ON			(PIN_LEVEL_LOW)
+
+/* EEPROM(25LC080C)の命令 */
+#define INSTRUCTION_READ	(0x03)	/* Read data from memory array beginning at selected address */
+#define INSTRUCTION_WRITE	(0x02)	/* Write data to memory array beginning at selected address */
+#define INSTRUCTION_WRDI	(0x04)	/* Reset the write enable latch (disable write operations) */
+#define INSTRUCTION_WREN	(0x06)	/* Set the write enable latch (enable write operations) */
+#define INSTRUCTION_RDSR	(0x05)	/* Read STATUS register */
+#define INSTRUCTION_WRSR	(0x01)	/* Write STATUS register */
+
+/* 通信バッファサイズ [byte] */
+#define BUFFER_SIZE			(3 + EEPROM_PAGE_SIZE)	/* 通常通信最大データ長 命令(1byte) + アドレス(2byte) + 書き込みデータ(1ページ) */
+
+/* 書き込み開始からステータス確認までの時間 [us] (書き込み時間 最大5ms) */
+#define EEPROM_WRITE_POLL_FIRST		(2000)
+/* 書き込み処理中の場合のステータス再確認間隔 [us] */
+#define EEPROM_WRITE_POLL_INTERVAL	(500)
+
+/* 起動時の全データ読み出し完了待ちの上限 [us] */
+#define EEPROM_LOAD_TIMEOUT			(10000)
+
+/* EEPROMのページ数 */
+#define EEPROM_PAGE_NUM		(EEPROM_SIZE / EEPROM_PAGE_SIZE)
+
+/* 書き込み待ちビットマップのワード数(1bitが1byteに対応) */
+#define DIRTY_BITMAP_WORD_NUM	(EEPROM_SIZE / 32)
+
+/* レイアウト定義の展開用 */
+#define EEPROM_LAYOUT_INFO_RECORD(id, type)		{offsetof(eeprom_layout_t, id), sizeof(type)},
+#define EEPROM_LAYOUT_INFO_AREA(id, size)		{offsetof(eeprom_layout_t, id), (size)},
+#define EEPROM_LAYOUT_SIZE_RECORD(id, type)		+ sizeof(type)
+#define EEPROM_LAYOUT_SIZE_AREA(id, size)		+ (size)
+#define EEPROM_LAYOUT_ASSERT_RECORD(id, type)																\
+	_Static_assert((offsetof(eeprom_layout_t, id) % _Alignof(type)) == 0,									\
+				   "EEPROM record " #id " is not aligned");												\
+	_Static_assert(((offsetof(eeprom_layout_t, id) % EEPROM_PAGE_SIZE) + sizeof(type)) <= EEPROM_PAGE_SIZE,	\
+				   "EEPROM record " #id " crosses a page boundary");
+#define EEPROM_LAYOUT_ASSERT_AREA(id, size)
+
+/********** Enum **********/
+
+typedef enum {
+	EEPROM_STATE_IDLE = 0,
+	EEPROM_STATE_LOAD,
+	EEPROM_STATE_WRITE_ENABLE,
+	EEPROM_STATE_WRITE,
+	EEPROM_STATE_READ_STATUS,
+	EEPROM_STATE_WAIT_WRITING
+} eeprom_state_t;
+
+/********** Type **********/
+
+
+/* EEPROMデータ配置 */
+typedef struct {
+	uint16_t address;
+	uint16_t size;
+} eeprom_data_info_t;
+
+/********** Constant **********/
+
+/* レイアウト定義の検査(隙間なく配置され、EEPROM容量と一致すること、型付きデータの整列とページ境界) */
+_Static_assert(sizeof(eeprom_layout_t) == EEPROM_SIZE, "EEPROM layout size must match the device size");
+_Static_assert(sizeof(eeprom_layout_t) == (0 EEPROM_LAYOUT(EEPROM_LAYOUT_SIZE_RECORD, EEPROM_LAYOUT_SIZE_AREA)),
+			   "EEPROM layout has padding between entries");
+EEPROM_LAYOUT(EEPROM_LAYOUT_ASSERT_RECORD, EEPROM_LAYOUT_ASSERT_AREA)
+
+static const eeprom_data_info_t eeprom_data_info_table[EEPROM_DATA_ID_NUM] = {
+	EEPROM_LAYOUT(EEPROM_LAYOUT_INFO_RECORD, EEPROM_LAYOUT_INFO_AREA)
+};
+
+/********** Variable **********/
+
+extern SPI_HandleTypeDef hspi3;
+
+static uint8_t eeprom_buffer[EEPROM_SIZE];
+static uint8_t send_buffer[BUFFER_SIZE];
+static uint8_t receive_buffer[BUFFER_SIZE];
+
+/* 書き込み完了確認(アラーム、SPI完了の割り込み処理)で更新し、周期処理とFlushEepromで参照するためvolatile */
+static volatile eeprom_state_t eeprom_state;
+static volatile bool_t eeprom_ready;
+
+/* RAMミラーのうちEEPROMへ未書き込みのbyte */
+static uint32_t dirty_bitmap[DIRTY_BITMAP_WORD_NUM];
+/* 次に書き込み待ちを探索するページ */
+static uint32_t flush_page;
+
+/* 書き込み中の範囲 */
+static uint16_t write_address;
+static uint8_t write_size;
+
+/********** Function Prototype **********/
+
+static result_t waitLoadComplete(void);
+static void callbackLoadStatus(void);
+static void callbackLoadCommand(void);
+static void callbackLoadData(void);
+static void markDirty(uint16_t address, uint16_t size);
+static bool_t existDirty(void);
+static bool_t prepareWritePage(void);
+static void eepromWriteEnable(void);
+static void callbackEepromWriteEnable(void);
+static void eepromWrite(void);
+static void callbackEepromWrite(void);
+static void callbackAlarmWriting(void);
+static void eepromReadStatus(void);
+static void callbackEepromReadStatus(void);
+
+/********** Function **********/
+
+/*
+ * Function: DRV EEPROM 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 全データの読み出しを開始して戻る、読み出し完了までの読み出し/書き込みは完了を待つ
+ */
+void InitEeprom(void)
+{
+	/* 変数初期化 */
+	eeprom_state = EEPROM_STATE_LOAD;
+	eeprom_ready = FALSE;
+	for (uint32_t index=0; index<DIRTY_BITMAP_WORD_NUM; index++) {
+		dirty_bitmap[index] = 0;
+	}
+	flush_page = 0;
+	write_address = 0;
+	write_size = 0;
+
+	/* 初回通信確立のためダミーのステータス読み出し、以降は完了割り込みで全データ読み出しまで進める */
+	send_buffer[0] = INSTRUCTION_RDSR;
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
+	SendReceiveSpi(SPI_EEPROM, send_buffer, receive_buffer, 2, callbackLoadStatus);
+}
+
+/*
+ * Function: EEPROM読み出し完了確認
+ * Argument: なし
+ * Return  : TRUE:全データ読み出し完了、FALSE:読み出し中
+ * Note    : なし
+ */
+bool_t IsEepromReady(void)
+{
+	return eeprom_ready;
+}
+
+/*
+ * Function: DRV EEPROM 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void MainEeprom(void)
+{
+	/* 書き込み中でなく、書き込み待ちのページがある場合は書き込み実行 */
+	/* 書き込み完了の確認と次のページの書き込みは、書き込み中に割り込み処理内で連続して実行する */
+	if (eeprom_state == EEPROM_STATE_IDLE) {
+		if (prepareWritePage() == TRUE) {
+			eepromWriteEnable();
+		} else {
+			/* 処理なし */
+		}
+	}
+}
+
+/*
+ * Function: EEPROM書き込み待ちデータの書き出し
+ * Argument: タイムアウト時間 [us]
+ * Return  : RESULT_OK:全データ書き込み完了、RESULT_NG:タイムアウト
+ * Note    : 電源断前などに使用、完了するまで周期処理を繰り返し実行する
+ */
+result_t FlushEeprom(uint32_t timeout_us)
+{
+	uint32_t start_time;
+	result_t result;
+
+	start_time = GetTimeUs();
+	while (((eeprom_state != EEPROM_STATE_IDLE) || (existDirty() == TRUE))
+		&& ((GetTimeUs() - start_time) < timeout_us)) {
+		MainEeprom();
+	}
+
+	if ((eeprom_state == EEPROM_STATE_IDLE) && (existDirty() == FALSE)) {
+		result = RESULT_OK;
+	} else {
+		result = RESULT_NG;
+	}
+
+	return result;
+}
+
+/*
+ * Function: EEPROMデータ読み出し
+ * Argument: EEPROMデータID、読み出しデータ格納先(レイアウト定義のサイズ分)
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:起動時の全データ読み出しが未完了
+ * Note    : 型付きデータはREAD_EEPROM_RECORDで読み出すこと
+ */
+result_t ReadEepromData(eeprom_data_id_t eeprom_data_id, void* read_data)
+{
+	return ReadEepromArea(eeprom_data_id, 0, (uint8_t*)read_data, eeprom_data_info_table[eeprom_data_id].size);
+}
+
+/*
+ * Function: EEPROMデータ書き込み
+ * Argument: EEPROMデータID、書き込みデータ(レイアウト定義のサイズ分)
+ * Return  : RESULT_OK:書き込み受付、RESULT_NG:起動時の全データ読み出しが未完了
+ * Note    : 型付きデータはWRITE_EEPROM_RECORDで書き込むこと、ページ内のデータは1回の書き込みで完了する
+ */
+result_t WriteEepromData(eeprom_data_id_t eeprom_data_id, const void* write_data)
+{
+	return WriteEepromArea(eeprom_data_id, 0, (const uint8_t*)write_data, eeprom_data_info_table[eeprom_data_id].size);
+}
+
+/*
+ * Function: EEPROM領域の部分読み出し
+ * Argument: EEPROMデータID、データ内のオフセット、読み出しデータ格納先、読み出しサイズ
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:範囲外または起動時の全データ読み出しが未完了
+ * Note    : 起動時の全データ読み出し中は完了を待つ(上限EEPROM_LOAD_TIMEOUT)
+ */
+result_t ReadEepromArea(eeprom_data_id_t eeprom_data_id, uint16_t offset, uint8_t* read_data, uint16_t size)
+{
+	uint16_t address = eeprom_data_info_table[eeprom_data_id].address + offset;
+	result_t result = RESULT_NG;
+
+	if ((offset + size <= eeprom_data_info_table[eeprom_data_id].size)
+	 && (waitLoadComplete() == RESULT_OK)) {
+		for (uint16_t index=0; index<size; index++) {
+			read_data[index] = eeprom_buffer[address + index];
+		}
+		result = RESULT_OK;
+	}
+
+	return result;
+}
+
+/*
+ * Function: EEPROM領域の部分書き込み
+ * Argument: EEPROMデータID、データ内のオフセット、書き込みデータ、書き込みサイズ
+ * Return  : RESULT_OK:書き込み受付、RESULT_NG:範囲外または起動時の全データ読み出しが未完了
+ * Note    : 起動時の全データ読み出し中は完了を待つ(読み出しデータで上書きされないよう)
+ */
+result_t WriteEepromArea(eeprom_data_id_t eeprom_data_id, uint16_t offset, const uint8_t* write_data, uint16_t size)
+{
+	uint16_t address = eeprom_data_info_table[eeprom_data_id].address + offset;
+	result_t result = RESULT_NG;
+
+	if ((offset + size <= eeprom_data_info_table[eeprom_data_id].size)
+	 && (waitLoadComplete() == RESULT_OK)) {
+		for (uint16_t index=0; index<size; index++) {
+			eeprom_buffer[address + index] = write_data[index];
+		}
+		markDirty(address, size);
+		result = RESULT_OK;
+	}
+
+	return result;
+}
+
+/*
+ * Function: EEPROMへの書き込み完了確認
+ * Argument: EEPROMデータID、データ内のオフセット、確認サイズ
+ * Return  : TRUE:範囲内の全データ書き込み完了、FALSE:書き込み待ちまたは書き込み中
+ * Note    : 書き込み順序を保証したい場合に、先のデータの書き込み完了を確認してから次のデータを書き込む
+ */
+bool_t IsEepromWritten(eeprom_data_id_t eeprom_data_id, uint16_t offset, uint16_t size)
+{
+	bool_t written = TRUE;
+	uint16_t start = eeprom_data_info_table[eeprom_data_id].address + offset;
+	uint16_t address;
+
+	/* 書き込み待ち確認 */
+	for (uint16_t index=0; index<size; index++) {
+		address = start + index;
+		if ((dirty_bitmap[address / 32] & ((uint32_t)1 << (address % 32))) != 0) {
+			written = FALSE;
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	/* 書き込み中の範囲との重なり確認 */
+	if ((eeprom_state != EEPROM_STATE_IDLE)
+	 && (start < write_address + write_size)
+	 && (write_address < start + size)) {
+		written = FALSE;
+	} else {
+		/* 処理なし */
+	}
+
+	return written;
+}
+
+/*
+ * Function: 起動時の全データ読み出し完了待ち
+ * Argument: なし
+ * Return  : RESULT_OK:読み出し完了、RESULT_NG:タイムアウト
+ * Note    : なし
+ */
+static result_t waitLoadComplete(void)
+{
+	uint32_t start_time = GetTimeUs();
+	result_t result = RESULT_OK;
+
+	while ((eeprom_ready == FALSE) && (result == RESULT_OK)) {
+		if ((GetTimeUs() - start_time) >= EEPROM_LOAD_TIMEOUT) {
+			result = RESULT_NG;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Function: 起動時のダミーステータス読み出し完了コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackLoadStatus(void)
+{
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+
+	/* EEPROMから全データを読み出す(読み出し命令とアドレスを送信) */
+	send_buffer[0] = INSTRUCTION_READ;
+	send_buffer[1] = 0x00;
+	send_buffer[2] = 0x00;
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
+	SendSpi(SPI_EEPROM, send_buffer, 3, callbackLoadCommand);
+}
+
+/*
+ * Function: 起動時の読み出し命令送信完了コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackLoadCommand(void)
+{
+	/* 通信を継続するのでCSピンは落とさない */
+	ReceiveSpi(SPI_EEPROM, eeprom_buffer, EEPROM_SIZE, callbackLoadData);
+}
+
+/*
+ * Function: 起動時の全データ読み出し完了コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackLoadData(void)
+{
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+
+	/* 読み出し完了、書き込みを受け付ける */
+	eeprom_state = EEPROM_STATE_IDLE;
+	eeprom_ready = TRUE;
+	RecordBootStep(BOOT_STEP_EEPROM_LOADED);
+}
+
+/*
+ * Function: 書き込み待ち設定
+ * Argument: 書き込みアドレス、書き込みサイズ
+ * Return  : なし
+ * Note    : 同じアドレスへの複数回の書き込みは1回の書き込みにまとまる
+ */
+static void markDirty(uint16_t address, uint16_t size)
+{
+	uint32_t primask;
+
+	/* 割り込み処理内の次ページ書き込み準備と競合しないよう割り込み禁止で更新 */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (uint16_t offset=0; offset<size; offset++) {
+		dirty_bitmap[(address + offset) / 32] |= (uint32_t)1 << ((address + offset) % 32);
+	}
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Function: 書き込み待ち有無確認
+ * Argument: なし
+ * Return  : TRUE:書き込み待ちあり、FALSE:書き込み待ちなし
+ * Note    : なし
+ */
+static bool_t existDirty(void)
+{
+	bool_t exist = FALSE;
+
+	for (uint32_t index=0; index<DIRTY_BITMAP_WORD_NUM; index++) {
+		if (dirty_bitmap[index] != 0) {
+			exist = TRUE;
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	return exist;
+}
+
+/*
+ * Function: 書き込みページ準備
+ * Argument: なし
+ * Return  : TRUE:書き込みデータあり、FALSE:書き込み待ちなし
+ * Note    : 書き込み待ちのあるページを探索し、ページ内の書き込み待ち範囲を送信バッファへ格納する
+ *           書き込み許可命令は送信バッファ先頭1byteのみ使用するため、格納したデータは保持される
+ *           書き込み停止中の周期処理、または書き込み完了時の割り込み処理内から呼び出す
+ */
+static bool_t prepareWritePage(void)
+{
+	bool_t found = FALSE;
+	uint32_t page;
+	uint16_t page_start;
+	uint16_t range_start;
+	uint16_t range_end;
+	uint16_t address;
+
+	for (uint32_t count=0; (count<EEPROM_PAGE_NUM) && (found == FALSE); count++) {
+		page = (flush_page + count) % EEPROM_PAGE_NUM;
+		page_start = page * EEPROM_PAGE_SIZE;
+		range_start = page_start + EEPROM_PAGE_SIZE;
+		range_end = page_start;
+		/* ページ内の書き込み待ち範囲を探索 */
+		for (uint16_t offset=0; offset<EEPROM_PAGE_SIZE; offset++) {
+			address = page_start + offset;
+			if ((dirty_bitmap[address / 32] & ((uint32_t)1 << (address % 32))) != 0) {
+				if (address < range_start) {
+					range_start = address;
+				} else {
+					/* 処理なし */
+				}
+				range_end = address + 1;
+			} else {
+				/* 処理なし */
+			}
+		}
+		if (range_start < range_end) {
+			found = TRUE;
+			/* 次回は次のページから探索 */
+			flush_page = (page + 1) % EEPROM_PAGE_NUM;
+			write_address = range_start;
+			write_size = range_end - range_start;
+			/* 範囲内をRAMミラーから格納し書き込み待ちを解除(書き込み中の更新は再度書き込み待ちとなる) */
+			for (uint8_t offset=0; offset<write_size; offset++) {
+				send_buffer[3 + offset] = eeprom_buffer[write_address + offset];
+				dirty_bitmap[(write_address + offset) / 32] &= ~((uint32_t)1 << ((write_address + offset) % 32));
+			}
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	return found;
+}
+
+/*
+ * Function: EEPROM書き込み許可送信
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void eepromWriteEnable(void)
+{
+	eeprom_state = EEPROM_STATE_WRITE_ENABLE;
+
+	/* 書き込み許可を送信 */
+	send_buffer[0] = INSTRUCTION_WREN;
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
+	SendSpi(SPI_EEPROM, send_buffer, 1, callbackEepromWriteEnable);
+}
+
+/*
+ * Function: EEPROM書き込み許可送信コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackEepromWriteEnable(void)
+{
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+
+	/* 書き込み許可が完了したので、書き込みを実行 */
+	eepromWrite();
+}
+
+/*
+ * Function: EEPROM書き込み送信
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void eepromWrite(void)
+{
+	eeprom_state = EEPROM_STATE_WRITE;
+
+	/* 書き込みデータを送信(データはprepareWritePageで格納済み) */
+	send_buffer[0] = INSTRUCTION_WRITE;
+	send_buffer[1] = (write_address & 0xFF00) >> 8;
+	send_buffer[2] = (write_address & 0x00FF) >> 0;
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
+	SendSpi(SPI_EEPROM, send_buffer, 3 + write_size, callbackEepromWrite);
+}
+
+/*
+ * Function: EEPROM書き込み送信コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackEepromWrite(void)
+{
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+
+	/* 書き込みデータを送信したので、書き込み時間の経過後にステータスを確認 */
+	eeprom_state = EEPROM_STATE_WAIT_WRITING;
+	SetTimerAlarm(ALARM_ID_EEPROM, EEPROM_WRITE_POLL_FIRST, callbackAlarmWriting);
+}
+
+/*
+ * Function: EEPROM書き込み完了待ちアラームコールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : アラームの割り込み処理内で呼び出される
+ */
+static void callbackAlarmWriting(void)
+{
+	eepromReadStatus();
+}
+
+/*
+ * Function: EEPROMステータス読み出し
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void eepromReadStatus(void)
+{
+	eeprom_state = EEPROM_STATE_READ_STATUS;
+
+	/* ステータス読み出し */
+	send_buffer[0] = INSTRUCTION_RDSR;
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_ON);
+	if (SendReceiveSpi(SPI_EEPROM, send_buffer, receive_buffer, 2, callbackEepromReadStatus) != RESULT_OK) {
+		/* SPI通信中で開始できない場合は割り込み処理内で待たず、次の確認間隔で再確認 */
+		WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+		eeprom_state = EEPROM_STATE_WAIT_WRITING;
+		SetTimerAlarm(ALARM_ID_EEPROM, EEPROM_WRITE_POLL_INTERVAL, callbackAlarmWriting);
+	} else {
+		/* 処理なし */
+	}
+}
+
+/*
+ * Function: EEPROMステータス読み出しコールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackEepromReadStatus(void)
+{
+	WritePin(PIN_ID_EEPROM_CS, PIN_CS_OFF);
+
+	/* Write-In-Process (WIP) bitを確認 */
+	if ((receive_buffer[1] & 0x01) != 1) {
+		/* 書き込み完了、書き込み待ちのページがあれば周期処理を待たずに続けて書き込み */
+		eeprom_state = EEPROM_STATE_IDLE;
+		if (prepareWritePage() == TRUE) {
+			eepromWriteEnable();
+		} else {
+			/* 処理なし */
+		}
+	} else {
+		/* 書き込み処理中 */
+		eeprom_state = EEPROM_STATE_WAIT_WRITING;
+		SetTimerAlarm(ALARM_ID_EEPROM, EEPROM_WRITE_POLL_INTERVAL, callbackAlarmWriting);
+	}
+}
@@ -1,38 +1,51 @@
-/*
- * drv_eeprom.h
- *
- *  Created on: Jul 18, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_EEPROM_H_
-#define DRV_EEPROM_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "drv_eeprom_id.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitEeprom(void);
-void MainEeprom(void);
-uint8_t ReadEeprom1byte(eeprom_data_id_t eeprom_data_id);
-uint16_t ReadEeprom2byte(eeprom_data_id_t eeprom_data_id);
-uint32_t ReadEeprom4byte(eeprom_data_id_t eeprom_data_id);
-void WriteEeprom1byte(eeprom_data_id_t eeprom_data_id, uint8_t write_data);
-void WriteEeprom2byte(eeprom_data_id_t eeprom_data_id, uint16_t write_data);
-void WriteEeprom4byte(eeprom_data_id_t eeprom_data_id, uint32_t write_data);
-
-#endif /* DRV_EEPROM_H_ */
+/*
+ * drv_eeprom.h
+ *
+ *  Created on: Jul 18, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_EEPROM_H_
+#define DRV_EEPROM_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "drv_eeprom_id.h"
+
+/********** Define **********/
+
+/*
+ * 型付きデータ読み出し/書き込み(ID名はレイアウト定義のEEPROM_RECORDのID名、戻り値はresult_t)
+ * 格納先の型とレイアウト定義の型のサイズ不一致はコンパイル時に検出する
+ */
+#define EEPROM_RECORD_SIZE_CHECK(id, data)																	\
+	((void)sizeof(struct {																					\
+		_Static_assert(sizeof(*(data)) == sizeof(((eeprom_layout_t*)0)->id), "EEPROM record " #id " size mismatch");	\
+		uint8_t dummy;																						\
+	}))
+#define READ_EEPROM_RECORD(id, data)	(EEPROM_RECORD_SIZE_CHECK(id, data), ReadEepromData(EEPROM_DATA_ID_##id, (data)))
+#define WRITE_EEPROM_RECORD(id, data)	(EEPROM_RECORD_SIZE_CHECK(id, data), WriteEepromData(EEPROM_DATA_ID_##id, (data)))
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitEeprom(void);
+void MainEeprom(void);
+result_t FlushEeprom(uint32_t timeout_us);
+bool_t IsEepromReady(void);
+result_t ReadEepromData(eeprom_data_id_t eeprom_data_id, void* read_data);
+result_t WriteEepromData(eeprom_data_id_t eeprom_data_id, const void* write_data);
+result_t ReadEepromArea(eeprom_data_id_t eeprom_data_id, uint16_t offset, uint8_t* read_data, uint16_t size);
+result_t WriteEepromArea(eeprom_data_id_t eeprom_data_id, uint16_t offset, const uint8_t* write_data, uint16_t size);
+bool_t IsEepromWritten(eeprom_data_id_t eeprom_data_id, uint16_t offset, uint16_t size);
+
+#endif /* DRV_EEPROM_H_ */
@@ -1,1053 +1,74 @@
-/*
- * drv_eeprom_id.h
- *
- *  Created on: Aug 2, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_EEPROM_ID_H_
-#define DRV_EEPROM_ID_H_
-
-/********** Include **********/
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	EEPROM_DATA_ID_EMPTY_0000 = 0,
-	EEPROM_DATA_ID_EMPTY_0001,
-	EEPROM_DATA_ID_EMPTY_0002,
-	EEPROM_DATA_ID_EMPTY_0003,
-	EEPROM_DATA_ID_EMPTY_0004,
-	EEPROM_DATA_ID_EMPTY_0005,
-	EEPROM_DATA_ID_EMPTY_0006,
-	EEPROM_DATA_ID_EMPTY_0007,
-	EEPROM_DATA_ID_EMPTY_0008,
-	EEPROM_DATA_ID_EMPTY_0009,
-	EEPROM_DATA_ID_EMPTY_0010,
-	EEPROM_DATA_ID_EMPTY_0011,
-	EEPROM_DATA_ID_EMPTY_0012,
-	EEPROM_DATA_ID_EMPTY_0013,
-	EEPROM_DATA_ID_EMPTY_0014,
-	EEPROM_DATA_ID_EMPTY_0015,
-	EEPROM_DATA_ID_EMPTY_0016,
-	EEPROM_DATA_ID_EMPTY_0017,
-	EEPROM_DATA_ID_EMPTY_0018,
-	EEPROM_DATA_ID_EMPTY_0019,
-	EEPROM_DATA_ID_EMPTY_0020,
-	EEPROM_DATA_ID_EMPTY_0021,
-	EEPROM_DATA_ID_EMPTY_0022,
-	EEPROM_DATA_ID_EMPTY_0023,
-	EEPROM_DATA_ID_EMPTY_0024,
-	EEPROM_DATA_ID_EMPTY_0025,
-	EEPROM_DATA_ID_EMPTY_0026,
-	EEPROM_DATA_ID_EMPTY_0027,
-	EEPROM_DATA_ID_EMPTY_0028,
-	EEPROM_DATA_ID_EMPTY_0029,
-	EEPROM_DATA_ID_EMPTY_0030,
-	EEPROM_DATA_ID_EMPTY_0031,
-	EEPROM_DATA_ID_EMPTY_0032,
-	EEPROM_DATA_ID_EMPTY_0033,
-	EEPROM_DATA_ID_EMPTY_0034,
-	EEPROM_DATA_ID_EMPTY_0035,
-	EEPROM_DATA_ID_EMPTY_0036,
-	EEPROM_DATA_ID_EMPTY_0037,
-	EEPROM_DATA_ID_EMPTY_0038,
-	EEPROM_DATA_ID_EMPTY_0039,
-	EEPROM_DATA_ID_EMPTY_0040,
-	EEPROM_DATA_ID_EMPTY_0041,
-	EEPROM_DATA_ID_EMPTY_0042,
-	EEPROM_DATA_ID_EMPTY_0043,
-	EEPROM_DATA_ID_EMPTY_0044,
-	EEPROM_DATA_ID_EMPTY_0045,
-	EEPROM_DATA_ID_EMPTY_0046,
-	EEPROM_DATA_ID_EMPTY_0047,
-	EEPROM_DATA_ID_EMPTY_0048,
-	EEPROM_DATA_ID_EMPTY_0049,
-	EEPROM_DATA_ID_EMPTY_0050,
-	EEPROM_DATA_ID_EMPTY_0051,
-	EEPROM_DATA_ID_EMPTY_0052,
-	EEPROM_DATA_ID_EMPTY_0053,
-	EEPROM_DATA_ID_EMPTY_0054,
-	EEPROM_DATA_ID_EMPTY_0055,
-	EEPROM_DATA_ID_EMPTY_0056,
-	EEPROM_DATA_ID_EMPTY_0057,
-	EEPROM_DATA_ID_EMPTY_0058,
-	EEPROM_DATA_ID_EMPTY_0059,
-	EEPROM_DATA_ID_EMPTY_0060,
-	EEPROM_DATA_ID_EMPTY_0061,
-	EEPROM_DATA_ID_EMPTY_0062,
-	EEPROM_DATA_ID_EMPTY_0063,
-	EEPROM_DATA_ID_EMPTY_0064,
-	EEPROM_DATA_ID_EMPTY_0065,
-	EEPROM_DATA_ID_EMPTY_0066,
-	EEPROM_DATA_ID_EMPTY_0067,
-	EEPROM_DATA_ID_EMPTY_0068,
-	EEPROM_DATA_ID_EMPTY_0069,
-	EEPROM_DATA_ID_EMPTY_0070,
-	EEPROM_DATA_ID_EMPTY_0071,
-	EEPROM_DATA_ID_EMPTY_0072,
-	EEPROM_DATA_ID_EMPTY_0073,
-	EEPROM_DATA_ID_EMPTY_0074,
-	EEPROM_DATA_ID_EMPTY_0075,
-	EEPROM_DATA_ID_EMPTY_0076,
-	EEPROM_DATA_ID_EMPTY_0077,
-	EEPROM_DATA_ID_EMPTY_0078,
-	EEPROM_DATA_ID_EMPTY_0079,
-	EEPROM_DATA_ID_EMPTY_0080,
-	EEPROM_DATA_ID_EMPTY_0081,
-	EEPROM_DATA_ID_EMPTY_0082,
-	EEPROM_DATA_ID_EMPTY_0083,
-	EEPROM_DATA_ID_EMPTY_0084,
-	EEPROM_DATA_ID_EMPTY_0085,
-	EEPROM_DATA_ID_EMPTY_0086,
-	EEPROM_DATA_ID_EMPTY_0087,
-	EEPROM_DATA_ID_EMPTY_0088,
-	EEPROM_DATA_ID_EMPTY_0089,
-	EEPROM_DATA_ID_EMPTY_0090,
-	EEPROM_DATA_ID_EMPTY_0091,
-	EEPROM_DATA_ID_EMPTY_0092,
-	EEPROM_DATA_ID_EMPTY_0093,
-	EEPROM_DATA_ID_EMPTY_0094,
-	EEPROM_DATA_ID_EMPTY_0095,
-	EEPROM_DATA_ID_EMPTY_0096,
-	EEPROM_DATA_ID_EMPTY_0097,
-	EEPROM_DATA_ID_EMPTY_0098,
-	EEPROM_DATA_ID_EMPTY_0099,
-	EEPROM_DATA_ID_EMPTY_0100,
-	EEPROM_DATA_ID_EMPTY_0101,
-	EEPROM_DATA_ID_EMPTY_0102,
-	EEPROM_DATA_ID_EMPTY_0103,
-	EEPROM_DATA_ID_EMPTY_0104,
-	EEPROM_DATA_ID_EMPTY_0105,
-	EEPROM_DATA_ID_EMPTY_0106,
-	EEPROM_DATA_ID_EMPTY_0107,
-	EEPROM_DATA_ID_EMPTY_0108,
-	EEPROM_DATA_ID_EMPTY_0109,
-	EEPROM_DATA_ID_EMPTY_0110,
-	EEPROM_DATA_ID_EMPTY_0111,
-	EEPROM_DATA_ID_EMPTY_0112,
-	EEPROM_DATA_ID_EMPTY_0113,
-	EEPROM_DATA_ID_EMPTY_0114,
-	EEPROM_DATA_ID_EMPTY_0115,
-	EEPROM_DATA_ID_EMPTY_0116,
-	EEPROM_DATA_ID_EMPTY_0117,
-	EEPROM_DATA_ID_EMPTY_0118,
-	EEPROM_DATA_ID_EMPTY_0119,
-	EEPROM_DATA_ID_EMPTY_0120,
-	EEPROM_DATA_ID_EMPTY_0121,
-	EEPROM_DATA_ID_EMPTY_0122,
-	EEPROM_DATA_ID_EMPTY_0123,
-	EEPROM_DATA_ID_EMPTY_0124,
-	EEPROM_DATA_ID_EMPTY_0125,
-	EEPROM_DATA_ID_EMPTY_0126,
-	EEPROM_DATA_ID_EMPTY_0127,
-	EEPROM_DATA_ID_EMPTY_0128,
-	EEPROM_DATA_ID_EMPTY_0129,
-	EEPROM_DATA_ID_EMPTY_0130,
-	EEPROM_DATA_ID_EMPTY_0131,
-	EEPROM_DATA_ID_EMPTY_0132,
-	EEPROM_DATA_ID_EMPTY_0133,
-	EEPROM_DATA_ID_EMPTY_0134,
-	EEPROM_DATA_ID_EMPTY_0135,
-	EEPROM_DATA_ID_EMPTY_0136,
-	EEPROM_DATA_ID_EMPTY_0137,
-	EEPROM_DATA_ID_EMPTY_0138,
-	EEPROM_DATA_ID_EMPTY_0139,
-	EEPROM_DATA_ID_EMPTY_0140,
-	EEPROM_DATA_ID_EMPTY_0141,
-	EEPROM_DATA_ID_EMPTY_0142,
-	EEPROM_DATA_ID_EMPTY_0143,
-	EEPROM_DATA_ID_EMPTY_0144,
-	EEPROM_DATA_ID_EMPTY_0145,
-	EEPROM_DATA_ID_EMPTY_0146,
-	EEPROM_DATA_ID_EMPTY_0147,
-	EEPROM_DATA_ID_EMPTY_0148,
-	EEPROM_DATA_ID_EMPTY_0149,
-	EEPROM_DATA_ID_EMPTY_0150,
-	EEPROM_DATA_ID_EMPTY_0151,
-	EEPROM_DATA_ID_EMPTY_0152,
-	EEPROM_DATA_ID_EMPTY_0153,
-	EEPROM_DATA_ID_EMPTY_0154,
-	EEPROM_DATA_ID_EMPTY_0155,
-	EEPROM_DATA_ID_EMPTY_0156,
-	EEPROM_DATA_ID_EMPTY_0157,
-	EEPROM_DATA_ID_EMPTY_0158,
-	EEPROM_DATA_ID_EMPTY_0159,
-	EEPROM_DATA_ID_EMPTY_0160,
-	EEPROM_DATA_ID_EMPTY_0161,
-	EEPROM_DATA_ID_EMPTY_0162,
-	EEPROM_DATA_ID_EMPTY_0163,
-	EEPROM_DATA_ID_EMPTY_0164,
-	EEPROM_DATA_ID_EMPTY_0165,
-	EEPROM_DATA_ID_EMPTY_0166,
-	EEPROM_DATA_ID_EMPTY_0167,
-	EEPROM_DATA_ID_EMPTY_0168,
-	EEPROM_DATA_ID_EMPTY_0169,
-	EEPROM_DATA_ID_EMPTY_0170,
-	EEPROM_DATA_ID_EMPTY_0171,
-	EEPROM_DATA_ID_EMPTY_0172,
-	EEPROM_DATA_ID_EMPTY_0173,
-	EEPROM_DATA_ID_EMPTY_0174,
-	EEPROM_DATA_ID_EMPTY_0175,
-	EEPROM_DATA_ID_EMPTY_0176,
-	EEPROM_DATA_ID_EMPTY_0177,
-	EEPROM_DATA_ID_EMPTY_0178,
-	EEPROM_DATA_ID_EMPTY_0179,
-	EEPROM_DATA_ID_EMPTY_0180,
-	EEPROM_DATA_ID_EMPTY_0181,
-	EEPROM_DATA_ID_EMPTY_0182,
-	EEPROM_DATA_ID_EMPTY_0183,
-	EEPROM_DATA_ID_EMPTY_0184,
-	EEPROM_DATA_ID_EMPTY_0185,
-	EEPROM_DATA_ID_EMPTY_0186,
-	EEPROM_DATA_ID_EMPTY_0187,
-	EEPROM_DATA_ID_EMPTY_0188,
-	EEPROM_DATA_ID_EMPTY_0189,
-	EEPROM_DATA_ID_EMPTY_0190,
-	EEPROM_DATA_ID_EMPTY_0191,
-	EEPROM_DATA_ID_EMPTY_0192,
-	EEPROM_DATA_ID_EMPTY_0193,
-	EEPROM_DATA_ID_EMPTY_0194,
-	EEPROM_DATA_ID_EMPTY_0195,
-	EEPROM_DATA_ID_EMPTY_0196,
-	EEPROM_DATA_ID_EMPTY_0197,
-	EEPROM_DATA_ID_EMPTY_0198,
-	EEPROM_DATA_ID_EMPTY_0199,
-	EEPROM_DATA_ID_EMPTY_0200,
-	EEPROM_DATA_ID_EMPTY_0201,
-	EEPROM_DATA_ID_EMPTY_0202,
-	EEPROM_DATA_ID_EMPTY_0203,
-	EEPROM_DATA_ID_EMPTY_0204,
-	EEPROM_DATA_ID_EMPTY_0205,
-	EEPROM_DATA_ID_EMPTY_0206,
-	EEPROM_DATA_ID_EMPTY_0207,
-	EEPROM_DATA_ID_EMPTY_0208,
-	EEPROM_DATA_ID_EMPTY_0209,
-	EEPROM_DATA_ID_EMPTY_0210,
-	EEPROM_DATA_ID_EMPTY_0211,
-	EEPROM_DATA_ID_EMPTY_0212,
-	EEPROM_DATA_ID_EMPTY_0213,
-	EEPROM_DATA_ID_EMPTY_0214,
-	EEPROM_DATA_ID_EMPTY_0215,
-	EEPROM_DATA_ID_EMPTY_0216,
-	EEPROM_DATA_ID_EMPTY_0217,
-	EEPROM_DATA_ID_EMPTY_0218,
-	EEPROM_DATA_ID_EMPTY_0219,
-	EEPROM_DATA_ID_EMPTY_0220,
-	EEPROM_DATA_ID_EMPTY_0221,
-	EEPROM_DATA_ID_EMPTY_0222,
-	EEPROM_DATA_ID_EMPTY_0223,
-	EEPROM_DATA_ID_EMPTY_0224,
-	EEPROM_DATA_ID_EMPTY_0225,
-	EEPROM_DATA_ID_EMPTY_0226,
-	EEPROM_DATA_ID_EMPTY_0227,
-	EEPROM_DATA_ID_EMPTY_0228,
-	EEPROM_DATA_ID_EMPTY_0229,
-	EEPROM_DATA_ID_EMPTY_0230,
-	EEPROM_DATA_ID_EMPTY_0231,
-	EEPROM_DATA_ID_EMPTY_0232,
-	EEPROM_DATA_ID_EMPTY_0233,
-	EEPROM_DATA_ID_EMPTY_0234,
-	EEPROM_DATA_ID_EMPTY_0235,
-	EEPROM_DATA_ID_EMPTY_0236,
-	EEPROM_DATA_ID_EMPTY_0237,
-	EEPROM_DATA_ID_EMPTY_0238,
-	EEPROM_DATA_ID_EMPTY_0239,
-	EEPROM_DATA_ID_EMPTY_0240,
-	EEPROM_DATA_ID_EMPTY_0241,
-	EEPROM_DATA_ID_EMPTY_0242,
-	EEPROM_DATA_ID_EMPTY_0243,
-	EEPROM_DATA_ID_EMPTY_0244,
-	EEPROM_DATA_ID_EMPTY_0245,
-	EEPROM_DATA_ID_EMPTY_0246,
-	EEPROM_DATA_ID_EMPTY_0247,
-	EEPROM_DATA_ID_EMPTY_0248,
-	EEPROM_DATA_ID_EMPTY_0249,
-	EEPROM_DATA_ID_EMPTY_0250,
-	EEPROM_DATA_ID_EMPTY_0251,
-	EEPROM_DATA_ID_EMPTY_0252,
-	EEPROM_DATA_ID_EMPTY_0253,
-	EEPROM_DATA_ID_EMPTY_0254,
-	EEPROM_DATA_ID_EMPTY_0255,
-	EEPROM_DATA_ID_EMPTY_0256,
-	EEPROM_DATA_ID_EMPTY_0257,
-	EEPROM_DATA_ID_EMPTY_0258,
-	EEPROM_DATA_ID_EMPTY_0259,
-	EEPROM_DATA_ID_EMPTY_0260,
-	EEPROM_DATA_ID_EMPTY_0261,
-	EEPROM_DATA_ID_EMPTY_0262,
-	EEPROM_DATA_ID_EMPTY_0263,
-	EEPROM_DATA_ID_EMPTY_0264,
-	EEPROM_DATA_ID_EMPTY_0265,
-	EEPROM_DATA_ID_EMPTY_0266,
-	EEPROM_DATA_ID_EMPTY_0267,
-	EEPROM_DATA_ID_EMPTY_0268,
-	EEPROM_DATA_ID_EMPTY_0269,
-	EEPROM_DATA_ID_EMPTY_0270,
-	EEPROM_DATA_ID_EMPTY_0271,
-	EEPROM_DATA_ID_EMPTY_0272,
-	EEPROM_DATA_ID_EMPTY_0273,
-	EEPROM_DATA_ID_EMPTY_0274,
-	EEPROM_DATA_ID_EMPTY_0275,
-	EEPROM_DATA_ID_EMPTY_0276,
-	EEPROM_DATA_ID_EMPTY_0277,
-	EEPROM_DATA_ID_EMPTY_0278,
-	EEPROM_DATA_ID_EMPTY_0279,
-	EEPROM_DATA_ID_EMPTY_0280,
-	EEPROM_DATA_ID_EMPTY_0281,
-	EEPROM_DATA_ID_EMPTY_0282,
-	EEPROM_DATA_ID_EMPTY_0283,
-	EEPROM_DATA_ID_EMPTY_0284,
-	EEPROM_DATA_ID_EMPTY_0285,
-	EEPROM_DATA_ID_EMPTY_0286,
-	EEPROM_DATA_ID_EMPTY_0287,
-	EEPROM_DATA_ID_EMPTY_0288,
-	EEPROM_DATA_ID_EMPTY_0289,
-	EEPROM_DATA_ID_EMPTY_0290,
-	EEPROM_DATA_ID_EMPTY_0291,
-	EEPROM_DATA_ID_EMPTY_0292,
-	EEPROM_DATA_ID_EMPTY_0293,
-	EEPROM_DATA_ID_EMPTY_0294,
-	EEPROM_DATA_ID_EMPTY_0295,
-	EEPROM_DATA_ID_EMPTY_0296,
-	EEPROM_DATA_ID_EMPTY_0297,
-	EEPROM_DATA_ID_EMPTY_0298,
-	EEPROM_DATA_ID_EMPTY_0299,
-	EEPROM_DATA_ID_EMPTY_0300,
-	EEPROM_DATA_ID_EMPTY_0301,
-	EEPROM_DATA_ID_EMPTY_0302,
-	EEPROM_DATA_ID_EMPTY_0303,
-	EEPROM_DATA_ID_EMPTY_0304,
-	EEPROM_DATA_ID_EMPTY_0305,
-	EEPROM_DATA_ID_EMPTY_0306,
-	EEPROM_DATA_ID_EMPTY_0307,
-	EEPROM_DATA_ID_EMPTY_0308,
-	EEPROM_DATA_ID_EMPTY_0309,
-	EEPROM_DATA_ID_EMPTY_0310,
-	EEPROM_DATA_ID_EMPTY_0311,
-	EEPROM_DATA_ID_EMPTY_0312,
-	EEPROM_DATA_ID_EMPTY_0313,
-	EEPROM_DATA_ID_EMPTY_0314,
-	EEPROM_DATA_ID_EMPTY_0315,
-	EEPROM_DATA_ID_EMPTY_0316,
-	EEPROM_DATA_ID_EMPTY_0317,
-	EEPROM_DATA_ID_EMPTY_0318,
-	EEPROM_DATA_ID_EMPTY_0319,
-	EEPROM_DATA_ID_EMPTY_0320,
-	EEPROM_DATA_ID_EMPTY_0321,
-	EEPROM_DATA_ID_EMPTY_0322,
-	EEPROM_DATA_ID_EMPTY_0323,
-	EEPROM_DATA_ID_EMPTY_0324,
-	EEPROM_DATA_ID_EMPTY_0325,
-	EEPROM_DATA_ID_EMPTY_0326,
-	EEPROM_DATA_ID_EMPTY_0327,
-	EEPROM_DATA_ID_EMPTY_0328,
-	EEPROM_DATA_ID_EMPTY_0329,
-	EEPROM_DATA_ID_EMPTY_0330,
-	EEPROM_DATA_ID_EMPTY_0331,
-	EEPROM_DATA_ID_EMPTY_0332,
-	EEPROM_DATA_ID_EMPTY_0333,
-	EEPROM_DATA_ID_EMPTY_0334,
-	EEPROM_DATA_ID_EMPTY_0335,
-	EEPROM_DATA_ID_EMPTY_0336,
-	EEPROM_DATA_ID_EMPTY_0337,
-	EEPROM_DATA_ID_EMPTY_0338,
-	EEPROM_DATA_ID_EMPTY_0339,
-	EEPROM_DATA_ID_EMPTY_0340,
-	EEPROM_DATA_ID_EMPTY_0341,
-	EEPROM_DATA_ID_EMPTY_0342,
-	EEPROM_DATA_ID_EMPTY_0343,
-	EEPROM_DATA_ID_EMPTY_0344,
-	EEPROM_DATA_ID_EMPTY_0345,
-	EEPROM_DATA_ID_EMPTY_0346,
-	EEPROM_DATA_ID_EMPTY_0347,
-	EEPROM_DATA_ID_EMPTY_0348,
-	EEPROM_DATA_ID_EMPTY_0349,
-	EEPROM_DATA_ID_EMPTY_0350,
-	EEPROM_DATA_ID_EMPTY_0351,
-	EEPROM_DATA_ID_EMPTY_0352,
-	EEPROM_DATA_ID_EMPTY_0353,
-	EEPROM_DATA_ID_EMPTY_0354,
-	EEPROM_DATA_ID_EMPTY_0355,
-	EEPROM_DATA_ID_EMPTY_0356,
-	EEPROM_DATA_ID_EMPTY_0357,
-	EEPROM_DATA_ID_EMPTY_0358,
-	EEPROM_DATA_ID_EMPTY_0359,
-	EEPROM_DATA_ID_EMPTY_0360,
-	EEPROM_DATA_ID_EMPTY_0361,
-	EEPROM_DATA_ID_EMPTY_0362,
-	EEPROM_DATA_ID_EMPTY_0363,
-	EEPROM_DATA_ID_EMPTY_0364,
-	EEPROM_DATA_ID_EMPTY_0365,
-	EEPROM_DATA_ID_EMPTY_0366,
-	EEPROM_DATA_ID_EMPTY_0367,
-	EEPROM_DATA_ID_EMPTY_0368,
-	EEPROM_DATA_ID_EMPTY_0369,
-	EEPROM_DATA_ID_EMPTY_0370,
-	EEPROM_DATA_ID_EMPTY_0371,
-	EEPROM_DATA_ID_EMPTY_0372,
-	EEPROM_DATA_ID_EMPTY_0373,
-	EEPROM_DATA_ID_EMPTY_0374,
-	EEPROM_DATA_ID_EMPTY_0375,
-	EEPROM_DATA_ID_EMPTY_0376,
-	EEPROM_DATA_ID_EMPTY_0377,
-	EEPROM_DATA_ID_EMPTY_0378,
-	EEPROM_DATA_ID_EMPTY_0379,
-	EEPROM_DATA_ID_EMPTY_0380,
-	EEPROM_DATA_ID_EMPTY_0381,
-	EEPROM_DATA_ID_EMPTY_0382,
-	EEPROM_DATA_ID_EMPTY_0383,
-	EEPROM_DATA_ID_EMPTY_0384,
-	EEPROM_DATA_ID_EMPTY_0385,
-	EEPROM_DATA_ID_EMPTY_0386,
-	EEPROM_DATA_ID_EMPTY_0387,
-	EEPROM_DATA_ID_EMPTY_0388,
-	EEPROM_DATA_ID_EMPTY_0389,
-	EEPROM_DATA_ID_EMPTY_0390,
-	EEPROM_DATA_ID_EMPTY_0391,
-	EEPROM_DATA_ID_EMPTY_0392,
-	EEPROM_DATA_ID_EMPTY_0393,
-	EEPROM_DATA_ID_EMPTY_0394,
-	EEPROM_DATA_ID_EMPTY_0395,
-	EEPROM_DATA_ID_EMPTY_0396,
-	EEPROM_DATA_ID_EMPTY_0397,
-	EEPROM_DATA_ID_EMPTY_0398,
-	EEPROM_DATA_ID_EMPTY_0399,
-	EEPROM_DATA_ID_EMPTY_0400,
-	EEPROM_DATA_ID_EMPTY_0401,
-	EEPROM_DATA_ID_EMPTY_0402,
-	EEPROM_DATA_ID_EMPTY_0403,
-	EEPROM_DATA_ID_EMPTY_0404,
-	EEPROM_DATA_ID_EMPTY_0405,
-	EEPROM_DATA_ID_EMPTY_0406,
-	EEPROM_DATA_ID_EMPTY_0407,
-	EEPROM_DATA_ID_EMPTY_0408,
-	EEPROM_DATA_ID_EMPTY_0409,
-	EEPROM_DATA_ID_EMPTY_0410,
-	EEPROM_DATA_ID_EMPTY_0411,
-	EEPROM_DATA_ID_EMPTY_0412,
-	EEPROM_DATA_ID_EMPTY_0413,
-	EEPROM_DATA_ID_EMPTY_0414,
-	EEPROM_DATA_ID_EMPTY_0415,
-	EEPROM_DATA_ID_EMPTY_0416,
-	EEPROM_DATA_ID_EMPTY_0417,
-	EEPROM_DATA_ID_EMPTY_0418,
-	EEPROM_DATA_ID_EMPTY_0419,
-	EEPROM_DATA_ID_EMPTY_0420,
-	EEPROM_DATA_ID_EMPTY_0421,
-	EEPROM_DATA_ID_EMPTY_0422,
-	EEPROM_DATA_ID_EMPTY_0423,
-	EEPROM_DATA_ID_EMPTY_0424,
-	EEPROM_DATA_ID_EMPTY_0425,
-	EEPROM_DATA_ID_EMPTY_0426,
-	EEPROM_DATA_ID_EMPTY_0427,
-	EEPROM_DATA_ID_EMPTY_0428,
-	EEPROM_DATA_ID_EMPTY_0429,
-	EEPROM_DATA_ID_EMPTY_0430,
-	EEPROM_DATA_ID_EMPTY_0431,
-	EEPROM_DATA_ID_EMPTY_0432,
-	EEPROM_DATA_ID_EMPTY_0433,
-	EEPROM_DATA_ID_EMPTY_0434,
-	EEPROM_DATA_ID_EMPTY_0435,
-	EEPROM_DATA_ID_EMPTY_0436,
-	EEPROM_DATA_ID_EMPTY_0437,
-	EEPROM_DATA_ID_EMPTY_0438,
-	EEPROM_DATA_ID_EMPTY_0439,
-	EEPROM_DATA_ID_EMPTY_0440,
-	EEPROM_DATA_ID_EMPTY_0441,
-	EEPROM_DATA_ID_EMPTY_0442,
-	EEPROM_DATA_ID_EMPTY_0443,
-	EEPROM_DATA_ID_EMPTY_0444,
-	EEPROM_DATA_ID_EMPTY_0445,
-	EEPROM_DATA_ID_EMPTY_0446,
-	EEPROM_DATA_ID_EMPTY_0447,
-	EEPROM_DATA_ID_EMPTY_0448,
-	EEPROM_DATA_ID_EMPTY_0449,
-	EEPROM_DATA_ID_EMPTY_0450,
-	EEPROM_DATA_ID_EMPTY_0451,
-	EEPROM_DATA_ID_EMPTY_0452,
-	EEPROM_DATA_ID_EMPTY_0453,
-	EEPROM_DATA_ID_EMPTY_0454,
-	EEPROM_DATA_ID_EMPTY_0455,
-	EEPROM_DATA_ID_EMPTY_0456,
-	EEPROM_DATA_ID_EMPTY_0457,
-	EEPROM_DATA_ID_EMPTY_0458,
-	EEPROM_DATA_ID_EMPTY_0459,
-	EEPROM_DATA_ID_EMPTY_0460,
-	EEPROM_DATA_ID_EMPTY_0461,
-	EEPROM_DATA_ID_EMPTY_0462,
-	EEPROM_DATA_ID_EMPTY_0463,
-	EEPROM_DATA_ID_EMPTY_0464,
-	EEPROM_DATA_ID_EMPTY_0465,
-	EEPROM_DATA_ID_EMPTY_0466,
-	EEPROM_DATA_ID_EMPTY_0467,
-	EEPROM_DATA_ID_EMPTY_0468,
-	EEPROM_DATA_ID_EMPTY_0469,
-	EEPROM_DATA_ID_EMPTY_0470,
-	EEPROM_DATA_ID_EMPTY_0471,
-	EEPROM_DATA_ID_EMPTY_0472,
-	EEPROM_DATA_ID_EMPTY_0473,
-	EEPROM_DATA_ID_EMPTY_0474,
-	EEPROM_DATA_ID_EMPTY_0475,
-	EEPROM_DATA_ID_EMPTY_0476,
-	EEPROM_DATA_ID_EMPTY_0477,
-	EEPROM_DATA_ID_EMPTY_0478,
-	EEPROM_DATA_ID_EMPTY_0479,
-	EEPROM_DATA_ID_EMPTY_0480,
-	EEPROM_DATA_ID_EMPTY_0481,
-	EEPROM_DATA_ID_EMPTY_0482,
-	EEPROM_DATA_ID_EMPTY_0483,
-	EEPROM_DATA_ID_EMPTY_0484,
-	EEPROM_DATA_ID_EMPTY_0485,
-	EEPROM_DATA_ID_EMPTY_0486,
-	EEPROM_DATA_ID_EMPTY_0487,
-	EEPROM_DATA_ID_EMPTY_0488,
-	EEPROM_DATA_ID_EMPTY_0489,
-	EEPROM_DATA_ID_EMPTY_0490,
-	EEPROM_DATA_ID_EMPTY_0491,
-	EEPROM_DATA_ID_EMPTY_0492,
-	EEPROM_DATA_ID_EMPTY_0493,
-	EEPROM_DATA_ID_EMPTY_0494,
-	EEPROM_DATA_ID_EMPTY_0495,
-	EEPROM_DATA_ID_EMPTY_0496,
-	EEPROM_DATA_ID_EMPTY_0497,
-	EEPROM_DATA_ID_EMPTY_0498,
-	EEPROM_DATA_ID_EMPTY_0499,
-	EEPROM_DATA_ID_EMPTY_0500,
-	EEPROM_DATA_ID_EMPTY_0501,
-	EEPROM_DATA_ID_EMPTY_0502,
-	EEPROM_DATA_ID_EMPTY_0503,
-	EEPROM_DATA_ID_EMPTY_0504,
-	EEPROM_DATA_ID_EMPTY_0505,
-	EEPROM_DATA_ID_EMPTY_0506,
-	EEPROM_DATA_ID_EMPTY_0507,
-	EEPROM_DATA_ID_EMPTY_0508,
-	EEPROM_DATA_ID_EMPTY_0509,
-	EEPROM_DATA_ID_EMPTY_0510,
-	EEPROM_DATA_ID_EMPTY_0511,
-	EEPROM_DATA_ID_EMPTY_0512,
-	EEPROM_DATA_ID_EMPTY_0513,
-	EEPROM_DATA_ID_EMPTY_0514,
-	EEPROM_DATA_ID_EMPTY_0515,
-	EEPROM_DATA_ID_EMPTY_0516,
-	EEPROM_DATA_ID_EMPTY_0517,
-	EEPROM_DATA_ID_EMPTY_0518,
-	EEPROM_DATA_ID_EMPTY_0519,
-	EEPROM_DATA_ID_EMPTY_0520,
-	EEPROM_DATA_ID_EMPTY_0521,
-	EEPROM_DATA_ID_EMPTY_0522,
-	EEPROM_DATA_ID_EMPTY_0523,
-	EEPROM_DATA_ID_EMPTY_0524,
-	EEPROM_DATA_ID_EMPTY_0525,
-	EEPROM_DATA_ID_EMPTY_0526,
-	EEPROM_DATA_ID_EMPTY_0527,
-	EEPROM_DATA_ID_EMPTY_0528,
-	EEPROM_DATA_ID_EMPTY_0529,
-	EEPROM_DATA_ID_EMPTY_0530,
-	EEPROM_DATA_ID_EMPTY_0531,
-	EEPROM_DATA_ID_EMPTY_0532,
-	EEPROM_DATA_ID_EMPTY_0533,
-	EEPROM_DATA_ID_EMPTY_0534,
-	EEPROM_DATA_ID_EMPTY_0535,
-	EEPROM_DATA_ID_EMPTY_0536,
-	EEPROM_DATA_ID_EMPTY_0537,
-	EEPROM_DATA_ID_EMPTY_0538,
-	EEPROM_DATA_ID_EMPTY_0539,
-	EEPROM_DATA_ID_EMPTY_0540,
-	EEPROM_DATA_ID_EMPTY_0541,
-	EEPROM_DATA_ID_EMPTY_0542,
-	EEPROM_DATA_ID_EMPTY_0543,
-	EEPROM_DATA_ID_EMPTY_0544,
-	EEPROM_DATA_ID_EMPTY_0545,
-	EEPROM_DATA_ID_EMPTY_0546,
-	EEPROM_DATA_ID_EMPTY_0547,
-	EEPROM_DATA_ID_EMPTY_0548,
-	EEPROM_DATA_ID_EMPTY_0549,
-	EEPROM_DATA_ID_EMPTY_0550,
-	EEPROM_DATA_ID_EMPTY_0551,
-	EEPROM_DATA_ID_EMPTY_0552,
-	EEPROM_DATA_ID_EMPTY_0553,
-	EEPROM_DATA_ID_EMPTY_0554,
-	EEPROM_DATA_ID_EMPTY_0555,
-	EEPROM_DATA_ID_EMPTY_0556,
-	EEPROM_DATA_ID_EMPTY_0557,
-	EEPROM_DATA_ID_EMPTY_0558,
-	EEPROM_DATA_ID_EMPTY_0559,
-	EEPROM_DATA_ID_EMPTY_0560,
-	EEPROM_DATA_ID_EMPTY_0561,
-	EEPROM_DATA_ID_EMPTY_0562,
-	EEPROM_DATA_ID_EMPTY_0563,
-	EEPROM_DATA_ID_EMPTY_0564,
-	EEPROM_DATA_ID_EMPTY_0565,
-	EEPROM_DATA_ID_EMPTY_0566,
-	EEPROM_DATA_ID_EMPTY_0567,
-	EEPROM_DATA_ID_EMPTY_0568,
-	EEPROM_DATA_ID_EMPTY_0569,
-	EEPROM_DATA_ID_EMPTY_0570,
-	EEPROM_DATA_ID_EMPTY_0571,
-	EEPROM_DATA_ID_EMPTY_0572,
-	EEPROM_DATA_ID_EMPTY_0573,
-	EEPROM_DATA_ID_EMPTY_0574,
-	EEPROM_DATA_ID_EMPTY_0575,
-	EEPROM_DATA_ID_EMPTY_0576,
-	EEPROM_DATA_ID_EMPTY_0577,
-	EEPROM_DATA_ID_EMPTY_0578,
-	EEPROM_DATA_ID_EMPTY_0579,
-	EEPROM_DATA_ID_EMPTY_0580,
-	EEPROM_DATA_ID_EMPTY_0581,
-	EEPROM_DATA_ID_EMPTY_0582,
-	EEPROM_DATA_ID_EMPTY_0583,
-	EEPROM_DATA_ID_EMPTY_0584,
-	EEPROM_DATA_ID_EMPTY_0585,
-	EEPROM_DATA_ID_EMPTY_0586,
-	EEPROM_DATA_ID_EMPTY_0587,
-	EEPROM_DATA_ID_EMPTY_0588,
-	EEPROM_DATA_ID_EMPTY_0589,
-	EEPROM_DATA_ID_EMPTY_0590,
-	EEPROM_DATA_ID_EMPTY_0591,
-	EEPROM_DATA_ID_EMPTY_0592,
-	EEPROM_DATA_ID_EMPTY_0593,
-	EEPROM_DATA_ID_EMPTY_0594,
-	EEPROM_DATA_ID_EMPTY_0595,
-	EEPROM_DATA_ID_EMPTY_0596,
-	EEPROM_DATA_ID_EMPTY_0597,
-	EEPROM_DATA_ID_EMPTY_0598,
-	EEPROM_DATA_ID_EMPTY_0599,
-	EEPROM_DATA_ID_EMPTY_0600,
-	EEPROM_DATA_ID_EMPTY_0601,
-	EEPROM_DATA_ID_EMPTY_0602,
-	EEPROM_DATA_ID_EMPTY_0603,
-	EEPROM_DATA_ID_EMPTY_0604,
-	EEPROM_DATA_ID_EMPTY_0605,
-	EEPROM_DATA_ID_EMPTY_0606,
-	EEPROM_DATA_ID_EMPTY_0607,
-	EEPROM_DATA_ID_EMPTY_0608,
-	EEPROM_DATA_ID_EMPTY_0609,
-	EEPROM_DATA_ID_EMPTY_0610,
-	EEPROM_DATA_ID_EMPTY_0611,
-	EEPROM_DATA_ID_EMPTY_0612,
-	EEPROM_DATA_ID_EMPTY_0613,
-	EEPROM_DATA_ID_EMPTY_0614,
-	EEPROM_DATA_ID_EMPTY_0615,
-	EEPROM_DATA_ID_EMPTY_0616,
-	EEPROM_DATA_ID_EMPTY_0617,
-	EEPROM_DATA_ID_EMPTY_0618,
-	EEPROM_DATA_ID_EMPTY_0619,
-	EEPROM_DATA_ID_EMPTY_0620,
-	EEPROM_DATA_ID_EMPTY_0621,
-	EEPROM_DATA_ID_EMPTY_0622,
-	EEPROM_DATA_ID_EMPTY_0623,
-	EEPROM_DATA_ID_EMPTY_0624,
-	EEPROM_DATA_ID_EMPTY_0625,
-	EEPROM_DATA_ID_EMPTY_0626,
-	EEPROM_DATA_ID_EMPTY_0627,
-	EEPROM_DATA_ID_EMPTY_0628,
-	EEPROM_DATA_ID_EMPTY_0629,
-	EEPROM_DATA_ID_EMPTY_0630,
-	EEPROM_DATA_ID_EMPTY_0631,
-	EEPROM_DATA_ID_EMPTY_0632,
-	EEPROM_DATA_ID_EMPTY_0633,
-	EEPROM_DATA_ID_EMPTY_0634,
-	EEPROM_DATA_ID_EMPTY_0635,
-	EEPROM_DATA_ID_EMPTY_0636,
-	EEPROM_DATA_ID_EMPTY_0637,
-	EEPROM_DATA_ID_EMPTY_0638,
-	EEPROM_DATA_ID_EMPTY_0639,
-	EEPROM_DATA_ID_EMPTY_0640,
-	EEPROM_DATA_ID_EMPTY_0641,
-	EEPROM_DATA_ID_EMPTY_0642,
-	EEPROM_DATA_ID_EMPTY_0643,
-	EEPROM_DATA_ID_EMPTY_0644,
-	EEPROM_DATA_ID_EMPTY_0645,
-	EEPROM_DATA_ID_EMPTY_0646,
-	EEPROM_DATA_ID_EMPTY_0647,
-	EEPROM_DATA_ID_EMPTY_0648,
-	EEPROM_DATA_ID_EMPTY_0649,
-	EEPROM_DATA_ID_EMPTY_0650,
-	EEPROM_DATA_ID_EMPTY_0651,
-	EEPROM_DATA_ID_EMPTY_0652,
-	EEPROM_DATA_ID_EMPTY_0653,
-	EEPROM_DATA_ID_EMPTY_0654,
-	EEPROM_DATA_ID_EMPTY_0655,
-	EEPROM_DATA_ID_EMPTY_0656,
-	EEPROM_DATA_ID_EMPTY_0657,
-	EEPROM_DATA_ID_EMPTY_0658,
-	EEPROM_DATA_ID_EMPTY_0659,
-	EEPROM_DATA_ID_EMPTY_0660,
-	EEPROM_DATA_ID_EMPTY_0661,
-	EEPROM_DATA_ID_EMPTY_0662,
-	EEPROM_DATA_ID_EMPTY_0663,
-	EEPROM_DATA_ID_EMPTY_0664,
-	EEPROM_DATA_ID_EMPTY_0665,
-	EEPROM_DATA_ID_EMPTY_0666,
-	EEPROM_DATA_ID_EMPTY_0667,
-	EEPROM_DATA_ID_EMPTY_0668,
-	EEPROM_DATA_ID_EMPTY_0669,
-	EEPROM_DATA_ID_EMPTY_0670,
-	EEPROM_DATA_ID_EMPTY_0671,
-	EEPROM_DATA_ID_EMPTY_0672,
-	EEPROM_DATA_ID_EMPTY_0673,
-	EEPROM_DATA_ID_EMPTY_0674,
-	EEPROM_DATA_ID_EMPTY_0675,
-	EEPROM_DATA_ID_EMPTY_0676,
-	EEPROM_DATA_ID_EMPTY_0677,
-	EEPROM_DATA_ID_EMPTY_0678,
-	EEPROM_DATA_ID_EMPTY_0679,
-	EEPROM_DATA_ID_EMPTY_0680,
-	EEPROM_DATA_ID_EMPTY_0681,
-	EEPROM_DATA_ID_EMPTY_0682,
-	EEPROM_DATA_ID_EMPTY_0683,
-	EEPROM_DATA_ID_EMPTY_0684,
-	EEPROM_DATA_ID_EMPTY_0685,
-	EEPROM_DATA_ID_EMPTY_0686,
-	EEPROM_DATA_ID_EMPTY_0687,
-	EEPROM_DATA_ID_EMPTY_0688,
-	EEPROM_DATA_ID_EMPTY_0689,
-	EEPROM_DATA_ID_EMPTY_0690,
-	EEPROM_DATA_ID_EMPTY_0691,
-	EEPROM_DATA_ID_EMPTY_0692,
-	EEPROM_DATA_ID_EMPTY_0693,
-	EEPROM_DATA_ID_EMPTY_0694,
-	EEPROM_DATA_ID_EMPTY_0695,
-	EEPROM_DATA_ID_EMPTY_0696,
-	EEPROM_DATA_ID_EMPTY_0697,
-	EEPROM_DATA_ID_EMPTY_0698,
-	EEPROM_DATA_ID_EMPTY_0699,
-	EEPROM_DATA_ID_EMPTY_0700,
-	EEPROM_DATA_ID_EMPTY_0701,
-	EEPROM_DATA_ID_EMPTY_0702,
-	EEPROM_DATA_ID_EMPTY_0703,
-	EEPROM_DATA_ID_EMPTY_0704,
-	EEPROM_DATA_ID_EMPTY_0705,
-	EEPROM_DATA_ID_EMPTY_0706,
-	EEPROM_DATA_ID_EMPTY_0707,
-	EEPROM_DATA_ID_EMPTY_0708,
-	EEPROM_DATA_ID_EMPTY_0709,
-	EEPROM_DATA_ID_EMPTY_0710,
-	EEPROM_DATA_ID_EMPTY_0711,
-	EEPROM_DATA_ID_EMPTY_0712,
-	EEPROM_DATA_ID_EMPTY_0713,
-	EEPROM_DATA_ID_EMPTY_0714,
-	EEPROM_DATA_ID_EMPTY_0715,
-	EEPROM_DATA_ID_EMPTY_0716,
-	EEPROM_DATA_ID_EMPTY_0717,
-	EEPROM_DATA_ID_EMPTY_0718,
-	EEPROM_DATA_ID_EMPTY_0719,
-	EEPROM_DATA_ID_EMPTY_0720,
-	EEPROM_DATA_ID_EMPTY_0721,
-	EEPROM_DATA_ID_EMPTY_0722,
-	EEPROM_DATA_ID_EMPTY_0723,
-	EEPROM_DATA_ID_EMPTY_0724,
-	EEPROM_DATA_ID_EMPTY_0725,
-	EEPROM_DATA_ID_EMPTY_0726,
-	EEPROM_DATA_ID_EMPTY_0727,
-	EEPROM_DATA_ID_EMPTY_0728,
-	EEPROM_DATA_ID_EMPTY_0729,
-	EEPROM_DATA_ID_EMPTY_0730,
-	EEPROM_DATA_ID_EMPTY_0731,
-	EEPROM_DATA_ID_EMPTY_0732,
-	EEPROM_DATA_ID_EMPTY_0733,
-	EEPROM_DATA_ID_EMPTY_0734,
-	EEPROM_DATA_ID_EMPTY_0735,
-	EEPROM_DATA_ID_EMPTY_0736,
-	EEPROM_DATA_ID_EMPTY_0737,
-	EEPROM_DATA_ID_EMPTY_0738,
-	EEPROM_DATA_ID_EMPTY_0739,
-	EEPROM_DATA_ID_EMPTY_0740,
-	EEPROM_DATA_ID_EMPTY_0741,
-	EEPROM_DATA_ID_EMPTY_0742,
-	EEPROM_DATA_ID_EMPTY_0743,
-	EEPROM_DATA_ID_EMPTY_0744,
-	EEPROM_DATA_ID_EMPTY_0745,
-	EEPROM_DATA_ID_EMPTY_0746,
-	EEPROM_DATA_ID_EMPTY_0747,
-	EEPROM_DATA_ID_EMPTY_0748,
-	EEPROM_DATA_ID_EMPTY_0749,
-	EEPROM_DATA_ID_EMPTY_0750,
-	EEPROM_DATA_ID_EMPTY_0751,
-	EEPROM_DATA_ID_EMPTY_0752,
-	EEPROM_DATA_ID_EMPTY_0753,
-	EEPROM_DATA_ID_EMPTY_0754,
-	EEPROM_DATA_ID_EMPTY_0755,
-	EEPROM_DATA_ID_EMPTY_0756,
-	EEPROM_DATA_ID_EMPTY_0757,
-	EEPROM_DATA_ID_EMPTY_0758,
-	EEPROM_DATA_ID_EMPTY_0759,
-	EEPROM_DATA_ID_EMPTY_0760,
-	EEPROM_DATA_ID_EMPTY_0761,
-	EEPROM_DATA_ID_EMPTY_0762,
-	EEPROM_DATA_ID_EMPTY_0763,
-	EEPROM_DATA_ID_EMPTY_0764,
-	EEPROM_DATA_ID_EMPTY_0765,
-	EEPROM_DATA_ID_EMPTY_0766,
-	EEPROM_DATA_ID_EMPTY_0767,
-	EEPROM_DATA_ID_EMPTY_0768,
-	EEPROM_DATA_ID_EMPTY_0769,
-	EEPROM_DATA_ID_EMPTY_0770,
-	EEPROM_DATA_ID_EMPTY_0771,
-	EEPROM_DATA_ID_EMPTY_0772,
-	EEPROM_DATA_ID_EMPTY_0773,
-	EEPROM_DATA_ID_EMPTY_0774,
-	EEPROM_DATA_ID_EMPTY_0775,
-	EEPROM_DATA_ID_EMPTY_0776,
-	EEPROM_DATA_ID_EMPTY_0777,
-	EEPROM_DATA_ID_EMPTY_0778,
-	EEPROM_DATA_ID_EMPTY_0779,
-	EEPROM_DATA_ID_EMPTY_0780,
-	EEPROM_DATA_ID_EMPTY_0781,
-	EEPROM_DATA_ID_EMPTY_0782,
-	EEPROM_DATA_ID_EMPTY_0783,
-	EEPROM_DATA_ID_EMPTY_0784,
-	EEPROM_DATA_ID_EMPTY_0785,
-	EEPROM_DATA_ID_EMPTY_0786,
-	EEPROM_DATA_ID_EMPTY_0787,
-	EEPROM_DATA_ID_EMPTY_0788,
-	EEPROM_DATA_ID_EMPTY_0789,
-	EEPROM_DATA_ID_EMPTY_0790,
-	EEPROM_DATA_ID_EMPTY_0791,
-	EEPROM_DATA_ID_EMPTY_0792,
-	EEPROM_DATA_ID_EMPTY_0793,
-	EEPROM_DATA_ID_EMPTY_0794,
-	EEPROM_DATA_ID_EMPTY_0795,
-	EEPROM_DATA_ID_EMPTY_0796,
-	EEPROM_DATA_ID_EMPTY_0797,
-	EEPROM_DATA_ID_EMPTY_0798,
-	EEPROM_DATA_ID_EMPTY_0799,
-	EEPROM_DATA_ID_EMPTY_0800,
-	EEPROM_DATA_ID_EMPTY_0801,
-	EEPROM_DATA_ID_EMPTY_0802,
-	EEPROM_DATA_ID_EMPTY_0803,
-	EEPROM_DATA_ID_EMPTY_0804,
-	EEPROM_DATA_ID_EMPTY_0805,
-	EEPROM_DATA_ID_EMPTY_0806,
-	EEPROM_DATA_ID_EMPTY_0807,
-	EEPROM_DATA_ID_EMPTY_0808,
-	EEPROM_DATA_ID_EMPTY_0809,
-	EEPROM_DATA_ID_EMPTY_0810,
-	EEPROM_DATA_ID_EMPTY_0811,
-	EEPROM_DATA_ID_EMPTY_0812,
-	EEPROM_DATA_ID_EMPTY_0813,
-	EEPROM_DATA_ID_EMPTY_0814,
-	EEPROM_DATA_ID_EMPTY_0815,
-	EEPROM_DATA_ID_EMPTY_0816,
-	EEPROM_DATA_ID_EMPTY_0817,
-	EEPROM_DATA_ID_EMPTY_0818,
-	EEPROM_DATA_ID_EMPTY_0819,
-	EEPROM_DATA_ID_EMPTY_0820,
-	EEPROM_DATA_ID_EMPTY_0821,
-	EEPROM_DATA_ID_EMPTY_0822,
-	EEPROM_DATA_ID_EMPTY_0823,
-	EEPROM_DATA_ID_EMPTY_0824,
-	EEPROM_DATA_ID_EMPTY_0825,
-	EEPROM_DATA_ID_EMPTY_0826,
-	EEPROM_DATA_ID_EMPTY_0827,
-	EEPROM_DATA_ID_EMPTY_0828,
-	EEPROM_DATA_ID_EMPTY_0829,
-	EEPROM_DATA_ID_EMPTY_0830,
-	EEPROM_DATA_ID_EMPTY_0831,
-	EEPROM_DATA_ID_EMPTY_0832,
-	EEPROM_DATA_ID_EMPTY_0833,
-	EEPROM_DATA_ID_EMPTY_0834,
-	EEPROM_DATA_ID_EMPTY_0835,
-	EEPROM_DATA_ID_EMPTY_0836,
-	EEPROM_DATA_ID_EMPTY_0837,
-	EEPROM_DATA_ID_EMPTY_0838,
-	EEPROM_DATA_ID_EMPTY_0839,
-	EEPROM_DATA_ID_EMPTY_0840,
-	EEPROM_DATA_ID_EMPTY_0841,
-	EEPROM_DATA_ID_EMPTY_0842,
-	EEPROM_DATA_ID_EMPTY_0843,
-	EEPROM_DATA_ID_EMPTY_0844,
-	EEPROM_DATA_ID_EMPTY_0845,
-	EEPROM_DATA_ID_EMPTY_0846,
-	EEPROM_DATA_ID_EMPTY_0847,
-	EEPROM_DATA_ID_EMPTY_0848,
-	EEPROM_DATA_ID_EMPTY_0849,
-	EEPROM_DATA_ID_EMPTY_0850,
-	EEPROM_DATA_ID_EMPTY_0851,
-	EEPROM_DATA_ID_EMPTY_0852,
-	EEPROM_DATA_ID_EMPTY_0853,
-	EEPROM_DATA_ID_EMPTY_0854,
-	EEPROM_DATA_ID_EMPTY_0855,
-	EEPROM_DATA_ID_EMPTY_0856,
-	EEPROM_DATA_ID_EMPTY_0857,
-	EEPROM_DATA_ID_EMPTY_0858,
-	EEPROM_DATA_ID_EMPTY_0859,
-	EEPROM_DATA_ID_EMPTY_0860,
-	EEPROM_DATA_ID_EMPTY_0861,
-	EEPROM_DATA_ID_EMPTY_0862,
-	EEPROM_DATA_ID_EMPTY_0863,
-	EEPROM_DATA_ID_EMPTY_0864,
-	EEPROM_DATA_ID_EMPTY_0865,
-	EEPROM_DATA_ID_EMPTY_0866,
-	EEPROM_DATA_ID_EMPTY_0867,
-	EEPROM_DATA_ID_EMPTY_0868,
-	EEPROM_DATA_ID_EMPTY_0869,
-	EEPROM_DATA_ID_EMPTY_0870,
-	EEPROM_DATA_ID_EMPTY_0871,
-	EEPROM_DATA_ID_EMPTY_0872,
-	EEPROM_DATA_ID_EMPTY_0873,
-	EEPROM_DATA_ID_EMPTY_0874,
-	EEPROM_DATA_ID_EMPTY_0875,
-	EEPROM_DATA_ID_EMPTY_0876,
-	EEPROM_DATA_ID_EMPTY_0877,
-	EEPROM_DATA_ID_EMPTY_0878,
-	EEPROM_DATA_ID_EMPTY_0879,
-	EEPROM_DATA_ID_EMPTY_0880,
-	EEPROM_DATA_ID_EMPTY_0881,
-	EEPROM_DATA_ID_EMPTY_0882,
-	EEPROM_DATA_ID_EMPTY_0883,
-	EEPROM_DATA_ID_EMPTY_0884,
-	EEPROM_DATA_ID_EMPTY_0885,
-	EEPROM_DATA_ID_EMPTY_0886,
-	EEPROM_DATA_ID_EMPTY_0887,
-	EEPROM_DATA_ID_EMPTY_0888,
-	EEPROM_DATA_ID_EMPTY_0889,
-	EEPROM_DATA_ID_EMPTY_0890,
-	EEPROM_DATA_ID_EMPTY_0891,
-	EEPROM_DATA_ID_EMPTY_0892,
-	EEPROM_DATA_ID_EMPTY_0893,
-	EEPROM_DATA_ID_EMPTY_0894,
-	EEPROM_DATA_ID_EMPTY_0895,
-	EEPROM_DATA_ID_EMPTY_0896,
-	EEPROM_DATA_ID_EMPTY_0897,
-	EEPROM_DATA_ID_EMPTY_0898,
-	EEPROM_DATA_ID_EMPTY_0899,
-	EEPROM_DATA_ID_EMPTY_0900,
-	EEPROM_DATA_ID_EMPTY_0901,
-	EEPROM_DATA_ID_EMPTY_0902,
-	EEPROM_DATA_ID_EMPTY_0903,
-	EEPROM_DATA_ID_EMPTY_0904,
-	EEPROM_DATA_ID_EMPTY_0905,
-	EEPROM_DATA_ID_EMPTY_0906,
-	EEPROM_DATA_ID_EMPTY_0907,
-	EEPROM_DATA_ID_EMPTY_0908,
-	EEPROM_DATA_ID_EMPTY_0909,
-	EEPROM_DATA_ID_EMPTY_0910,
-	EEPROM_DATA_ID_EMPTY_0911,
-	EEPROM_DATA_ID_EMPTY_0912,
-	EEPROM_DATA_ID_EMPTY_0913,
-	EEPROM_DATA_ID_EMPTY_0914,
-	EEPROM_DATA_ID_EMPTY_0915,
-	EEPROM_DATA_ID_EMPTY_0916,
-	EEPROM_DATA_ID_EMPTY_0917,
-	EEPROM_DATA_ID_EMPTY_0918,
-	EEPROM_DATA_ID_EMPTY_0919,
-	EEPROM_DATA_ID_EMPTY_0920,
-	EEPROM_DATA_ID_EMPTY_0921,
-	EEPROM_DATA_ID_EMPTY_0922,
-	EEPROM_DATA_ID_EMPTY_0923,
-	EEPROM_DATA_ID_EMPTY_0924,
-	EEPROM_DATA_ID_EMPTY_0925,
-	EEPROM_DATA_ID_EMPTY_0926,
-	EEPROM_DATA_ID_EMPTY_0927,
-	EEPROM_DATA_ID_EMPTY_0928,
-	EEPROM_DATA_ID_EMPTY_0929,
-	EEPROM_DATA_ID_EMPTY_0930,
-	EEPROM_DATA_ID_EMPTY_0931,
-	EEPROM_DATA_ID_EMPTY_0932,
-	EEPROM_DATA_ID_EMPTY_0933,
-	EEPROM_DATA_ID_EMPTY_0934,
-	EEPROM_DATA_ID_EMPTY_0935,
-	EEPROM_DATA_ID_EMPTY_0936,
-	EEPROM_DATA_ID_EMPTY_0937,
-	EEPROM_DATA_ID_EMPTY_0938,
-	EEPROM_DATA_ID_EMPTY_0939,
-	EEPROM_DATA_ID_EMPTY_0940,
-	EEPROM_DATA_ID_EMPTY_0941,
-	EEPROM_DATA_ID_EMPTY_0942,
-	EEPROM_DATA_ID_EMPTY_0943,
-	EEPROM_DATA_ID_EMPTY_0944,
-	EEPROM_DATA_ID_EMPTY_0945,
-	EEPROM_DATA_ID_EMPTY_0946,
-	EEPROM_DATA_ID_EMPTY_0947,
-	EEPROM_DATA_ID_EMPTY_0948,
-	EEPROM_DATA_ID_EMPTY_0949,
-	EEPROM_DATA_ID_EMPTY_0950,
-	EEPROM_DATA_ID_EMPTY_0951,
-	EEPROM_DATA_ID_EMPTY_0952,
-	EEPROM_DATA_ID_EMPTY_0953,
-	EEPROM_DATA_ID_EMPTY_0954,
-	EEPROM_DATA_ID_EMPTY_0955,
-	EEPROM_DATA_ID_EMPTY_0956,
-	EEPROM_DATA_ID_EMPTY_0957,
-	EEPROM_DATA_ID_EMPTY_0958,
-	EEPROM_DATA_ID_EMPTY_0959,
-	EEPROM_DATA_ID_EMPTY_0960,
-	EEPROM_DATA_ID_EMPTY_0961,
-	EEPROM_DATA_ID_EMPTY_0962,
-	EEPROM_DATA_ID_EMPTY_0963,
-	EEPROM_DATA_ID_EMPTY_0964,
-	EEPROM_DATA_ID_EMPTY_0965,
-	EEPROM_DATA_ID_EMPTY_0966,
-	EEPROM_DATA_ID_EMPTY_0967,
-	EEPROM_DATA_ID_EMPTY_0968,
-	EEPROM_DATA_ID_EMPTY_0969,
-	EEPROM_DATA_ID_EMPTY_0970,
-	EEPROM_DATA_ID_EMPTY_0971,
-	EEPROM_DATA_ID_EMPTY_0972,
-	EEPROM_DATA_ID_EMPTY_0973,
-	EEPROM_DATA_ID_EMPTY_0974,
-	EEPROM_DATA_ID_EMPTY_0975,
-	EEPROM_DATA_ID_EMPTY_0976,
-	EEPROM_DATA_ID_EMPTY_0977,
-	EEPROM_DATA_ID_EMPTY_0978,
-	EEPROM_DATA_ID_EMPTY_0979,
-	EEPROM_DATA_ID_EMPTY_0980,
-	EEPROM_DATA_ID_EMPTY_0981,
-	EEPROM_DATA_ID_EMPTY_0982,
-	EEPROM_DATA_ID_EMPTY_0983,
-	EEPROM_DATA_ID_EMPTY_0984,
-	EEPROM_DATA_ID_EMPTY_0985,
-	EEPROM_DATA_ID_EMPTY_0986,
-	EEPROM_DATA_ID_EMPTY_0987,
-	EEPROM_DATA_ID_EMPTY_0988,
-	EEPROM_DATA_ID_EMPTY_0989,
-	EEPROM_DATA_ID_EMPTY_0990,
-	EEPROM_DATA_ID_EMPTY_0991,
-	EEPROM_DATA_ID_EMPTY_0992,
-	EEPROM_DATA_ID_EMPTY_0993,
-	EEPROM_DATA_ID_EMPTY_0994,
-	EEPROM_DATA_ID_EMPTY_0995,
-	EEPROM_DATA_ID_EMPTY_0996,
-	EEPROM_DATA_ID_EMPTY_0997,
-	EEPROM_DATA_ID_EMPTY_0998,
-	EEPROM_DATA_ID_EMPTY_0999,
-	EEPROM_DATA_ID_EMPTY_1000,
-	EEPROM_DATA_ID_EMPTY_1001,
-	EEPROM_DATA_ID_EMPTY_1002,
-	EEPROM_DATA_ID_EMPTY_1003,
-	EEPROM_DATA_ID_EMPTY_1004,
-	EEPROM_DATA_ID_EMPTY_1005,
-	EEPROM_DATA_ID_EMPTY_1006,
-	EEPROM_DATA_ID_EMPTY_1007,
-	EEPROM_DATA_ID_EMPTY_1008,
-	EEPROM_DATA_ID_EMPTY_1009,
-	EEPROM_DATA_ID_EMPTY_1010,
-	EEPROM_DATA_ID_EMPTY_1011,
-	EEPROM_DATA_ID_EMPTY_1012,
-	EEPROM_DATA_ID_EMPTY_1013,
-	EEPROM_DATA_ID_EMPTY_1014,
-	EEPROM_DATA_ID_EMPTY_1015,
-	EEPROM_DATA_ID_EMPTY_1016,
-	EEPROM_DATA_ID_EMPTY_1017,
-	EEPROM_DATA_ID_EMPTY_1018,
-	EEPROM_DATA_ID_EMPTY_1019,
-	EEPROM_DATA_ID_EMPTY_1020,
-	EEPROM_DATA_ID_EMPTY_1021,
-	EEPROM_DATA_ID_EMPTY_1022,
-	EEPROM_DATA_ID_EMPTY_1023
-} eeprom_data_id_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-#endif /* DRV_EEPROM_ID_H_ */
+/*
+ * drv_eeprom_id.h
+ *
+ *  Created on: Aug 2, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_EEPROM_ID_H_
+#define DRV_EEPROM_ID_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* EEPROM(25LC080C)の容量 [byte] */
+#define EEPROM_SIZE			(1024)
+
+/* EEPROM(25LC080C)のページサイズ [byte] */
+#define EEPROM_PAGE_SIZE	(16)
+
+/*
+ * EEPROMレイアウト定義
+ *   EEPROM_RECORD(ID名, 型)      : 型付きデータ、読み出し/書き込みは全体を1回で行う(ページを跨がないこと)
+ *   EEPROM_AREA(ID名, サイズ)    : バイト列の領域、上位モジュールが独自の形式で管理する
+ * 先頭から記載順に隙間なく配置し、合計をEEPROM容量と一致させること(drv_eeprom.cでコンパイル時に検査)
+ */
+#define EEPROM_LAYOUT(EEPROM_RECORD, EEPROM_AREA)									\
+	EEPROM_RECORD(STICK_CALIB,	eeprom_stick_calib_t)	/* 0x000 ジョイスティックキャリブレーション */	\
+	EEPROM_AREA(FREE_000E,		0x0F2)					/* 0x00E 未使用 */							\
+	EEPROM_AREA(SAVEDATA,		0x180)					/* 0x100 セーブデータ(drv_savedata) */		\
+	EEPROM_AREA(SAVERING,		0x180)					/* 0x280 書き込み分散記録(drv_savedata) */
+
+/* レイアウト定義の展開用 */
+#define EEPROM_LAYOUT_ID_RECORD(id, type)		EEPROM_DATA_ID_##id,
+#define EEPROM_LAYOUT_ID_AREA(id, size)			EEPROM_DATA_ID_##id,
+#define EEPROM_LAYOUT_MEMBER_RECORD(id, type)	type id;
+#define EEPROM_LAYOUT_MEMBER_AREA(id, size)		uint8_t id[size];
+
+/********** Enum **********/
+
+typedef enum {
+	EEPROM_LAYOUT(EEPROM_LAYOUT_ID_RECORD, EEPROM_LAYOUT_ID_AREA)
+	EEPROM_DATA_ID_NUM
+} eeprom_data_id_t;
+
+/********** Type **********/
+
+/* ジョイスティックキャリブレーション値(AD変換値) */
+typedef struct {
+	uint16_t min;
+	uint16_t center;
+	uint16_t max;
+} eeprom_stick_axis_t;
+
+typedef struct {
+	uint16_t magic;						/* 識別値(書き込み済み判定用) */
+	eeprom_stick_axis_t axis[2];		/* 水平、垂直 */
+} eeprom_stick_calib_t;
+
+/* EEPROM全体の配置(オフセット、サイズの算出に使用) */
+typedef struct {
+	EEPROM_LAYOUT(EEPROM_LAYOUT_MEMBER_RECORD, EEPROM_LAYOUT_MEMBER_AREA)
+} eeprom_layout_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+#endif /* DRV_EEPROM_ID_H_ */
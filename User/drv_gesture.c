@@ -0,0 +1,456 @@
+/*
+ * drv_gesture.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include <math.h>
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "drv_touch.h"
+#include "drv_gesture.h"
+
+/********** Define **********/
+
+/* 接触なし */
+#define GESTURE_CONTACT_NONE		(TOUCH_CONTACT_NUM)
+
+/* タップ、長押しと判定する移動量の上限 [px] */
+#define GESTURE_MOVE_THRESHOLD		(10.0f)
+/* タップと判定する接触時間の上限 [us] */
+#define GESTURE_TAP_TIME_MAX		(250000)
+/* ダブルタップと判定するタップ間隔の上限 [us] */
+#define GESTURE_DOUBLE_TAP_INTERVAL	(300000)
+/* ダブルタップと判定するタップ位置の距離の上限 [px] */
+#define GESTURE_DOUBLE_TAP_DISTANCE	(30.0f)
+/* 長押しと判定する接触時間 [us] */
+#define GESTURE_LONG_PRESS_TIME		(500000)
+/* スワイプと判定する速度の下限 [px/s] */
+#define GESTURE_SWIPE_SPEED_MIN		(300.0f)
+/* 速度算出に使用する座標履歴数 [周期] */
+#define GESTURE_HISTORY_NUM			(4)
+/* 慣性スクロールの1周期あたりの減衰率 */
+#define GESTURE_FLICK_FRICTION		(0.95f)
+/* 慣性スクロールを停止する速度 [px/s] */
+#define GESTURE_FLICK_STOP_SPEED	(20.0f)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+typedef struct {
+	point_t point;
+	uint32_t time;
+} gesture_history_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+static gesture_event_t gesture_event[GESTURE_EVENT_NUM_MAX];
+static uint32_t gesture_event_num;
+
+/* 1本目の指 */
+static uint32_t primary_contact;
+static uint32_t primary_start_time;
+static bool_t primary_moved;
+static bool_t primary_long_press;
+static point_t primary_last_point;
+static gesture_history_t primary_history[GESTURE_HISTORY_NUM];
+static uint32_t primary_history_index;
+
+/* 2本目の指 */
+static uint32_t secondary_contact;
+static bool_t pinch_used;
+static point_t pinch_start_vector;
+
+/* ダブルタップ判定用 */
+static bool_t last_tap_valid;
+static uint32_t last_tap_time;
+static point_t last_tap_point;
+
+/* スクロール */
+static point_t scroll_delta;
+static point_t scroll_velocity;
+static uint32_t last_time;
+
+/********** Function Prototype **********/
+
+static void startPrimary(uint32_t contact_index, const touch_contact_t* contact, uint32_t time);
+static void updatePrimary(const touch_contact_t* contact, uint32_t time);
+static void finishPrimary(const touch_contact_t* contact, uint32_t time);
+static void updatePinch(const touch_contact_t* primary, const touch_contact_t* secondary);
+static void updateInertia(uint32_t time);
+static gesture_event_t* addGestureEvent(gesture_type_t type, point_t point);
+static bool_t isContactActive(const touch_contact_t* contact);
+static float getDistanceSquare(point_t a, point_t b);
+
+/********** Function **********/
+
+/*
+ * Function: DRV GESTURE 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitGesture(void)
+{
+	gesture_event_num = 0;
+	primary_contact = GESTURE_CONTACT_NONE;
+	secondary_contact = GESTURE_CONTACT_NONE;
+	pinch_used = FALSE;
+	last_tap_valid = FALSE;
+	scroll_delta.x = 0.0f;
+	scroll_delta.y = 0.0f;
+	scroll_velocity.x = 0.0f;
+	scroll_velocity.y = 0.0f;
+	last_time = GetTimeUs();
+}
+
+/*
+ * Function: DRV GESTURE 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : MainTouchの後に呼び出す
+ *           処理量は接触テーブルの要素数で上限が決まる
+ */
+void MainGesture(void)
+{
+	uint32_t time = GetTimeUs();
+	touch_contact_t primary;
+	touch_contact_t secondary;
+	touch_contact_t contact;
+
+	gesture_event_num = 0;
+	scroll_delta.x = 0.0f;
+	scroll_delta.y = 0.0f;
+
+	/* 1本目の指 */
+	if (primary_contact != GESTURE_CONTACT_NONE) {
+		primary = GetTouchContact(primary_contact);
+		if (isContactActive(&primary) == TRUE) {
+			updatePrimary(&primary, time);
+		} else {
+			finishPrimary(&primary, time);
+		}
+	}
+	if (primary_contact == GESTURE_CONTACT_NONE) {
+		/* 接触中の指を1本目とする(1本目の終了と同じ周期に触れた指、ピンチ後に残った指を含む) */
+		for (uint32_t index=0; index<TOUCH_CONTACT_NUM; index++) {
+			contact = GetTouchContact(index);
+			if (isContactActive(&contact) == TRUE) {
+				startPrimary(index, &contact, time);
+				break;
+			}
+		}
+	}
+
+	/* 2本目の指 */
+	if (primary_contact != GESTURE_CONTACT_NONE) {
+		primary = GetTouchContact(primary_contact);
+		if (secondary_contact == GESTURE_CONTACT_NONE) {
+			for (uint32_t index=0; index<TOUCH_CONTACT_NUM; index++) {
+				contact = GetTouchContact(index);
+				if ((index != primary_contact) && (isContactActive(&contact) == TRUE)) {
+					/* ピンチ開始(以降タップ、スワイプとは判定しない) */
+					secondary_contact = index;
+					pinch_used = TRUE;
+					pinch_start_vector.x = contact.point.x - primary.point.x;
+					pinch_start_vector.y = contact.point.y - primary.point.y;
+					break;
+				}
+			}
+		} else {
+			secondary = GetTouchContact(secondary_contact);
+			if (isContactActive(&secondary) == TRUE) {
+				updatePinch(&primary, &secondary);
+			} else {
+				secondary_contact = GESTURE_CONTACT_NONE;
+			}
+		}
+	} else {
+		secondary_contact = GESTURE_CONTACT_NONE;
+		/* 指が離れている間は慣性スクロール */
+		updateInertia(time);
+	}
+
+	last_time = time;
+}
+
+/*
+ * Function: ジェスチャイベント数取得
+ * Argument: なし
+ * Return  : 今周期に発生したジェスチャイベント数
+ * Note    : なし
+ */
+uint32_t GetGestureEventNum(void)
+{
+	return gesture_event_num;
+}
+
+/*
+ * Function: ジェスチャイベント取得
+ * Argument: イベントインデックス(発生順)
+ * Return  : ジェスチャイベント
+ * Note    : なし
+ */
+gesture_event_t GetGestureEvent(uint32_t index)
+{
+	gesture_event_t event = {GESTURE_TAP, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, 1.0f, 0.0f};
+
+	if (index < gesture_event_num) {
+		event = gesture_event[index];
+	}
+
+	return event;
+}
+
+/*
+ * Function: スクロール量取得
+ * Argument: なし
+ * Return  : 今周期のスクロール量 [px]
+ * Note    : ドラッグ中は指の移動量、スワイプ後は減衰する慣性移動量
+ */
+point_t GetScrollDelta(void)
+{
+	return scroll_delta;
+}
+
+/*
+ * Function: 1本目の指の接触開始
+ * Argument: 接触テーブルのインデックス、接触、現在時刻
+ * Return  : なし
+ * Note    : 接触開始以外の周期から1本目とした指(ピンチ後に残った指)は、触れた時刻が不明なため
+ *           タップ、長押し、スワイプと判定しない
+ */
+static void startPrimary(uint32_t contact_index, const touch_contact_t* contact, uint32_t time)
+{
+	primary_contact = contact_index;
+	primary_start_time = time;
+	primary_moved = FALSE;
+	primary_long_press = FALSE;
+	primary_last_point = contact->point;
+	for (uint32_t index=0; index<GESTURE_HISTORY_NUM; index++) {
+		primary_history[index].point = contact->point;
+		primary_history[index].time = time;
+	}
+	primary_history_index = 0;
+	if (contact->state == TOUCH_CONTACT_START) {
+		pinch_used = FALSE;
+	} else {
+		pinch_used = TRUE;
+	}
+
+	/* 触れたら慣性スクロールを停止 */
+	scroll_velocity.x = 0.0f;
+	scroll_velocity.y = 0.0f;
+}
+
+/*
+ * Function: 1本目の指の接触中処理
+ * Argument: 接触、現在時刻
+ * Return  : なし
+ * Note    : なし
+ */
+static void updatePrimary(const touch_contact_t* contact, uint32_t time)
+{
+	gesture_event_t* event;
+
+	if ((primary_moved == FALSE)
+	 && (getDistanceSquare(contact->point, contact->start_point) > GESTURE_MOVE_THRESHOLD * GESTURE_MOVE_THRESHOLD)) {
+		primary_moved = TRUE;
+	}
+
+	if (secondary_contact == GESTURE_CONTACT_NONE) {
+		if (primary_moved == TRUE) {
+			/* ドラッグ */
+			scroll_delta.x = contact->point.x - primary_last_point.x;
+			scroll_delta.y = contact->point.y - primary_last_point.y;
+			event = addGestureEvent(GESTURE_DRAG, contact->point);
+			if (event != NULL) {
+				event->delta = scroll_delta;
+			}
+		} else if ((primary_long_press == FALSE) && (pinch_used == FALSE)
+				&& ((time - primary_start_time) >= GESTURE_LONG_PRESS_TIME)) {
+			/* 長押し */
+			primary_long_press = TRUE;
+			addGestureEvent(GESTURE_LONG_PRESS, contact->point);
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	/* 速度算出用の履歴を更新 */
+	primary_history[primary_history_index].point = contact->point;
+	primary_history[primary_history_index].time = time;
+	if (primary_history_index < GESTURE_HISTORY_NUM - 1) {
+		primary_history_index ++;
+	} else {
+		primary_history_index = 0;
+	}
+
+	primary_last_point = contact->point;
+}
+
+/*
+ * Function: 1本目の指の接触終了
+ * Argument: 接触、現在時刻
+ * Return  : なし
+ * Note    : タップ、ダブルタップ、スワイプを判定する
+ */
+static void finishPrimary(const touch_contact_t* contact, uint32_t time)
+{
+	gesture_event_t* event;
+	gesture_history_t* oldest = &primary_history[primary_history_index];
+	point_t velocity;
+	float duration;
+
+	if (pinch_used == TRUE) {
+		/* ピンチ後はジェスチャなし */
+	} else if ((primary_moved == FALSE) && (primary_long_press == FALSE)
+			&& ((time - primary_start_time) < GESTURE_TAP_TIME_MAX)) {
+		/* タップ */
+		addGestureEvent(GESTURE_TAP, contact->point);
+		if ((last_tap_valid == TRUE)
+		 && ((time - last_tap_time) < GESTURE_DOUBLE_TAP_INTERVAL)
+		 && (getDistanceSquare(contact->point, last_tap_point) < GESTURE_DOUBLE_TAP_DISTANCE * GESTURE_DOUBLE_TAP_DISTANCE)) {
+			addGestureEvent(GESTURE_DOUBLE_TAP, contact->point);
+			last_tap_valid = FALSE;
+		} else {
+			last_tap_valid = TRUE;
+			last_tap_time = time;
+			last_tap_point = contact->point;
+		}
+	} else if ((primary_moved == TRUE) && (time != oldest->time)) {
+		/* 直近の履歴から離した時の速度を算出 */
+		duration = (time - oldest->time) / 1000000.0f;
+		velocity.x = (contact->point.x - oldest->point.x) / duration;
+		velocity.y = (contact->point.y - oldest->point.y) / duration;
+		if ((velocity.x * velocity.x + velocity.y * velocity.y) >= GESTURE_SWIPE_SPEED_MIN * GESTURE_SWIPE_SPEED_MIN) {
+			/* スワイプ(慣性スクロール開始) */
+			event = addGestureEvent(GESTURE_SWIPE, contact->point);
+			if (event != NULL) {
+				event->velocity = velocity;
+			}
+			scroll_velocity = velocity;
+		}
+	} else {
+		/* 処理なし */
+	}
+
+	/* 1本目の指が離れたらピンチも終了 */
+	primary_contact = GESTURE_CONTACT_NONE;
+	secondary_contact = GESTURE_CONTACT_NONE;
+}
+
+/*
+ * Function: ピンチ更新
+ * Argument: 1本目の指の接触、2本目の指の接触
+ * Return  : なし
+ * Note    : 開始時の2本指のベクトルとの比と角度から拡大率と回転角を算出する
+ */
+static void updatePinch(const touch_contact_t* primary, const touch_contact_t* secondary)
+{
+	gesture_event_t* event;
+	point_t center;
+	point_t vector;
+	float start_length_square;
+
+	center.x = (primary->point.x + secondary->point.x) / 2.0f;
+	center.y = (primary->point.y + secondary->point.y) / 2.0f;
+	vector.x = secondary->point.x - primary->point.x;
+	vector.y = secondary->point.y - primary->point.y;
+
+	event = addGestureEvent(GESTURE_PINCH, center);
+	if (event != NULL) {
+		start_length_square = pinch_start_vector.x * pinch_start_vector.x + pinch_start_vector.y * pinch_start_vector.y;
+		if (start_length_square < 1.0f) {
+			start_length_square = 1.0f;
+		}
+		event->scale = sqrtf((vector.x * vector.x + vector.y * vector.y) / start_length_square);
+		event->rotation = atan2f(pinch_start_vector.x * vector.y - pinch_start_vector.y * vector.x,
+								 pinch_start_vector.x * vector.x + pinch_start_vector.y * vector.y);
+	}
+}
+
+/*
+ * Function: 慣性スクロール更新
+ * Argument: 現在時刻
+ * Return  : なし
+ * Note    : なし
+ */
+static void updateInertia(uint32_t time)
+{
+	float elapsed = (time - last_time) / 1000000.0f;
+
+	if ((scroll_velocity.x * scroll_velocity.x + scroll_velocity.y * scroll_velocity.y)
+	  < GESTURE_FLICK_STOP_SPEED * GESTURE_FLICK_STOP_SPEED) {
+		scroll_velocity.x = 0.0f;
+		scroll_velocity.y = 0.0f;
+	} else {
+		scroll_delta.x = scroll_velocity.x * elapsed;
+		scroll_delta.y = scroll_velocity.y * elapsed;
+		scroll_velocity.x *= GESTURE_FLICK_FRICTION;
+		scroll_velocity.y *= GESTURE_FLICK_FRICTION;
+	}
+}
+
+/*
+ * Function: ジェスチャイベント追加
+ * Argument: ジェスチャ種別、座標
+ * Return  : 追加したイベント(追加できない場合はNULL)
+ * Note    : 種別毎の値は呼び出し元で設定する
+ */
+static gesture_event_t* addGestureEvent(gesture_type_t type, point_t point)
+{
+	gesture_event_t* event = NULL;
+
+	if (gesture_event_num < GESTURE_EVENT_NUM_MAX) {
+		event = &gesture_event[gesture_event_num];
+		event->type = type;
+		event->point = point;
+		event->delta.x = 0.0f;
+		event->delta.y = 0.0f;
+		event->velocity.x = 0.0f;
+		event->velocity.y = 0.0f;
+		event->scale = 1.0f;
+		event->rotation = 0.0f;
+		gesture_event_num ++;
+	}
+
+	return event;
+}
+
+/*
+ * Function: 接触中判定
+ * Argument: 接触
+ * Return  : TRUE:接触中、FALSE:接触なしまたは終了
+ * Note    : なし
+ */
+static bool_t isContactActive(const touch_contact_t* contact)
+{
+	bool_t active = FALSE;
+
+	if ((contact->state == TOUCH_CONTACT_START)
+	 || (contact->state == TOUCH_CONTACT_MOVE)
+	 || (contact->state == TOUCH_CONTACT_STAY)) {
+		active = TRUE;
+	}
+
+	return active;
+}
+
+/*
+ * Function: 2点間の距離の2乗
+ * Argument: 座標、座標
+ * Return  : 距離の2乗
+ * Note    : なし
+ */
+static float getDistanceSquare(point_t a, point_t b)
+{
+	return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+}
@@ -0,0 +1,56 @@
+/*
+ * drv_gesture.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_GESTURE_H_
+#define DRV_GESTURE_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 1周期に発生するジェスチャの最大数 */
+#define GESTURE_EVENT_NUM_MAX	(4)
+
+/********** Enum **********/
+
+typedef enum {
+	GESTURE_TAP = 0,			/* タップ */
+	GESTURE_DOUBLE_TAP,			/* ダブルタップ(2回目のタップと同じ周期に発生) */
+	GESTURE_LONG_PRESS,			/* 長押し */
+	GESTURE_DRAG,				/* 1本指で移動中(毎周期) */
+	GESTURE_SWIPE,				/* 1本指で払って離した */
+	GESTURE_PINCH				/* 2本指で操作中(毎周期) */
+} gesture_type_t;
+
+/********** Type **********/
+
+/* ジェスチャイベント */
+typedef struct {
+	gesture_type_t type;
+	point_t point;				/* 座標(GESTURE_PINCHは2本指の中点) */
+	point_t delta;				/* GESTURE_DRAG: 前周期からの移動量 */
+	point_t velocity;			/* GESTURE_SWIPE: 離した時の速度 [px/s] */
+	float scale;				/* GESTURE_PINCH: 開始時からの拡大率 */
+	float rotation;				/* GESTURE_PINCH: 開始時からの回転角 [rad] */
+} gesture_event_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitGesture(void);
+void MainGesture(void);
+uint32_t GetGestureEventNum(void);
+gesture_event_t GetGestureEvent(uint32_t index);
+point_t GetScrollDelta(void);
+
+#endif /* DRV_GESTURE_H_ */
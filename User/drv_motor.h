@@ -1,32 +1,32 @@
-/*
- * drv_motor.h
- *
- *  Created on: 2023/07/08
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_MOTOR_H_
-#define DRV_MOTOR_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitMotor(void);
-void StartMotor(uint32_t time);
-void StopMotor(void);
-
-#endif /* DRV_MOTOR_H_ */
+/*
+ * drv_motor.h
+ *
+ *  Created on: 2023/07/08
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_MOTOR_H_
+#define DRV_MOTOR_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitMotor(void);
+void StartMotor(uint32_t time);
+void StopMotor(void);
+
+#endif /* DRV_MOTOR_H_ */
@@ -0,0 +1,704 @@
+/*
+ * drv_savedata.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include <stddef.h>
+#include "typedef.h"
+#include "drv_eeprom.h"
+#include "drv_savedata.h"
+
+/********** Define **********/
+
+/* スロットのヘッダサイズ [byte] (1ページに収める) */
+#define SAVEDATA_HEADER_SIZE	(EEPROM_PAGE_SIZE)
+
+/* ヘッダの識別値 */
+#define SAVEDATA_MAGIC			(0x5A5D)
+
+/* ヘッダ内の配置 [byte] */
+#define HEADER_OFFSET_MAGIC		(0)		/* 識別値(2byte) */
+#define HEADER_OFFSET_SEQ		(2)		/* 書き込み通し番号(4byte) */
+#define HEADER_OFFSET_LENGTH	(6)		/* データサイズ(2byte) */
+#define HEADER_OFFSET_CRC		(8)		/* 通し番号、データサイズ、データのCRC32(4byte) */
+
+/* 書き込み分散記録のエントリ内の配置 [byte] */
+#define RING_OFFSET_SEQ			(0)		/* 書き込み通し番号(4byte) */
+#define RING_OFFSET_DATA		(4)		/* データ(SAVERING_DATA_SIZE) */
+#define RING_OFFSET_CRC			(RING_OFFSET_DATA + SAVERING_DATA_SIZE)	/* 通し番号、データのCRC32(4byte) */
+/* 書き込み分散記録のエントリサイズ [byte] (1ページに収め、1回の書き込みで完了させる) */
+#define RING_ENTRY_SIZE			(RING_OFFSET_CRC + 4)
+
+/* CRC32(IEEE 802.3)の生成多項式(反転) */
+#define CRC32_POLYNOMIAL		(0xEDB88320)
+
+/********** Enum **********/
+
+typedef enum {
+	SAVEDATA_STATE_IDLE = 0,
+	SAVEDATA_STATE_WRITE_BODY,		/* データの書き込み完了待ち */
+	SAVEDATA_STATE_WRITE_HEADER		/* ヘッダの書き込み完了待ち */
+} savedata_state_t;
+
+/********** Type **********/
+
+typedef struct {
+	uint16_t offset;				/* EEPROM_DATA_ID_SAVEDATA内の配置先頭(ページ境界に合わせること) */
+	uint16_t size;					/* データサイズ */
+	uint32_t slot_num;				/* スロット数(2以上) */
+} savedata_info_t;
+
+typedef struct {
+	savedata_state_t state;
+	bool_t valid;					/* 有効なスロットあり */
+	uint32_t slot;					/* 最新の有効なスロット */
+	uint32_t seq;					/* 最新の有効なスロットの通し番号 */
+	uint32_t write_slot;			/* 書き込み中のスロット */
+	uint8_t write_header[SAVEDATA_HEADER_SIZE];	/* 書き込み中のスロットのヘッダ */
+} savedata_record_t;
+
+typedef struct {
+	uint16_t offset;				/* EEPROM_DATA_ID_SAVERING内の配置先頭(ページ境界に合わせること) */
+	uint32_t entry_num;				/* エントリ数(領域サイズ / RING_ENTRY_SIZE) */
+} savering_info_t;
+
+typedef struct {
+	bool_t valid;					/* 有効なエントリあり */
+	uint32_t head;					/* 最新のエントリ */
+	uint32_t seq;					/* 最新のエントリの通し番号 */
+} savering_record_t;
+
+/********** Constant **********/
+
+/* 各スロット、エントリのページ境界を領域の配置先頭で保証する */
+_Static_assert((offsetof(eeprom_layout_t, SAVEDATA) % EEPROM_PAGE_SIZE) == 0, "SAVEDATA area must be page aligned");
+_Static_assert((offsetof(eeprom_layout_t, SAVERING) % EEPROM_PAGE_SIZE) == 0, "SAVERING area must be page aligned");
+_Static_assert((EEPROM_PAGE_SIZE % RING_ENTRY_SIZE) == 0, "Ring entry must not cross a page boundary");
+
+/*
+ * スロットはヘッダ1ページ + データ(ページ単位に切り上げ)で構成し、記録ごとにスロット数分を連続して配置する
+ * 設定: 0x000 - 0x05F (48byte x 2スロット)
+ * ゲーム進行: 0x060 - 0x17F (144byte x 2スロット)
+ */
+static const savedata_info_t savedata_info_table[SAVEDATA_ID_NUM] = {
+	/* 配置先頭	データサイズ				スロット数 */
+	{0x000,	SAVEDATA_SIZE_SETTING,	2},	/* SAVEDATA_ID_SETTING */
+	{0x060,	SAVEDATA_SIZE_GAME,		2}	/* SAVEDATA_ID_GAME */
+};
+
+/*
+ * 書き込み分散記録は領域内のエントリへ順に追記し、末尾の次は先頭へ戻る
+ * プレイ時間: 0x000 - 0x0FF (16byte x 16エントリ)
+ * 起動回数: 0x100 - 0x17F (16byte x 8エントリ)
+ */
+static const savering_info_t savering_info_table[SAVERING_ID_NUM] = {
+	/* 配置先頭	エントリ数 */
+	{0x000,	16},	/* SAVERING_ID_PLAY_TIME */
+	{0x100,	8}		/* SAVERING_ID_BOOT_COUNT */
+};
+
+/********** Variable **********/
+
+static savedata_record_t savedata_record[SAVEDATA_ID_NUM];
+static savering_record_t savering_record[SAVERING_ID_NUM];
+
+/* EEPROMのRAMミラーから最新のスロット、エントリを探索済み */
+static bool_t savedata_scanned;
+
+/********** Function Prototype **********/
+
+static uint16_t getSlotSize(savedata_id_t savedata_id);
+static uint16_t getSlotHeaderOffset(savedata_id_t savedata_id, uint32_t slot);
+static uint16_t getSlotBodyOffset(savedata_id_t savedata_id, uint32_t slot);
+static void scanSavedata(void);
+static bool_t checkSlot(savedata_id_t savedata_id, uint32_t slot, uint32_t* seq);
+static uint16_t getRingEntryOffset(savering_id_t savering_id, uint32_t entry);
+static uint32_t getRingSeq(savering_id_t savering_id, uint32_t entry);
+static bool_t checkRingEntry(savering_id_t savering_id, uint32_t entry);
+static void findRingHead(savering_id_t savering_id);
+static uint32_t readBigEndian(const uint8_t* data, uint32_t size);
+static uint32_t updateCrc32(uint32_t crc, uint8_t data);
+static uint32_t calcSlotCrc32(uint32_t seq, uint16_t length, const uint8_t* data);
+
+/********** Function **********/
+
+/*
+ * Function: セーブデータ初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : EEPROM初期化後に実行すること、読み出し済みのRAMミラーから最新の有効なスロットを探す
+ *           起動時の全データ読み出しが未完了の場合は、読み出し完了後に周期処理で探す
+ */
+void InitSavedata(void)
+{
+	savedata_record_t* record;
+
+	for (uint32_t id=0; id<SAVEDATA_ID_NUM; id++) {
+		record = &savedata_record[id];
+		record->state = SAVEDATA_STATE_IDLE;
+		record->valid = FALSE;
+		record->slot = 0;
+		record->seq = 0;
+		record->write_slot = 0;
+	}
+	for (uint32_t id=0; id<SAVERING_ID_NUM; id++) {
+		savering_record[id].valid = FALSE;
+		savering_record[id].head = 0;
+		savering_record[id].seq = 0;
+	}
+
+	savedata_scanned = FALSE;
+	if (IsEepromReady() == TRUE) {
+		scanSavedata();
+	} else {
+		/* 処理なし(探索前に保存すると既存のスロットより古い通し番号で書き込むため、探索まで保存を受け付けない) */
+	}
+}
+
+/*
+ * Function: セーブデータ周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : MainEepromより前に実行すること
+ */
+void MainSavedata(void)
+{
+	savedata_record_t* record;
+
+	/* 起動時の全データ読み出しが初期化に間に合わなかった場合は、読み出し完了後に探索 */
+	if ((savedata_scanned == FALSE) && (IsEepromReady() == TRUE)) {
+		scanSavedata();
+	} else {
+		/* 処理なし */
+	}
+
+	for (uint32_t id=0; id<SAVEDATA_ID_NUM; id++) {
+		record = &savedata_record[id];
+		switch (record->state) {
+		case SAVEDATA_STATE_WRITE_BODY:
+			/* データの書き込みが完了してからヘッダを書き込む */
+			if (IsEepromWritten(EEPROM_DATA_ID_SAVEDATA, getSlotBodyOffset(id, record->write_slot), savedata_info_table[id].size) == TRUE) {
+				WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, getSlotHeaderOffset(id, record->write_slot), record->write_header, SAVEDATA_HEADER_SIZE);
+				record->state = SAVEDATA_STATE_WRITE_HEADER;
+			} else {
+				/* 処理なし */
+			}
+			break;
+		case SAVEDATA_STATE_WRITE_HEADER:
+			/* ヘッダの書き込み完了で書き込んだスロットが最新となる */
+			if (IsEepromWritten(EEPROM_DATA_ID_SAVEDATA, getSlotHeaderOffset(id, record->write_slot), SAVEDATA_HEADER_SIZE) == TRUE) {
+				record->valid = TRUE;
+				record->slot = record->write_slot;
+				record->seq ++;
+				record->state = SAVEDATA_STATE_IDLE;
+			} else {
+				/* 処理なし */
+			}
+			break;
+		case SAVEDATA_STATE_IDLE:
+		default:
+			/* 処理なし */
+			break;
+		}
+	}
+}
+
+/*
+ * Function: セーブデータ読み出し
+ * Argument: セーブデータID、読み出しデータ格納先(データサイズ分)
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:有効なデータなし
+ * Note    : 書き込み中は書き込み完了前の最新の有効なデータを読み出す
+ */
+result_t LoadSavedata(savedata_id_t savedata_id, uint8_t* data)
+{
+	savedata_record_t* record = &savedata_record[savedata_id];
+	result_t result;
+
+	if (record->valid == TRUE) {
+		ReadEepromArea(EEPROM_DATA_ID_SAVEDATA, getSlotBodyOffset(savedata_id, record->slot), data, savedata_info_table[savedata_id].size);
+		result = RESULT_OK;
+	} else {
+		result = RESULT_NG;
+	}
+
+	return result;
+}
+
+/*
+ * Function: セーブデータ書き込み
+ * Argument: セーブデータID、書き込みデータ(データサイズ分)
+ * Return  : RESULT_OK:書き込み開始、RESULT_NG:書き込み中またはEEPROM読み出し未完了
+ * Note    : 最新の有効なスロットとは別のスロットへデータ、ヘッダの順に書き込むため、
+ *           書き込み中に電源が断たれても直前に書き込み完了したデータが残る
+ */
+result_t SaveSavedata(savedata_id_t savedata_id, const uint8_t* data)
+{
+	savedata_record_t* record = &savedata_record[savedata_id];
+	uint16_t size = savedata_info_table[savedata_id].size;
+	uint32_t seq;
+	uint32_t crc;
+	result_t result;
+
+	if ((savedata_scanned == TRUE) && (record->state == SAVEDATA_STATE_IDLE)) {
+		/* 最新の有効なスロットの次のスロットへ書き込む */
+		if (record->valid == TRUE) {
+			record->write_slot = (record->slot + 1) % savedata_info_table[savedata_id].slot_num;
+		} else {
+			record->write_slot = 0;
+		}
+		seq = record->seq + 1;
+		crc = calcSlotCrc32(seq, size, data);
+
+		/* ヘッダ作成 */
+		for (uint32_t index=0; index<SAVEDATA_HEADER_SIZE; index++) {
+			record->write_header[index] = 0xFF;
+		}
+		record->write_header[HEADER_OFFSET_MAGIC + 0] = (SAVEDATA_MAGIC & 0xFF00) >> 8;
+		record->write_header[HEADER_OFFSET_MAGIC + 1] = (SAVEDATA_MAGIC & 0x00FF) >> 0;
+		record->write_header[HEADER_OFFSET_SEQ + 0] = (seq & 0xFF000000) >> 24;
+		record->write_header[HEADER_OFFSET_SEQ + 1] = (seq & 0x00FF0000) >> 16;
+		record->write_header[HEADER_OFFSET_SEQ + 2] = (seq & 0x0000FF00) >>  8;
+		record->write_header[HEADER_OFFSET_SEQ + 3] = (seq & 0x000000FF) >>  0;
+		record->write_header[HEADER_OFFSET_LENGTH + 0] = (size & 0xFF00) >> 8;
+		record->write_header[HEADER_OFFSET_LENGTH + 1] = (size & 0x00FF) >> 0;
+		record->write_header[HEADER_OFFSET_CRC + 0] = (crc & 0xFF000000) >> 24;
+		record->write_header[HEADER_OFFSET_CRC + 1] = (crc & 0x00FF0000) >> 16;
+		record->write_header[HEADER_OFFSET_CRC + 2] = (crc & 0x0000FF00) >>  8;
+		record->write_header[HEADER_OFFSET_CRC + 3] = (crc & 0x000000FF) >>  0;
+
+		/* データを書き込み、ヘッダはデータの書き込み完了後に周期処理で書き込む */
+		result = WriteEepromArea(EEPROM_DATA_ID_SAVEDATA, getSlotBodyOffset(savedata_id, record->write_slot), data, size);
+		if (result == RESULT_OK) {
+			record->state = SAVEDATA_STATE_WRITE_BODY;
+		}
+	} else {
+		result = RESULT_NG;
+	}
+
+	return result;
+}
+
+/*
+ * Function: セーブデータ書き込み中確認
+ * Argument: セーブデータID
+ * Return  : TRUE:書き込み中、FALSE:書き込み完了
+ * Note    : なし
+ */
+bool_t IsSavedataBusy(savedata_id_t savedata_id)
+{
+	bool_t busy;
+
+	if (savedata_record[savedata_id].state != SAVEDATA_STATE_IDLE) {
+		busy = TRUE;
+	} else {
+		busy = FALSE;
+	}
+
+	return busy;
+}
+
+/*
+ * Function: 書き込み分散記録の最新データ読み出し
+ * Argument: 書き込み分散記録ID、読み出しデータ格納先(SAVERING_DATA_SIZE)
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:有効なデータなし
+ * Note    : なし
+ */
+result_t ReadSaveRing(savering_id_t savering_id, uint8_t* data)
+{
+	savering_record_t* record = &savering_record[savering_id];
+	result_t result;
+
+	if (record->valid == TRUE) {
+		ReadEepromArea(EEPROM_DATA_ID_SAVERING, getRingEntryOffset(savering_id, record->head) + RING_OFFSET_DATA, data, SAVERING_DATA_SIZE);
+		result = RESULT_OK;
+	} else {
+		result = RESULT_NG;
+	}
+
+	return result;
+}
+
+/*
+ * Function: 書き込み分散記録の追記
+ * Argument: 書き込み分散記録ID、書き込みデータ(SAVERING_DATA_SIZE)
+ * Return  : RESULT_OK:書き込み受付、RESULT_NG:EEPROM読み出し未完了(最新のエントリは更新しない)
+ * Note    : 最新のエントリの次のエントリへ書き込むため、各セルの書き換え回数はエントリ数分の1となる
+ *           エントリは1ページに収まりCRC32で検証するため、書き込み途中の電源断では直前のデータが残る
+ */
+result_t AppendSaveRing(savering_id_t savering_id, const uint8_t* data)
+{
+	savering_record_t* record = &savering_record[savering_id];
+	uint8_t entry[RING_ENTRY_SIZE];
+	uint32_t head;
+	uint32_t seq;
+	uint32_t crc;
+	result_t result = RESULT_NG;
+
+	/* 最新のエントリの探索前は、既存のエントリより古い通し番号で書き込まないよう受け付けない */
+	if (savedata_scanned == TRUE) {
+		if (record->valid == TRUE) {
+			head = (record->head + 1) % savering_info_table[savering_id].entry_num;
+			seq = record->seq + 1;
+		} else {
+			head = 0;
+			seq = 0;
+		}
+
+		/* エントリ作成 */
+		entry[RING_OFFSET_SEQ + 0] = (seq & 0xFF000000) >> 24;
+		entry[RING_OFFSET_SEQ + 1] = (seq & 0x00FF0000) >> 16;
+		entry[RING_OFFSET_SEQ + 2] = (seq & 0x0000FF00) >>  8;
+		entry[RING_OFFSET_SEQ + 3] = (seq & 0x000000FF) >>  0;
+		for (uint32_t index=0; index<SAVERING_DATA_SIZE; index++) {
+			entry[RING_OFFSET_DATA + index] = data[index];
+		}
+		crc = 0xFFFFFFFF;
+		for (uint32_t index=0; index<RING_OFFSET_CRC; index++) {
+			crc = updateCrc32(crc, entry[index]);
+		}
+		crc = ~crc;
+		entry[RING_OFFSET_CRC + 0] = (crc & 0xFF000000) >> 24;
+		entry[RING_OFFSET_CRC + 1] = (crc & 0x00FF0000) >> 16;
+		entry[RING_OFFSET_CRC + 2] = (crc & 0x0000FF00) >>  8;
+		entry[RING_OFFSET_CRC + 3] = (crc & 0x000000FF) >>  0;
+
+		/* 書き込みを受け付けた場合のみ最新のエントリを更新 */
+		result = WriteEepromArea(EEPROM_DATA_ID_SAVERING, getRingEntryOffset(savering_id, head), entry, RING_ENTRY_SIZE);
+		if (result == RESULT_OK) {
+			record->valid = TRUE;
+			record->head = head;
+			record->seq = seq;
+		}
+	} else {
+		/* 処理なし */
+	}
+
+	return result;
+}
+
+/*
+ * Function: 書き込み分散記録の書き換え回数推定
+ * Argument: 書き込み分散記録ID
+ * Return  : 1セルあたりの書き換え回数の推定値 [回]
+ * Note    : 通し番号から総書き込み回数を求め、エントリ数で割る(EEPROM_ENDURANCE_CYCLEと比較して寿命を判断する)
+ */
+uint32_t GetSaveRingWear(savering_id_t savering_id)
+{
+	savering_record_t* record = &savering_record[savering_id];
+	uint32_t wear;
+
+	if (record->valid == TRUE) {
+		wear = record->seq / savering_info_table[savering_id].entry_num + 1;
+	} else {
+		wear = 0;
+	}
+
+	return wear;
+}
+
+/*
+ * Function: 最新のスロット、エントリの探索
+ * Argument: なし
+ * Return  : なし
+ * Note    : 起動時の全データ読み出し完了後に実行する
+ */
+static void scanSavedata(void)
+{
+	savedata_record_t* record;
+	uint32_t seq;
+
+	for (uint32_t id=0; id<SAVEDATA_ID_NUM; id++) {
+		record = &savedata_record[id];
+		for (uint32_t slot=0; slot<savedata_info_table[id].slot_num; slot++) {
+			if (checkSlot(id, slot, &seq) == TRUE) {
+				/* 通し番号が新しいスロットを採用(周回を考慮して差分で比較) */
+				if ((record->valid == FALSE) || ((int32_t)(seq - record->seq) > 0)) {
+					record->valid = TRUE;
+					record->slot = slot;
+					record->seq = seq;
+				} else {
+					/* 処理なし */
+				}
+			} else {
+				/* 処理なし(書き込み途中の電源断などで破損したスロット) */
+			}
+		}
+	}
+
+	for (uint32_t id=0; id<SAVERING_ID_NUM; id++) {
+		findRingHead(id);
+	}
+
+	savedata_scanned = TRUE;
+}
+
+/*
+ * Function: スロットサイズ取得
+ * Argument: セーブデータID
+ * Return  : スロットサイズ [byte]
+ * Note    : データはページ単位に切り上げ、スロット先頭が常にページ境界となる
+ */
+static uint16_t getSlotSize(savedata_id_t savedata_id)
+{
+	uint16_t body_size;
+
+	body_size = (savedata_info_table[savedata_id].size + EEPROM_PAGE_SIZE - 1) / EEPROM_PAGE_SIZE * EEPROM_PAGE_SIZE;
+
+	return SAVEDATA_HEADER_SIZE + body_size;
+}
+
+/*
+ * Function: スロットのヘッダ配置取得
+ * Argument: セーブデータID、スロット
+ * Return  : EEPROM_DATA_ID_SAVEDATA内のヘッダ先頭
+ * Note    : なし
+ */
+static uint16_t getSlotHeaderOffset(savedata_id_t savedata_id, uint32_t slot)
+{
+	return savedata_info_table[savedata_id].offset + getSlotSize(savedata_id) * slot;
+}
+
+/*
+ * Function: スロットのデータ配置取得
+ * Argument: セーブデータID、スロット
+ * Return  : EEPROM_DATA_ID_SAVEDATA内のデータ先頭
+ * Note    : なし
+ */
+static uint16_t getSlotBodyOffset(savedata_id_t savedata_id, uint32_t slot)
+{
+	return getSlotHeaderOffset(savedata_id, slot) + SAVEDATA_HEADER_SIZE;
+}
+
+/*
+ * Function: スロット有効確認
+ * Argument: セーブデータID、スロット、通し番号格納先
+ * Return  : TRUE:有効、FALSE:無効
+ * Note    : 識別値、データサイズ、CRC32が一致するスロットを有効とする
+ */
+static bool_t checkSlot(savedata_id_t savedata_id, uint32_t slot, uint32_t* seq)
+{
+	uint16_t body_offset = getSlotBodyOffset(savedata_id, slot);
+	uint16_t size = savedata_info_table[savedata_id].size;
+	uint8_t header[SAVEDATA_HEADER_SIZE];
+	uint8_t body[EEPROM_PAGE_SIZE];
+	uint16_t chunk;
+	uint32_t crc;
+	bool_t valid = FALSE;
+
+	if ((ReadEepromArea(EEPROM_DATA_ID_SAVEDATA, getSlotHeaderOffset(savedata_id, slot), header, SAVEDATA_HEADER_SIZE) == RESULT_OK)
+	 && (readBigEndian(&header[HEADER_OFFSET_MAGIC], 2) == SAVEDATA_MAGIC)
+	 && (readBigEndian(&header[HEADER_OFFSET_LENGTH], 2) == size)) {
+		*seq = readBigEndian(&header[HEADER_OFFSET_SEQ], 4);
+		/* RAMミラー上のヘッダ(通し番号、データサイズ)とデータからCRC32を算出 */
+		crc = 0xFFFFFFFF;
+		for (uint32_t index=HEADER_OFFSET_SEQ; index<HEADER_OFFSET_CRC; index++) {
+			crc = updateCrc32(crc, header[index]);
+		}
+		for (uint16_t offset=0; offset<size; offset+=chunk) {
+			if (size - offset < EEPROM_PAGE_SIZE) {
+				chunk = size - offset;
+			} else {
+				chunk = EEPROM_PAGE_SIZE;
+			}
+			ReadEepromArea(EEPROM_DATA_ID_SAVEDATA, body_offset + offset, body, chunk);
+			for (uint16_t index=0; index<chunk; index++) {
+				crc = updateCrc32(crc, body[index]);
+			}
+		}
+		crc = ~crc;
+		if (crc == readBigEndian(&header[HEADER_OFFSET_CRC], 4)) {
+			valid = TRUE;
+		} else {
+			/* 処理なし */
+		}
+	} else {
+		/* 処理なし */
+	}
+
+	return valid;
+}
+
+/*
+ * Function: 書き込み分散記録のエントリ配置取得
+ * Argument: 書き込み分散記録ID、エントリ
+ * Return  : EEPROM_DATA_ID_SAVERING内のエントリ先頭
+ * Note    : なし
+ */
+static uint16_t getRingEntryOffset(savering_id_t savering_id, uint32_t entry)
+{
+	return savering_info_table[savering_id].offset + RING_ENTRY_SIZE * entry;
+}
+
+/*
+ * Function: 書き込み分散記録のエントリの通し番号取得
+ * Argument: 書き込み分散記録ID、エントリ
+ * Return  : 通し番号
+ * Note    : なし
+ */
+static uint32_t getRingSeq(savering_id_t savering_id, uint32_t entry)
+{
+	uint8_t seq[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+	/* 読み出せない場合は未書き込み(0xFF)と同じ扱い */
+	(void)ReadEepromArea(EEPROM_DATA_ID_SAVERING, getRingEntryOffset(savering_id, entry) + RING_OFFSET_SEQ, seq, 4);
+
+	return readBigEndian(seq, 4);
+}
+
+/*
+ * Function: 書き込み分散記録のエントリ有効確認
+ * Argument: 書き込み分散記録ID、エントリ
+ * Return  : TRUE:有効、FALSE:無効
+ * Note    : なし
+ */
+static bool_t checkRingEntry(savering_id_t savering_id, uint32_t entry)
+{
+	uint8_t data[RING_ENTRY_SIZE];
+	uint32_t crc = 0xFFFFFFFF;
+	bool_t valid = FALSE;
+
+	if (ReadEepromArea(EEPROM_DATA_ID_SAVERING, getRingEntryOffset(savering_id, entry), data, RING_ENTRY_SIZE) == RESULT_OK) {
+		for (uint32_t index=0; index<RING_OFFSET_CRC; index++) {
+			crc = updateCrc32(crc, data[index]);
+		}
+		crc = ~crc;
+		if (crc == readBigEndian(&data[RING_OFFSET_CRC], 4)) {
+			valid = TRUE;
+		} else {
+			/* 処理なし */
+		}
+	}
+
+	return valid;
+}
+
+/*
+ * Function: 書き込み分散記録の最新エントリ探索
+ * Argument: 書き込み分散記録ID
+ * Return  : なし
+ * Note    : エントリ0から最新のエントリまでは通し番号が連続し、その先は1周前の番号となるため、
+ *           「通し番号 - エントリ0の通し番号 == エントリ番号」を満たす最後のエントリを二分探索する
+ *           エントリ0が無効(未使用、または書き込み途中の電源断で通し番号も不定)の場合は基準にできないため、
+ *           1周前の末尾のエントリを最新とする(エントリ1以降は1周前の連続した番号)
+ *           RAMミラーを参照するため、InitEepromの読み出し以外のSPI通信は発生しない
+ */
+static void findRingHead(savering_id_t savering_id)
+{
+	savering_record_t* record = &savering_record[savering_id];
+	uint32_t entry_num = savering_info_table[savering_id].entry_num;
+	uint32_t first_seq;
+	uint32_t low;
+	uint32_t high;
+	uint32_t middle;
+	uint32_t previous;
+
+	record->valid = FALSE;
+	record->head = 0;
+	record->seq = 0;
+
+	if (checkRingEntry(savering_id, 0) == TRUE) {
+		first_seq = getRingSeq(savering_id, 0);
+		low = 0;
+		high = entry_num - 1;
+		while (low < high) {
+			middle = (low + high + 1) / 2;
+			if (getRingSeq(savering_id, middle) - first_seq == middle) {
+				low = middle;
+			} else {
+				high = middle - 1;
+			}
+		}
+
+		if (checkRingEntry(savering_id, low) == TRUE) {
+			record->valid = TRUE;
+			record->head = low;
+			record->seq = getRingSeq(savering_id, low);
+		} else {
+			/* 最新のエントリが書き込み途中で破損していた場合は1つ前のエントリを採用(エントリ0は有効なのでlowは1以上) */
+			previous = low - 1;
+			if ((checkRingEntry(savering_id, previous) == TRUE)
+			 && (getRingSeq(savering_id, previous) == getRingSeq(savering_id, low) - 1)) {
+				record->valid = TRUE;
+				record->head = previous;
+				record->seq = getRingSeq(savering_id, previous);
+			} else {
+				/* 処理なし */
+			}
+		}
+	} else {
+		/* エントリ0の書き込み途中で電源断した場合は、1周前の末尾のエントリが最新 */
+		previous = entry_num - 1;
+		if (checkRingEntry(savering_id, previous) == TRUE) {
+			record->valid = TRUE;
+			record->head = previous;
+			record->seq = getRingSeq(savering_id, previous);
+		} else {
+			/* 処理なし(未使用の領域) */
+		}
+	}
+}
+
+/*
+ * Function: ビッグエンディアンの値取得
+ * Argument: データ、サイズ [byte] (4以下)
+ * Return  : 値
+ * Note    : ヘッダ、エントリ内の値はビッグエンディアンで格納する
+ */
+static uint32_t readBigEndian(const uint8_t* data, uint32_t size)
+{
+	uint32_t value = 0;
+
+	for (uint32_t index=0; index<size; index++) {
+		value = (value << 8) | data[index];
+	}
+
+	return value;
+}
+
+/*
+ * Function: CRC32更新(1byte)
+ * Argument: CRC32途中値、データ
+ * Return  : CRC32途中値
+ * Note    : なし
+ */
+static uint32_t updateCrc32(uint32_t crc, uint8_t data)
+{
+	crc ^= data;
+	for (uint32_t bit=0; bit<8; bit++) {
+		if ((crc & 0x00000001) != 0) {
+			crc = (crc >> 1) ^ CRC32_POLYNOMIAL;
+		} else {
+			crc = crc >> 1;
+		}
+	}
+
+	return crc;
+}
+
+/*
+ * Function: スロットのCRC32算出
+ * Argument: 通し番号、データサイズ、データ
+ * Return  : CRC32
+ * Note    : ヘッダと同じ並び(ビッグエンディアン)で通し番号、データサイズ、データの順に算出
+ */
+static uint32_t calcSlotCrc32(uint32_t seq, uint16_t length, const uint8_t* data)
+{
+	uint32_t crc = 0xFFFFFFFF;
+
+	crc = updateCrc32(crc, (seq & 0xFF000000) >> 24);
+	crc = updateCrc32(crc, (seq & 0x00FF0000) >> 16);
+	crc = updateCrc32(crc, (seq & 0x0000FF00) >>  8);
+	crc = updateCrc32(crc, (seq & 0x000000FF) >>  0);
+	crc = updateCrc32(crc, (length & 0xFF00) >> 8);
+	crc = updateCrc32(crc, (length & 0x00FF) >> 0);
+	for (uint16_t offset=0; offset<length; offset++) {
+		crc = updateCrc32(crc, data[offset]);
+	}
+
+	return ~crc;
+}
@@ -0,0 +1,59 @@
+/*
+ * drv_savedata.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_SAVEDATA_H_
+#define DRV_SAVEDATA_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* セーブデータサイズ [byte] */
+#define SAVEDATA_SIZE_SETTING	(32)
+#define SAVEDATA_SIZE_GAME		(128)
+
+/* 書き込み分散記録の1回分のデータサイズ [byte] */
+#define SAVERING_DATA_SIZE		(8)
+
+/* EEPROM(25LC080C)の書き換え可能回数 [回] */
+#define EEPROM_ENDURANCE_CYCLE	(1000000)
+
+/********** Enum **********/
+
+typedef enum {
+	SAVEDATA_ID_SETTING = 0,	/* 設定 */
+	SAVEDATA_ID_GAME,			/* ゲーム進行 */
+	SAVEDATA_ID_NUM
+} savedata_id_t;
+
+typedef enum {
+	SAVERING_ID_PLAY_TIME = 0,	/* プレイ時間 */
+	SAVERING_ID_BOOT_COUNT,		/* 起動回数 */
+	SAVERING_ID_NUM
+} savering_id_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitSavedata(void);
+void MainSavedata(void);
+result_t LoadSavedata(savedata_id_t savedata_id, uint8_t* data);
+result_t SaveSavedata(savedata_id_t savedata_id, const uint8_t* data);
+bool_t IsSavedataBusy(savedata_id_t savedata_id);
+result_t ReadSaveRing(savering_id_t savering_id, uint8_t* data);
+result_t AppendSaveRing(savering_id_t savering_id, const uint8_t* data);
+uint32_t GetSaveRingWear(savering_id_t savering_id);
+
+#endif /* DRV_SAVEDATA_H_ */
@@ -1,371 +1,863 @@
-/*
- * drv_sound.c
- *
- *  Created on: Jul 9, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_dio.h"
-#include "mcal_spi.h"
-#include "mcal_timer.h"
-#include "drv_sound.h"
-
-/********** Define **********/
-
-/* 送信データバッファサイズ */
-#define SEND_BUFFER_SIZE		(256)
-/* 非同期送信ジョブキューサイズ */
-#define SEND_JOB_QUEUE_SIZE		(20)
-
-#define SPI_YMF825				(SPI_CH2)
-
-#define PIN_CS_OFF				(PIN_LEVEL_HIGH)
-#define PIN_CS_ON				(PIN_LEVEL_LOW)
-
-#define YMF825_REG_CLKE			(0x00)		/* #0  Clock Enable */
-#define YMF825_REG_ALRST		(0x01)		/* #1  Reset */
-#define YMF825_REG_AP			(0x02)		/* #2  Analog Block Power-down control, AP0: VREF, IREF, AP1: SPAMP, SPOUT1, AP2: SPAMP, SPOUT2, AP3: DAC */
-#define YMF825_REG_GAIN			(0x03)		/* #3  Speaker Amplifier Gain Setting */
-#define YMF825_REG_HW_ID		(0x04)		/* #4  Hardware ID */
-#define YMF825_REG_CONTENTS		(0x07)		/* #7  Contents Data Write Port */
-#define YMF825_REG_SEQUENCER	(0x08)		/* #8  Sequencer Setting */
-#define YMF825_REG_SEQ_VOL		(0x09)		/* #9  Sequencer volume */
-#define YMF825_REG_SEQ_SIZE		(0x0A)		/* #10 Size of sequence data in bytes */
-#define YMF825_REG_CRGD_VNO		(0x0B)		/* #11 Voice number */
-#define YMF825_REG_VOVOL		(0x0C)		/* #12 Volume each voice number */
-#define YMF825_REG_BLOCK		(0x0D)		/* #13 Specifies an octave */
-#define YMF825_REG_FNUM			(0x0E)		/* #14 Frequency information for one octave */
-#define YMF825_REG_KEYON		(0x0F)		/* #15 KeyOn, Mute, EG_RST, ToneNum */
-#define YMF825_REG_CHVOL		(0x10)		/* #16 Volume for each voice, interpolation of the SEQ_Vol and ChVol */
-#define YMF825_REG_XVB			(0x11)		/* #17 Vibrato modulation */
-#define YMF825_REG_INT			(0x12)		/* #18 Integer part */
-#define YMF825_REG_FRA			(0x13)		/* #19 Fraction part */
-#define YMF825_REG_DIR_MT		(0x14)		/* #20 Control the interpolation in a mute state */
-#define YMF825_REG_MS_S_U		(0x17)		/* #23 Sequencer Time unit Setting MS_S13 - MS_S7 */
-#define YMF825_REG_MS_S_L		(0x18)		/* #24 Sequencer Time unit Setting MS_S6 - MS_S0 */
-#define YMF825_REG_MASTER_VOL	(0x19)		/* #25 Master Volume */
-#define YMF825_REG_SFTRST		(0x1A)		/* #26 Soft Reset */
-#define YMF825_REG_MUTE_ITIME	(0x1B)		/* #27 Sequencer Delay, Recovery Function Setting, Volume Interpolation Setting */
-#define YMF825_REG_LFO_RST		(0x1C)		/* #28 LFO Reset */
-#define YMF825_REG_DRV_SEL		(0x1D)		/* #29 Power Rail Selection */
-#define YMF825_REG_W_CEQ0		(0x20)		/* #32 Band 0 coefficients */
-#define YMF825_REG_W_CEQ1		(0x21)		/* #33 Band 1 coefficients */
-#define YMF825_REG_W_CEQ2		(0x22)		/* #34 Band 2 coefficients */
-
-/********** Enum **********/
-
-typedef enum {
-	SEND_MODE_SYNC = 0,
-	SEND_MODE_ASYNC
-} send_mode_t;
-
-typedef enum {
-	SEND_STATE_IDLE = 0,
-	SEND_STATE_BUSY
-} send_state_t;
-
-/********** Type **********/
-
-typedef struct {
-	uint16_t buffer_index;
-	uint16_t length;
-} send_job_t;
-
-/********** Constant **********/
-
-static const uint8_t tone_data[] ={
-	0x81,//header
-	//T_ADR 0
-	0x01,0x85,
-	0x00,0x7F,0xF4,0xBB,0x00,0x10,0x40,
-	0x00,0xAF,0xA0,0x0E,0x03,0x10,0x40,
-	0x00,0x2F,0xF3,0x9B,0x00,0x20,0x41,
-	0x00,0xAF,0xA0,0x0E,0x01,0x10,0x40,
-	0x80,0x03,0x81,0x80,
-};
-
-/********** Variable **********/
-
-static uint8_t send_buffer[SEND_BUFFER_SIZE];
-static uint16_t send_buffer_index_top;
-static send_state_t sync_send_state;
-static send_state_t async_send_state;
-
-static send_job_t send_job_queue[SEND_JOB_QUEUE_SIZE];
-static uint32_t send_job_queue_index_top;
-static uint32_t send_job_queue_index_end;
-
-/********** Function Prototype **********/
-
-static void sendSingleWrite(uint8_t command, uint8_t data, send_mode_t send_mode);
-static void sendBurstWrite(uint8_t command, uint8_t* data_address, uint16_t length, send_mode_t send_mode);
-static void addSendBufferIndex(uint16_t* buffer_index, uint16_t add_value);
-static void sendSync(uint16_t buffer_index, uint16_t length);
-static void callbackSyncSendComplete(void);
-static void sendAsync(uint16_t buffer_index, uint16_t length);
-static void sendJob(void);
-static void callbackAsyncSendComplete(void);
-
-/********** Function **********/
-
-/*
- * Function: 
- * Argument: 
- * Return  : 
- * Note    : 
- */
-void InitSound(void)
-{
-	send_buffer_index_top = 0;
-	sync_send_state = SEND_STATE_IDLE;
-	async_send_state = SEND_STATE_IDLE;
-	send_job_queue_index_top = 0;
-	send_job_queue_index_end = 0;
-
-	sendSingleWrite(YMF825_REG_DRV_SEL, 0x01, SEND_MODE_SYNC);		/* YMF825複数電源設定(5V, 3.3V) */
-	sendSingleWrite(YMF825_REG_AP, 0x0E, SEND_MODE_SYNC);			/* AP0(VREF, IREF)有効化 */
-	WaitUs(1000);													/* 発振器安定待ち */
-	sendSingleWrite(YMF825_REG_CLKE, 0x01, SEND_MODE_SYNC);			/* クロック有効化 */
-	sendSingleWrite(YMF825_REG_ALRST, 0x00, SEND_MODE_SYNC);		/* 内部リセット解除 */
-	sendSingleWrite(YMF825_REG_SFTRST, 0xA3, SEND_MODE_SYNC);		/* Synthesizer blockリセット */
-	WaitUs(1000);													/* リセット待ち */
-	sendSingleWrite(YMF825_REG_SFTRST, 0x00, SEND_MODE_SYNC);		/* Synthesizer blockリセット解除 */
-	WaitUs(30000);													/* VREF安定、リセット完了待ち*/
-	sendSingleWrite(YMF825_REG_AP, 0x04, SEND_MODE_SYNC);			/* AP1(SPAMP, SPOUT1)、AP3(DAC)有効化 */
-	WaitUs(10);														/* ポップノイズ抑制 */
-	sendSingleWrite(YMF825_REG_AP, 0x00, SEND_MODE_SYNC);			/* AP2(SPAMP, SPOUT2)有効化 */
-
-	sendSingleWrite(YMF825_REG_GAIN, 0x01, SEND_MODE_SYNC);			/* Analog Gain */
-	sendSingleWrite(YMF825_REG_MASTER_VOL, 0x60, SEND_MODE_SYNC);	/* Master volume level */
-	sendSingleWrite(YMF825_REG_MUTE_ITIME, 0x3F, SEND_MODE_SYNC);	/* Interpolation(補間)有効化 */
-	sendSingleWrite(YMF825_REG_DIR_MT, 0x00, SEND_MODE_SYNC);		/* Interpolation(補間)有効化 */
-
-	sendSingleWrite(YMF825_REG_SEQUENCER, 0xF6, SEND_MODE_SYNC);	/* Sequencerリセット */
-	WaitUs(6);														/* リセット待ち */
-	sendSingleWrite(YMF825_REG_SEQUENCER, 0x00, SEND_MODE_SYNC);	/* Sequencerリセット解除 */
-	sendSingleWrite(YMF825_REG_SEQ_VOL, 0xF9, SEND_MODE_SYNC);		/* sequencer volume、sequence data size */
-	sendSingleWrite(YMF825_REG_SEQ_SIZE, 0x00, SEND_MODE_SYNC);		/* sequence data size */
-
-	sendSingleWrite(YMF825_REG_MS_S_U, 0x40, SEND_MODE_SYNC);		/* Sequencer Time unit Setting */
-	sendSingleWrite(YMF825_REG_MS_S_L, 0x00, SEND_MODE_SYNC);		/* Sequencer Time unit Setting */
-
-	/* トーンデータ設定 */
-	sendBurstWrite(YMF825_REG_CONTENTS, (uint8_t*)tone_data, sizeof(tone_data), SEND_MODE_SYNC);
-
-	sendSingleWrite(YMF825_REG_KEYON, 0x30, SEND_MODE_SYNC);		/* KeyOff, Mute */
-	sendSingleWrite(YMF825_REG_CHVOL, 0x71, SEND_MODE_SYNC);		/* Volume for each voice */
-	sendSingleWrite(YMF825_REG_XVB, 0x00, SEND_MODE_SYNC);			/* Vibrato modulation */
-	sendSingleWrite(YMF825_REG_INT, 0x08, SEND_MODE_SYNC);			/* Integer part */
-	sendSingleWrite(YMF825_REG_FRA, 0x00, SEND_MODE_SYNC);			/* Fraction part */
-}
-
-/*
- * Function: サウンド生成開始
- * Argument: BLOCK: Specifies an octave、FNUM: Sets the frequency information for one octave.
- * Return  : なし
- * Note    : なし
- */
-void KeyOn(uint8_t block, uint16_t fnum)
-{
-	sendSingleWrite(YMF825_REG_CRGD_VNO, 0x00, SEND_MODE_ASYNC);	/* Voice number */
-	sendSingleWrite(YMF825_REG_VOVOL, 0x54, SEND_MODE_ASYNC);		/* Volume each voice number */
-	sendSingleWrite(YMF825_REG_BLOCK, ((fnum & 0x0380) >> 4) + (block & 0x07), SEND_MODE_ASYNC);	/* Specifies an octave */
-	sendSingleWrite(YMF825_REG_FNUM, (fnum & 0x3F), SEND_MODE_ASYNC);	/* Frequency information for one octave */
-	sendSingleWrite(YMF825_REG_KEYON, 0x40, SEND_MODE_ASYNC);		/* KeyOn */
-}
-
-/*
- * Function: サウンド生成停止
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void KeyOff(void)
-{
-	sendSingleWrite(YMF825_REG_KEYON, 0x00, SEND_MODE_ASYNC);		/* KeyOff */
-}
-
-/*
- * Function: サウンド出力先デバイス変更
- * Argument: サウンド出力先デバイス
- * Return  : なし
- * Note    : なし
- */
-void ChangeSoundOutputDevice(sound_output_device_t output_device)
-{
-	if (output_device == SOUND_OUTPUT_SPEAKER) {
-		sendSingleWrite(YMF825_REG_AP, 0x00, SEND_MODE_SYNC);			/* AP2(SPAMP, SPOUT2)有効化 */
-	} else if (output_device == SOUND_OUTPUT_LINE) {
-		sendSingleWrite(YMF825_REG_AP, 0x04, SEND_MODE_SYNC);			/* AP2(SPAMP, SPOUT2)無効化 */
-	} else {
-		/* 処理なし */
-	}
-}
-
-/*
- * Function: 単一データ送信
- * Argument: コマンド(YMF825 REG)、送信データ、送信モード(同期/非同期)
- * Return  : なし
- * Note    : なし
- */
-static void sendSingleWrite(uint8_t command, uint8_t data, send_mode_t send_mode)
-{
-	uint16_t send_buffer_index;
-
-	/* 送信データをバッファに格納 */
-	if ((send_buffer_index_top + 2) >= SEND_BUFFER_SIZE) {
-		send_buffer_index_top = 0;
-	}
-	send_buffer_index = send_buffer_index_top;
-	send_buffer[send_buffer_index_top] = command;
-	send_buffer[send_buffer_index_top + 1] = data;
-	addSendBufferIndex(&send_buffer_index_top, 2);
-
-	if (send_mode == SEND_MODE_SYNC) {
-		sendSync(send_buffer_index, 2);
-	} else {
-		sendAsync(send_buffer_index, 2);
-	}
-}
-
-/*
- * Function: 複数データ送信
- * Argument: コマンド(YMF825 REG)、送信データ格納アドレス、送信データ長、送信モード(同期/非同期)
- * Return  : なし
- * Note    : なし
- */
-static void sendBurstWrite(uint8_t command, uint8_t* data_address, uint16_t length, send_mode_t send_mode)
-{
-	uint16_t send_buffer_index;
-
-	/* 送信データをバッファに格納 */
-	if ((send_buffer_index_top + 1 + length) >= SEND_BUFFER_SIZE) {
-		send_buffer_index_top = 0;
-	}
-	send_buffer_index = send_buffer_index_top;
-	send_buffer[send_buffer_index_top] = command;
-	for (uint16_t index=0; index<length; index++) {
-		send_buffer[send_buffer_index_top + 1 + index] = data_address[index];
-	}
-	addSendBufferIndex(&send_buffer_index_top, 1 + length);
-
-	if (send_mode == SEND_MODE_SYNC) {
-		sendSync(send_buffer_index, length);
-	} else {
-		sendAsync(send_buffer_index, length);
-	}
-}
-
-/*
- * Function: 送信バッファインデックス加算
- * Argument: 送信バッファインデックスアドレス、加算値
- * Return  : なし
- * Note    : なし
- */
-static void addSendBufferIndex(uint16_t* buffer_index, uint16_t add_value)
-{
-	if ((*buffer_index + add_value) < SEND_BUFFER_SIZE) {
-		*buffer_index += add_value;
-	} else {
-		*buffer_index = (*buffer_index + add_value) - SEND_BUFFER_SIZE;
-	}
-}
-
-/*
- * Function: 同期送信
- * Argument: 送信バッファインデックス、送信データ長
- * Return  : なし
- * Note    : なし
- */
-static void sendSync(uint16_t buffer_index, uint16_t length)
-{
-	sync_send_state = SEND_STATE_BUSY;
-
-	WritePin(PIN_ID_SOUND_CS, PIN_CS_ON);
-	SendSpi(SPI_YMF825, &send_buffer[buffer_index], length, callbackSyncSendComplete);
-
-	while (sync_send_state == SEND_STATE_BUSY) {
-		/* 処理なし(送信完了待ち) */
-	}
-
-	WritePin(PIN_ID_SOUND_CS, PIN_CS_OFF);
-}
-
-/*
- * Function: 同期送信完了時コールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackSyncSendComplete(void)
-{
-	sync_send_state = SEND_STATE_IDLE;
-}
-
-/*
- * Function: 非同期送信
- * Argument: 送信バッファインデックス、送信データ長
- * Return  : なし
- * Note    : なし
- */
-static void sendAsync(uint16_t buffer_index, uint16_t length)
-{
-	send_job_queue[send_job_queue_index_top].buffer_index = buffer_index;
-	send_job_queue[send_job_queue_index_top].length = length;
-
-	if (send_job_queue_index_top < SEND_JOB_QUEUE_SIZE - 1) {
-		send_job_queue_index_top ++;
-	} else {
-		send_job_queue_index_top = 0;
-	}
-
-	if (async_send_state == SEND_STATE_IDLE) {
-		async_send_state = SEND_STATE_BUSY;
-		sendJob();
-	}
-}
-
-/*
- * Function: ジョブ送信
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void sendJob(void)
-{
-	uint32_t send_job_queue_index;
-
-	if (send_job_queue_index_top != send_job_queue_index_end) {
-		/* 次のジョブを送信 */
-		send_job_queue_index = send_job_queue_index_end;
-		
-		if (send_job_queue_index_end < SEND_JOB_QUEUE_SIZE - 1) {
-			send_job_queue_index_end ++;
-		} else {
-			send_job_queue_index_end = 0;
-		}
-
-		WritePin(PIN_ID_SOUND_CS, PIN_CS_ON);
-
-		SendSpi(SPI_YMF825, &send_buffer[send_job_queue[send_job_queue_index].buffer_index], send_job_queue[send_job_queue_index].length, callbackAsyncSendComplete);
-	} else {
-		/* すべてのジョブを送信済み */
-		async_send_state = SEND_STATE_IDLE;
-	}
-}
-
-/*
- * Function: 非同期送信完了時コールバック
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackAsyncSendComplete(void)
-{
-	WritePin(PIN_ID_SOUND_CS, PIN_CS_OFF);
-	sendJob();
-}
+/*
+ * drv_sound.c
+ *
+ *  Created on: Jul 9, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_dio.h"
+#include "mcal_spi.h"
+#include "mcal_timer.h"
+#include "sys_boot.h"
+#include "sys_latency.h"
+#include "drv_sound.h"
+
+/********** Define **********/
+
+/* 送信データバッファサイズ */
+#define SEND_BUFFER_SIZE		(256)
+/* 非同期送信ジョブキューサイズ */
+#define SEND_JOB_QUEUE_SIZE		(64)
+
+#define SPI_YMF825				(SPI_CH2)
+
+#define PIN_CS_OFF				(PIN_LEVEL_HIGH)
+#define PIN_CS_ON				(PIN_LEVEL_LOW)
+
+#define YMF825_REG_CLKE			(0x00)		/* #0  Clock Enable */
+#define YMF825_REG_ALRST		(0x01)		/* #1  Reset */
+#define YMF825_REG_AP			(0x02)		/* #2  Analog Block Power-down control, AP0: VREF, IREF, AP1: SPAMP, SPOUT1, AP2: SPAMP, SPOUT2, AP3: DAC */
+#define YMF825_REG_GAIN			(0x03)		/* #3  Speaker Amplifier Gain Setting */
+#define YMF825_REG_HW_ID		(0x04)		/* #4  Hardware ID */
+#define YMF825_REG_CONTENTS		(0x07)		/* #7  Contents Data Write Port */
+#define YMF825_REG_SEQUENCER	(0x08)		/* #8  Sequencer Setting */
+#define YMF825_REG_SEQ_VOL		(0x09)		/* #9  Sequencer volume */
+#define YMF825_REG_SEQ_SIZE		(0x0A)		/* #10 Size of sequence data in bytes */
+#define YMF825_REG_CRGD_VNO		(0x0B)		/* #11 Voice number */
+#define YMF825_REG_VOVOL		(0x0C)		/* #12 Volume each voice number */
+#define YMF825_REG_BLOCK		(0x0D)		/* #13 Specifies an octave */
+#define YMF825_REG_FNUM			(0x0E)		/* #14 Frequency information for one octave */
+#define YMF825_REG_KEYON		(0x0F)		/* #15 KeyOn, Mute, EG_RST, ToneNum */
+#define YMF825_REG_CHVOL		(0x10)		/* #16 Volume for each voice, interpolation of the SEQ_Vol and ChVol */
+#define YMF825_REG_XVB			(0x11)		/* #17 Vibrato modulation */
+#define YMF825_REG_INT			(0x12)		/* #18 Integer part */
+#define YMF825_REG_FRA			(0x13)		/* #19 Fraction part */
+#define YMF825_REG_DIR_MT		(0x14)		/* #20 Control the interpolation in a mute state */
+#define YMF825_REG_MS_S_U		(0x17)		/* #23 Sequencer Time unit Setting MS_S13 - MS_S7 */
+#define YMF825_REG_MS_S_L		(0x18)		/* #24 Sequencer Time unit Setting MS_S6 - MS_S0 */
+#define YMF825_REG_MASTER_VOL	(0x19)		/* #25 Master Volume */
+#define YMF825_REG_SFTRST		(0x1A)		/* #26 Soft Reset */
+#define YMF825_REG_MUTE_ITIME	(0x1B)		/* #27 Sequencer Delay, Recovery Function Setting, Volume Interpolation Setting */
+#define YMF825_REG_LFO_RST		(0x1C)		/* #28 LFO Reset */
+#define YMF825_REG_DRV_SEL		(0x1D)		/* #29 Power Rail Selection */
+#define YMF825_REG_W_CEQ0		(0x20)		/* #32 Band 0 coefficients */
+#define YMF825_REG_W_CEQ1		(0x21)		/* #33 Band 1 coefficients */
+#define YMF825_REG_W_CEQ2		(0x22)		/* #34 Band 2 coefficients */
+
+/* KEYONのKeyOnビット */
+#define YMF825_KEYON_KEYON		(0x40)
+
+/* CHVOLのDIR_CV(音量補間有効) */
+#define YMF825_CHVOL_DIR_CV		(0x01)
+
+/* 初期ボイス音量 */
+#define VOICE_VOLUME_DEFAULT	(28)
+
+/* 変調パラメータの固定小数点シフト量 */
+#define MODULATION_SHIFT		(8)
+
+/* ビブラート波形テーブルの要素数 */
+#define VIBRATO_TABLE_SIZE		(64)
+
+/* 初期化手順の送信を送信ジョブキューが空くまで見合わせる場合の再実行までの時間 [us] */
+#define SOUND_INIT_RETRY_WAIT	(100)
+
+/* 初期化手順(トーンデータ設定前まで)の書き込み数 */
+#define SOUND_INIT_WRITE_NUM	(sizeof(sound_init_write_table) / sizeof(sound_init_write_table[0]))
+
+/********** Enum **********/
+
+typedef enum {
+	SEND_MODE_SYNC = 0,
+	SEND_MODE_ASYNC
+} send_mode_t;
+
+typedef enum {
+	SEND_STATE_IDLE = 0,
+	SEND_STATE_BUSY
+} send_state_t;
+
+typedef enum {
+	SEND_PHASE_BUFFER = 0,		/* 送信バッファ内データ送信中 */
+	SEND_PHASE_EXTERNAL			/* 直接送信データ送信中 */
+} send_phase_t;
+
+typedef enum {
+	SOUND_INIT_STATE_REGISTER = 0,	/* 電源投入、リセット、基本設定の書き込み中 */
+	SOUND_INIT_STATE_TONE,			/* トーンデータ書き込み中 */
+	SOUND_INIT_STATE_VOICE,			/* ボイス毎の設定書き込み中 */
+	SOUND_INIT_STATE_READY			/* 初期化完了 */
+} sound_init_state_t;
+
+/********** Type **********/
+
+typedef struct {
+	uint16_t buffer_index;			/* 送信バッファ内の送信データ先頭インデックス */
+	uint16_t buffer_length;			/* 送信バッファから送信するデータ長 */
+	const uint8_t* external_data;	/* 送信バッファを経由せず直接送信するデータ(NULL:なし) */
+	uint16_t external_length;		/* 直接送信するデータ長 */
+	callback_t complete_callback;	/* 送信完了時コールバック(直接送信データの参照終了通知) */
+} send_job_t;
+
+typedef struct {
+	int32_t bend;				/* 現在ピッチベンド [1/8半音、Q8] */
+	int32_t bend_target;		/* 目標ピッチベンド [1/8半音、Q8] */
+	int32_t bend_step;			/* 1周期あたりのピッチベンド変化量 [Q8] */
+	uint8_t vibrato_depth;		/* ビブラート深さ [1/8半音] */
+	uint8_t vibrato_rate;		/* 1周期あたりのビブラート位相変化量(256で1周期) */
+	uint8_t vibrato_phase;		/* ビブラート位相 */
+	int32_t volume;				/* 現在音量 [Q8] */
+	int32_t volume_target;		/* 目標音量 [Q8] */
+	int32_t volume_step;		/* 1周期あたりの音量変化量 [Q8] */
+	uint16_t reg_multiplier;	/* 書き込み済みの周波数倍率(INT 2bit + FRA 9bit) */
+	uint8_t reg_chvol;			/* 書き込み済みのCHVOL */
+} voice_modulation_t;
+
+typedef struct {
+	uint8_t command;			/* YMF825 REG */
+	uint8_t data;				/* 書き込みデータ */
+	uint32_t wait;				/* 送信完了後の待機時間 [us] (0:待機せず続けて送信) */
+} sound_init_write_t;
+
+/********** Constant **********/
+
+/* 初期化手順(電源投入からトーンデータ設定前まで) */
+static const sound_init_write_t sound_init_write_table[] = {
+	{YMF825_REG_DRV_SEL,	0x01,	0},			/* YMF825複数電源設定(5V, 3.3V) */
+	{YMF825_REG_AP,			0x0E,	1000},		/* AP0(VREF, IREF)有効化、発振器安定待ち */
+	{YMF825_REG_CLKE,		0x01,	0},			/* クロック有効化 */
+	{YMF825_REG_ALRST,		0x00,	0},			/* 内部リセット解除 */
+	{YMF825_REG_SFTRST,		0xA3,	1000},		/* Synthesizer blockリセット、リセット待ち */
+	{YMF825_REG_SFTRST,		0x00,	30000},		/* Synthesizer blockリセット解除、VREF安定、リセット完了待ち */
+	{YMF825_REG_AP,			0x04,	10},		/* AP1(SPAMP, SPOUT1)、AP3(DAC)有効化、ポップノイズ抑制 */
+	{YMF825_REG_AP,			0x00,	0},			/* AP2(SPAMP, SPOUT2)有効化 */
+	{YMF825_REG_GAIN,		0x01,	0},			/* Analog Gain */
+	{YMF825_REG_MASTER_VOL,	0x60,	0},			/* Master volume level */
+	{YMF825_REG_MUTE_ITIME,	0x3F,	0},			/* Interpolation(補間)有効化 */
+	{YMF825_REG_DIR_MT,		0x00,	0},			/* Interpolation(補間)有効化 */
+	{YMF825_REG_SEQUENCER,	0xF6,	6},			/* Sequencerリセット、リセット待ち */
+	{YMF825_REG_SEQUENCER,	0x00,	0},			/* Sequencerリセット解除 */
+	{YMF825_REG_SEQ_VOL,	0xF9,	0},			/* sequencer volume、sequence data size */
+	{YMF825_REG_SEQ_SIZE,	0x00,	0},			/* sequence data size */
+	{YMF825_REG_MS_S_U,		0x40,	0},			/* Sequencer Time unit Setting */
+	{YMF825_REG_MS_S_L,		0x00,	0},			/* Sequencer Time unit Setting */
+};
+
+/* ピッチベンドの周波数倍率テーブル(INT 2bit + FRA 9bit、512 = 1.0倍)
+ * pitch_multiplier_table[i] = round(512 * 2^((i - SOUND_PITCH_BEND_MAX) / (12 * SOUND_PITCH_STEP)))
+ * 全要素をホストテスト(Test/test_sound.cのtestModulationTable)で計算式と比較する */
+static const uint16_t pitch_multiplier_table[SOUND_PITCH_BEND_MAX * 2 + 1] = {
+	256, 258, 260, 262, 264, 265, 267, 269, 271, 273, 275, 277,
+	279, 281, 283, 285, 287, 289, 292, 294, 296, 298, 300, 302,
+	304, 307, 309, 311, 313, 316, 318, 320, 323, 325, 327, 330,
+	332, 334, 337, 339, 342, 344, 347, 349, 352, 354, 357, 359,
+	362, 365, 367, 370, 373, 375, 378, 381, 384, 386, 389, 392,
+	395, 398, 401, 403, 406, 409, 412, 415, 418, 421, 424, 427,
+	431, 434, 437, 440, 443, 446, 450, 453, 456, 459, 463, 466,
+	470, 473, 476, 480, 483, 487, 490, 494, 497, 501, 505, 508,
+	512, 516, 519, 523, 527, 531, 535, 539, 542, 546, 550, 554,
+	558, 562, 566, 571, 575, 579, 583, 587, 592, 596, 600, 604,
+	609, 613, 618, 622, 627, 631, 636, 640, 645, 650, 654, 659,
+	664, 669, 674, 679, 683, 688, 693, 698, 703, 709, 714, 719,
+	724, 729, 735, 740, 745, 751, 756, 762, 767, 773, 778, 784,
+	790, 795, 801, 807, 813, 819, 825, 831, 837, 843, 849, 855,
+	861, 867, 874, 880, 886, 893, 899, 906, 912, 919, 926, 932,
+	939, 946, 953, 960, 967, 974, 981, 988, 995, 1002, 1009, 1017,
+	1024,
+};
+
+/* ビブラート波形テーブル
+ * vibrato_table[i] = round(127 * sin(2π * i / VIBRATO_TABLE_SIZE))
+ * 全要素をホストテスト(Test/test_sound.cのtestModulationTable)で計算式と比較する */
+static const int8_t vibrato_table[VIBRATO_TABLE_SIZE] = {
+	0, 12, 25, 37, 49, 60, 71, 81, 90, 98, 106, 112, 117, 122, 125, 126,
+	127, 126, 125, 122, 117, 112, 106, 98, 90, 81, 71, 60, 49, 37, 25, 12,
+	0, -12, -25, -37, -49, -60, -71, -81, -90, -98, -106, -112, -117, -122, -125, -126,
+	-127, -126, -125, -122, -117, -112, -106, -98, -90, -81, -71, -60, -49, -37, -25, -12,
+};
+
+static const uint8_t tone_data[] ={
+	0x81,//header
+	//T_ADR 0
+	0x01,0x85,
+	0x00,0x7F,0xF4,0xBB,0x00,0x10,0x40,
+	0x00,0xAF,0xA0,0x0E,0x03,0x10,0x40,
+	0x00,0x2F,0xF3,0x9B,0x00,0x20,0x41,
+	0x00,0xAF,0xA0,0x0E,0x01,0x10,0x40,
+	0x80,0x03,0x81,0x80,
+};
+
+/********** Variable **********/
+
+/* 送信完了割り込みで更新し、空き待ちで読み続けるためvolatileとする */
+static uint8_t send_buffer[SEND_BUFFER_SIZE];
+static volatile uint16_t send_buffer_index_top;
+static volatile uint16_t send_buffer_index_end;
+static volatile send_state_t async_send_state;
+static volatile send_phase_t send_phase;
+
+static send_job_t send_job_queue[SEND_JOB_QUEUE_SIZE];
+static volatile uint32_t send_job_queue_index_top;
+static volatile uint32_t send_job_queue_index_end;
+
+static voice_modulation_t voice_modulation[SOUND_VOICE_NUM];
+
+static sound_init_state_t sound_init_state;
+static uint32_t sound_init_index;
+static uint32_t sound_init_wait;
+
+/********** Function Prototype **********/
+
+static void stepSoundInit(void);
+static bool_t isSendQueueEmpty(void);
+static void sendInitWrite(uint8_t command, uint8_t data, uint32_t wait);
+static void callbackInitSendComplete(void);
+static void updateVoiceModulation(uint8_t voice);
+static void sendSingleWrite(uint8_t command, uint8_t data, send_mode_t send_mode);
+static void sendBurstWrite(uint8_t command, const uint8_t* data_address, uint16_t length, send_mode_t send_mode, callback_t callback);
+static void addSendBufferIndex(volatile uint16_t* buffer_index, uint16_t add_value);
+static uint16_t allocateSendBuffer(uint16_t length);
+static void addSendJob(uint16_t buffer_index, uint16_t buffer_length, const uint8_t* external_data, uint16_t external_length, callback_t callback, send_mode_t send_mode);
+static void sendJob(void);
+static void callbackAsyncSendComplete(void);
+
+/********** Function **********/
+
+/*
+ * Function: DRV SOUND 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 初期化手順を開始して戻る、以降の手順は送信完了、アラーム割り込みで進める
+ *           完了はIsSoundReadyで確認し、完了までは他の関数を使用しないこと
+ */
+void InitSound(void)
+{
+	send_buffer_index_top = 0;
+	send_buffer_index_end = 0;
+	async_send_state = SEND_STATE_IDLE;
+	send_phase = SEND_PHASE_BUFFER;
+	send_job_queue_index_top = 0;
+	send_job_queue_index_end = 0;
+
+	for (uint8_t voice=0; voice<SOUND_VOICE_NUM; voice++) {
+		voice_modulation[voice].bend = 0;
+		voice_modulation[voice].bend_target = 0;
+		voice_modulation[voice].bend_step = 0;
+		voice_modulation[voice].vibrato_depth = 0;
+		voice_modulation[voice].vibrato_rate = 0;
+		voice_modulation[voice].vibrato_phase = 0;
+		voice_modulation[voice].volume = VOICE_VOLUME_DEFAULT << MODULATION_SHIFT;
+		voice_modulation[voice].volume_target = VOICE_VOLUME_DEFAULT << MODULATION_SHIFT;
+		voice_modulation[voice].volume_step = 0;
+		voice_modulation[voice].reg_multiplier = pitch_multiplier_table[SOUND_PITCH_BEND_MAX];
+		voice_modulation[voice].reg_chvol = (VOICE_VOLUME_DEFAULT << 2) | YMF825_CHVOL_DIR_CV;
+	}
+
+	/* 初期化手順開始 */
+	sound_init_state = SOUND_INIT_STATE_REGISTER;
+	sound_init_index = 0;
+	sound_init_wait = 0;
+	stepSoundInit();
+}
+
+/*
+ * Function: サウンド初期化完了判定
+ * Argument: なし
+ * Return  : TRUE:初期化完了、FALSE:初期化中
+ * Note    : なし
+ */
+bool_t IsSoundReady(void)
+{
+	bool_t ready = FALSE;
+
+	if (sound_init_state == SOUND_INIT_STATE_READY) {
+		ready = TRUE;
+	}
+
+	return ready;
+}
+
+/*
+ * Function: DRV SOUND 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : ピッチベンド、ビブラート、音量変化を1周期分進め、変化したレジスタのみ送信する
+ */
+void MainSound(void)
+{
+	for (uint8_t voice=0; voice<SOUND_VOICE_NUM; voice++) {
+		updateVoiceModulation(voice);
+	}
+}
+
+/*
+ * Function: サウンド生成開始
+ * Argument: ボイス番号、BLOCK: Specifies an octave、FNUM: Sets the frequency information for one octave.
+ * Return  : なし
+ * Note    : なし
+ */
+void KeyOn(uint8_t voice, uint8_t block, uint16_t fnum)
+{
+	sendSingleWrite(YMF825_REG_CRGD_VNO, voice & 0x0F, SEND_MODE_ASYNC);	/* Voice number */
+	sendSingleWrite(YMF825_REG_VOVOL, 0x54, SEND_MODE_ASYNC);		/* Volume each voice number */
+	sendSingleWrite(YMF825_REG_BLOCK, ((fnum & 0x0380) >> 4) + (block & 0x07), SEND_MODE_ASYNC);	/* Specifies an octave */
+	sendSingleWrite(YMF825_REG_FNUM, (fnum & 0x7F), SEND_MODE_ASYNC);	/* Frequency information for one octave */
+	sendSingleWrite(YMF825_REG_KEYON, 0x40, SEND_MODE_ASYNC);		/* KeyOn */
+	RECORD_LATENCY_STAGE(LATENCY_STAGE_KEYON_QUEUED);
+}
+
+/*
+ * Function: サウンド生成停止
+ * Argument: ボイス番号
+ * Return  : なし
+ * Note    : なし
+ */
+void KeyOff(uint8_t voice)
+{
+	sendSingleWrite(YMF825_REG_CRGD_VNO, voice & 0x0F, SEND_MODE_ASYNC);	/* Voice number */
+	sendSingleWrite(YMF825_REG_KEYON, 0x00, SEND_MODE_ASYNC);		/* KeyOff */
+}
+
+/*
+ * Function: ピッチベンド設定
+ * Argument: ボイス番号、ピッチベンド [1/8半音] (±SOUND_PITCH_BEND_MAX)、変化に要する周期数(0:即時)
+ * Return  : なし
+ * Note    : 周期処理で目標値まで直線的に変化させる
+ */
+void SetPitchBend(uint8_t voice, int16_t bend, uint16_t frame)
+{
+	voice_modulation_t* modulation;
+
+	if (voice < SOUND_VOICE_NUM) {
+		modulation = &voice_modulation[voice];
+
+		if (bend > SOUND_PITCH_BEND_MAX) {
+			bend = SOUND_PITCH_BEND_MAX;
+		} else if (bend < -SOUND_PITCH_BEND_MAX) {
+			bend = -SOUND_PITCH_BEND_MAX;
+		} else {
+			/* 処理なし */
+		}
+
+		modulation->bend_target = (int32_t)bend << MODULATION_SHIFT;
+		if (frame == 0) {
+			modulation->bend = modulation->bend_target;
+			modulation->bend_step = 0;
+		} else {
+			modulation->bend_step = (modulation->bend_target - modulation->bend) / frame;
+			if ((modulation->bend_step == 0) && (modulation->bend_target != modulation->bend)) {
+				/* 変化量が分解能未満の場合は最小単位で変化させる */
+				if (modulation->bend_target > modulation->bend) {
+					modulation->bend_step = 1;
+				} else {
+					modulation->bend_step = -1;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Function: ビブラート設定
+ * Argument: ボイス番号、深さ [1/8半音] (0:停止)、速さ(1周期あたりの位相変化量、256で1周期)
+ * Return  : なし
+ * Note    : 60FPSの場合、速さ26で約6Hz
+ */
+void SetVibrato(uint8_t voice, uint8_t depth, uint8_t rate)
+{
+	if (voice < SOUND_VOICE_NUM) {
+		voice_modulation[voice].vibrato_depth = depth;
+		voice_modulation[voice].vibrato_rate = rate;
+		if (depth == 0) {
+			voice_modulation[voice].vibrato_phase = 0;
+		}
+	}
+}
+
+/*
+ * Function: ボイス音量設定
+ * Argument: ボイス番号、音量(0～SOUND_VOLUME_MAX)、変化に要する周期数(0:即時)
+ * Return  : なし
+ * Note    : 周期処理で目標値まで直線的に変化させる(フェードイン/アウト)
+ */
+void SetVoiceVolume(uint8_t voice, uint8_t volume, uint16_t frame)
+{
+	voice_modulation_t* modulation;
+
+	if (voice < SOUND_VOICE_NUM) {
+		modulation = &voice_modulation[voice];
+
+		if (volume > SOUND_VOLUME_MAX) {
+			volume = SOUND_VOLUME_MAX;
+		}
+
+		modulation->volume_target = (int32_t)volume << MODULATION_SHIFT;
+		if (frame == 0) {
+			modulation->volume = modulation->volume_target;
+			modulation->volume_step = 0;
+		} else {
+			modulation->volume_step = (modulation->volume_target - modulation->volume) / frame;
+			if ((modulation->volume_step == 0) && (modulation->volume_target != modulation->volume)) {
+				/* 変化量が分解能未満の場合は最小単位で変化させる */
+				if (modulation->volume_target > modulation->volume) {
+					modulation->volume_step = 1;
+				} else {
+					modulation->volume_step = -1;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Function: 送信ジョブキュー空き数取得
+ * Argument: なし
+ * Return  : 待機せずに追加できる単一データ送信数
+ * Note    : なし
+ */
+uint32_t GetSoundQueueSpace(void)
+{
+	uint32_t used;
+
+	if (send_job_queue_index_top >= send_job_queue_index_end) {
+		used = send_job_queue_index_top - send_job_queue_index_end;
+	} else {
+		used = SEND_JOB_QUEUE_SIZE - send_job_queue_index_end + send_job_queue_index_top;
+	}
+
+	/* キューは満杯判定のため1要素を空けておく */
+	return SEND_JOB_QUEUE_SIZE - 1 - used;
+}
+
+/*
+ * Function: トーンデータ書き込み
+ * Argument: トーンデータ先頭アドレス、トーンデータ長、書き込み完了時コールバック
+ * Return  : なし
+ * Note    : トーンデータはコピーせずに直接送信するため、コールバック通知まで内容を保持すること
+ */
+void WriteToneData(const uint8_t* data, uint16_t length, callback_t callback)
+{
+	sendBurstWrite(YMF825_REG_CONTENTS, data, length, SEND_MODE_ASYNC, callback);
+}
+
+/*
+ * Function: サウンド出力先デバイス変更
+ * Argument: サウンド出力先デバイス
+ * Return  : なし
+ * Note    : 送信完了を待たずに戻る(以降の書き込みは送信順に反映される)
+ */
+void ChangeSoundOutputDevice(sound_output_device_t output_device)
+{
+	if (output_device == SOUND_OUTPUT_SPEAKER) {
+		sendSingleWrite(YMF825_REG_AP, 0x00, SEND_MODE_ASYNC);			/* AP2(SPAMP, SPOUT2)有効化 */
+	} else if (output_device == SOUND_OUTPUT_LINE) {
+		sendSingleWrite(YMF825_REG_AP, 0x04, SEND_MODE_ASYNC);			/* AP2(SPAMP, SPOUT2)無効化 */
+	} else {
+		/* 処理なし */
+	}
+}
+
+/*
+ * Function: 初期化手順実行
+ * Argument: なし
+ * Return  : なし
+ * Note    : 待機時間で区切った1手順分を非同期送信し、最後の送信完了後に待機してから次の手順を実行する
+ *           アラーム割り込み処理から呼び出すため、送信の空き待ちをしないよう送信ジョブキューが空の場合のみ送信する
+ *           (1手順の送信はジョブキュー、送信バッファに収まる量とする)
+ *           空でない場合は送信を見合わせ、SOUND_INIT_RETRY_WAIT後に同じ手順を再実行する
+ */
+static void stepSoundInit(void)
+{
+	const sound_init_write_t* init_write;
+	bool_t step_end = FALSE;
+	uint8_t voice;
+
+	if ((sound_init_state != SOUND_INIT_STATE_READY) && (isSendQueueEmpty() == FALSE)) {
+		/* 送信完了割り込みは割り込み処理内で待っても発生しないため、空き待ちせずに再実行 */
+		SetTimerAlarm(ALARM_ID_SOUND, SOUND_INIT_RETRY_WAIT, stepSoundInit);
+	} else if (sound_init_state == SOUND_INIT_STATE_REGISTER) {
+		while (step_end == FALSE) {
+			init_write = &sound_init_write_table[sound_init_index];
+			sound_init_index ++;
+			if (sound_init_index >= SOUND_INIT_WRITE_NUM) {
+				/* 基本設定完了、続けてトーンデータを設定 */
+				sound_init_state = SOUND_INIT_STATE_TONE;
+				step_end = TRUE;
+			} else if (init_write->wait > 0) {
+				step_end = TRUE;
+			} else {
+				/* 処理なし */
+			}
+
+			if (step_end == TRUE) {
+				sendInitWrite(init_write->command, init_write->data, init_write->wait);
+			} else {
+				sendSingleWrite(init_write->command, init_write->data, SEND_MODE_ASYNC);
+			}
+		}
+	} else if (sound_init_state == SOUND_INIT_STATE_TONE) {
+		RecordBootStep(BOOT_STEP_SOUND_POWER_UP);
+
+		/* トーンデータ設定 */
+		sound_init_state = SOUND_INIT_STATE_VOICE;
+		sound_init_index = 0;
+		sound_init_wait = 0;
+		sendBurstWrite(YMF825_REG_CONTENTS, tone_data, sizeof(tone_data), SEND_MODE_ASYNC, callbackInitSendComplete);
+	} else if (sound_init_state == SOUND_INIT_STATE_VOICE) {
+		if (sound_init_index < SOUND_VOICE_NUM) {
+			/* 1ボイス分の設定 */
+			voice = (uint8_t)sound_init_index;
+			sound_init_index ++;
+			sendSingleWrite(YMF825_REG_CRGD_VNO, voice, SEND_MODE_ASYNC);	/* Voice number */
+			sendSingleWrite(YMF825_REG_KEYON, 0x30, SEND_MODE_ASYNC);		/* KeyOff, Mute */
+			sendSingleWrite(YMF825_REG_CHVOL, voice_modulation[voice].reg_chvol, SEND_MODE_ASYNC);	/* Volume for each voice */
+			sendSingleWrite(YMF825_REG_XVB, 0x00, SEND_MODE_ASYNC);			/* Vibrato modulation */
+			sendSingleWrite(YMF825_REG_INT, 0x08, SEND_MODE_ASYNC);			/* Integer part */
+			sendInitWrite(YMF825_REG_FRA, 0x00, 0);							/* Fraction part */
+		} else {
+			/* 全ボイスの設定完了 */
+			sound_init_state = SOUND_INIT_STATE_READY;
+			RecordBootStep(BOOT_STEP_SOUND_READY);
+		}
+	} else {
+		/* 処理なし */
+	}
+}
+
+/*
+ * Function: 送信ジョブキュー空判定
+ * Argument: なし
+ * Return  : TRUE:送信中、送信待ちのジョブなし、FALSE:送信中または送信待ちのジョブあり
+ * Note    : 空の場合は送信バッファ全体も空きとなる
+ */
+static bool_t isSendQueueEmpty(void)
+{
+	bool_t empty = FALSE;
+
+	if (send_job_queue_index_top == send_job_queue_index_end) {
+		empty = TRUE;
+	}
+
+	return empty;
+}
+
+/*
+ * Function: 初期化手順の区切りとなる単一データ送信
+ * Argument: コマンド(YMF825 REG)、送信データ、送信完了後の待機時間 [us]
+ * Return  : なし
+ * Note    : 非同期送信し、送信完了後に待機時間経過で次の手順を実行する
+ */
+static void sendInitWrite(uint8_t command, uint8_t data, uint32_t wait)
+{
+	uint16_t send_buffer_index;
+
+	sound_init_wait = wait;
+
+	send_buffer_index = allocateSendBuffer(2);
+	send_buffer[send_buffer_index] = command;
+	send_buffer[send_buffer_index + 1] = data;
+
+	addSendJob(send_buffer_index, 2, NULL, 0, callbackInitSendComplete, SEND_MODE_ASYNC);
+}
+
+/*
+ * Function: 初期化手順の送信完了時コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : 送信完了割り込み処理、待機時間0の場合もアラーム割り込みから次の手順を実行する
+ */
+static void callbackInitSendComplete(void)
+{
+	SetTimerAlarm(ALARM_ID_SOUND, sound_init_wait, stepSoundInit);
+}
+
+/*
+ * Function: ボイス変調更新
+ * Argument: ボイス番号
+ * Return  : なし
+ * Note    : 書き込み済みの値から変化したレジスタのみ送信する
+ */
+static void updateVoiceModulation(uint8_t voice)
+{
+	voice_modulation_t* modulation = &voice_modulation[voice];
+	bool_t voice_selected = FALSE;
+	int32_t pitch;
+	uint16_t multiplier;
+	uint8_t chvol;
+
+	/* ピッチベンドを目標値に近づける */
+	modulation->bend += modulation->bend_step;
+	if (((modulation->bend_step > 0) && (modulation->bend >= modulation->bend_target))
+	 || ((modulation->bend_step < 0) && (modulation->bend <= modulation->bend_target))
+	 || (modulation->bend_step == 0)) {
+		modulation->bend = modulation->bend_target;
+		modulation->bend_step = 0;
+	}
+
+	/* ビブラートを加算 */
+	pitch = modulation->bend >> MODULATION_SHIFT;
+	if (modulation->vibrato_depth != 0) {
+		modulation->vibrato_phase += modulation->vibrato_rate;
+		pitch += ((int32_t)vibrato_table[modulation->vibrato_phase >> 2] * modulation->vibrato_depth) >> 7;
+	}
+	if (pitch > SOUND_PITCH_BEND_MAX) {
+		pitch = SOUND_PITCH_BEND_MAX;
+	} else if (pitch < -SOUND_PITCH_BEND_MAX) {
+		pitch = -SOUND_PITCH_BEND_MAX;
+	} else {
+		/* 処理なし */
+	}
+
+	/* 音量を目標値に近づける */
+	modulation->volume += modulation->volume_step;
+	if (((modulation->volume_step > 0) && (modulation->volume >= modulation->volume_target))
+	 || ((modulation->volume_step < 0) && (modulation->volume <= modulation->volume_target))
+	 || (modulation->volume_step == 0)) {
+		modulation->volume = modulation->volume_target;
+		modulation->volume_step = 0;
+	}
+
+	/* 周波数倍率が変化した場合のみ送信 */
+	multiplier = pitch_multiplier_table[pitch + SOUND_PITCH_BEND_MAX];
+	if (multiplier != modulation->reg_multiplier) {
+		modulation->reg_multiplier = multiplier;
+		sendSingleWrite(YMF825_REG_CRGD_VNO, voice, SEND_MODE_ASYNC);						/* Voice number */
+		voice_selected = TRUE;
+		sendSingleWrite(YMF825_REG_INT, ((multiplier >> 9) << 3) | ((multiplier >> 6) & 0x07), SEND_MODE_ASYNC);	/* Integer part, Fraction part(上位) */
+		sendSingleWrite(YMF825_REG_FRA, (multiplier & 0x3F) << 1, SEND_MODE_ASYNC);		/* Fraction part(下位) */
+	}
+
+	/* 音量が変化した場合のみ送信 */
+	chvol = ((modulation->volume >> MODULATION_SHIFT) << 2) | YMF825_CHVOL_DIR_CV;
+	if (chvol != modulation->reg_chvol) {
+		modulation->reg_chvol = chvol;
+		if (voice_selected == FALSE) {
+			sendSingleWrite(YMF825_REG_CRGD_VNO, voice, SEND_MODE_ASYNC);					/* Voice number */
+		}
+		sendSingleWrite(YMF825_REG_CHVOL, chvol, SEND_MODE_ASYNC);							/* Volume for each voice */
+	}
+}
+
+/*
+ * Function: 単一データ送信
+ * Argument: コマンド(YMF825 REG)、送信データ、送信モード(同期/非同期)
+ * Return  : なし
+ * Note    : なし
+ */
+static void sendSingleWrite(uint8_t command, uint8_t data, send_mode_t send_mode)
+{
+	uint16_t send_buffer_index;
+
+	/* 送信データをバッファに格納 */
+	send_buffer_index = allocateSendBuffer(2);
+	send_buffer[send_buffer_index] = command;
+	send_buffer[send_buffer_index + 1] = data;
+
+	addSendJob(send_buffer_index, 2, NULL, 0, NULL, send_mode);
+}
+
+/*
+ * Function: 複数データ送信
+ * Argument: コマンド(YMF825 REG)、送信データ格納アドレス、送信データ長、送信モード(同期/非同期)、送信完了時コールバック
+ * Return  : なし
+ * Note    : コマンドのみ送信バッファに格納し、送信データはコピーせずに直接送信する
+ *           非同期送信の場合、送信データはコールバック通知まで保持すること
+ */
+static void sendBurstWrite(uint8_t command, const uint8_t* data_address, uint16_t length, send_mode_t send_mode, callback_t callback)
+{
+	uint16_t send_buffer_index;
+
+	/* コマンドのみバッファに格納 */
+	send_buffer_index = allocateSendBuffer(1);
+	send_buffer[send_buffer_index] = command;
+
+	addSendJob(send_buffer_index, 1, data_address, length, callback, send_mode);
+}
+
+/*
+ * Function: 送信バッファインデックス加算
+ * Argument: 送信バッファインデックスアドレス、加算値
+ * Return  : なし
+ * Note    : なし
+ */
+static void addSendBufferIndex(volatile uint16_t* buffer_index, uint16_t add_value)
+{
+	if ((*buffer_index + add_value) < SEND_BUFFER_SIZE) {
+		*buffer_index += add_value;
+	} else {
+		*buffer_index = (*buffer_index + add_value) - SEND_BUFFER_SIZE;
+	}
+}
+
+/*
+ * Function: 送信バッファ確保
+ * Argument: 確保サイズ
+ * Return  : 確保した領域の先頭インデックス
+ * Note    : 送信中のデータを上書きしないよう、空きが出来るまで待機する
+ *           空き待ちは送信完了割り込みで解除されるため、割り込み処理内から待機が発生する呼び出しをしないこと
+ *           確保した領域は連続しており、バッファ終端で折り返さない
+ */
+static uint16_t allocateSendBuffer(uint16_t length)
+{
+	uint16_t buffer_index = 0;
+	bool_t allocated = FALSE;
+
+	while (allocated == FALSE) {
+		if (send_job_queue_index_top == send_job_queue_index_end) {
+			/* 送信中のジョブが無いのでバッファ全体が空き */
+			send_buffer_index_top = 0;
+			send_buffer_index_end = 0;
+			buffer_index = 0;
+			allocated = TRUE;
+		} else if (send_buffer_index_top > send_buffer_index_end) {
+			if ((SEND_BUFFER_SIZE - send_buffer_index_top) >= length) {
+				/* バッファ終端までに空きがある */
+				buffer_index = send_buffer_index_top;
+				allocated = TRUE;
+			} else if (send_buffer_index_end >= length) {
+				/* バッファ先頭に折り返して空きがある(終端の残りは送信完了まで未使用) */
+				buffer_index = 0;
+				allocated = TRUE;
+			} else {
+				/* 処理なし(送信完了待ち) */
+			}
+		} else if (send_buffer_index_top < send_buffer_index_end) {
+			if ((send_buffer_index_end - send_buffer_index_top) >= length) {
+				/* 送信中データの手前までに空きがある */
+				buffer_index = send_buffer_index_top;
+				allocated = TRUE;
+			}
+		} else {
+			/* 処理なし(バッファフル、送信完了待ち) */
+		}
+	}
+
+	send_buffer_index_top = buffer_index;
+	addSendBufferIndex(&send_buffer_index_top, length);
+
+	return buffer_index;
+}
+
+/*
+ * Function: 送信ジョブ追加
+ * Argument: 送信バッファインデックス、送信バッファデータ長、直接送信データ、直接送信データ長、送信完了時コールバック、送信モード(同期/非同期)
+ * Return  : なし
+ * Note    : ジョブキューに空きが出来るまで待機する
+ *           同期送信の場合は送信完了まで待機する(いずれも割り込み処理内から待機が発生する呼び出しをしないこと)
+ */
+static void addSendJob(uint16_t buffer_index, uint16_t buffer_length, const uint8_t* external_data, uint16_t external_length, callback_t callback, send_mode_t send_mode)
+{
+	uint32_t send_job_queue_index_next;
+
+	if (send_job_queue_index_top < SEND_JOB_QUEUE_SIZE - 1) {
+		send_job_queue_index_next = send_job_queue_index_top + 1;
+	} else {
+		send_job_queue_index_next = 0;
+	}
+
+	while (send_job_queue_index_next == send_job_queue_index_end) {
+		/* 処理なし(ジョブキューの空き待ち) */
+	}
+
+	send_job_queue[send_job_queue_index_top].buffer_index = buffer_index;
+	send_job_queue[send_job_queue_index_top].buffer_length = buffer_length;
+	send_job_queue[send_job_queue_index_top].external_data = external_data;
+	send_job_queue[send_job_queue_index_top].external_length = external_length;
+	send_job_queue[send_job_queue_index_top].complete_callback = callback;
+	send_job_queue_index_top = send_job_queue_index_next;
+
+	if (async_send_state == SEND_STATE_IDLE) {
+		async_send_state = SEND_STATE_BUSY;
+		sendJob();
+	}
+
+	if (send_mode == SEND_MODE_SYNC) {
+		while (async_send_state == SEND_STATE_BUSY) {
+			/* 処理なし(送信完了待ち) */
+		}
+	}
+}
+
+/*
+ * Function: ジョブ送信
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void sendJob(void)
+{
+	send_job_t* job;
+
+	if (send_job_queue_index_top != send_job_queue_index_end) {
+		/* 次のジョブを送信(ジョブは送信完了までキューに残す) */
+		job = &send_job_queue[send_job_queue_index_end];
+		send_phase = SEND_PHASE_BUFFER;
+
+		WritePin(PIN_ID_SOUND_CS, PIN_CS_ON);
+
+		SendSpi(SPI_YMF825, &send_buffer[job->buffer_index], job->buffer_length, callbackAsyncSendComplete);
+	} else {
+		/* すべてのジョブを送信済み */
+		async_send_state = SEND_STATE_IDLE;
+	}
+}
+
+/*
+ * Function: 非同期送信完了時コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackAsyncSendComplete(void)
+{
+	send_job_t* job = &send_job_queue[send_job_queue_index_end];
+	callback_t complete_callback;
+
+	if ((send_phase == SEND_PHASE_BUFFER) && (job->external_length > 0)) {
+		/* CSを保持したまま直接送信データを続けて送信 */
+		send_phase = SEND_PHASE_EXTERNAL;
+		SendSpi(SPI_YMF825, (uint8_t*)job->external_data, job->external_length, callbackAsyncSendComplete);
+	} else {
+		WritePin(PIN_ID_SOUND_CS, PIN_CS_OFF);
+
+#if LATENCY_TRACE_ENABLE
+		if ((job->buffer_length == 2)
+		 && (send_buffer[job->buffer_index] == YMF825_REG_KEYON)
+		 && ((send_buffer[job->buffer_index + 1] & YMF825_KEYON_KEYON) != 0)) {
+			/* KeyOn送信完了 */
+			RECORD_LATENCY_STAGE(LATENCY_STAGE_KEYON_COMPLETE);
+		}
+#endif
+
+		/* 送信済み領域を解放 */
+		send_buffer_index_end = job->buffer_index;
+		addSendBufferIndex(&send_buffer_index_end, job->buffer_length);
+		complete_callback = job->complete_callback;
+
+		if (send_job_queue_index_end < SEND_JOB_QUEUE_SIZE - 1) {
+			send_job_queue_index_end ++;
+		} else {
+			send_job_queue_index_end = 0;
+		}
+
+		if (complete_callback != NULL) {
+			complete_callback();
+		}
+
+		sendJob();
+	}
+}
@@ -1,38 +1,57 @@
-/*
- * drv_sound.h
- *
- *  Created on: Jul 9, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_SOUND_H_
-#define DRV_SOUND_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	SOUND_OUTPUT_SPEAKER = 0,
-	SOUND_OUTPUT_LINE
-} sound_output_device_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitSound(void);
-void KeyOn(uint8_t block, uint16_t fnum);
-void KeyOff(void);
-void ChangeSoundOutputDevice(sound_output_device_t output_device);
-
-#endif /* DRV_SOUND_H_ */
+/*
+ * drv_sound.h
+ *
+ *  Created on: Jul 9, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_SOUND_H_
+#define DRV_SOUND_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 同時発音数 */
+#define SOUND_VOICE_NUM			(16)
+
+/* ピッチ指定の分解能 [1/半音] */
+#define SOUND_PITCH_STEP		(8)
+/* ピッチベンド範囲 [1/8半音] (±1オクターブ) */
+#define SOUND_PITCH_BEND_MAX	(12 * SOUND_PITCH_STEP)
+
+/* ボイス音量最大値(CHVOL 5bit) */
+#define SOUND_VOLUME_MAX		(31)
+
+/********** Enum **********/
+
+typedef enum {
+	SOUND_OUTPUT_SPEAKER = 0,
+	SOUND_OUTPUT_LINE
+} sound_output_device_t;
+
+/********** Type **********/
+
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitSound(void);
+bool_t IsSoundReady(void);
+void MainSound(void);
+void KeyOn(uint8_t voice, uint8_t block, uint16_t fnum);
+void KeyOff(uint8_t voice);
+void SetPitchBend(uint8_t voice, int16_t bend, uint16_t frame);
+void SetVibrato(uint8_t voice, uint8_t depth, uint8_t rate);
+void SetVoiceVolume(uint8_t voice, uint8_t volume, uint16_t frame);
+uint32_t GetSoundQueueSpace(void);
+void WriteToneData(const uint8_t* data, uint16_t length, callback_t callback);
+void ChangeSoundOutputDevice(sound_output_device_t output_device);
+
+#endif /* DRV_SOUND_H_ */
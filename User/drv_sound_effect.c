@@ -0,0 +1,370 @@
+/*
+ * drv_sound_effect.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "drv_sound.h"
+#include "drv_sound_effect.h"
+
+/********** Define **********/
+
+/* 効果音発音に必要な送信ジョブ数(KeyOn) */
+#define SE_SEND_JOB_NUM			(5)
+/* 効果音停止に必要な送信ジョブ数(KeyOff) */
+#define SE_KEYOFF_JOB_NUM		(2)
+
+/* 割り当て無しを表すボイス番号 */
+#define VOICE_NONE				(0xFF)
+
+/* 音楽音量の初期値 */
+#define MUSIC_VOLUME_DEFAULT	(28)
+/* ダッキング時の音楽音量の割合 [1/256] */
+#define DUCK_VOLUME_RATIO		(96)
+/* ダッキング開始/解除の音量変化に要する周期数 */
+#define DUCK_FADE_FRAME			(6)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+typedef struct {
+	uint8_t voice_top;		/* グループ先頭のボイス番号 */
+	uint8_t voice_num;		/* グループのボイス数(同時発音数上限) */
+} sound_group_info_t;
+
+typedef struct {
+	sound_group_t group;	/* ボイスグループ */
+	uint8_t priority;		/* 優先度(大きいほど優先) */
+	uint8_t block;			/* BLOCK */
+	uint16_t fnum;			/* FNUM */
+	uint8_t volume;			/* 音量(0～SOUND_VOLUME_MAX) */
+	uint16_t frame;			/* 発音周期数 */
+	uint16_t cooldown;		/* 再発音禁止周期数 */
+	bool_t duck;			/* 発音中の音楽ダッキング有無 */
+} sound_effect_info_t;
+
+typedef struct {
+	se_id_t se_id;			/* 発音中の効果音ID(SE_ID_NUM:空き) */
+	uint8_t priority;		/* 発音中の効果音の優先度 */
+	uint16_t remain_frame;	/* 残り発音周期数 */
+	uint32_t start_frame;	/* 発音開始周期 */
+	bool_t keyoff_pending;	/* KeyOff送信待ち(送信キューの空き待ち) */
+} voice_state_t;
+
+/********** Constant **********/
+
+static const sound_group_info_t sound_group_info_table[SOUND_GROUP_NUM] = {
+	{14,	2},		/* SOUND_GROUP_UI */
+	{8,		6},		/* SOUND_GROUP_GAME */
+	{0,		8},		/* SOUND_GROUP_MUSIC */
+};
+
+static const sound_effect_info_t sound_effect_info_table[SE_ID_NUM] = {
+	/* group,			priority,	block,	fnum,	volume,	frame,	cooldown,	duck */
+	{SOUND_GROUP_UI,	1,			5,		651,	24,		4,		3,			FALSE},	/* SE_ID_CURSOR */
+	{SOUND_GROUP_UI,	2,			5,		868,	28,		8,		6,			FALSE},	/* SE_ID_DECIDE */
+	{SOUND_GROUP_UI,	2,			4,		488,	28,		8,		6,			FALSE},	/* SE_ID_CANCEL */
+	{SOUND_GROUP_GAME,	1,			5,		580,	20,		6,		4,			FALSE},	/* SE_ID_SHOT */
+	{SOUND_GROUP_GAME,	2,			4,		730,	26,		10,		4,			FALSE},	/* SE_ID_HIT */
+	{SOUND_GROUP_GAME,	3,			2,		651,	31,		40,		20,			TRUE},	/* SE_ID_EXPLOSION */
+};
+
+/********** Variable **********/
+
+static voice_state_t voice_state[SOUND_VOICE_NUM];
+static uint32_t last_play_frame[SE_ID_NUM];
+static uint32_t frame_count;
+static uint32_t duck_count;
+static uint8_t music_volume;
+
+/********** Function Prototype **********/
+
+static uint8_t selectVoice(sound_group_t group, uint8_t priority);
+static void releaseVoice(uint8_t voice);
+static void updateMusicVolume(void);
+static void requestKeyOff(uint8_t voice);
+static void sendPendingKeyOff(void);
+
+/********** Function **********/
+
+/*
+ * Function: DRV SOUND EFFECT 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : DRV SOUND 初期化後に実行すること
+ */
+void InitSoundEffect(void)
+{
+	frame_count = 0;
+	duck_count = 0;
+	music_volume = MUSIC_VOLUME_DEFAULT;
+
+	for (uint8_t voice=0; voice<SOUND_VOICE_NUM; voice++) {
+		voice_state[voice].se_id = SE_ID_NUM;
+		voice_state[voice].priority = 0;
+		voice_state[voice].remain_frame = 0;
+		voice_state[voice].start_frame = 0;
+		voice_state[voice].keyoff_pending = FALSE;
+	}
+
+	for (se_id_t se_id=0; se_id<SE_ID_NUM; se_id++) {
+		/* 初回は再発音禁止期間外とする */
+		last_play_frame[se_id] = frame_count - sound_effect_info_table[se_id].cooldown;
+	}
+}
+
+/*
+ * Function: DRV SOUND EFFECT 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : DRV SOUND 周期処理の前に実行すること
+ *           送信キューに空きが無い場合、KeyOffは次の周期以降に送信する
+ */
+void MainSoundEffect(void)
+{
+	frame_count ++;
+
+	/* 発音時間が経過した効果音を停止 */
+	for (uint8_t voice=0; voice<SOUND_VOICE_NUM; voice++) {
+		if (voice_state[voice].se_id != SE_ID_NUM) {
+			if (voice_state[voice].remain_frame > 1) {
+				voice_state[voice].remain_frame --;
+			} else {
+				requestKeyOff(voice);
+				releaseVoice(voice);
+			}
+		}
+	}
+
+	sendPendingKeyOff();
+}
+
+/*
+ * Function: 効果音再生
+ * Argument: 効果音ID
+ * Return  : 再生開始成功/失敗
+ * Note    : 再発音禁止期間中、グループ内に割り当て可能なボイスが無い場合、送信キューに空きが無い場合は失敗
+ *           ボイス選択はグループ内のボイスのみを対象とする
+ */
+result_t PlaySoundEffect(se_id_t se_id)
+{
+	result_t result = RESULT_NG;
+	const sound_effect_info_t* info;
+	uint8_t voice;
+
+	if (se_id < SE_ID_NUM) {
+		info = &sound_effect_info_table[se_id];
+
+		if (((frame_count - last_play_frame[se_id]) >= info->cooldown)
+		 && (GetSoundQueueSpace() >= SE_SEND_JOB_NUM)) {
+			voice = selectVoice(info->group, info->priority);
+			if (voice != VOICE_NONE) {
+				/* 発音中の効果音を打ち切って割り当て */
+				releaseVoice(voice);
+
+				voice_state[voice].se_id = se_id;
+				voice_state[voice].priority = info->priority;
+				voice_state[voice].remain_frame = info->frame;
+				voice_state[voice].start_frame = frame_count;
+				/* 送信待ちのKeyOffはKeyOnで上書きされるため破棄 */
+				voice_state[voice].keyoff_pending = FALSE;
+				last_play_frame[se_id] = frame_count;
+
+				SetVoiceVolume(voice, info->volume, 0);
+				KeyOn(voice, info->block, info->fnum);
+
+				if (info->duck == TRUE) {
+					duck_count ++;
+					if (duck_count == 1) {
+						updateMusicVolume();
+					}
+				}
+
+				result = RESULT_OK;
+			}
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Function: 効果音停止
+ * Argument: 効果音ID
+ * Return  : なし
+ * Note    : 指定した効果音を発音中のボイスをすべて停止する
+ *           送信キューに空きが無い場合、KeyOffは周期処理で送信する
+ */
+void StopSoundEffect(se_id_t se_id)
+{
+	const sound_group_info_t* group_info;
+
+	if (se_id < SE_ID_NUM) {
+		group_info = &sound_group_info_table[sound_effect_info_table[se_id].group];
+
+		for (uint8_t voice=group_info->voice_top; voice<(group_info->voice_top + group_info->voice_num); voice++) {
+			if (voice_state[voice].se_id == se_id) {
+				requestKeyOff(voice);
+				releaseVoice(voice);
+			}
+		}
+
+		sendPendingKeyOff();
+	}
+}
+
+/*
+ * Function: 音楽音量設定
+ * Argument: 音量(0～SOUND_VOLUME_MAX)
+ * Return  : なし
+ * Note    : ダッキング中はダッキング後の音量を反映する
+ */
+void SetMusicVolume(uint8_t volume)
+{
+	music_volume = volume;
+	updateMusicVolume();
+}
+
+/*
+ * Function: グループのボイス番号取得
+ * Argument: ボイスグループ、グループ内インデックス
+ * Return  : ボイス番号(範囲外の場合はグループ先頭)
+ * Note    : 音楽再生はSOUND_GROUP_MUSICのボイスを使用すること
+ */
+uint8_t GetSoundGroupVoice(sound_group_t group, uint8_t index)
+{
+	uint8_t voice = 0;
+
+	if (group < SOUND_GROUP_NUM) {
+		voice = sound_group_info_table[group].voice_top;
+		if (index < sound_group_info_table[group].voice_num) {
+			voice += index;
+		}
+	}
+
+	return voice;
+}
+
+/*
+ * Function: グループのボイス数取得
+ * Argument: ボイスグループ
+ * Return  : ボイス数
+ * Note    : なし
+ */
+uint8_t GetSoundGroupVoiceNum(sound_group_t group)
+{
+	uint8_t voice_num = 0;
+
+	if (group < SOUND_GROUP_NUM) {
+		voice_num = sound_group_info_table[group].voice_num;
+	}
+
+	return voice_num;
+}
+
+/*
+ * Function: ボイス選択
+ * Argument: ボイスグループ、優先度
+ * Return  : ボイス番号(VOICE_NONE:割り当て不可)
+ * Note    : 空きボイスを優先し、空きが無ければ優先度が同じか低いボイスのうち最も古いものを選択する
+ *           探索範囲はグループ内のボイス(最大でグループの同時発音数)に限定する
+ */
+static uint8_t selectVoice(sound_group_t group, uint8_t priority)
+{
+	const sound_group_info_t* group_info = &sound_group_info_table[group];
+	uint8_t select_voice = VOICE_NONE;
+
+	for (uint8_t voice=group_info->voice_top; voice<(group_info->voice_top + group_info->voice_num); voice++) {
+		if (voice_state[voice].se_id == SE_ID_NUM) {
+			/* 空きボイス */
+			select_voice = voice;
+			break;
+		} else if (voice_state[voice].priority <= priority) {
+			if ((select_voice == VOICE_NONE)
+			 || (voice_state[voice].priority < voice_state[select_voice].priority)
+			 || ((voice_state[voice].priority == voice_state[select_voice].priority)
+			  && ((frame_count - voice_state[voice].start_frame) > (frame_count - voice_state[select_voice].start_frame)))) {
+				/* 優先度が低い、または同じ優先度でより古いボイス */
+				select_voice = voice;
+			}
+		} else {
+			/* 処理なし(優先度が高いボイスは打ち切らない) */
+		}
+	}
+
+	return select_voice;
+}
+
+/*
+ * Function: ボイス解放
+ * Argument: ボイス番号
+ * Return  : なし
+ * Note    : ダッキング要因の効果音であればダッキングを解除する
+ */
+static void releaseVoice(uint8_t voice)
+{
+	if (voice_state[voice].se_id != SE_ID_NUM) {
+		if (sound_effect_info_table[voice_state[voice].se_id].duck == TRUE) {
+			duck_count --;
+			if (duck_count == 0) {
+				updateMusicVolume();
+			}
+		}
+		voice_state[voice].se_id = SE_ID_NUM;
+		voice_state[voice].priority = 0;
+	}
+}
+
+/*
+ * Function: 音楽音量更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 音楽グループの全ボイスのCHVOLを変化させる
+ */
+static void updateMusicVolume(void)
+{
+	const sound_group_info_t* group_info = &sound_group_info_table[SOUND_GROUP_MUSIC];
+	uint8_t volume = music_volume;
+
+	if (duck_count > 0) {
+		volume = (uint8_t)(((uint32_t)music_volume * DUCK_VOLUME_RATIO) >> 8);
+	}
+
+	for (uint8_t voice=group_info->voice_top; voice<(group_info->voice_top + group_info->voice_num); voice++) {
+		SetVoiceVolume(voice, volume, DUCK_FADE_FRAME);
+	}
+}
+
+/*
+ * Function: KeyOff送信要求
+ * Argument: ボイス番号
+ * Return  : なし
+ * Note    : 送信はsendPendingKeyOffで行う
+ */
+static void requestKeyOff(uint8_t voice)
+{
+	voice_state[voice].keyoff_pending = TRUE;
+}
+
+/*
+ * Function: 送信待ちKeyOff送信
+ * Argument: なし
+ * Return  : なし
+ * Note    : 送信キューに空きがある分だけ送信し、残りは次の呼び出しまで保持する
+ *           DRV SOUNDの送信キューの空き待ちで処理が止まらないようにする
+ */
+static void sendPendingKeyOff(void)
+{
+	for (uint8_t voice=0; voice<SOUND_VOICE_NUM; voice++) {
+		if ((voice_state[voice].keyoff_pending == TRUE) && (GetSoundQueueSpace() >= SE_KEYOFF_JOB_NUM)) {
+			voice_state[voice].keyoff_pending = FALSE;
+			KeyOff(voice);
+		}
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * drv_sound_effect.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_SOUND_EFFECT_H_
+#define DRV_SOUND_EFFECT_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/* ボイスグループ */
+typedef enum {
+	SOUND_GROUP_UI = 0,		/* UI効果音 */
+	SOUND_GROUP_GAME,		/* ゲーム効果音 */
+	SOUND_GROUP_MUSIC,		/* 音楽 */
+	SOUND_GROUP_NUM
+} sound_group_t;
+
+/* 効果音ID */
+typedef enum {
+	SE_ID_CURSOR = 0,
+	SE_ID_DECIDE,
+	SE_ID_CANCEL,
+	SE_ID_SHOT,
+	SE_ID_HIT,
+	SE_ID_EXPLOSION,
+	SE_ID_NUM
+} se_id_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitSoundEffect(void);
+void MainSoundEffect(void);
+result_t PlaySoundEffect(se_id_t se_id);
+void StopSoundEffect(se_id_t se_id);
+void SetMusicVolume(uint8_t volume);
+uint8_t GetSoundGroupVoice(sound_group_t group, uint8_t index);
+uint8_t GetSoundGroupVoiceNum(sound_group_t group);
+
+#endif /* DRV_SOUND_EFFECT_H_ */
@@ -1,374 +1,738 @@
-/*
- * drv_touch.c
- *
- *  Created on: Jun 30, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "drv_tft.h"
-#include "mcal_i2c.h"
-#include "drv_touch.h"
-
-/********** Define **********/
-
-/* 通信データバッファサイズ [byte] */
-#define DATA_BUFFER_SIZE		(64)
-
-/* 読み出しリトライ試行回数 */
-#define READ_RETRY_MAX			(10)
-
-/* タッチ同時検出最大数 */
-#define TOUCH_POINT_NUM_MAX		(5)
-
-/********** Enum **********/
-
-typedef enum {
-	TOUCH_COM_STATE_INIT = 0,
-	TOUCH_COM_STATE_COM,
-	TOUCH_COM_STATE_WAIT,
-	TOUCH_COM_STATE_ERROR,
-	TOUCH_COM_STATE_TIMEOUT
-} touch_com_state_t;
-
-/********** Type **********/
-
-typedef struct {
-	uint8_t* send_data;
-	uint16_t send_length;
-	callback_t send_callback;
-	uint8_t* receive_buffer;
-	uint16_t receive_length;
-	callback_t receive_callback;
-} touch_com_job_t;
-
-typedef struct {
-	uint8_t track_id;
-	uint16_t x;
-	uint16_t y;
-	uint16_t size;
-} touch_point_t;
-
-/********** Variable **********/
-
-static touch_com_state_t touch_com_state;
-static touch_com_job_t* current_job;
-static uint32_t job_retry_count;
-static uint8_t data_buffer[DATA_BUFFER_SIZE];
-
-static uint8_t touch_point_num;
-static uint8_t touch_point_num_old;
-static touch_point_t touch_point[TOUCH_POINT_NUM_MAX];
-
-static touch_state_t touch_input_state;
-static touch_point_t touch_input_point;
-
-/********** Function Prototype **********/
-
-static void startJob(const touch_com_job_t* job);
-static void callbackSendCompleteOnlySend(void);
-static void callbackSendCompleteStartRead(void);
-static void callbackReceiveCompleteCheckInfo(void);
-static void callbackReceiveCompleteCheckCoordinate(void);
-static void parseReadData(void);
-static void transitionTouchState(void);
-static result_t updateTouchInputPoint(void);
-
-/********** Constant **********/
-
-/* GT911 I2C device addresses */
-static const uint8_t gt911_i2c_device_address = 0x5D;
-
-/* GT911デバイス情報レジスタアドレス */
-static const uint8_t gt911_device_info_register[] = {0x81, 0x40};
-
-/* GT911タッチ座標情報レジスタアドレス */
-static const uint8_t gt911_touch_coordinate_register[] = {0x81, 0x4E};
-
-/* GT911 Buffer statusクリア用送信データ(レジスタ0x814Eに0x00を書き込む) */
-static const uint8_t gt911_buffer_status_clear_data[] = {0x81, 0x4E, 0x00};
-
-/* GT911デバイス情報読み出し用ジョブ */
-static const touch_com_job_t job_read_info = {
-	(uint8_t*)gt911_device_info_register,
-	sizeof(gt911_device_info_register),
-	callbackSendCompleteStartRead,
-	data_buffer,
-	11,
-	callbackReceiveCompleteCheckInfo
-};
-
-/* GT911タッチ座標情報読み出し用ジョブ */
-static const touch_com_job_t job_read_coordinate = {
-	(uint8_t*)gt911_touch_coordinate_register,
-	sizeof(gt911_touch_coordinate_register),
-	callbackSendCompleteStartRead,
-	data_buffer,
-	50,
-	callbackReceiveCompleteCheckCoordinate
-};
-
-/* GT911 Buffer statusクリア用ジョブ */
-static const touch_com_job_t job_clear_buffer_status = {
-	(uint8_t*)gt911_buffer_status_clear_data,
-	sizeof(gt911_buffer_status_clear_data),
-	callbackSendCompleteOnlySend,
-	NULL,
-	0,
-	NULL
-};
-
-/********** Function **********/
-
-/*
- * Function: DRV TOUCH 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitTouch(void)
-{
-	/* 変数初期化 */
-	touch_com_state = TOUCH_COM_STATE_INIT;
-	current_job = NULL;
-	job_retry_count = 0;
-	touch_point_num = 0;
-	touch_point_num_old = 0;
-	touch_input_state = TOUCH_OFF;
-
-	/* GT911の設定確認 */
-	startJob(&job_read_info);
-}
-
-/*
- * Function: DRV TOUCH 周期処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void MainTouch(void)
-{
-	if (touch_com_state == TOUCH_COM_STATE_WAIT) {
-		/* 受信データからタッチ情報を作成 */
-		parseReadData();
-	} else {
-		/* 処理なし(タッチ情報は前回値を使用する) */
-	}
-
-	/* タッチ情報をもとにタッチ状態を遷移 */
-	transitionTouchState();
-
-	/* GT911タッチ座標情報読み出し(エラー時や通信中は行わない) */
-	if ((touch_com_state == TOUCH_COM_STATE_WAIT)
-	 || (touch_com_state == TOUCH_COM_STATE_TIMEOUT)) {
-		startJob(&job_read_coordinate);
-	}
-
-	/* 前回値更新 */
-	touch_point_num_old = touch_point_num;
-}
-
-/*
- * Function: タッチ入力状態取得
- * Argument: なし
- * Return  : タッチ入力状態
- * Note    : なし
- */
-touch_state_t GetTouchState(void)
-{
-	return touch_input_state;
-}
-
-/*
- * Function: タッチ入力座標取得
- * Argument: なし
- * Return  : タッチ入力座標
- * Note    : なし
- */
-point_t GetTouchPoint(void)
-{
-	point_t point;
-
-	point.x = touch_input_point.x;
-	point.y = touch_input_point.y;
-
-	return point;
-}
-
-/*
- * Function: ジョブ処理開始
- * Argument: ジョブポインタ
- * Return  : なし
- * Note    : なし
- */
-static void startJob(const touch_com_job_t* job)
-{
-	/* 通信中状態へ遷移 */
-	touch_com_state = TOUCH_COM_STATE_COM;
-	/* 送信開始 */
-	current_job = (touch_com_job_t*)job;
-	SendI2c(gt911_i2c_device_address, current_job->send_data, current_job->send_length, current_job->send_callback);
-}
-
-/*
- * Function: 送信完了コールバック(送信のみ)
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackSendCompleteOnlySend(void)
-{
-	/* 通信が完了したので、待機状態へ遷移 */
-	touch_com_state = TOUCH_COM_STATE_WAIT;
-}
-
-/*
- * Function: 送信完了コールバック(受信開始)
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackSendCompleteStartRead(void)
-{
-	/* 受信開始 */
-	ReceiveI2c(gt911_i2c_device_address, current_job->receive_buffer, current_job->receive_length, current_job->receive_callback);
-}
-
-/*
- * Function: 受信完了コールバック(GT911デバイス情報読み出し完了時)
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackReceiveCompleteCheckInfo(void)
-{
-	/* GT911のタッチ検出解像度判定 */
-	if ((data_buffer[6] == (uint8_t)(TFT_WIDTH >> 0))		/* x coordinate resolution ( low byte ) */
-	 && (data_buffer[7] == (uint8_t)(TFT_WIDTH >> 8))		/* x coordinate resolution ( high byte )*/
-	 && (data_buffer[8] == (uint8_t)(TFT_HEIGHT >> 0))		/* y coordinate resolution ( low byte ) */
-	 && (data_buffer[9] == (uint8_t)(TFT_HEIGHT >> 8))) {	/* y coordinate resolution ( high byte ) */
-		/* GT911のタッチ検出解像度設定が正しいので座標読み出し実行 */
-		startJob(&job_read_coordinate);
-	} else {
-		/* GT911のタッチ検出解像度設定が不正なのでエラー状態へ遷移 */
-		touch_com_state = TOUCH_COM_STATE_ERROR;
-	}
-}
-
-/*
- * Function: 受信完了コールバック(GT911タッチ座標情報読み出し完了時)
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void callbackReceiveCompleteCheckCoordinate(void)
-{
-	/* Buffer status確認 */
-	if ((data_buffer[0] & 0x80) == 0x80) {
-		/* タッチ座標情報読み出し成功、Buffer statusクリア */
-		startJob(&job_clear_buffer_status);
-	} else {
-		/* タッチ座標情報読み出し失敗、読み出しリトライ */
-		if (job_retry_count < READ_RETRY_MAX) {
-			/* 座標読み出し実行 */
-			job_retry_count ++;
-			startJob(&job_read_coordinate);
-		} else {
-			/* リトライ試行上限なのでタイムアウト状態へ遷移 */
-			touch_com_state = TOUCH_COM_STATE_TIMEOUT;
-		}
-	}
-}
-
-/*
- * Function: 受信データ解析
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void parseReadData(void)
-{
-	uint8_t index;
-
-	touch_point_num = data_buffer[0] & 0x07;
-
-	for (index=0; index<TOUCH_POINT_NUM_MAX; index++) {
-		touch_point[index].track_id = data_buffer[index * 8 + 1];
-		touch_point[index].x = data_buffer[index * 8 + 2];
-		touch_point[index].x += data_buffer[index * 8 + 3] << 8;
-		touch_point[index].y = data_buffer[index * 8 + 4];
-		touch_point[index].y += data_buffer[index * 8 + 5] << 8;
-		touch_point[index].size = data_buffer[index * 8 + 6];
-		touch_point[index].size += data_buffer[index * 8 + 7] << 8;
-	}
-}
-
-/*
- * Function: タッチ状態遷移
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-static void transitionTouchState(void)
-{
-	result_t result;
-	switch (touch_input_state) {
-	case TOUCH_OFF:				/* TOUCH_OFFとTOUCH_ENDは同じ処理 */
-	case TOUCH_END:
-		if ((touch_point_num_old == 0) && (touch_point_num > 0)) {
-			/* 一度タッチ検出がなくなった後に1つ以上のタッチを検出したら、先頭のタッチ情報をタッチ入力として扱う */
-			touch_input_point = touch_point[0];
-			touch_input_state = TOUCH_START;
-		} else {
-			/* タッチ無し */
-			touch_input_state = TOUCH_OFF;
-		}
-		break;
-	case TOUCH_ON:				/* TOUCH_ONとTOUCH_STARTは同じ処理 */
-	case TOUCH_START:
-		if (touch_point_num == 0) {
-			/* タッチがなければタッチ入力終了 */
-			touch_input_state = TOUCH_END;
-		} else {
-			/* タッチ情報を更新 */
-			result = updateTouchInputPoint();
-			if (result == RESULT_NG) {
-				/* 最初に検出したタッチ入力がなくなったらタッチ入力終了 */
-				touch_input_state = TOUCH_END;
-			} else {
-				/* タッチ継続 */
-				touch_input_state = TOUCH_ON;
-			}
-		}
-		break;
-	default:
-		touch_input_state = TOUCH_OFF;
-		break;
-	}
-}
-
-/*
- * Function: タッチ入力更新
- * Argument: なし
- * Return  : タッチ入力更新成功/失敗
- * Note    : なし
- */
-static result_t updateTouchInputPoint(void)
-{
-	result_t result = RESULT_NG;
-	uint8_t index;
-
-	for (index=0; index<touch_point_num; index++) {
-		if (touch_input_point.track_id == touch_point[index].track_id) {
-			/* 同じtrack idが検出出来たら、タッチ入力を更新*/
-			touch_input_point = touch_point[index];
-			result = RESULT_OK;
-			break;
-		}
-	}
-
-	return result;
-}
+/*
+ * drv_touch.c
+ *
+ *  Created on: Jun 30, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "drv_tft.h"
+#include "mcal_dio.h"
+#include "mcal_i2c.h"
+#include "mcal_timer.h"
+#include "drv_touch.h"
+
+/********** Define **********/
+
+/* 通信データバッファサイズ [byte] */
+#define DATA_BUFFER_SIZE		(64)
+
+/* GT911 I2C device addresses */
+#define GT911_I2C_DEVICE_ADDRESS	(0x5D)
+
+/* 読み出しリトライ試行回数 */
+#define READ_RETRY_MAX			(10)
+
+/* タッチ同時検出最大数 */
+#define TOUCH_POINT_NUM_MAX		(5)
+
+/* GT911タッチ座標情報の1点あたりのサイズ [byte] */
+#define GT911_POINT_SIZE		(8)
+/* GT911タッチ座標情報の先頭(Buffer status + 1点目)のサイズ [byte] */
+#define GT911_COORDINATE_FIRST_SIZE	(1 + GT911_POINT_SIZE)
+
+/* 差し替え中の接触に使用するtrack id(GT911のtrack idと重ならない値) */
+#define TOUCH_INJECT_TRACK_ID	(0xFF)
+
+/* 座標予測: 座標の小数部ビット数 */
+#define PREDICT_POSITION_SHIFT	(8)
+/* 座標予測: 速度の上限 [(px << PREDICT_POSITION_SHIFT) / ms] */
+#define PREDICT_VELOCITY_MAX	(20 << PREDICT_POSITION_SHIFT)
+/* 座標予測: 予測時間の上限 [us] */
+#define PREDICT_LEAD_TIME_MAX	(100000)
+/* 座標予測: 平滑化係数の最大値(平滑化なし) */
+#define PREDICT_SMOOTHING_MAX	(256)
+
+#if TOUCH_INT_ENABLE && !defined(TOUCH_INT_Pin)
+#error "TOUCH_INT_ENABLE requires TOUCH_INT pin (GT911 INT) in CubeMX"
+#endif
+
+/********** Enum **********/
+
+typedef enum {
+	TOUCH_COM_STATE_INIT = 0,
+	TOUCH_COM_STATE_COM,
+	TOUCH_COM_STATE_WAIT,
+	TOUCH_COM_STATE_ERROR,
+	TOUCH_COM_STATE_TIMEOUT
+} touch_com_state_t;
+
+/********** Type **********/
+
+typedef struct {
+	uint8_t track_id;
+	uint16_t x;
+	uint16_t y;
+	uint16_t size;
+} touch_point_t;
+
+/********** Variable **********/
+
+static touch_com_state_t touch_com_state;
+static uint32_t job_retry_count;
+static uint8_t data_buffer[DATA_BUFFER_SIZE];
+
+static uint8_t touch_point_num;
+static uint8_t touch_point_num_old;
+static touch_point_t touch_point[TOUCH_POINT_NUM_MAX];
+
+static touch_state_t touch_input_state;
+static touch_point_t touch_input_point;
+
+static touch_contact_t touch_contact[TOUCH_CONTACT_NUM];
+
+/* 座標予測 */
+static uint32_t touch_read_time;		/* Buffer status読み出し完了時刻(書き込み:割り込み処理) */
+static uint32_t touch_sample_time;		/* touch_pointの読み出し時刻(parseReadDataで座標と同時に更新) */
+static uint32_t touch_predict_lead_time;
+static uint32_t touch_predict_smoothing;
+static int32_t touch_predict_velocity_x[TOUCH_CONTACT_NUM];
+static int32_t touch_predict_velocity_y[TOUCH_CONTACT_NUM];
+static uint32_t touch_predict_time[TOUCH_CONTACT_NUM];
+
+/* GT911タッチ座標情報(2点目以降)読み出し用ジョブ(読み出しサイズは検出数で決定) */
+static i2c_job_t job_read_coordinate_rest;
+
+#if TOUCH_INT_ENABLE
+/* GT911の座標更新通知(書き込み:割り込み処理、読み出し:周期処理) */
+static bool_t touch_int_pending;
+#endif
+
+/* 外部から与えたタッチ入力(リプレイ用) */
+static bool_t touch_inject_enable;
+static touch_state_t touch_inject_state;
+static point_t touch_inject_point;
+
+/********** Function Prototype **********/
+
+static void startJob(const i2c_job_t* job);
+static void callbackSendCompleteOnlySend(result_t result);
+static void callbackReceiveCompleteCheckInfo(result_t result);
+static void callbackReceiveCompleteCheckCoordinate(result_t result);
+static void callbackReceiveCompleteCoordinateRest(result_t result);
+static void parseReadData(void);
+static void transitionTouchState(void);
+static void updateTouchContact(const touch_point_t point[], uint8_t point_num);
+static void updateTouchPrediction(uint32_t contact_index, uint16_t x, uint16_t y);
+static int32_t clampPredictValue(int32_t value, int32_t min, int32_t max);
+#if TOUCH_INT_ENABLE
+static void callbackTouchInt(pin_id_t pin_id);
+#endif
+static result_t updateTouchInputPoint(void);
+
+/********** Constant **********/
+
+/* GT911デバイス情報レジスタアドレス */
+static const uint8_t gt911_device_info_register[] = {0x81, 0x40};
+
+/* GT911タッチ座標情報レジスタアドレス */
+static const uint8_t gt911_touch_coordinate_register[] = {0x81, 0x4E};
+
+/* GT911タッチ座標情報(2点目以降)レジスタアドレス */
+static const uint8_t gt911_touch_coordinate_rest_register[] = {0x81, 0x57};
+
+/* GT911 Buffer statusクリア用送信データ(レジスタ0x814Eに0x00を書き込む) */
+static const uint8_t gt911_buffer_status_clear_data[] = {0x81, 0x4E, 0x00};
+
+/* GT911デバイス情報読み出し用ジョブ */
+static const i2c_job_t job_read_info = {
+	GT911_I2C_DEVICE_ADDRESS,
+	gt911_device_info_register,
+	sizeof(gt911_device_info_register),
+	data_buffer,
+	11,
+	I2C_JOB_RESTART,
+	callbackReceiveCompleteCheckInfo
+};
+
+/* GT911タッチ座標情報読み出し用ジョブ(Buffer statusと1点目) */
+static const i2c_job_t job_read_coordinate = {
+	GT911_I2C_DEVICE_ADDRESS,
+	gt911_touch_coordinate_register,
+	sizeof(gt911_touch_coordinate_register),
+	data_buffer,
+	GT911_COORDINATE_FIRST_SIZE,
+	I2C_JOB_RESTART,
+	callbackReceiveCompleteCheckCoordinate
+};
+
+/* GT911 Buffer statusクリア用ジョブ */
+static const i2c_job_t job_clear_buffer_status = {
+	GT911_I2C_DEVICE_ADDRESS,
+	gt911_buffer_status_clear_data,
+	sizeof(gt911_buffer_status_clear_data),
+	NULL,
+	0,
+	I2C_JOB_STOP,
+	callbackSendCompleteOnlySend
+};
+
+/********** Function **********/
+
+/*
+ * Function: DRV TOUCH 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitTouch(void)
+{
+	/* 変数初期化 */
+	touch_com_state = TOUCH_COM_STATE_INIT;
+	job_retry_count = 0;
+	touch_point_num = 0;
+	touch_point_num_old = 0;
+	touch_input_state = TOUCH_OFF;
+	for (uint32_t index=0; index<TOUCH_CONTACT_NUM; index++) {
+		touch_contact[index].state = TOUCH_CONTACT_NONE;
+	}
+	touch_read_time = 0;
+	touch_sample_time = 0;
+	touch_predict_lead_time = 0;
+	touch_predict_smoothing = PREDICT_SMOOTHING_MAX;
+	touch_inject_enable = FALSE;
+	touch_inject_state = TOUCH_OFF;
+	touch_inject_point.x = 0.0f;
+	touch_inject_point.y = 0.0f;
+
+#if TOUCH_INT_ENABLE
+	/* GT911は座標更新時にINT端子をパルス出力する */
+	touch_int_pending = FALSE;
+	EnablePinInterrupt(PIN_ID_TOUCH_INT, callbackTouchInt);
+#endif
+
+	job_read_coordinate_rest.device_address = GT911_I2C_DEVICE_ADDRESS;
+	job_read_coordinate_rest.write_data = gt911_touch_coordinate_rest_register;
+	job_read_coordinate_rest.write_length = sizeof(gt911_touch_coordinate_rest_register);
+	job_read_coordinate_rest.read_data = &data_buffer[GT911_COORDINATE_FIRST_SIZE];
+	job_read_coordinate_rest.read_length = 0;
+	job_read_coordinate_rest.flag = I2C_JOB_RESTART;
+	job_read_coordinate_rest.callback = callbackReceiveCompleteCoordinateRest;
+
+	/* GT911の設定確認 */
+	startJob(&job_read_info);
+}
+
+/*
+ * Function: DRV TOUCH 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void MainTouch(void)
+{
+	touch_point_t inject_point;
+	uint8_t inject_point_num = 0;
+
+	if (touch_com_state == TOUCH_COM_STATE_WAIT) {
+		/* 受信データからタッチ情報を作成 */
+		parseReadData();
+	} else {
+		/* 処理なし(タッチ情報は前回値を使用する) */
+	}
+
+	/* タッチ情報をもとにタッチ状態を遷移 */
+	transitionTouchState();
+	if (touch_inject_enable == TRUE) {
+		/* 差し替え中は差し替えた1点で接触テーブルを更新する(ジェスチャ判定に使用) */
+		if ((touch_inject_state == TOUCH_START) || (touch_inject_state == TOUCH_ON)) {
+			inject_point.track_id = TOUCH_INJECT_TRACK_ID;
+			inject_point.x = (uint16_t)touch_inject_point.x;
+			inject_point.y = (uint16_t)touch_inject_point.y;
+			inject_point.size = 0;
+			inject_point_num = 1;
+		}
+		updateTouchContact(&inject_point, inject_point_num);
+	} else {
+		updateTouchContact(touch_point, touch_point_num);
+	}
+
+	/* GT911タッチ座標情報読み出し(エラー時や通信中は行わない) */
+#if TOUCH_INT_ENABLE
+	/* INT端子で座標更新が通知された場合のみ読み出す(通信中の通知は次周期に読み出す) */
+	if ((touch_int_pending == TRUE)
+	 && ((touch_com_state == TOUCH_COM_STATE_WAIT)
+	  || (touch_com_state == TOUCH_COM_STATE_TIMEOUT))) {
+		touch_int_pending = FALSE;
+		startJob(&job_read_coordinate);
+	}
+#else
+	if ((touch_com_state == TOUCH_COM_STATE_WAIT)
+	 || (touch_com_state == TOUCH_COM_STATE_TIMEOUT)) {
+		startJob(&job_read_coordinate);
+	}
+#endif
+
+	/* 前回値更新 */
+	touch_point_num_old = touch_point_num;
+}
+
+/*
+ * Function: タッチ入力状態取得
+ * Argument: なし
+ * Return  : タッチ入力状態
+ * Note    : なし
+ */
+touch_state_t GetTouchState(void)
+{
+	touch_state_t state = touch_input_state;
+
+	if (touch_inject_enable == TRUE) {
+		state = touch_inject_state;
+	}
+
+	return state;
+}
+
+/*
+ * Function: タッチ入力座標取得
+ * Argument: なし
+ * Return  : タッチ入力座標
+ * Note    : なし
+ */
+point_t GetTouchPoint(void)
+{
+	point_t point;
+
+	if (touch_inject_enable == TRUE) {
+		point = touch_inject_point;
+	} else {
+		point.x = touch_input_point.x;
+		point.y = touch_input_point.y;
+	}
+
+	return point;
+}
+
+/*
+ * Function: タッチ接触取得
+ * Argument: 接触テーブルのインデックス(0～TOUCH_CONTACT_NUM-1)
+ * Return  : タッチ接触
+ * Note    : 接触開始から終了まで同じインデックスに格納される
+ */
+touch_contact_t GetTouchContact(uint32_t index)
+{
+	touch_contact_t contact = {TOUCH_CONTACT_NONE, 0, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+
+	if (index < TOUCH_CONTACT_NUM) {
+		contact = touch_contact[index];
+	}
+
+	return contact;
+}
+
+/*
+ * Function: タッチ座標予測設定
+ * Argument: 予測時間 [us](座標読み出しから表示までの追加遅延、0で予測無効)、
+ *           速度の平滑化係数(1～256、小さいほど平滑化が強い、256で平滑化なし)
+ * Return  : なし
+ * Note    : 予測座標は座標読み出し時刻からの経過時間+予測時間だけ外挿する
+ */
+void SetTouchPrediction(uint32_t lead_time, uint32_t smoothing)
+{
+	if (lead_time > PREDICT_LEAD_TIME_MAX) {
+		lead_time = PREDICT_LEAD_TIME_MAX;
+	}
+	if (smoothing < 1) {
+		smoothing = 1;
+	} else if (smoothing > PREDICT_SMOOTHING_MAX) {
+		smoothing = PREDICT_SMOOTHING_MAX;
+	} else {
+		/* 処理なし */
+	}
+
+	touch_predict_lead_time = lead_time;
+	touch_predict_smoothing = smoothing;
+}
+
+/*
+ * Function: タッチ入力差し替え有効/無効設定
+ * Argument: TRUE:InjectTouchの値を使用、FALSE:GT911の値を使用
+ * Return  : なし
+ * Note    : 差し替え中もGT911との通信は継続する
+ *           差し替え中の接触テーブルは差し替えた1点で更新する
+ */
+void SetTouchInject(bool_t enable)
+{
+	touch_inject_enable = enable;
+}
+
+/*
+ * Function: タッチ入力差し替え
+ * Argument: タッチ入力状態、タッチ入力座標
+ * Return  : なし
+ * Note    : なし
+ */
+void InjectTouch(touch_state_t state, point_t point)
+{
+	touch_inject_state = state;
+	touch_inject_point = point;
+}
+
+/*
+ * Function: ジョブ処理開始
+ * Argument: ジョブポインタ
+ * Return  : なし
+ * Note    : なし
+ */
+static void startJob(const i2c_job_t* job)
+{
+	result_t result;
+
+	/* 通信中状態へ遷移 */
+	touch_com_state = TOUCH_COM_STATE_COM;
+	/* 通信開始(読み出しはレジスタアドレス送信とリピーテッドスタートで1回の通信) */
+	result = AddI2cJob(job);
+	if (result == RESULT_NG) {
+		/* I2Cジョブキュー満杯のため次周期に再開 */
+		touch_com_state = TOUCH_COM_STATE_TIMEOUT;
+	}
+}
+
+/*
+ * Function: 送信完了コールバック(送信のみ)
+ * Argument: 通信結果
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackSendCompleteOnlySend(result_t result)
+{
+	(void)result;
+
+	/* 通信が完了したので、待機状態へ遷移(Buffer statusクリア失敗時も読み出したデータは有効) */
+	touch_com_state = TOUCH_COM_STATE_WAIT;
+}
+
+/*
+ * Function: 受信完了コールバック(GT911デバイス情報読み出し完了時)
+ * Argument: 通信結果
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackReceiveCompleteCheckInfo(result_t result)
+{
+	/* GT911のタッチ検出解像度判定 */
+	if ((result == RESULT_OK)
+	 && (data_buffer[6] == (uint8_t)(TFT_WIDTH >> 0))		/* x coordinate resolution ( low byte ) */
+	 && (data_buffer[7] == (uint8_t)(TFT_WIDTH >> 8))		/* x coordinate resolution ( high byte )*/
+	 && (data_buffer[8] == (uint8_t)(TFT_HEIGHT >> 0))		/* y coordinate resolution ( low byte ) */
+	 && (data_buffer[9] == (uint8_t)(TFT_HEIGHT >> 8))) {	/* y coordinate resolution ( high byte ) */
+		/* GT911のタッチ検出解像度設定が正しいので座標読み出し実行 */
+		startJob(&job_read_coordinate);
+	} else {
+		/* GT911のタッチ検出解像度設定が不正なのでエラー状態へ遷移 */
+		touch_com_state = TOUCH_COM_STATE_ERROR;
+	}
+}
+
+/*
+ * Function: 受信完了コールバック(GT911タッチ座標情報読み出し完了時)
+ * Argument: 通信結果
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackReceiveCompleteCheckCoordinate(result_t result)
+{
+	uint8_t point_num;
+
+	if (result == RESULT_NG) {
+		/* 通信エラー(リトライはmcal_i2cで実施済み)、次周期に再開 */
+		touch_com_state = TOUCH_COM_STATE_TIMEOUT;
+	} else if ((data_buffer[0] & 0x80) == 0x80) {
+		/* Buffer status確認 */
+		touch_read_time = GetTimeUs();
+		job_retry_count = 0;
+		point_num = data_buffer[0] & 0x07;
+		if (point_num > TOUCH_POINT_NUM_MAX) {
+			point_num = TOUCH_POINT_NUM_MAX;
+		}
+		if (point_num > 1) {
+			/* 2点目以降を検出数分だけ読み出し */
+			job_read_coordinate_rest.read_length = (point_num - 1) * GT911_POINT_SIZE;
+			startJob(&job_read_coordinate_rest);
+		} else {
+			/* タッチ座標情報読み出し成功、Buffer statusクリア */
+			startJob(&job_clear_buffer_status);
+		}
+	} else {
+		/* タッチ座標情報読み出し失敗、読み出しリトライ */
+#if TOUCH_INT_ENABLE
+		/* INT端子の通知後はデータ準備済みのためリトライせず、次の通知を待つ(受信データは解析しない) */
+		touch_com_state = TOUCH_COM_STATE_TIMEOUT;
+#else
+		if (job_retry_count < READ_RETRY_MAX) {
+			/* 座標読み出し実行 */
+			job_retry_count ++;
+			startJob(&job_read_coordinate);
+		} else {
+			/* リトライ試行上限なのでタイムアウト状態へ遷移 */
+			touch_com_state = TOUCH_COM_STATE_TIMEOUT;
+		}
+#endif
+	}
+}
+
+/*
+ * Function: 受信完了コールバック(GT911タッチ座標情報2点目以降読み出し完了時)
+ * Argument: 通信結果
+ * Return  : なし
+ * Note    : なし
+ */
+static void callbackReceiveCompleteCoordinateRest(result_t result)
+{
+	if (result == RESULT_OK) {
+		/* タッチ座標情報読み出し成功、Buffer statusクリア */
+		startJob(&job_clear_buffer_status);
+	} else {
+		/* 通信エラー、次周期に再開 */
+		touch_com_state = TOUCH_COM_STATE_TIMEOUT;
+	}
+}
+
+/*
+ * Function: 受信データ解析
+ * Argument: なし
+ * Return  : なし
+ * Note    : 読み出し時刻は座標と同時に確定する(一連の読み出しの途中で周期処理が来ても、古い座標と新しい時刻を組み合わせない)
+ */
+static void parseReadData(void)
+{
+	uint8_t index;
+
+	touch_sample_time = touch_read_time;
+	touch_point_num = data_buffer[0] & 0x07;
+
+	for (index=0; index<TOUCH_POINT_NUM_MAX; index++) {
+		touch_point[index].track_id = data_buffer[index * 8 + 1];
+		touch_point[index].x = data_buffer[index * 8 + 2];
+		touch_point[index].x += data_buffer[index * 8 + 3] << 8;
+		touch_point[index].y = data_buffer[index * 8 + 4];
+		touch_point[index].y += data_buffer[index * 8 + 5] << 8;
+		touch_point[index].size = data_buffer[index * 8 + 6];
+		touch_point[index].size += data_buffer[index * 8 + 7] << 8;
+	}
+}
+
+/*
+ * Function: タッチ状態遷移
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void transitionTouchState(void)
+{
+	result_t result;
+	switch (touch_input_state) {
+	case TOUCH_OFF:				/* TOUCH_OFFとTOUCH_ENDは同じ処理 */
+	case TOUCH_END:
+		if ((touch_point_num_old == 0) && (touch_point_num > 0)) {
+			/* 一度タッチ検出がなくなった後に1つ以上のタッチを検出したら、先頭のタッチ情報をタッチ入力として扱う */
+			touch_input_point = touch_point[0];
+			touch_input_state = TOUCH_START;
+		} else {
+			/* タッチ無し */
+			touch_input_state = TOUCH_OFF;
+		}
+		break;
+	case TOUCH_ON:				/* TOUCH_ONとTOUCH_STARTは同じ処理 */
+	case TOUCH_START:
+		if (touch_point_num == 0) {
+			/* タッチがなければタッチ入力終了 */
+			touch_input_state = TOUCH_END;
+		} else {
+			/* タッチ情報を更新 */
+			result = updateTouchInputPoint();
+			if (result == RESULT_NG) {
+				/* 最初に検出したタッチ入力がなくなったらタッチ入力終了 */
+				touch_input_state = TOUCH_END;
+			} else {
+				/* タッチ継続 */
+				touch_input_state = TOUCH_ON;
+			}
+		}
+		break;
+	default:
+		touch_input_state = TOUCH_OFF;
+		break;
+	}
+}
+
+/*
+ * Function: タッチ入力更新
+ * Argument: なし
+ * Return  : タッチ入力更新成功/失敗
+ * Note    : なし
+ */
+static result_t updateTouchInputPoint(void)
+{
+	result_t result = RESULT_NG;
+	uint8_t index;
+
+	for (index=0; index<touch_point_num; index++) {
+		if (touch_input_point.track_id == touch_point[index].track_id) {
+			/* 同じtrack idが検出出来たら、タッチ入力を更新*/
+			touch_input_point = touch_point[index];
+			result = RESULT_OK;
+			break;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Function: タッチ接触テーブル更新
+ * Argument: 今周期の検出点、検出数
+ * Return  : なし
+ * Note    : track idで前周期の接触と対応付ける
+ *           処理量は検出数×テーブル要素数で上限が決まる
+ */
+static void updateTouchContact(const touch_point_t point[], uint8_t point_num)
+{
+	bool_t contact_found[TOUCH_CONTACT_NUM];
+	uint32_t contact_index;
+	uint8_t index;
+
+	/* 前周期に終了した接触を解放 */
+	for (contact_index=0; contact_index<TOUCH_CONTACT_NUM; contact_index++) {
+		if (touch_contact[contact_index].state == TOUCH_CONTACT_END) {
+			touch_contact[contact_index].state = TOUCH_CONTACT_NONE;
+		}
+		contact_found[contact_index] = FALSE;
+	}
+
+	for (index=0; (index<point_num) && (index<TOUCH_POINT_NUM_MAX); index++) {
+		/* 同じtrack idの接触を検索 */
+		for (contact_index=0; contact_index<TOUCH_CONTACT_NUM; contact_index++) {
+			if ((touch_contact[contact_index].state != TOUCH_CONTACT_NONE)
+			 && (touch_contact[contact_index].track_id == point[index].track_id)) {
+				break;
+			}
+		}
+
+		if (contact_index < TOUCH_CONTACT_NUM) {
+			/* 接触継続 */
+			if ((touch_contact[contact_index].point.x != point[index].x)
+			 || (touch_contact[contact_index].point.y != point[index].y)) {
+				touch_contact[contact_index].state = TOUCH_CONTACT_MOVE;
+			} else {
+				touch_contact[contact_index].state = TOUCH_CONTACT_STAY;
+			}
+		} else {
+			/* 新規接触は空き要素に格納 */
+			for (contact_index=0; contact_index<TOUCH_CONTACT_NUM; contact_index++) {
+				if (touch_contact[contact_index].state == TOUCH_CONTACT_NONE) {
+					touch_contact[contact_index].state = TOUCH_CONTACT_START;
+					touch_contact[contact_index].track_id = point[index].track_id;
+					touch_contact[contact_index].start_point.x = point[index].x;
+					touch_contact[contact_index].start_point.y = point[index].y;
+					break;
+				}
+			}
+		}
+
+		if (contact_index < TOUCH_CONTACT_NUM) {
+			updateTouchPrediction(contact_index, point[index].x, point[index].y);
+			touch_contact[contact_index].point.x = point[index].x;
+			touch_contact[contact_index].point.y = point[index].y;
+			contact_found[contact_index] = TRUE;
+		}
+	}
+
+	/* 検出されなくなった接触は終了 */
+	for (contact_index=0; contact_index<TOUCH_CONTACT_NUM; contact_index++) {
+		if ((contact_found[contact_index] == FALSE)
+		 && (touch_contact[contact_index].state != TOUCH_CONTACT_NONE)) {
+			touch_contact[contact_index].state = TOUCH_CONTACT_END;
+		}
+	}
+}
+
+/*
+ * Function: タッチ座標予測更新
+ * Argument: 接触テーブルのインデックス、今周期の座標
+ * Return  : なし
+ * Note    : 新しい座標を読み出した場合のみ速度を更新する(接触開始時は速度0から開始)
+ *           接触テーブルの座標を更新する前に呼び出す
+ */
+static void updateTouchPrediction(uint32_t contact_index, uint16_t x, uint16_t y)
+{
+	touch_contact_t* contact = &touch_contact[contact_index];
+	int32_t elapsed;
+	int32_t velocity;
+	int32_t lead;
+	int32_t predicted_x;
+	int32_t predicted_y;
+
+	if (contact->state == TOUCH_CONTACT_START) {
+		touch_predict_velocity_x[contact_index] = 0;
+		touch_predict_velocity_y[contact_index] = 0;
+		touch_predict_time[contact_index] = touch_sample_time;
+	} else if (touch_sample_time != touch_predict_time[contact_index]) {
+		elapsed = touch_sample_time - touch_predict_time[contact_index];
+
+		/* 今回の速度を算出し、前回までの速度と加重平均 */
+		velocity = (((int32_t)x - (int32_t)contact->point.x) << PREDICT_POSITION_SHIFT) * 1000 / elapsed;
+		velocity = clampPredictValue(velocity, -PREDICT_VELOCITY_MAX, PREDICT_VELOCITY_MAX);
+		touch_predict_velocity_x[contact_index] += (velocity - touch_predict_velocity_x[contact_index]) * (int32_t)touch_predict_smoothing / PREDICT_SMOOTHING_MAX;
+
+		velocity = (((int32_t)y - (int32_t)contact->point.y) << PREDICT_POSITION_SHIFT) * 1000 / elapsed;
+		velocity = clampPredictValue(velocity, -PREDICT_VELOCITY_MAX, PREDICT_VELOCITY_MAX);
+		touch_predict_velocity_y[contact_index] += (velocity - touch_predict_velocity_y[contact_index]) * (int32_t)touch_predict_smoothing / PREDICT_SMOOTHING_MAX;
+
+		touch_predict_time[contact_index] = touch_sample_time;
+	} else {
+		/* 処理なし(新しい座標なし) */
+	}
+
+	if (touch_predict_lead_time == 0) {
+		/* 予測無効 */
+		contact->predicted_point.x = x;
+		contact->predicted_point.y = y;
+	} else {
+		/* 座標読み出しから表示までの時間分を外挿 */
+		lead = (GetTimeUs() - touch_predict_time[contact_index]) + touch_predict_lead_time;
+		lead = clampPredictValue(lead, 0, PREDICT_LEAD_TIME_MAX);
+		predicted_x = ((int32_t)x << PREDICT_POSITION_SHIFT) + touch_predict_velocity_x[contact_index] * lead / 1000;
+		predicted_y = ((int32_t)y << PREDICT_POSITION_SHIFT) + touch_predict_velocity_y[contact_index] * lead / 1000;
+		predicted_x = clampPredictValue(predicted_x, 0, (TFT_WIDTH - 1) << PREDICT_POSITION_SHIFT);
+		predicted_y = clampPredictValue(predicted_y, 0, (TFT_HEIGHT - 1) << PREDICT_POSITION_SHIFT);
+		contact->predicted_point.x = predicted_x >> PREDICT_POSITION_SHIFT;
+		contact->predicted_point.y = predicted_y >> PREDICT_POSITION_SHIFT;
+	}
+}
+
+/*
+ * Function: 範囲制限
+ * Argument: 値、最小値、最大値
+ * Return  : 範囲内に制限した値
+ * Note    : なし
+ */
+static int32_t clampPredictValue(int32_t value, int32_t min, int32_t max)
+{
+	if (value < min) {
+		value = min;
+	} else if (value > max) {
+		value = max;
+	} else {
+		/* 処理なし */
+	}
+
+	return value;
+}
+
+#if TOUCH_INT_ENABLE
+/*
+ * Function: GT911 INT端子割り込みコールバック
+ * Argument: 端子ID
+ * Return  : なし
+ * Note    : EXTI割り込み処理
+ */
+static void callbackTouchInt(pin_id_t pin_id)
+{
+	touch_int_pending = TRUE;
+}
+#endif
@@ -1,40 +1,67 @@
-/*
- * drv_touch.h
- *
- *  Created on: Jun 30, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef DRV_TOUCH_H_
-#define DRV_TOUCH_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	TOUCH_OFF = 0,
-	TOUCH_START,
-	TOUCH_ON,
-	TOUCH_END
-} touch_state_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitTouch(void);
-void MainTouch(void);
-touch_state_t GetTouchState(void);
-point_t GetTouchPoint(void);
-
-#endif /* DRV_TOUCH_H_ */
+/*
+ * drv_touch.h
+ *
+ *  Created on: Jun 30, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef DRV_TOUCH_H_
+#define DRV_TOUCH_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* タッチ座標読み出し契機(0:毎周期読み出し、1:GT911のINT端子割り込み) */
+#define TOUCH_INT_ENABLE		(0)
+
+/* タッチ接触テーブルの要素数(終了した接触と新規の接触が同時に存在できる数) */
+#define TOUCH_CONTACT_NUM		(10)
+
+/********** Enum **********/
+
+typedef enum {
+	TOUCH_OFF = 0,
+	TOUCH_START,
+	TOUCH_ON,
+	TOUCH_END
+} touch_state_t;
+
+typedef enum {
+	TOUCH_CONTACT_NONE = 0,		/* 未使用 */
+	TOUCH_CONTACT_START,		/* 接触開始 */
+	TOUCH_CONTACT_MOVE,			/* 接触中(移動あり) */
+	TOUCH_CONTACT_STAY,			/* 接触中(移動なし) */
+	TOUCH_CONTACT_END			/* 接触終了 */
+} touch_contact_state_t;
+
+/********** Type **********/
+
+/* タッチ接触(GT911のtrack id毎) */
+typedef struct {
+	touch_contact_state_t state;	/* 接触状態 */
+	uint8_t track_id;				/* GT911のtrack id */
+	point_t point;					/* 現在の座標(接触終了時は最後の座標) */
+	point_t start_point;			/* 接触開始時の座標 */
+	point_t predicted_point;		/* 表示時刻に予測した座標(予測無効時はpointと同じ) */
+} touch_contact_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitTouch(void);
+void MainTouch(void);
+touch_state_t GetTouchState(void);
+point_t GetTouchPoint(void);
+touch_contact_t GetTouchContact(uint32_t index);
+void SetTouchPrediction(uint32_t lead_time, uint32_t smoothing);
+void SetTouchInject(bool_t enable);
+void InjectTouch(touch_state_t state, point_t point);
+
+#endif /* DRV_TOUCH_H_ */
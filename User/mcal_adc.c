@@ -1,94 +1,275 @@
-/*
- * mcal_adc.c
- *
- *  Created on: Jul 8, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_adc.h"
-
-/********** Define **********/
-
-#define AD_VALUE_MAX		(0x03FFF)
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-const uint32_t injection_rank_table[AD_ID_NUM] =
-{
-	ADC_INJECTED_RANK_1,
-	ADC_INJECTED_RANK_2,
-	ADC_INJECTED_RANK_3
-};
-
-/********** Variable **********/
-
-extern ADC_HandleTypeDef hadc1;
-
-static float ad_value[AD_ID_NUM];
-
-/********** Function Prototype **********/
-
-/********** Function **********/
-
-/*
- * Function: MCAL ADC 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitAdc(void)
-{
-	/* 各デバイスの初期値を設定 */
-	ad_value[AD_ID_POS_H] = 0.5f;
-	ad_value[AD_ID_POS_V] = 0.5f;
-	ad_value[AD_ID_LEVER] = 1.0f;
-}
-
-/*
- * Function: MCAL ADC 周期処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void MainAdc(void)
-{
-	/* AD変換実行 */
-	HAL_ADCEx_InjectedStart_IT(&hadc1);
-}
-
-/*
- * Function: AD値取得
- * Argument: AD値ID
- * Return  : AD値(0.0～1.0)
- * Note    : なし
- */
-float GetAd(ad_id_t ad_id)
-{
-	return ad_value[ad_id];
-}
-
-/*
- * Function: AD変換完了割り込み処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InterruptAdcComplete(void)
-{
-	uint32_t ad_id;
-	uint32_t value;
-
-	for (ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
-		/* AD変換結果取得 */
-		value = HAL_ADCEx_InjectedGetValue(&hadc1, injection_rank_table[ad_id]);
-		ad_value[ad_id] = value / (float)AD_VALUE_MAX;
-	}
-}
+/*
+ * mcal_adc.c
+ *
+ *  Created on: Jul 8, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_adc.h"
+
+/********** Define **********/
+
+#if AD_DMA_ENABLE
+/* オーバーサンプリング比(14bit×16回加算を4bit右シフトして14bitに戻す) */
+#define AD_OVERSAMPLING_RATIO	(16)
+#endif
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+#if AD_DMA_ENABLE
+const uint32_t regular_channel_table[AD_ID_NUM] =
+{
+	ADC_CHANNEL_5,
+	ADC_CHANNEL_6,
+	ADC_CHANNEL_9
+};
+
+const uint32_t regular_rank_table[AD_ID_NUM] =
+{
+	ADC_REGULAR_RANK_1,
+	ADC_REGULAR_RANK_2,
+	ADC_REGULAR_RANK_3
+};
+#else
+const uint32_t injection_rank_table[AD_ID_NUM] =
+{
+	ADC_INJECTED_RANK_1,
+	ADC_INJECTED_RANK_2,
+	ADC_INJECTED_RANK_3
+};
+#endif
+
+/********** Variable **********/
+
+extern ADC_HandleTypeDef hadc1;
+
+#if AD_DMA_ENABLE
+/* DMA転送先(GPDMA循環転送で常に最新の変換結果に更新される) */
+static uint32_t ad_dma_buffer[AD_ID_NUM];
+#else
+static uint32_t ad_raw_value[AD_ID_NUM];
+#endif
+static callback_t ad_callback;
+
+/* 外部から与えたAD変換値(リプレイ用) */
+static bool_t ad_inject_enable;
+static uint32_t ad_inject_value[AD_ID_NUM];
+
+/********** Function Prototype **********/
+
+#if AD_DMA_ENABLE
+static void startAdcDma(void);
+#endif
+
+/********** Function **********/
+
+/*
+ * Function: MCAL ADC 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitAdc(void)
+{
+	/* 各デバイスの初期値を設定 */
+#if AD_DMA_ENABLE
+	ad_dma_buffer[AD_ID_POS_H] = AD_VALUE_MAX / 2;
+	ad_dma_buffer[AD_ID_POS_V] = AD_VALUE_MAX / 2;
+	ad_dma_buffer[AD_ID_LEVER] = AD_VALUE_MAX;
+#else
+	ad_raw_value[AD_ID_POS_H] = AD_VALUE_MAX / 2;
+	ad_raw_value[AD_ID_POS_V] = AD_VALUE_MAX / 2;
+	ad_raw_value[AD_ID_LEVER] = AD_VALUE_MAX;
+#endif
+	ad_callback = NULL;
+	ad_inject_enable = FALSE;
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		ad_inject_value[ad_id] = 0;
+	}
+
+#if AD_DMA_ENABLE
+	/* 連続変換開始 */
+	startAdcDma();
+#endif
+}
+
+/*
+ * Function: MCAL ADC 周期処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void MainAdc(void)
+{
+#if AD_DMA_ENABLE
+	/* 処理なし(DMA連続変換中) */
+#else
+	/* AD変換実行 */
+	HAL_ADCEx_InjectedStart_IT(&hadc1);
+#endif
+}
+
+/*
+ * Function: AD値取得
+ * Argument: AD値ID
+ * Return  : AD値(0.0～1.0)
+ * Note    : DMA連続変換時はAD変換を開始せず、最新のオーバーサンプリング値を返す
+ */
+float GetAd(ad_id_t ad_id)
+{
+	return GetAdRaw(ad_id) / (float)AD_VALUE_MAX;
+}
+
+/*
+ * Function: AD変換値取得
+ * Argument: AD値ID
+ * Return  : AD変換値(0～AD_VALUE_MAX)
+ * Note    : なし
+ */
+uint32_t GetAdRaw(ad_id_t ad_id)
+{
+	uint32_t value;
+
+	if (ad_inject_enable == TRUE) {
+		value = ad_inject_value[ad_id];
+	} else {
+#if AD_DMA_ENABLE
+		value = ad_dma_buffer[ad_id];
+#else
+		value = ad_raw_value[ad_id];
+#endif
+	}
+
+	return value;
+}
+
+/*
+ * Function: AD変換値差し替え有効/無効設定
+ * Argument: TRUE:InjectAdの値を使用、FALSE:AD変換結果を使用
+ * Return  : なし
+ * Note    : 差し替え中もAD変換は継続する
+ */
+void SetAdInject(bool_t enable)
+{
+	ad_inject_enable = enable;
+}
+
+/*
+ * Function: AD変換値差し替え
+ * Argument: AD値ID、AD変換値(0～AD_VALUE_MAX)
+ * Return  : なし
+ * Note    : なし
+ */
+void InjectAd(ad_id_t ad_id, uint32_t value)
+{
+	ad_inject_value[ad_id] = value;
+}
+
+/*
+ * Function: AD変換完了コールバック関数設定
+ * Argument: コールバック関数
+ * Return  : なし
+ * Note    : コールバック関数は割り込み処理から呼び出される
+ *           DMA連続変換時はUpdateAdの呼び出し毎に呼び出される
+ */
+void SetAdCallback(callback_t callback)
+{
+	ad_callback = callback;
+}
+
+/*
+ * Function: AD値更新通知
+ * Argument: なし
+ * Return  : なし
+ * Note    : 5ms周期の割り込み処理
+ *           DMA連続変換時は変換毎の割り込みを使用しないため、周期割り込みからコールバック関数を呼び出す
+ */
+void UpdateAd(void)
+{
+#if AD_DMA_ENABLE
+	if (ad_callback != NULL) {
+		ad_callback();
+	}
+#else
+	/* 処理なし(AD変換完了割り込みで通知) */
+#endif
+}
+
+/*
+ * Function: AD変換完了割り込み処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InterruptAdcComplete(void)
+{
+#if AD_DMA_ENABLE
+	/* 処理なし(DMA連続変換中はインジェクテッド変換を使用しない) */
+#else
+	uint32_t ad_id;
+
+	for (ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		/* AD変換結果取得 */
+		ad_raw_value[ad_id] = HAL_ADCEx_InjectedGetValue(&hadc1, injection_rank_table[ad_id]);
+	}
+
+	if (ad_callback != NULL) {
+		ad_callback();
+	}
+#endif
+}
+
+#if AD_DMA_ENABLE
+/*
+ * Function: DMA連続変換開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : CubeMXの設定(インジェクテッド変換)をレギュラー変換の連続スキャンに変更する
+ *           hadc1にはGPDMAの循環転送チャネル(ワード転送)がリンクされていること
+ *           変換毎の割り込みは発生させない
+ */
+static void startAdcDma(void)
+{
+	ADC_ChannelConfTypeDef channel_config = {0};
+	uint32_t ad_id;
+
+	HAL_ADC_Stop(&hadc1);
+
+	/* 3チャネル連続スキャン、結果は循環DMAで転送 */
+	hadc1.Init.ScanConvMode = ADC_SCAN_ENABLE;
+	hadc1.Init.ContinuousConvMode = ENABLE;
+	hadc1.Init.NbrOfConversion = AD_ID_NUM;
+	hadc1.Init.ConversionDataManagement = ADC_CONVERSIONDATA_DMA_CIRCULAR;
+	/* ハードウェアオーバーサンプリングで平均化 */
+	hadc1.Init.OversamplingMode = ENABLE;
+	hadc1.Init.Oversampling.Ratio = AD_OVERSAMPLING_RATIO;
+	hadc1.Init.Oversampling.RightBitShift = ADC_RIGHTBITSHIFT_4;
+	hadc1.Init.Oversampling.TriggeredMode = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
+	hadc1.Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+	HAL_ADC_Init(&hadc1);
+
+	for (ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		channel_config.Channel = regular_channel_table[ad_id];
+		channel_config.Rank = regular_rank_table[ad_id];
+		/* 変換レートを下げるため最長のサンプリング時間 */
+		channel_config.SamplingTime = ADC_SAMPLETIME_814CYCLES;
+		channel_config.SingleDiff = ADC_SINGLE_ENDED;
+		channel_config.OffsetNumber = ADC_OFFSET_NONE;
+		channel_config.Offset = 0;
+		HAL_ADC_ConfigChannel(&hadc1, &channel_config);
+	}
+
+	HAL_ADCEx_Calibration_Start(&hadc1, ADC_CALIB_OFFSET, ADC_SINGLE_ENDED);
+	HAL_ADC_Start_DMA(&hadc1, ad_dma_buffer, AD_ID_NUM);
+	/* 1スキャン(約1ms)毎にDMAのハーフ転送/転送完了割り込みが発生するため禁止する(結果はUpdateAdで参照) */
+	__HAL_DMA_DISABLE_IT(hadc1.DMA_Handle, DMA_IT_HT | DMA_IT_TC);
+}
+#endif
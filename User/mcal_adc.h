@@ -1,40 +1,51 @@
-/*
- * mcal_adc.h
- *
- *  Created on: Jul 8, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef MCAL_ADC_H_
-#define MCAL_ADC_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	AD_ID_POS_H = 0,
-	AD_ID_POS_V,
-	AD_ID_LEVER,
-	AD_ID_NUM
-} ad_id_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitAdc(void);
-void MainAdc(void);
-float GetAd(ad_id_t ad_id);
-void InterruptAdcComplete(void);
-
-#endif /* MCAL_ADC_H_ */
+/*
+ * mcal_adc.h
+ *
+ *  Created on: Jul 8, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef MCAL_ADC_H_
+#define MCAL_ADC_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* AD変換方式(0:フレーム毎のインジェクテッド変換、1:DMA連続変換+ハードウェアオーバーサンプリング) */
+#define AD_DMA_ENABLE		(0)
+
+/* AD変換値の最大値(14bit) */
+#define AD_VALUE_MAX		(0x03FFF)
+
+/********** Enum **********/
+
+typedef enum {
+	AD_ID_POS_H = 0,
+	AD_ID_POS_V,
+	AD_ID_LEVER,
+	AD_ID_NUM
+} ad_id_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitAdc(void);
+void MainAdc(void);
+float GetAd(ad_id_t ad_id);
+uint32_t GetAdRaw(ad_id_t ad_id);
+void SetAdInject(bool_t enable);
+void InjectAd(ad_id_t ad_id, uint32_t value);
+void SetAdCallback(callback_t callback);
+void UpdateAd(void);
+void InterruptAdcComplete(void);
+
+#endif /* MCAL_ADC_H_ */
@@ -1,95 +1,152 @@
-/*
- * mcal_dio.c
- *
- *  Created on: 2023/06/19
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_dio.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-typedef struct {
-	GPIO_TypeDef* gpio;
-	uint16_t pin;
-} gpio_t;
-
-/********** Constant **********/
-
-const gpio_t gpio_table[PIN_ID_NUM] = {
-	{TFT_CS_GPIO_Port, TFT_CS_Pin},		/* PIN_ID_TFT_CS */
-	{TFT_DC_GPIO_Port, TFT_DC_Pin},		/* PIN_ID_TFT_DC */
-	{EEPROM_CS_GPIO_Port, EEPROM_CS_Pin},/* PIN_ID_EEPROM_CS */
-	{SW_A_GPIO_Port, SW_A_Pin},			/* PIN_ID_SW_A */
-	{SW_B_GPIO_Port, SW_B_Pin},			/* PIN_ID_SW_B */
-	{SW_C_GPIO_Port, SW_C_Pin},			/* PIN_ID_SW_C */
-	{SW_D_GPIO_Port, SW_D_Pin},			/* PIN_ID_SW_D */
-	{SOUND_CS_GPIO_Port, SOUND_CS_Pin},	/* PIN_ID_SOUND_CS */
-	{AUDIO_SW_GPIO_Port, AUDIO_SW_Pin},	/* PIN_ID_AUDIO_SW */
-};
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-/********** Function **********/
-
-/*
- * Function: MCAL DIO 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitDio(void)
-{
-	/* 処理なし */
-}
-
-/*
- * Function: 端子読み出し
- * Argument: 端子ID
- * Return  : 端子レベル
- * Note    : なし
- */
-pin_level_t ReadPin(pin_id_t pin_id)
-{
-	pin_level_t pin_level = PIN_LEVEL_LOW;
-	GPIO_PinState pin_state;
-
-	if (pin_id < PIN_ID_NUM) {
-		pin_state = HAL_GPIO_ReadPin(gpio_table[pin_id].gpio, gpio_table[pin_id].pin);
-		if (pin_state == GPIO_PIN_SET) {
-			pin_level = PIN_LEVEL_HIGH;
-		}
-	}
-
-	return pin_level;
-}
-
-/*
- * Function: 端子書き込み
- * Argument: 端子ID、端子レベル
- * Return  : なし
- * Note    : なし
- */
-void WritePin(pin_id_t pin_id, pin_level_t pin_level)
-{
-	GPIO_PinState pin_state;
-
-	if (pin_id < PIN_ID_NUM) {
-		if (pin_level == PIN_LEVEL_LOW) {
-			pin_state = GPIO_PIN_RESET;
-		} else {
-			pin_state = GPIO_PIN_SET;
-		}
-		HAL_GPIO_WritePin(gpio_table[pin_id].gpio, gpio_table[pin_id].pin, pin_state);
-	}
-}
+/*
+ * mcal_dio.c
+ *
+ *  Created on: 2023/06/19
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_dio.h"
+
+/********** Define **********/
+
+/* EXTIライン数 */
+#define EXTI_LINE_NUM	(16)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+typedef struct {
+	GPIO_TypeDef* gpio;
+	uint16_t pin;
+} gpio_t;
+
+/********** Constant **********/
+
+const gpio_t gpio_table[PIN_ID_NUM] = {
+	{TFT_CS_GPIO_Port, TFT_CS_Pin},		/* PIN_ID_TFT_CS */
+	{TFT_DC_GPIO_Port, TFT_DC_Pin},		/* PIN_ID_TFT_DC */
+	{EEPROM_CS_GPIO_Port, EEPROM_CS_Pin},/* PIN_ID_EEPROM_CS */
+	{SW_A_GPIO_Port, SW_A_Pin},			/* PIN_ID_SW_A */
+	{SW_B_GPIO_Port, SW_B_Pin},			/* PIN_ID_SW_B */
+	{SW_C_GPIO_Port, SW_C_Pin},			/* PIN_ID_SW_C */
+	{SW_D_GPIO_Port, SW_D_Pin},			/* PIN_ID_SW_D */
+	{SOUND_CS_GPIO_Port, SOUND_CS_Pin},	/* PIN_ID_SOUND_CS */
+	{AUDIO_SW_GPIO_Port, AUDIO_SW_Pin},	/* PIN_ID_AUDIO_SW */
+#if defined(TOUCH_INT_Pin)
+	{TOUCH_INT_GPIO_Port, TOUCH_INT_Pin},/* PIN_ID_TOUCH_INT */
+#endif
+};
+
+/********** Variable **********/
+
+static pin_callback_t pin_callback[PIN_ID_NUM];
+
+/********** Function Prototype **********/
+
+/********** Function **********/
+
+/*
+ * Function: MCAL DIO 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitDio(void)
+{
+	for (pin_id_t pin_id=0; pin_id<PIN_ID_NUM; pin_id++) {
+		pin_callback[pin_id] = NULL;
+	}
+}
+
+/*
+ * Function: 端子読み出し
+ * Argument: 端子ID
+ * Return  : 端子レベル
+ * Note    : なし
+ */
+pin_level_t ReadPin(pin_id_t pin_id)
+{
+	pin_level_t pin_level = PIN_LEVEL_LOW;
+	GPIO_PinState pin_state;
+
+	if (pin_id < PIN_ID_NUM) {
+		pin_state = HAL_GPIO_ReadPin(gpio_table[pin_id].gpio, gpio_table[pin_id].pin);
+		if (pin_state == GPIO_PIN_SET) {
+			pin_level = PIN_LEVEL_HIGH;
+		}
+	}
+
+	return pin_level;
+}
+
+/*
+ * Function: 端子書き込み
+ * Argument: 端子ID、端子レベル
+ * Return  : なし
+ * Note    : なし
+ */
+void WritePin(pin_id_t pin_id, pin_level_t pin_level)
+{
+	GPIO_PinState pin_state;
+
+	if (pin_id < PIN_ID_NUM) {
+		if (pin_level == PIN_LEVEL_LOW) {
+			pin_state = GPIO_PIN_RESET;
+		} else {
+			pin_state = GPIO_PIN_SET;
+		}
+		HAL_GPIO_WritePin(gpio_table[pin_id].gpio, gpio_table[pin_id].pin, pin_state);
+	}
+}
+
+/*
+ * Function: 端子割り込み有効化
+ * Argument: 端子ID、コールバック関数
+ * Return  : なし
+ * Note    : 端子を両エッジのEXTI入力(プルアップ)に設定し直す
+ *           同じEXTIラインを使用する端子は1つのみ有効化可能
+ */
+void EnablePinInterrupt(pin_id_t pin_id, pin_callback_t callback)
+{
+	GPIO_InitTypeDef gpio_init = {0};
+	uint32_t exti_line;
+
+	if (pin_id < PIN_ID_NUM) {
+		pin_callback[pin_id] = callback;
+
+		gpio_init.Pin = gpio_table[pin_id].pin;
+		gpio_init.Mode = GPIO_MODE_IT_RISING_FALLING;
+		gpio_init.Pull = GPIO_PULLUP;
+		HAL_GPIO_Init(gpio_table[pin_id].gpio, &gpio_init);
+
+		/* 端子番号からEXTIライン割り込みを算出 */
+		for (exti_line=0; exti_line<EXTI_LINE_NUM; exti_line++) {
+			if ((gpio_table[pin_id].pin & (1U << exti_line)) != 0) {
+				break;
+			}
+		}
+		/* 他の割り込みとの排他制御不要とするため優先度は他と同じ0 */
+		HAL_NVIC_SetPriority((IRQn_Type)(EXTI0_IRQn + exti_line), 0, 0);
+		HAL_NVIC_EnableIRQ((IRQn_Type)(EXTI0_IRQn + exti_line));
+	}
+}
+
+/*
+ * Function: 端子エッジ割り込み処理
+ * Argument: GPIO端子番号(HAL_GPIO_EXTI_Rising_Callback、HAL_GPIO_EXTI_Falling_Callbackの引数)
+ * Return  : なし
+ * Note    : なし
+ */
+void InterruptPinEdge(uint16_t gpio_pin)
+{
+	for (pin_id_t pin_id=0; pin_id<PIN_ID_NUM; pin_id++) {
+		if ((gpio_table[pin_id].pin == gpio_pin) && (pin_callback[pin_id] != NULL)) {
+			pin_callback[pin_id](pin_id);
+		}
+	}
+}
@@ -1,50 +1,58 @@
-/*
- * mcal_dio.h
- *
- *  Created on: 2023/06/19
- *      Author: KimiakiK
- */
-
-
-#ifndef MCAL_DIO_H_
-#define MCAL_DIO_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	PIN_ID_TFT_CS = 0,
-	PIN_ID_TFT_DC,
-	PIN_ID_EEPROM_CS,
-	PIN_ID_SW_A,
-	PIN_ID_SW_B,
-	PIN_ID_SW_C,
-	PIN_ID_SW_D,
-	PIN_ID_SOUND_CS,
-	PIN_ID_AUDIO_SW,
-	PIN_ID_NUM
-} pin_id_t;
-
-typedef enum {
-	PIN_LEVEL_LOW = 0,
-	PIN_LEVEL_HIGH
-} pin_level_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitDio(void);
-pin_level_t ReadPin(pin_id_t pin_id);
-void WritePin(pin_id_t pin_id, pin_level_t pin_level);
-
-#endif /* MCAL_DIO_H_ */
+/*
+ * mcal_dio.h
+ *
+ *  Created on: 2023/06/19
+ *      Author: KimiakiK
+ */
+
+
+#ifndef MCAL_DIO_H_
+#define MCAL_DIO_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+typedef enum {
+	PIN_ID_TFT_CS = 0,
+	PIN_ID_TFT_DC,
+	PIN_ID_EEPROM_CS,
+	PIN_ID_SW_A,
+	PIN_ID_SW_B,
+	PIN_ID_SW_C,
+	PIN_ID_SW_D,
+	PIN_ID_SOUND_CS,
+	PIN_ID_AUDIO_SW,
+#if defined(TOUCH_INT_Pin)
+	PIN_ID_TOUCH_INT,
+#endif
+	PIN_ID_NUM
+} pin_id_t;
+
+typedef enum {
+	PIN_LEVEL_LOW = 0,
+	PIN_LEVEL_HIGH
+} pin_level_t;
+
+/********** Type **********/
+
+/* 端子割り込みコールバック関数 */
+typedef void (*pin_callback_t)(pin_id_t pin_id);
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitDio(void);
+pin_level_t ReadPin(pin_id_t pin_id);
+void WritePin(pin_id_t pin_id, pin_level_t pin_level);
+void EnablePinInterrupt(pin_id_t pin_id, pin_callback_t callback);
+void InterruptPinEdge(uint16_t gpio_pin);
+
+#endif /* MCAL_DIO_H_ */
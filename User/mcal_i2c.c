@@ -1,93 +1,275 @@
-/*
- * mcal_i2c.c
- *
- *  Created on: Jun 30, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_i2c.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-extern I2C_HandleTypeDef hi2c1;
-
-static callback_t send_callback;
-static callback_t receive_callback;
-
-/********** Function Prototype **********/
-
-/********** Function **********/
-
-/*
- * Function: MCAL I2C 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitI2c(void)
-{
-	send_callback = NULL;
-	receive_callback = NULL;
-}
-
-/*
- * Function: I2Cデータ送信
- * Argument: デバイスアドレス(7bit)、送信データ先頭アドレス、送信データ長、送信完了時コールバック
- * Return  : なし
- * Note    : なし
- */
-void SendI2c(uint16_t device_address, uint8_t* data, uint16_t length, callback_t callback)
-{
-	send_callback = callback;
-	HAL_I2C_Master_Transmit_DMA(&hi2c1, device_address << 1, data, length);
-}
-
-/*
- * Function: I2Cデータ受信
- * Argument: デバイスアドレス(7bit)、受信データ格納アドレス、受信データ長、受信完了時コールバック
- * Return  : なし
- * Note    : なし
- */
-void ReceiveI2c(uint16_t device_address, uint8_t* data, uint16_t length, callback_t callback)
-{
-	receive_callback = callback;
-	HAL_I2C_Master_Receive_DMA(&hi2c1, device_address << 1, data, length);
-}
-
-/*
- * Function: I2C送信完了割り込み処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InterruptI2cSendComplete(void)
-{
-	if (send_callback != NULL) {
-		send_callback();
-	}
-}
-
-/*
- * Function: I2C受信完了割り込み処理
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InterruptI2cReceiveComplete(void)
-{
-	if (receive_callback != NULL) {
-		receive_callback();
-	}
-}
+/*
+ * mcal_i2c.c
+ *
+ *  Created on: Jun 30, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_i2c.h"
+#include "mcal_timer.h"
+
+/********** Define **********/
+
+/* I2Cジョブキューサイズ */
+#define I2C_JOB_QUEUE_SIZE		(16)
+
+/* エラー時のリトライ待ち時間 [us] (初回、以降はリトライ毎に倍にして上限で止める) */
+#define I2C_RETRY_WAIT_FIRST	(100)
+#define I2C_RETRY_WAIT_MAX		(1600)
+
+/* リトライを打ち切ってRESULT_NGを通知するまでの時間 [us] (ジョブ開始から) */
+#define I2C_RETRY_TIMEOUT		(10000)
+
+/********** Enum **********/
+
+typedef enum {
+	I2C_PHASE_IDLE = 0,
+	I2C_PHASE_WRITE,
+	I2C_PHASE_READ,
+	I2C_PHASE_RETRY_WAIT
+} i2c_phase_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+extern I2C_HandleTypeDef hi2c1;
+
+static i2c_job_t i2c_job_queue[I2C_JOB_QUEUE_SIZE];
+static uint32_t i2c_job_queue_index_top;
+static uint32_t i2c_job_queue_index_end;
+
+static i2c_phase_t i2c_phase;
+static uint32_t i2c_retry_wait;
+static uint32_t i2c_job_start_time;
+
+/********** Function Prototype **********/
+
+static void beginJob(void);
+static void startJob(void);
+static void startRead(void);
+static void retryJob(void);
+static void completeJob(result_t result);
+
+/********** Function **********/
+
+/*
+ * Function: MCAL I2C 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitI2c(void)
+{
+	i2c_job_queue_index_top = 0;
+	i2c_job_queue_index_end = 0;
+	i2c_phase = I2C_PHASE_IDLE;
+	i2c_retry_wait = I2C_RETRY_WAIT_FIRST;
+	i2c_job_start_time = 0;
+}
+
+/*
+ * Function: I2Cジョブ追加
+ * Argument: ジョブ(内容はキューにコピーする、データは完了まで保持すること)
+ * Return  : RESULT_OK:追加成功、RESULT_NG:キュー満杯
+ * Note    : 通信中でなければ即座に開始し、以降のジョブは完了割り込みから連続して実行する
+ */
+result_t AddI2cJob(const i2c_job_t* job)
+{
+	result_t result = RESULT_NG;
+	uint32_t i2c_job_queue_index_next;
+	uint32_t primask;
+
+	/* 周期処理と完了コールバック(割り込み処理)の両方から追加されるため、空き判定からキュー更新、開始判定まで割り込み禁止で行う */
+	/* (完了割り込みがキューを空と判定してから停止するまでの間に追加したジョブも取りこぼさない) */
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (i2c_job_queue_index_top < I2C_JOB_QUEUE_SIZE - 1) {
+		i2c_job_queue_index_next = i2c_job_queue_index_top + 1;
+	} else {
+		i2c_job_queue_index_next = 0;
+	}
+
+	if (i2c_job_queue_index_next != i2c_job_queue_index_end) {
+		i2c_job_queue[i2c_job_queue_index_top] = *job;
+		i2c_job_queue_index_top = i2c_job_queue_index_next;
+		if (i2c_phase == I2C_PHASE_IDLE) {
+			beginJob();
+		}
+
+		result = RESULT_OK;
+	}
+
+	__set_PRIMASK(primask);
+
+	return result;
+}
+
+/*
+ * Function: I2C送信完了割り込み処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : HAL_I2C_MasterTxCpltCallbackから呼び出す
+ */
+void InterruptI2cSendComplete(void)
+{
+	if (i2c_phase == I2C_PHASE_WRITE) {
+		if (i2c_job_queue[i2c_job_queue_index_end].read_length > 0) {
+			startRead();
+		} else {
+			completeJob(RESULT_OK);
+		}
+	}
+}
+
+/*
+ * Function: I2C受信完了割り込み処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : HAL_I2C_MasterRxCpltCallbackから呼び出す
+ */
+void InterruptI2cReceiveComplete(void)
+{
+	if (i2c_phase == I2C_PHASE_READ) {
+		completeJob(RESULT_OK);
+	}
+}
+
+/*
+ * Function: I2Cエラー割り込み処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : HAL_I2C_ErrorCallbackから呼び出す(NACK、アービトレーションロスト、バスエラー)
+ *           待ち時間をおいてジョブを最初からリトライし、打ち切り時間でRESULT_NGを通知する
+ */
+void InterruptI2cError(void)
+{
+	if ((i2c_phase == I2C_PHASE_WRITE) || (i2c_phase == I2C_PHASE_READ)) {
+		retryJob();
+	}
+}
+
+/*
+ * Function: ジョブ初回開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : リトライ待ち時間と打ち切り時間の基準時刻を初期化してキュー先頭のジョブを開始する
+ */
+static void beginJob(void)
+{
+	i2c_retry_wait = I2C_RETRY_WAIT_FIRST;
+	i2c_job_start_time = GetTimeUs();
+	startJob();
+}
+
+/*
+ * Function: ジョブ開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : キュー先頭のジョブを書き込みから開始する(リトライ時はアラーム割り込み処理から呼び出す)
+ */
+static void startJob(void)
+{
+	i2c_job_t* job = &i2c_job_queue[i2c_job_queue_index_end];
+	uint32_t transfer_option;
+	HAL_StatusTypeDef status;
+
+	if (job->write_length > 0) {
+		i2c_phase = I2C_PHASE_WRITE;
+		if ((job->read_length > 0) && (job->flag == I2C_JOB_RESTART)) {
+			/* 読み出しをリピーテッドスタートで続ける */
+			transfer_option = I2C_FIRST_FRAME;
+		} else {
+			transfer_option = I2C_FIRST_AND_LAST_FRAME;
+		}
+		status = HAL_I2C_Master_Seq_Transmit_DMA(&hi2c1, job->device_address << 1, (uint8_t*)job->write_data, job->write_length, transfer_option);
+		if (status != HAL_OK) {
+			retryJob();
+		}
+	} else {
+		startRead();
+	}
+}
+
+/*
+ * Function: 読み出し開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+static void startRead(void)
+{
+	i2c_job_t* job = &i2c_job_queue[i2c_job_queue_index_end];
+	uint32_t transfer_option;
+	HAL_StatusTypeDef status;
+
+	i2c_phase = I2C_PHASE_READ;
+	if ((job->write_length > 0) && (job->flag == I2C_JOB_RESTART)) {
+		transfer_option = I2C_LAST_FRAME;
+	} else {
+		transfer_option = I2C_FIRST_AND_LAST_FRAME;
+	}
+	status = HAL_I2C_Master_Seq_Receive_DMA(&hi2c1, job->device_address << 1, job->read_data, job->read_length, transfer_option);
+	if (status != HAL_OK) {
+		retryJob();
+	}
+}
+
+/*
+ * Function: ジョブリトライ
+ * Argument: なし
+ * Return  : なし
+ * Note    : バスが解放されるまでの時間を空けるため、アラームで待ち時間後にジョブを再開始する
+ *           (エラー通知やHAL_BUSYから即座に再開始すると、バス占有中はリトライを一瞬で使い切る)
+ *           次のリトライがジョブ開始から打ち切り時間を超える場合はRESULT_NGを通知する
+ */
+static void retryJob(void)
+{
+	uint32_t elapsed_time = GetTimeUs() - i2c_job_start_time;
+
+	if (elapsed_time + i2c_retry_wait < I2C_RETRY_TIMEOUT) {
+		i2c_phase = I2C_PHASE_RETRY_WAIT;
+		SetTimerAlarm(ALARM_ID_I2C, i2c_retry_wait, startJob);
+		if (i2c_retry_wait < I2C_RETRY_WAIT_MAX) {
+			i2c_retry_wait *= 2;
+		} else {
+			/* 処理なし */
+		}
+	} else {
+		completeJob(RESULT_NG);
+	}
+}
+
+/*
+ * Function: ジョブ完了
+ * Argument: 通信結果
+ * Return  : なし
+ * Note    : コールバック通知後、次のジョブがあれば開始する
+ */
+static void completeJob(result_t result)
+{
+	i2c_callback_t callback = i2c_job_queue[i2c_job_queue_index_end].callback;
+
+	if (i2c_job_queue_index_end < I2C_JOB_QUEUE_SIZE - 1) {
+		i2c_job_queue_index_end ++;
+	} else {
+		i2c_job_queue_index_end = 0;
+	}
+
+	/* 次のジョブ開始前に通知(コールバック内で追加したジョブも連続して実行) */
+	i2c_phase = I2C_PHASE_IDLE;
+	if (callback != NULL) {
+		callback(result);
+	}
+
+	if ((i2c_phase == I2C_PHASE_IDLE) && (i2c_job_queue_index_end != i2c_job_queue_index_top)) {
+		beginJob();
+	}
+}
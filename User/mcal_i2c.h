@@ -1,34 +1,54 @@
-/*
- * mcal_i2c.h
- *
- *  Created on: Jun 30, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef MCAL_I2C_H_
-#define MCAL_I2C_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitI2c(void);
-void SendI2c(uint16_t device_address, uint8_t* data, uint16_t length, callback_t callback);
-void ReceiveI2c(uint16_t device_address, uint8_t* data, uint16_t length, callback_t callback);
-void InterruptI2cSendComplete(void);
-void InterruptI2cReceiveComplete(void);
-
-#endif /* MCAL_I2C_H_ */
+/*
+ * mcal_i2c.h
+ *
+ *  Created on: Jun 30, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef MCAL_I2C_H_
+#define MCAL_I2C_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/* 書き込みと読み出しの間の条件 */
+typedef enum {
+	I2C_JOB_RESTART = 0,	/* リピーテッドスタート(レジスタ読み出し) */
+	I2C_JOB_STOP			/* ストップコンディション後に読み出し */
+} i2c_job_flag_t;
+
+/********** Type **********/
+
+/* I2C完了コールバック関数(引数は通信結果) */
+typedef void (*i2c_callback_t)(result_t result);
+
+/* I2Cジョブ(書き込み→読み出しの順に実行、長さ0の方向は実行しない) */
+typedef struct {
+	uint16_t device_address;		/* デバイスアドレス(7bit) */
+	const uint8_t* write_data;		/* 書き込みデータ */
+	uint16_t write_length;			/* 書き込みデータ長 */
+	uint8_t* read_data;				/* 読み出しデータ格納先 */
+	uint16_t read_length;			/* 読み出しデータ長 */
+	i2c_job_flag_t flag;			/* 書き込みと読み出しの間の条件 */
+	i2c_callback_t callback;		/* 完了コールバック(割り込み処理から呼び出し) */
+} i2c_job_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitI2c(void);
+result_t AddI2cJob(const i2c_job_t* job);
+void InterruptI2cSendComplete(void);
+void InterruptI2cReceiveComplete(void);
+void InterruptI2cError(void);
+
+#endif /* MCAL_I2C_H_ */
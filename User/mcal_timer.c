@@ -1,242 +1,473 @@
-/*
- * mcal_timer.c
- *
- *  Created on: Jun 15, 2023
- *      Author: KimiakiK
- */
-
-
-/********** Include **********/
-
-#include "typedef.h"
-#include "mcal_timer.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	TIMER_MODE_SIMPLE = 0,
-	TIMER_MODE_INTERRUPT,
-	TIMER_MODE_PWM
-} timer_mode_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-extern TIM_HandleTypeDef htim1;
-extern TIM_HandleTypeDef htim2;
-extern TIM_HandleTypeDef htim3;
-extern TIM_HandleTypeDef htim4;
-extern TIM_HandleTypeDef htim5;
-extern TIM_HandleTypeDef htim6;
-
-static TIM_HandleTypeDef* const htim[TIMER_CH_NUM] = {
-	&htim1,		/* TIMER_CH1 */
-	&htim2,		/* TIMER_CH2 */
-	&htim3,		/* TIMER_CH3 */
-	&htim4,		/* TIMER_CH4 */
-	&htim5,		/* TIMER_CH5 */
-	&htim6,		/* TIMER_CH5 */
-};
-
-static const timer_mode_t timer_mode[TIMER_CH_NUM] = {
-	TIMER_MODE_PWM,			/* TIMER_CH1 */
-	TIMER_MODE_INTERRUPT,	/* TIMER_CH2 */
-	TIMER_MODE_PWM,			/* TIMER_CH3 */
-	TIMER_MODE_SIMPLE,		/* TIMER_CH4 */
-	TIMER_MODE_INTERRUPT,	/* TIMER_CH5 */
-	TIMER_MODE_INTERRUPT,	/* TIMER_CH5 */
-};
-
-static const uint32_t pwm_ch[TIMER_CH_NUM] = {
-	TIM_CHANNEL_3,			/* TIMER_CH1 */
-	0,						/* TIMER_CH2 */
-	TIM_CHANNEL_3,			/* TIMER_CH3 */
-	0,						/* TIMER_CH4 */
-	0,						/* TIMER_CH5 */
-	0,						/* TIMER_CH5 */
-};
-
-/********** Variable **********/
-
-static callback_t timer_callback[TIMER_CH_NUM];
-
-/********** Function Prototype **********/
-
-/********** Function **********/
-
-/*
- * Function: MCAL Timer 初期化
- * Argument: なし
- * Return  : なし
- * Note    : なし
- */
-void InitTimer(void)
-{
-	uint32_t index;
-
-	for (index=0; index<TIMER_CH_NUM; index++) {
-		timer_callback[index] = NULL;
-	}
-}
-
-/*
- * Function: タイマー割り込み処理
- * Argument: タイマーチャネル
- * Return  : なし
- * Note    : なし
- */
-void InterruptTimer(timer_ch_t timer_ch)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		if (timer_callback[timer_ch] != NULL) {
-			timer_callback[timer_ch]();
-		}
-	}
-}
-
-
-/*
- * Function: タイマーコールバック関数設定
- * Argument: タイマーチャネル、コールバック関数
- * Return  : なし
- * Note    : なし
- */
-void SetTimerCallback(timer_ch_t timer_ch, callback_t callback)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		timer_callback[timer_ch] = callback;
-	}
-}
-
-/*
- * Function: タイマー開始
- * Argument: タイマーチャネル
- * Return  : なし
- * Note    : なし
- */
-void StartTimer(timer_ch_t timer_ch)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		switch (timer_mode[timer_ch]) {
-		case TIMER_MODE_SIMPLE:
-			HAL_TIM_Base_Start(htim[timer_ch]);
-			break;
-		case TIMER_MODE_INTERRUPT:
-			HAL_TIM_Base_Start_IT(htim[timer_ch]);
-			break;
-		case TIMER_MODE_PWM:
-			HAL_TIM_PWM_Start(htim[timer_ch],pwm_ch[timer_ch]);
-			HAL_TIMEx_PWMN_Start(htim[timer_ch],pwm_ch[timer_ch]);
-			break;
-		default:
-			/* 処理なし */
-			break;
-		}
-	}
-}
-
-/*
- * Function: タイマー停止
- * Argument: タイマーチャネル
- * Return  : なし
- * Note    : なし
- */
-void StopTimer(timer_ch_t timer_ch)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		switch (timer_mode[timer_ch]) {
-		case TIMER_MODE_SIMPLE:
-			HAL_TIM_Base_Stop(htim[timer_ch]);
-			break;
-		case TIMER_MODE_INTERRUPT:
-			HAL_TIM_Base_Stop_IT(htim[timer_ch]);
-			break;
-		case TIMER_MODE_PWM:
-			HAL_TIM_PWM_Stop(htim[timer_ch],pwm_ch[timer_ch]);
-			HAL_TIMEx_PWMN_Stop(htim[timer_ch],pwm_ch[timer_ch]);
-			break;
-		default:
-			/* 処理なし */
-			break;
-		}
-	}
-}
-
-/*
- * Function: タイマーカウンタ取得
- * Argument: タイマーチャネル
- * Return  : カウンタ
- * Note    : なし
- */
-uint32_t GetTimerCounter(timer_ch_t timer_ch)
-{
-	uint32_t count = 0;
-
-	if (timer_ch < TIMER_CH_NUM) {
-		count =  htim[timer_ch]->Instance->CNT;
-	}
-
-	return count;
-}
-
-/*
- * Function: タイマーカウンタ設定
- * Argument: タイマーチャネル、カウンタ
- * Return  : なし
- * Note    : なし
- */
-void SetTimerCounter(timer_ch_t timer_ch, uint32_t count)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		htim[timer_ch]->Instance->CNT = count;
-	}
-}
-
-/*
- * Function: タイマー周期取得
- * Argument: タイマーチャネル
- * Return  : 周期
- * Note    : なし
- */
-uint32_t GetTimerPeriod(timer_ch_t timer_ch)
-{
-	uint32_t period = 0;
-
-	if (timer_ch < TIMER_CH_NUM) {
-		period =  htim[timer_ch]->Instance->ARR;
-	}
-
-	return period;
-}
-
-/*
- * Function: タイマー周期設定
- * Argument: タイマーチャネル、周期
- * Return  : なし
- * Note    : なし
- */
-void SetTimerPeriod(timer_ch_t timer_ch, uint32_t period)
-{
-	if (timer_ch < TIMER_CH_NUM) {
-		htim[timer_ch]->Instance->ARR = period;
-	}
-}
-
-/*
- * Function: Wait
- * Argument: Wait時間 [us]
- * Return  : なし
- * Note    : なし
- */
-void WaitUs(uint32_t us)
-{
-	SetTimerCounter(TIMER_CH4, 0);
-	StartTimer(TIMER_CH4);
-	while (GetTimerCounter(TIMER_CH4) < us) {
-		/* 処理なし(時間経過待ち) */
-	}
-	StopTimer(TIMER_CH4);
-}
+/*
+ * mcal_timer.c
+ *
+ *  Created on: Jun 15, 2023
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+
+/********** Define **********/
+
+/* 時刻計測用タイマー(1カウント = 1us、32bitフリーラン) */
+#define TIMER_CH_TIME		(TIMER_CH4)
+
+/* ALARM_ID_EEPROMの実行コンテキスト(遅延実行のホストテストはALARM_CONTEXT_DEFERREDを指定してビルド) */
+#ifndef ALARM_CONTEXT_EEPROM
+#define ALARM_CONTEXT_EEPROM	ALARM_CONTEXT_ISR
+#endif
+
+/********** Enum **********/
+
+typedef enum {
+	TIMER_MODE_SIMPLE = 0,
+	TIMER_MODE_INTERRUPT,
+	TIMER_MODE_PWM
+} timer_mode_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim4;
+extern TIM_HandleTypeDef htim5;
+extern TIM_HandleTypeDef htim6;
+
+static TIM_HandleTypeDef* const htim[TIMER_CH_NUM] = {
+	&htim1,		/* TIMER_CH1 */
+	&htim2,		/* TIMER_CH2 */
+	&htim3,		/* TIMER_CH3 */
+	&htim4,		/* TIMER_CH4 */
+	&htim5,		/* TIMER_CH5 */
+	&htim6,		/* TIMER_CH5 */
+};
+
+static const timer_mode_t timer_mode[TIMER_CH_NUM] = {
+	TIMER_MODE_PWM,			/* TIMER_CH1 */
+	TIMER_MODE_INTERRUPT,	/* TIMER_CH2 */
+	TIMER_MODE_PWM,			/* TIMER_CH3 */
+	TIMER_MODE_SIMPLE,		/* TIMER_CH4 */
+	TIMER_MODE_INTERRUPT,	/* TIMER_CH5 */
+	TIMER_MODE_INTERRUPT,	/* TIMER_CH5 */
+};
+
+static const uint32_t pwm_ch[TIMER_CH_NUM] = {
+	TIM_CHANNEL_3,			/* TIMER_CH1 */
+	0,						/* TIMER_CH2 */
+	TIM_CHANNEL_3,			/* TIMER_CH3 */
+	0,						/* TIMER_CH4 */
+	0,						/* TIMER_CH5 */
+	0,						/* TIMER_CH5 */
+};
+
+static const alarm_context_t alarm_context[ALARM_ID_NUM] = {
+	ALARM_CONTEXT_EEPROM,	/* ALARM_ID_EEPROM (書き込み完了確認を待たずに次ページを書き込むため割り込み処理内で実行) */
+	ALARM_CONTEXT_ISR,		/* ALARM_ID_TFT */
+	ALARM_CONTEXT_ISR,		/* ALARM_ID_SOUND */
+	ALARM_CONTEXT_ISR,		/* ALARM_ID_SCHEDULER */
+	ALARM_CONTEXT_ISR,		/* ALARM_ID_I2C */
+};
+
+/********** Variable **********/
+
+static callback_t timer_callback[TIMER_CH_NUM];
+
+/* アラーム */
+static bool_t alarm_active[ALARM_ID_NUM];
+static uint32_t alarm_time[ALARM_ID_NUM];
+static uint32_t alarm_period[ALARM_ID_NUM];
+static callback_t alarm_callback[ALARM_ID_NUM];
+static bool_t alarm_deferred_pending[ALARM_ID_NUM];
+static callback_t alarm_deferred_notify;
+
+/********** Function Prototype **********/
+
+static void startAlarm(alarm_id_t alarm_id, uint32_t delay_us, uint32_t period_us, callback_t callback);
+static void updateAlarmCompare(void);
+
+/********** Function **********/
+
+/*
+ * Function: MCAL Timer 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitTimer(void)
+{
+	uint32_t index;
+
+	for (index=0; index<TIMER_CH_NUM; index++) {
+		timer_callback[index] = NULL;
+	}
+	alarm_deferred_notify = NULL;
+	for (index=0; index<ALARM_ID_NUM; index++) {
+		alarm_active[index] = FALSE;
+		alarm_time[index] = 0;
+		alarm_period[index] = 0;
+		alarm_callback[index] = NULL;
+		alarm_deferred_pending[index] = FALSE;
+	}
+
+	/* 時刻計測用タイマーはフリーランで動作させる */
+	SetTimerCounter(TIMER_CH_TIME, 0);
+	StartTimer(TIMER_CH_TIME);
+}
+
+/*
+ * Function: タイマー割り込み処理
+ * Argument: タイマーチャネル
+ * Return  : なし
+ * Note    : なし
+ */
+void InterruptTimer(timer_ch_t timer_ch)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		if (timer_callback[timer_ch] != NULL) {
+			timer_callback[timer_ch]();
+		}
+	}
+}
+
+
+/*
+ * Function: タイマーコールバック関数設定
+ * Argument: タイマーチャネル、コールバック関数
+ * Return  : なし
+ * Note    : なし
+ */
+void SetTimerCallback(timer_ch_t timer_ch, callback_t callback)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		timer_callback[timer_ch] = callback;
+	}
+}
+
+/*
+ * Function: タイマー開始
+ * Argument: タイマーチャネル
+ * Return  : なし
+ * Note    : なし
+ */
+void StartTimer(timer_ch_t timer_ch)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		switch (timer_mode[timer_ch]) {
+		case TIMER_MODE_SIMPLE:
+			HAL_TIM_Base_Start(htim[timer_ch]);
+			break;
+		case TIMER_MODE_INTERRUPT:
+			HAL_TIM_Base_Start_IT(htim[timer_ch]);
+			break;
+		case TIMER_MODE_PWM:
+			HAL_TIM_PWM_Start(htim[timer_ch],pwm_ch[timer_ch]);
+			HAL_TIMEx_PWMN_Start(htim[timer_ch],pwm_ch[timer_ch]);
+			break;
+		default:
+			/* 処理なし */
+			break;
+		}
+	}
+}
+
+/*
+ * Function: タイマー停止
+ * Argument: タイマーチャネル
+ * Return  : なし
+ * Note    : なし
+ */
+void StopTimer(timer_ch_t timer_ch)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		switch (timer_mode[timer_ch]) {
+		case TIMER_MODE_SIMPLE:
+			HAL_TIM_Base_Stop(htim[timer_ch]);
+			break;
+		case TIMER_MODE_INTERRUPT:
+			HAL_TIM_Base_Stop_IT(htim[timer_ch]);
+			break;
+		case TIMER_MODE_PWM:
+			HAL_TIM_PWM_Stop(htim[timer_ch],pwm_ch[timer_ch]);
+			HAL_TIMEx_PWMN_Stop(htim[timer_ch],pwm_ch[timer_ch]);
+			break;
+		default:
+			/* 処理なし */
+			break;
+		}
+	}
+}
+
+/*
+ * Function: タイマーカウンタ取得
+ * Argument: タイマーチャネル
+ * Return  : カウンタ
+ * Note    : なし
+ */
+uint32_t GetTimerCounter(timer_ch_t timer_ch)
+{
+	uint32_t count = 0;
+
+	if (timer_ch < TIMER_CH_NUM) {
+		count =  htim[timer_ch]->Instance->CNT;
+	}
+
+	return count;
+}
+
+/*
+ * Function: タイマーカウンタ設定
+ * Argument: タイマーチャネル、カウンタ
+ * Return  : なし
+ * Note    : なし
+ */
+void SetTimerCounter(timer_ch_t timer_ch, uint32_t count)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		htim[timer_ch]->Instance->CNT = count;
+	}
+}
+
+/*
+ * Function: タイマー周期取得
+ * Argument: タイマーチャネル
+ * Return  : 周期
+ * Note    : なし
+ */
+uint32_t GetTimerPeriod(timer_ch_t timer_ch)
+{
+	uint32_t period = 0;
+
+	if (timer_ch < TIMER_CH_NUM) {
+		period =  htim[timer_ch]->Instance->ARR;
+	}
+
+	return period;
+}
+
+/*
+ * Function: タイマー周期設定
+ * Argument: タイマーチャネル、周期
+ * Return  : なし
+ * Note    : なし
+ */
+void SetTimerPeriod(timer_ch_t timer_ch, uint32_t period)
+{
+	if (timer_ch < TIMER_CH_NUM) {
+		htim[timer_ch]->Instance->ARR = period;
+	}
+}
+
+/*
+ * Function: 現在時刻取得
+ * Argument: なし
+ * Return  : 現在時刻 [us]
+ * Note    : 約71分で一周するため、時刻の比較は差分で行うこと
+ */
+uint32_t GetTimeUs(void)
+{
+	return GetTimerCounter(TIMER_CH_TIME);
+}
+
+/*
+ * Function: Wait
+ * Argument: Wait時間 [us]
+ * Return  : なし
+ * Note    : 時刻計測用タイマーの差分で判定するため、割り込み処理内からも使用可能
+ *           待機中は他の処理を実行できないため、デバイスの待ち時間にはアラームを使用すること
+ */
+void WaitUs(uint32_t us)
+{
+	uint32_t start_time = GetTimeUs();
+
+	while ((GetTimeUs() - start_time) < us) {
+		/* 処理なし(時間経過待ち) */
+	}
+}
+
+/*
+ * Function: 単発アラーム設定
+ * Argument: アラームID、通知までの時間 [us]、コールバック関数
+ * Return  : なし
+ * Note    : アラームID毎の実行コンテキスト(alarm_context)でコールバック関数を呼び出す
+ *           設定済みのアラームは上書きする、割り込み処理内からも使用可能
+ */
+void SetTimerAlarm(alarm_id_t alarm_id, uint32_t delay_us, callback_t callback)
+{
+	startAlarm(alarm_id, delay_us, 0, callback);
+}
+
+/*
+ * Function: 周期アラーム設定
+ * Argument: アラームID、初回通知までの時間 [us]、通知周期 [us]、コールバック関数
+ * Return  : なし
+ * Note    : 解除するまで通知周期毎にコールバック関数を呼び出す、周期0は単発アラームとなる
+ *           設定済みのアラームは上書きする、割り込み処理内からも使用可能
+ */
+void SetTimerAlarmPeriodic(alarm_id_t alarm_id, uint32_t delay_us, uint32_t period_us, callback_t callback)
+{
+	startAlarm(alarm_id, delay_us, period_us, callback);
+}
+
+/*
+ * Function: アラーム解除
+ * Argument: アラームID
+ * Return  : なし
+ * Note    : 実行待ちの遅延実行コールバックも破棄する
+ */
+void CancelTimerAlarm(alarm_id_t alarm_id)
+{
+	uint32_t primask;
+
+	if (alarm_id < ALARM_ID_NUM) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		alarm_active[alarm_id] = FALSE;
+		alarm_deferred_pending[alarm_id] = FALSE;
+		updateAlarmCompare();
+		__set_PRIMASK(primask);
+	}
+}
+
+/*
+ * Function: アラーム割り込み処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : 時刻計測用タイマーのコンペアマッチ(CH1)割り込みから呼び出すこと
+ */
+void InterruptTimerAlarm(void)
+{
+	uint32_t now = GetTimeUs();
+
+	for (uint32_t index=0; index<ALARM_ID_NUM; index++) {
+		/* 時刻の周回を考慮して差分で判定 */
+		if ((alarm_active[index] == TRUE) && ((int32_t)(now - alarm_time[index]) >= 0)) {
+			/* コールバック内で再設定できるよう、呼び出し前に次回時刻を設定または解除 */
+			if (alarm_period[index] > 0) {
+				alarm_time[index] += alarm_period[index];
+				if ((int32_t)(alarm_time[index] - now) <= 0) {
+					/* 処理遅れで過ぎた周期は通知せずに飛ばす */
+					alarm_time[index] = now + alarm_period[index];
+				}
+			} else {
+				alarm_active[index] = FALSE;
+			}
+
+			if (alarm_context[index] == ALARM_CONTEXT_DEFERRED) {
+				/* 実行待ちが残っている場合は1回にまとめる */
+				alarm_deferred_pending[index] = TRUE;
+				if (alarm_deferred_notify != NULL) {
+					alarm_deferred_notify();
+				}
+			} else if (alarm_callback[index] != NULL) {
+				alarm_callback[index]();
+			} else {
+				/* 処理なし */
+			}
+		}
+	}
+
+	updateAlarmCompare();
+}
+
+/*
+ * Function: アラーム遅延実行処理
+ * Argument: なし
+ * Return  : なし
+ * Note    : メインループから呼び出すこと
+ *           ALARM_CONTEXT_DEFERREDのアラームで、通知済みのコールバック関数を実行する
+ */
+void MainTimerAlarm(void)
+{
+	uint32_t primask;
+	callback_t callback;
+
+	for (uint32_t index=0; index<ALARM_ID_NUM; index++) {
+		callback = NULL;
+
+		primask = __get_PRIMASK();
+		__disable_irq();
+		if (alarm_deferred_pending[index] == TRUE) {
+			alarm_deferred_pending[index] = FALSE;
+			callback = alarm_callback[index];
+		}
+		__set_PRIMASK(primask);
+
+		if (callback != NULL) {
+			callback();
+		}
+	}
+}
+
+/*
+ * Function: 遅延実行通知コールバック設定
+ * Argument: コールバック関数
+ * Return  : なし
+ * Note    : ALARM_CONTEXT_DEFERREDのアラーム通知時に割り込み処理内から呼び出す
+ *           MainTimerAlarmの実行要求に使用する
+ */
+void SetTimerAlarmDeferredNotify(callback_t callback)
+{
+	alarm_deferred_notify = callback;
+}
+
+/*
+ * Function: アラーム開始
+ * Argument: アラームID、初回通知までの時間 [us]、通知周期 [us] (0:単発)、コールバック関数
+ * Return  : なし
+ * Note    : なし
+ */
+static void startAlarm(alarm_id_t alarm_id, uint32_t delay_us, uint32_t period_us, callback_t callback)
+{
+	uint32_t primask;
+
+	if (alarm_id < ALARM_ID_NUM) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		alarm_time[alarm_id] = GetTimeUs() + delay_us;
+		alarm_period[alarm_id] = period_us;
+		alarm_callback[alarm_id] = callback;
+		alarm_active[alarm_id] = TRUE;
+		updateAlarmCompare();
+		__set_PRIMASK(primask);
+	}
+}
+
+/*
+ * Function: アラーム用コンペア値更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 割り込み禁止中または割り込み処理内から呼び出すこと
+ */
+static void updateAlarmCompare(void)
+{
+	bool_t active = FALSE;
+	uint32_t nearest = 0;
+
+	/* 最も早く通知するアラームを探す */
+	for (uint32_t index=0; index<ALARM_ID_NUM; index++) {
+		if (alarm_active[index] == TRUE) {
+			if ((active == FALSE) || ((int32_t)(alarm_time[index] - nearest) < 0)) {
+				nearest = alarm_time[index];
+			}
+			active = TRUE;
+		}
+	}
+
+	if (active == TRUE) {
+		__HAL_TIM_SET_COMPARE(htim[TIMER_CH_TIME], TIM_CHANNEL_1, nearest);
+		__HAL_TIM_ENABLE_IT(htim[TIMER_CH_TIME], TIM_IT_CC1);
+		if ((int32_t)(nearest - GetTimeUs()) <= 0) {
+			/* コンペア値設定前に時刻を過ぎた場合は、ソフトウェアでコンペアマッチを発生させる */
+			HAL_TIM_GenerateEvent(htim[TIMER_CH_TIME], TIM_EVENTSOURCE_CC1);
+		}
+	} else {
+		__HAL_TIM_DISABLE_IT(htim[TIMER_CH_TIME], TIM_IT_CC1);
+	}
+}
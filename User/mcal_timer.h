@@ -1,49 +1,72 @@
-/*
- * mcal_timer.h
- *
- *  Created on: Jun 15, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef MCAL_TIMER_H_
-#define MCAL_TIMER_H_
-
-/********** Include **********/
-
-#include "typedef.h"
-
-/********** Define **********/
-
-/********** Enum **********/
-
-typedef enum {
-	TIMER_CH1 = 0,		/* 振動モータ用 : PWM 約150Hz duty 50% */
-	TIMER_CH2,			/* 振動モータ駆動時間制御用 : 1カウント = 160MHz / (15999 + 1) = 0.1ms */
-	TIMER_CH3,			/* TFTバックライト用 */
-	TIMER_CH4,			/* Wait用(1us) : 160MHz / (159+1) */
-	TIMER_CH5,			/* 60fps周期用 : (266666+1) * 160MHz / 1 */
-	TIMER_CH6,			/* 5ms周期用 : (4999+1) * 160MHz / (159 + 1) */
-	TIMER_CH_NUM
-} timer_ch_t;
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitTimer(void);
-void InterruptTimer(timer_ch_t timer_ch);
-void SetTimerCallback(timer_ch_t timer_ch, callback_t callback);
-void StartTimer(timer_ch_t timer_ch);
-void StopTimer(timer_ch_t timer_ch);
-uint32_t GetTimerCounter(timer_ch_t timer_ch);
-void SetTimerCounter(timer_ch_t timer_ch, uint32_t count);
-uint32_t GetTimerPeriod(timer_ch_t timer_ch);
-void SetTimerPeriod(timer_ch_t timer_ch, uint32_t period);
-void WaitUs(uint32_t us);
-
-#endif /* MCAL_TIMER_H_ */
+/*
+ * mcal_timer.h
+ *
+ *  Created on: Jun 15, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef MCAL_TIMER_H_
+#define MCAL_TIMER_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+typedef enum {
+	TIMER_CH1 = 0,		/* 振動モータ用 : PWM 約150Hz duty 50% */
+	TIMER_CH2,			/* 振動モータ駆動時間制御用 : 1カウント = 160MHz / (15999 + 1) = 0.1ms */
+	TIMER_CH3,			/* TFTバックライト用 */
+	TIMER_CH4,			/* Wait用、時刻計測用(1us、フリーラン) : 160MHz / (159+1) */
+	TIMER_CH5,			/* 60fps周期用 : (266666+1) * 160MHz / 1 */
+	TIMER_CH6,			/* 5ms周期用 : (4999+1) * 160MHz / (159 + 1) */
+	TIMER_CH_NUM
+} timer_ch_t;
+
+/* アラーム(時刻計測用タイマーのコンペアマッチで通知、単発/周期) */
+typedef enum {
+	ALARM_ID_EEPROM = 0,	/* EEPROM書き込み完了確認用 */
+	ALARM_ID_TFT,			/* TFT初期化手順の待機用 */
+	ALARM_ID_SOUND,			/* YMF825初期化手順の待機用 */
+	ALARM_ID_SCHEDULER,		/* SYS SCHEDULER 周期タスク起動用 */
+	ALARM_ID_I2C,			/* I2Cエラー時のリトライ待機用 */
+	ALARM_ID_NUM
+} alarm_id_t;
+
+/* アラームのコールバック実行コンテキスト */
+typedef enum {
+	ALARM_CONTEXT_ISR = 0,		/* コンペアマッチ割り込み処理内で実行 */
+	ALARM_CONTEXT_DEFERRED		/* MainTimerAlarm(メインループ)で実行 */
+} alarm_context_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitTimer(void);
+void InterruptTimer(timer_ch_t timer_ch);
+void SetTimerCallback(timer_ch_t timer_ch, callback_t callback);
+void StartTimer(timer_ch_t timer_ch);
+void StopTimer(timer_ch_t timer_ch);
+uint32_t GetTimerCounter(timer_ch_t timer_ch);
+void SetTimerCounter(timer_ch_t timer_ch, uint32_t count);
+uint32_t GetTimerPeriod(timer_ch_t timer_ch);
+void SetTimerPeriod(timer_ch_t timer_ch, uint32_t period);
+uint32_t GetTimeUs(void);
+void WaitUs(uint32_t us);
+void SetTimerAlarm(alarm_id_t alarm_id, uint32_t delay_us, callback_t callback);
+void SetTimerAlarmPeriodic(alarm_id_t alarm_id, uint32_t delay_us, uint32_t period_us, callback_t callback);
+void CancelTimerAlarm(alarm_id_t alarm_id);
+void InterruptTimerAlarm(void);
+void MainTimerAlarm(void);
+void SetTimerAlarmDeferredNotify(callback_t callback);
+
+#endif /* MCAL_TIMER_H_ */
@@ -0,0 +1,93 @@
+/*
+ * mcal_uart.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_uart.h"
+
+/********** Define **********/
+
+/* 送信タイムアウト [ms] */
+#define SEND_TIMEOUT		(100)
+
+/* 10進数文字列の最大桁数(uint32_t) */
+#define NUMBER_DIGIT_MAX	(10)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+extern UART_HandleTypeDef huart2;
+
+/********** Function Prototype **********/
+
+/********** Function **********/
+
+/*
+ * Function: MCAL UART 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitUart(void)
+{
+	/* 処理なし */
+}
+
+/*
+ * Function: UARTデータ送信
+ * Argument: 送信データ先頭アドレス、送信データ長
+ * Return  : なし
+ * Note    : 同期送信(デバッグ出力用)
+ */
+void SendUart(const uint8_t* data, uint16_t length)
+{
+	HAL_UART_Transmit(&huart2, (uint8_t*)data, length, SEND_TIMEOUT);
+}
+
+/*
+ * Function: UART文字列送信
+ * Argument: 送信文字列(NULL終端)
+ * Return  : なし
+ * Note    : 同期送信(デバッグ出力用)
+ */
+void SendUartString(const char* string)
+{
+	uint16_t length = 0;
+
+	while (string[length] != '\0') {
+		length ++;
+	}
+
+	SendUart((const uint8_t*)string, length);
+}
+
+/*
+ * Function: UART数値送信
+ * Argument: 送信数値
+ * Return  : なし
+ * Note    : 10進数文字列で同期送信(デバッグ出力用)
+ */
+void SendUartNumber(uint32_t value)
+{
+	uint8_t digit[NUMBER_DIGIT_MAX];
+	uint16_t index = NUMBER_DIGIT_MAX;
+
+	do {
+		index --;
+		digit[index] = '0' + (value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	SendUart(&digit[index], NUMBER_DIGIT_MAX - index);
+}
@@ -0,0 +1,33 @@
+/*
+ * mcal_uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef MCAL_UART_H_
+#define MCAL_UART_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitUart(void);
+void SendUart(const uint8_t* data, uint16_t length);
+void SendUartString(const char* string);
+void SendUartNumber(uint32_t value);
+
+#endif /* MCAL_UART_H_ */
@@ -0,0 +1,109 @@
+/*
+ * sys_boot.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "mcal_uart.h"
+#include "sys_boot.h"
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+static const char* const boot_step_name[BOOT_STEP_NUM] = {
+	"start",				/* BOOT_STEP_START */
+	"driver_started",		/* BOOT_STEP_DRIVER_STARTED */
+	"eeprom_loaded",		/* BOOT_STEP_EEPROM_LOADED */
+	"sound_power_up",		/* BOOT_STEP_SOUND_POWER_UP */
+	"sound_ready",			/* BOOT_STEP_SOUND_READY */
+	"tft_reset_done",		/* BOOT_STEP_TFT_RESET_DONE */
+	"tft_ready",			/* BOOT_STEP_TFT_READY */
+	"device_ready",			/* BOOT_STEP_DEVICE_READY */
+	"device_timeout",		/* BOOT_STEP_DEVICE_TIMEOUT */
+	"first_frame",			/* BOOT_STEP_FIRST_FRAME */
+};
+
+/********** Variable **********/
+
+static uint32_t boot_start_time;
+static uint32_t boot_step_time[BOOT_STEP_NUM];
+
+/********** Function Prototype **********/
+
+/********** Function **********/
+
+/*
+ * Function: SYS BOOT 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 時刻計測用タイマーを使用するため、MCAL TIMER 初期化後に実行すること
+ */
+void InitBootTrace(void)
+{
+	for (uint32_t step=0; step<BOOT_STEP_NUM; step++) {
+		boot_step_time[step] = BOOT_TIME_INVALID;
+	}
+
+	boot_start_time = GetTimeUs();
+	boot_step_time[BOOT_STEP_START] = 0;
+}
+
+/*
+ * Function: 起動手順到達記録
+ * Argument: 起動手順
+ * Return  : なし
+ * Note    : 最初に到達した時刻のみ記録する、割り込み処理内からも使用可能
+ */
+void RecordBootStep(boot_step_t step)
+{
+	if ((step < BOOT_STEP_NUM) && (boot_step_time[step] == BOOT_TIME_INVALID)) {
+		boot_step_time[step] = GetTimeUs() - boot_start_time;
+	}
+}
+
+/*
+ * Function: 起動手順到達時刻取得
+ * Argument: 起動手順
+ * Return  : 計測開始からの経過時間 [us] (未到達の場合はBOOT_TIME_INVALID)
+ * Note    : なし
+ */
+uint32_t GetBootStepTime(boot_step_t step)
+{
+	uint32_t time = BOOT_TIME_INVALID;
+
+	if (step < BOOT_STEP_NUM) {
+		time = boot_step_time[step];
+	}
+
+	return time;
+}
+
+/*
+ * Function: 起動時間トレース出力
+ * Argument: なし
+ * Return  : なし
+ * Note    : USART2へCSV形式(起動手順,経過時間[us])で同期送信する、未到達の手順は出力しない
+ */
+void DumpBootTrace(void)
+{
+	SendUartString("step,time_us\r\n");
+	for (uint32_t step=0; step<BOOT_STEP_NUM; step++) {
+		if (boot_step_time[step] != BOOT_TIME_INVALID) {
+			SendUartString(boot_step_name[step]);
+			SendUartString(",");
+			SendUartNumber(boot_step_time[step]);
+			SendUartString("\r\n");
+		}
+	}
+}
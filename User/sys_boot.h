@@ -0,0 +1,51 @@
+/*
+ * sys_boot.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef SYS_BOOT_H_
+#define SYS_BOOT_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 未到達の起動手順の時刻 */
+#define BOOT_TIME_INVALID		(0xFFFFFFFF)
+
+/********** Enum **********/
+
+/* 起動手順(記録時刻はInitBootTrace実行からの経過時間) */
+typedef enum {
+	BOOT_STEP_START = 0,			/* 起動時間計測開始(MCAL初期化後) */
+	BOOT_STEP_DRIVER_STARTED,		/* 全ドライバの初期化開始 */
+	BOOT_STEP_EEPROM_LOADED,		/* EEPROM全データ読み出し完了 */
+	BOOT_STEP_SOUND_POWER_UP,		/* YMF825電源投入、リセット手順完了 */
+	BOOT_STEP_SOUND_READY,			/* YMF825トーン、ボイス設定完了 */
+	BOOT_STEP_TFT_RESET_DONE,		/* TFTハードウェアリセット待ち完了 */
+	BOOT_STEP_TFT_READY,			/* TFTスリープ解除、初期設定完了 */
+	BOOT_STEP_DEVICE_READY,			/* 全デバイスの初期化完了 */
+	BOOT_STEP_DEVICE_TIMEOUT,		/* デバイスの初期化完了待ちタイムアウト */
+	BOOT_STEP_FIRST_FRAME,			/* 初回表示データ送信開始 */
+	BOOT_STEP_NUM
+} boot_step_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitBootTrace(void);
+void RecordBootStep(boot_step_t step);
+uint32_t GetBootStepTime(boot_step_t step);
+void DumpBootTrace(void);
+
+#endif /* SYS_BOOT_H_ */
@@ -0,0 +1,192 @@
+/*
+ * sys_latency.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "mcal_uart.h"
+#include "sys_latency.h"
+
+/********** Define **********/
+
+/* 計測打ち切り時間 [us] (KeyOnに至らなかった入力を破棄する) */
+#define LATENCY_TIMEOUT			(500000)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+#if LATENCY_TRACE_ENABLE
+static const char* const latency_stage_name[LATENCY_STAGE_NUM] = {
+	"pin_edge",			/* LATENCY_STAGE_PIN_EDGE */
+	"debounce",			/* LATENCY_STAGE_DEBOUNCE */
+	"state_update",		/* LATENCY_STAGE_STATE_UPDATE */
+	"keyon_queued",		/* LATENCY_STAGE_KEYON_QUEUED */
+	"keyon_complete",	/* LATENCY_STAGE_KEYON_COMPLETE */
+};
+#endif
+
+/********** Variable **********/
+
+#if LATENCY_TRACE_ENABLE
+static uint32_t stage_time[LATENCY_STAGE_NUM];
+static latency_stage_t stage_next;
+static uint32_t latency_histogram[LATENCY_STAGE_NUM][LATENCY_BIN_NUM];
+#endif
+
+/********** Function Prototype **********/
+
+#if LATENCY_TRACE_ENABLE
+static void addHistogram(void);
+#endif
+
+/********** Function **********/
+
+/*
+ * Function: SYS LATENCY 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitLatency(void)
+{
+#if LATENCY_TRACE_ENABLE
+	stage_next = LATENCY_STAGE_PIN_EDGE;
+#endif
+	ResetLatencyHistogram();
+}
+
+#if LATENCY_TRACE_ENABLE
+/*
+ * Function: 計測ポイント通過記録
+ * Argument: 計測ポイント
+ * Return  : なし
+ * Note    : 端子変化検出から順に通過した場合のみ記録し、KeyOn送信完了でヒストグラムに加算する
+ *           呼び出しはRECORD_LATENCY_STAGEで行い、LATENCY_TRACE_ENABLEが無効の場合は呼び出し自体を削除する
+ *           割り込み処理(SW入力、送信完了)とメインループの両方から呼び出すため、記録の更新は割り込み禁止で行う
+ */
+void RecordLatencyStage(latency_stage_t stage)
+{
+	uint32_t primask;
+	uint32_t time;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	time = GetTimeUs();
+	if ((stage_next != LATENCY_STAGE_PIN_EDGE)
+	 && ((time - stage_time[LATENCY_STAGE_PIN_EDGE]) > LATENCY_TIMEOUT)) {
+		/* 計測打ち切り */
+		stage_next = LATENCY_STAGE_PIN_EDGE;
+	}
+
+	if (stage == stage_next) {
+		stage_time[stage] = time;
+		if (stage < LATENCY_STAGE_KEYON_COMPLETE) {
+			stage_next = stage + 1;
+		} else {
+			addHistogram();
+			stage_next = LATENCY_STAGE_PIN_EDGE;
+		}
+	}
+
+	__set_PRIMASK(primask);
+}
+#endif
+
+/*
+ * Function: ヒストグラム初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void ResetLatencyHistogram(void)
+{
+#if LATENCY_TRACE_ENABLE
+	for (uint32_t stage=0; stage<LATENCY_STAGE_NUM; stage++) {
+		for (uint32_t bin=0; bin<LATENCY_BIN_NUM; bin++) {
+			latency_histogram[stage][bin] = 0;
+		}
+	}
+#endif
+}
+
+/*
+ * Function: ヒストグラム取得
+ * Argument: 計測ポイント、ビン番号
+ * Return  : 端子変化検出から計測ポイントまでの時間が該当ビンに入った回数
+ * Note    : ビン番号nは n*LATENCY_BIN_WIDTH 以上 (n+1)*LATENCY_BIN_WIDTH 未満 [us]
+ *           LATENCY_TRACE_ENABLEが無効の場合は常に0
+ */
+uint32_t GetLatencyHistogram(latency_stage_t stage, uint32_t bin)
+{
+	uint32_t count = 0;
+
+#if LATENCY_TRACE_ENABLE
+	if ((stage < LATENCY_STAGE_NUM) && (bin < LATENCY_BIN_NUM)) {
+		count = latency_histogram[stage][bin];
+	}
+#else
+	(void)stage;
+	(void)bin;
+#endif
+
+	return count;
+}
+
+/*
+ * Function: ヒストグラム出力
+ * Argument: なし
+ * Return  : なし
+ * Note    : USART2へCSV形式(ビン下限[us],計測ポイント毎の回数)で同期送信する
+ *           LATENCY_TRACE_ENABLEが無効の場合は何もしない
+ */
+void DumpLatencyHistogram(void)
+{
+#if LATENCY_TRACE_ENABLE
+	SendUartString("bin_us");
+	for (uint32_t stage=LATENCY_STAGE_DEBOUNCE; stage<LATENCY_STAGE_NUM; stage++) {
+		SendUartString(",");
+		SendUartString(latency_stage_name[stage]);
+	}
+	SendUartString("\r\n");
+
+	for (uint32_t bin=0; bin<LATENCY_BIN_NUM; bin++) {
+		SendUartNumber(bin * LATENCY_BIN_WIDTH);
+		for (uint32_t stage=LATENCY_STAGE_DEBOUNCE; stage<LATENCY_STAGE_NUM; stage++) {
+			SendUartString(",");
+			SendUartNumber(latency_histogram[stage][bin]);
+		}
+		SendUartString("\r\n");
+	}
+#endif
+}
+
+#if LATENCY_TRACE_ENABLE
+/*
+ * Function: ヒストグラム加算
+ * Argument: なし
+ * Return  : なし
+ * Note    : 各計測ポイントの端子変化検出からの経過時間を加算する
+ */
+static void addHistogram(void)
+{
+	uint32_t bin;
+
+	for (uint32_t stage=0; stage<LATENCY_STAGE_NUM; stage++) {
+		bin = (stage_time[stage] - stage_time[LATENCY_STAGE_PIN_EDGE]) / LATENCY_BIN_WIDTH;
+		if (bin >= LATENCY_BIN_NUM) {
+			bin = LATENCY_BIN_NUM - 1;
+		}
+		latency_histogram[stage][bin] ++;
+	}
+}
+#endif
@@ -0,0 +1,65 @@
+/*
+ * sys_latency.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef SYS_LATENCY_H_
+#define SYS_LATENCY_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 入力遅延計測有効/無効(1:有効、0:無効) */
+#define LATENCY_TRACE_ENABLE	(0)
+
+/* ヒストグラムのビン幅 [us] */
+#define LATENCY_BIN_WIDTH		(1000)
+/* ヒストグラムのビン数(最終ビンは範囲外をまとめて計数) */
+#define LATENCY_BIN_NUM			(64)
+
+/* 計測ポイント通過記録(無効時は呼び出し自体を削除する) */
+#if LATENCY_TRACE_ENABLE
+#define RECORD_LATENCY_STAGE(stage)		RecordLatencyStage(stage)
+#else
+#define RECORD_LATENCY_STAGE(stage)		((void)0)
+#endif
+
+/********** Enum **********/
+
+/* 計測ポイント(SW入力からサウンド出力まで)
+ * 端子変化検出の時刻はSW入力の検出方式で分解能が異なる
+ *   SW_INPUT_EXTI_ENABLE=1:端子変化のEXTI割り込みの時刻
+ *   SW_INPUT_EXTI_ENABLE=0:端子変化後の最初の5ms周期ポーリングの時刻(実際の端子変化から最大5ms遅れるため、
+ *                          端子変化からの遅延は計測値より最大5ms長い) */
+typedef enum {
+	LATENCY_STAGE_PIN_EDGE = 0,		/* 端子変化検出 */
+	LATENCY_STAGE_DEBOUNCE,			/* チャタリング除去確定 */
+	LATENCY_STAGE_STATE_UPDATE,		/* 入力状態更新(INPUT_PUSH) */
+	LATENCY_STAGE_KEYON_QUEUED,		/* KeyOn送信ジョブ追加 */
+	LATENCY_STAGE_KEYON_COMPLETE,	/* KeyOn送信完了 */
+	LATENCY_STAGE_NUM
+} latency_stage_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitLatency(void);
+#if LATENCY_TRACE_ENABLE
+void RecordLatencyStage(latency_stage_t stage);
+#endif
+void ResetLatencyHistogram(void);
+uint32_t GetLatencyHistogram(latency_stage_t stage, uint32_t bin);
+void DumpLatencyHistogram(void);
+
+#endif /* SYS_LATENCY_H_ */
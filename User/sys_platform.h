@@ -1,29 +1,29 @@
-/*
- * sys_platform.h
- *
- *  Created on: Apr 22, 2023
- *      Author: KimiakiK
- */
-
-
-#ifndef SYS_PLATFORM_H_
-#define SYS_PLATFORM_H_
-
-/********** Include **********/
-
-/********** Define **********/
-
-/********** Enum **********/
-
-/********** Type **********/
-
-/********** Constant **********/
-
-/********** Variable **********/
-
-/********** Function Prototype **********/
-
-void InitPlatform(void);
-void MainPlatform(void);
-
-#endif /* SYS_PLATFORM_H_ */
+/*
+ * sys_platform.h
+ *
+ *  Created on: Apr 22, 2023
+ *      Author: KimiakiK
+ */
+
+
+#ifndef SYS_PLATFORM_H_
+#define SYS_PLATFORM_H_
+
+/********** Include **********/
+
+/********** Define **********/
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitPlatform(void);
+void MainPlatform(void);
+
+#endif /* SYS_PLATFORM_H_ */
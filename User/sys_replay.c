@@ -0,0 +1,584 @@
+/*
+ * sys_replay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_adc.h"
+#include "mcal_uart.h"
+#include "drv_controller.h"
+#include "drv_touch.h"
+#include "sys_replay.h"
+
+/********** Define **********/
+
+/* フレームヘッダ: 変化した項目のフラグ */
+#define REPLAY_FLAG_INPUT		(0x01)
+#define REPLAY_FLAG_AD_POS_H	(0x02)
+#define REPLAY_FLAG_AD_POS_V	(0x04)
+#define REPLAY_FLAG_AD_LEVER	(0x08)
+#define REPLAY_FLAG_TOUCH		(0x10)
+#define REPLAY_FLAG_EVENT		(0x20)
+/* フレームヘッダ: 変化なしフレームの連続数(下位7bit) */
+#define REPLAY_FLAG_REPEAT		(0x80)
+#define REPLAY_REPEAT_MAX		(0x7F)
+
+/* AD変換値: 差分(7bit符号付き)で表現できない場合は絶対値(14bit)を2byteで記録 */
+#define REPLAY_AD_ABSOLUTE		(0x80)
+#define REPLAY_AD_DELTA_MIN		(-64)
+#define REPLAY_AD_DELTA_MAX		(63)
+
+/* 入力状態: 1入力2bitで詰めたバイト数 */
+#define REPLAY_INPUT_BYTE_NUM	((INPUT_ID_NUM * 2 + 7) / 8)
+
+/* 入力イベント: 1フレームの最大記録数(超過分は記録しない)、1イベント1byte(bit7:種別、bit6-0:入力ID) */
+#define REPLAY_EVENT_NUM_MAX	(32)
+#define REPLAY_EVENT_TYPE_SHIFT	(7)
+#define REPLAY_EVENT_ID_MASK	(0x7F)
+
+/* タッチ入力: 状態1byte、X座標2byte、Y座標2byte */
+#define REPLAY_TOUCH_SIZE		(5)
+
+/* 1フレームの最大記録サイズ [byte] */
+#define REPLAY_FRAME_SIZE_MAX	(1 + REPLAY_INPUT_BYTE_NUM + AD_ID_NUM * 2 + REPLAY_TOUCH_SIZE + 1 + REPLAY_EVENT_NUM_MAX)
+
+/* ダンプ時の1行のバイト数 */
+#define REPLAY_DUMP_LINE_SIZE	(32)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/* 1フレーム分の入力 */
+typedef struct {
+	uint32_t input_bits;			/* 入力状態(入力ID毎に2bit) */
+	uint32_t ad[AD_ID_NUM];			/* AD変換値 */
+	touch_state_t touch_state;		/* タッチ入力状態 */
+	uint16_t touch_x;				/* タッチ入力座標 */
+	uint16_t touch_y;
+	uint32_t event_num;				/* 今フレームの入力イベント数 */
+	uint8_t event[REPLAY_EVENT_NUM_MAX];	/* 入力イベント(記録形式) */
+} replay_frame_t;
+
+/********** Constant **********/
+
+static const uint8_t replay_ad_flag_table[AD_ID_NUM] = {
+	REPLAY_FLAG_AD_POS_H,
+	REPLAY_FLAG_AD_POS_V,
+	REPLAY_FLAG_AD_LEVER
+};
+
+static const char hex_char_table[16] = {
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/********** Variable **********/
+
+static replay_state_t replay_state;
+static uint8_t replay_buffer[REPLAY_BUFFER_SIZE];
+static uint32_t replay_length;
+static uint32_t replay_position;
+static uint32_t replay_frame_num;
+static uint32_t replay_repeat_count;
+static bool_t replay_first_frame;
+static replay_frame_t replay_frame_last;
+
+/********** Function Prototype **********/
+
+static void captureFrame(replay_frame_t* frame);
+static void injectFrame(const replay_frame_t* frame);
+static void setInject(bool_t enable);
+static void writeRepeat(void);
+static void writeFrame(const replay_frame_t* frame, uint8_t flags);
+static result_t readFrame(replay_frame_t* frame);
+static result_t readData(uint8_t* data, uint32_t size);
+
+/********** Function **********/
+
+/*
+ * Function: SYS REPLAY 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void InitReplay(void)
+{
+	replay_state = REPLAY_STATE_IDLE;
+	replay_length = 0;
+	replay_position = 0;
+	replay_frame_num = 0;
+	replay_repeat_count = 0;
+	replay_first_frame = TRUE;
+}
+
+/*
+ * Function: SYS REPLAY 周期処理(再生)
+ * Argument: なし
+ * Return  : なし
+ * Note    : 入力系ドライバの周期処理より前に呼び出す
+ *           記録の最後まで再生したら実入力に戻す
+ */
+void MainReplay(void)
+{
+	result_t result;
+
+	if (replay_state == REPLAY_STATE_PLAY) {
+		if (replay_repeat_count > 0) {
+			/* 変化なしフレーム(前回の差し替え値を継続) */
+			replay_repeat_count --;
+			replay_frame_num ++;
+		} else {
+			result = readFrame(&replay_frame_last);
+			if (result == RESULT_OK) {
+				injectFrame(&replay_frame_last);
+				replay_frame_num ++;
+			} else {
+				/* 再生終了 */
+				StopReplay();
+			}
+		}
+	}
+}
+
+/*
+ * Function: SYS REPLAY 周期処理(記録)
+ * Argument: なし
+ * Return  : なし
+ * Note    : 入力系ドライバの周期処理より後に呼び出す
+ *           バッファが満杯になったら記録を終了する
+ */
+void RecordReplay(void)
+{
+	replay_frame_t frame;
+	uint8_t flags = 0;
+
+	if (replay_state == REPLAY_STATE_RECORD) {
+		captureFrame(&frame);
+
+		/* 前フレームから変化した項目を判定 */
+		if ((replay_first_frame == TRUE) || (frame.input_bits != replay_frame_last.input_bits)) {
+			flags |= REPLAY_FLAG_INPUT;
+		}
+		for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+			if ((replay_first_frame == TRUE) || (frame.ad[ad_id] != replay_frame_last.ad[ad_id])) {
+				flags |= replay_ad_flag_table[ad_id];
+			}
+		}
+		if ((replay_first_frame == TRUE)
+		 || (frame.touch_state != replay_frame_last.touch_state)
+		 || (frame.touch_x != replay_frame_last.touch_x)
+		 || (frame.touch_y != replay_frame_last.touch_y)) {
+			flags |= REPLAY_FLAG_TOUCH;
+		}
+		if (frame.event_num > 0) {
+			flags |= REPLAY_FLAG_EVENT;
+		}
+
+		if (flags == 0) {
+			/* 変化なしは連続数のみ記録 */
+			replay_repeat_count ++;
+			replay_frame_num ++;
+			if (replay_repeat_count == REPLAY_REPEAT_MAX) {
+				if (replay_length + 1 + REPLAY_FRAME_SIZE_MAX <= REPLAY_BUFFER_SIZE) {
+					writeRepeat();
+				} else {
+					/* バッファ満杯(確保済みの1byteに連続数を記録して終了) */
+					StopReplay();
+				}
+			}
+		} else if (replay_length + 1 + REPLAY_FRAME_SIZE_MAX <= REPLAY_BUFFER_SIZE) {
+			writeRepeat();
+			writeFrame(&frame, flags);
+			replay_frame_last = frame;
+			replay_first_frame = FALSE;
+			replay_frame_num ++;
+		} else {
+			/* バッファ満杯 */
+			StopReplay();
+		}
+	}
+}
+
+/*
+ * Function: 記録開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : 前回の記録は破棄する
+ */
+void StartReplayRecord(void)
+{
+	StopReplay();
+
+	replay_length = 0;
+	replay_frame_num = 0;
+	replay_repeat_count = 0;
+	replay_first_frame = TRUE;
+	replay_state = REPLAY_STATE_RECORD;
+}
+
+/*
+ * Function: 再生開始
+ * Argument: なし
+ * Return  : なし
+ * Note    : 記録またはLoadReplayで読み込んだデータを先頭から再生する
+ */
+void StartReplayPlay(void)
+{
+	StopReplay();
+
+	replay_position = 0;
+	replay_frame_num = 0;
+	replay_repeat_count = 0;
+	setInject(TRUE);
+	replay_state = REPLAY_STATE_PLAY;
+}
+
+/*
+ * Function: 記録/再生終了
+ * Argument: なし
+ * Return  : なし
+ * Note    : なし
+ */
+void StopReplay(void)
+{
+	if (replay_state == REPLAY_STATE_RECORD) {
+		/* 未出力の変化なしフレームを記録 */
+		writeRepeat();
+	} else if (replay_state == REPLAY_STATE_PLAY) {
+		setInject(FALSE);
+	} else {
+		/* 処理なし */
+	}
+
+	replay_state = REPLAY_STATE_IDLE;
+}
+
+/*
+ * Function: 記録/再生状態取得
+ * Argument: なし
+ * Return  : 記録/再生状態
+ * Note    : なし
+ */
+replay_state_t GetReplayState(void)
+{
+	return replay_state;
+}
+
+/*
+ * Function: 記録/再生フレーム数取得
+ * Argument: なし
+ * Return  : 記録済み、または再生済みのフレーム数
+ * Note    : なし
+ */
+uint32_t GetReplayFrameNum(void)
+{
+	return replay_frame_num;
+}
+
+/*
+ * Function: 記録データ出力
+ * Argument: なし
+ * Return  : なし
+ * Note    : 1行目に"REPLAY,フレーム数,バイト数"、以降16進文字列でUART出力する
+ *           送信完了まで戻らないため、記録/再生中は呼び出さないこと
+ */
+void DumpReplay(void)
+{
+	char line[REPLAY_DUMP_LINE_SIZE * 2 + 3];
+	uint32_t line_index = 0;
+
+	SendUartString("REPLAY,");
+	SendUartNumber(replay_frame_num);
+	SendUartString(",");
+	SendUartNumber(replay_length);
+	SendUartString("\r\n");
+
+	for (uint32_t index=0; index<replay_length; index++) {
+		line[line_index + 0] = hex_char_table[replay_buffer[index] >> 4];
+		line[line_index + 1] = hex_char_table[replay_buffer[index] & 0x0F];
+		line_index += 2;
+		if ((line_index == REPLAY_DUMP_LINE_SIZE * 2) || (index == replay_length - 1)) {
+			line[line_index + 0] = '\r';
+			line[line_index + 1] = '\n';
+			line[line_index + 2] = '\0';
+			SendUartString(line);
+			line_index = 0;
+		}
+	}
+}
+
+/*
+ * Function: 記録データ読み込み
+ * Argument: 記録データ(DumpReplayで出力したバイト列)、バイト数
+ * Return  : RESULT_OK:読み込み成功、RESULT_NG:サイズ超過
+ * Note    : ホストビルドで記録ファイルから再生する場合などに使用する
+ */
+result_t LoadReplay(const uint8_t* data, uint32_t length)
+{
+	result_t result = RESULT_NG;
+
+	if (length <= REPLAY_BUFFER_SIZE) {
+		StopReplay();
+		for (uint32_t index=0; index<length; index++) {
+			replay_buffer[index] = data[index];
+		}
+		replay_length = length;
+		replay_frame_num = 0;
+		result = RESULT_OK;
+	}
+
+	return result;
+}
+
+/*
+ * Function: 現在の入力を取得
+ * Argument: 格納先
+ * Return  : なし
+ * Note    : なし
+ */
+static void captureFrame(replay_frame_t* frame)
+{
+	point_t point;
+	input_event_t event;
+
+	frame->input_bits = 0;
+	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+		frame->input_bits |= (uint32_t)GetInputState(input_id) << (input_id * 2);
+	}
+
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		frame->ad[ad_id] = GetAdRaw(ad_id);
+	}
+
+	frame->touch_state = GetTouchState();
+	point = GetTouchPoint();
+	frame->touch_x = (uint16_t)point.x;
+	frame->touch_y = (uint16_t)point.y;
+
+	frame->event_num = 0;
+	for (uint32_t index=0; (index<GetInputEventNum()) && (index<REPLAY_EVENT_NUM_MAX); index++) {
+		event = GetInputEvent(index);
+		frame->event[index] = ((uint8_t)event.type << REPLAY_EVENT_TYPE_SHIFT) | (uint8_t)event.input_id;
+		frame->event_num ++;
+	}
+}
+
+/*
+ * Function: 記録した入力を差し替え
+ * Argument: 差し替える入力
+ * Return  : なし
+ * Note    : なし
+ */
+static void injectFrame(const replay_frame_t* frame)
+{
+	point_t point;
+
+	for (input_id_t input_id=0; input_id<INPUT_ID_NUM; input_id++) {
+		InjectInputState(input_id, (frame->input_bits >> (input_id * 2)) & 0x03);
+	}
+
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		InjectAd(ad_id, frame->ad[ad_id]);
+	}
+
+	point.x = frame->touch_x;
+	point.y = frame->touch_y;
+	InjectTouch(frame->touch_state, point);
+
+	for (uint32_t index=0; index<frame->event_num; index++) {
+		InjectInputEvent(frame->event[index] & REPLAY_EVENT_ID_MASK, frame->event[index] >> REPLAY_EVENT_TYPE_SHIFT);
+	}
+}
+
+/*
+ * Function: 入力差し替え有効/無効設定
+ * Argument: TRUE:有効、FALSE:無効
+ * Return  : なし
+ * Note    : なし
+ */
+static void setInject(bool_t enable)
+{
+	SetAdInject(enable);
+	SetInputInject(enable);
+	SetTouchInject(enable);
+}
+
+/*
+ * Function: 変化なしフレーム数書き込み
+ * Argument: なし
+ * Return  : なし
+ * Note    : 連続数が0の場合は何もしない
+ */
+static void writeRepeat(void)
+{
+	if ((replay_repeat_count > 0) && (replay_length < REPLAY_BUFFER_SIZE)) {
+		replay_buffer[replay_length] = REPLAY_FLAG_REPEAT | replay_repeat_count;
+		replay_length ++;
+	}
+	replay_repeat_count = 0;
+}
+
+/*
+ * Function: フレーム書き込み
+ * Argument: 書き込むフレーム、変化した項目のフラグ
+ * Return  : なし
+ * Note    : 変化した項目のみ書き込む
+ */
+static void writeFrame(const replay_frame_t* frame, uint8_t flags)
+{
+	int32_t delta;
+
+	replay_buffer[replay_length] = flags;
+	replay_length ++;
+
+	if ((flags & REPLAY_FLAG_INPUT) != 0) {
+		for (uint32_t index=0; index<REPLAY_INPUT_BYTE_NUM; index++) {
+			replay_buffer[replay_length] = (frame->input_bits >> (index * 8)) & 0xFF;
+			replay_length ++;
+		}
+	}
+
+	for (uint32_t ad_id=0; ad_id<AD_ID_NUM; ad_id++) {
+		if ((flags & replay_ad_flag_table[ad_id]) != 0) {
+			delta = (int32_t)frame->ad[ad_id] - (int32_t)replay_frame_last.ad[ad_id];
+			if ((replay_first_frame == FALSE) && (delta >= REPLAY_AD_DELTA_MIN) && (delta <= REPLAY_AD_DELTA_MAX)) {
+				/* 差分 */
+				replay_buffer[replay_length] = delta & 0x7F;
+				replay_length ++;
+			} else {
+				/* 絶対値 */
+				replay_buffer[replay_length + 0] = REPLAY_AD_ABSOLUTE | ((frame->ad[ad_id] >> 8) & 0x3F);
+				replay_buffer[replay_length + 1] = frame->ad[ad_id] & 0xFF;
+				replay_length += 2;
+			}
+		}
+	}
+
+	if ((flags & REPLAY_FLAG_TOUCH) != 0) {
+		replay_buffer[replay_length + 0] = frame->touch_state;
+		replay_buffer[replay_length + 1] = (frame->touch_x >> 8) & 0xFF;
+		replay_buffer[replay_length + 2] = frame->touch_x & 0xFF;
+		replay_buffer[replay_length + 3] = (frame->touch_y >> 8) & 0xFF;
+		replay_buffer[replay_length + 4] = frame->touch_y & 0xFF;
+		replay_length += REPLAY_TOUCH_SIZE;
+	}
+
+	if ((flags & REPLAY_FLAG_EVENT) != 0) {
+		replay_buffer[replay_length] = frame->event_num;
+		replay_length ++;
+		for (uint32_t index=0; index<frame->event_num; index++) {
+			replay_buffer[replay_length] = frame->event[index];
+			replay_length ++;
+		}
+	}
+}
+
+/*
+ * Function: フレーム読み出し
+ * Argument: 前フレームの値(読み出したフレームで更新)
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:記録終端または記録データ異常
+ * Note    : 変化なしフレームの連続数を読み出した場合は、その1フレーム目として前フレームの値を返す
+ *           入力イベントは前フレームの値を引き継がない
+ *           途中で記録が途切れている、または範囲外の値を読み出した場合は記録終端として扱う
+ */
+static result_t readFrame(replay_frame_t* frame)
+{
+	result_t result;
+	uint8_t flags;
+	uint8_t data[REPLAY_EVENT_NUM_MAX];
+
+	frame->event_num = 0;
+
+	result = readData(&flags, 1);
+	if (result == RESULT_OK) {
+		if ((flags & REPLAY_FLAG_REPEAT) != 0) {
+			/* 変化なし(今フレーム分を除いた残りを保持) */
+			if ((flags & REPLAY_REPEAT_MAX) > 0) {
+				replay_repeat_count = (flags & REPLAY_REPEAT_MAX) - 1;
+			} else {
+				result = RESULT_NG;
+			}
+		} else {
+			if ((flags & REPLAY_FLAG_INPUT) != 0) {
+				result = readData(data, REPLAY_INPUT_BYTE_NUM);
+				if (result == RESULT_OK) {
+					frame->input_bits = 0;
+					for (uint32_t index=0; index<REPLAY_INPUT_BYTE_NUM; index++) {
+						frame->input_bits |= (uint32_t)data[index] << (index * 8);
+					}
+				}
+			}
+
+			for (uint32_t ad_id=0; (ad_id<AD_ID_NUM) && (result == RESULT_OK); ad_id++) {
+				if ((flags & replay_ad_flag_table[ad_id]) != 0) {
+					result = readData(&data[0], 1);
+					if (result != RESULT_OK) {
+						/* 処理なし */
+					} else if ((data[0] & REPLAY_AD_ABSOLUTE) != 0) {
+						result = readData(&data[1], 1);
+						frame->ad[ad_id] = ((uint32_t)(data[0] & 0x3F) << 8) | data[1];
+					} else {
+						/* 7bit符号付き差分を符号拡張 */
+						frame->ad[ad_id] += (int32_t)(data[0] ^ 0x40) - 0x40;
+					}
+				}
+			}
+
+			if ((result == RESULT_OK) && ((flags & REPLAY_FLAG_TOUCH) != 0)) {
+				result = readData(data, REPLAY_TOUCH_SIZE);
+				if ((result == RESULT_OK) && (data[0] > TOUCH_END)) {
+					result = RESULT_NG;
+				}
+				if (result == RESULT_OK) {
+					frame->touch_state = data[0];
+					frame->touch_x = ((uint16_t)data[1] << 8) | data[2];
+					frame->touch_y = ((uint16_t)data[3] << 8) | data[4];
+				}
+			}
+
+			if ((result == RESULT_OK) && ((flags & REPLAY_FLAG_EVENT) != 0)) {
+				result = readData(&data[0], 1);
+				if ((result == RESULT_OK) && ((data[0] == 0) || (data[0] > REPLAY_EVENT_NUM_MAX))) {
+					result = RESULT_NG;
+				}
+				if (result == RESULT_OK) {
+					frame->event_num = data[0];
+					result = readData(frame->event, frame->event_num);
+				}
+				for (uint32_t index=0; (index<frame->event_num) && (result == RESULT_OK); index++) {
+					if ((frame->event[index] & REPLAY_EVENT_ID_MASK) >= INPUT_ID_NUM) {
+						result = RESULT_NG;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Function: 記録データ読み出し
+ * Argument: 格納先、バイト数
+ * Return  : RESULT_OK:読み出し成功、RESULT_NG:記録の残りが不足
+ * Note    : 読み出した分だけ読み出し位置を進める
+ */
+static result_t readData(uint8_t* data, uint32_t size)
+{
+	result_t result = RESULT_NG;
+
+	if (size <= replay_length - replay_position) {
+		for (uint32_t index=0; index<size; index++) {
+			data[index] = replay_buffer[replay_position];
+			replay_position ++;
+		}
+		result = RESULT_OK;
+	}
+
+	return result;
+}
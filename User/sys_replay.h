@@ -0,0 +1,48 @@
+/*
+ * sys_replay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef SYS_REPLAY_H_
+#define SYS_REPLAY_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* 記録バッファサイズ [byte] */
+#define REPLAY_BUFFER_SIZE		(32768)
+
+/********** Enum **********/
+
+typedef enum {
+	REPLAY_STATE_IDLE = 0,
+	REPLAY_STATE_RECORD,
+	REPLAY_STATE_PLAY
+} replay_state_t;
+
+/********** Type **********/
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitReplay(void);
+void MainReplay(void);
+void RecordReplay(void);
+void StartReplayRecord(void);
+void StartReplayPlay(void);
+void StopReplay(void);
+replay_state_t GetReplayState(void);
+uint32_t GetReplayFrameNum(void);
+void DumpReplay(void);
+result_t LoadReplay(const uint8_t* data, uint32_t length);
+
+#endif /* SYS_REPLAY_H_ */
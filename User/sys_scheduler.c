@@ -0,0 +1,357 @@
+/*
+ * sys_scheduler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+/********** Include **********/
+
+#include "typedef.h"
+#include "mcal_timer.h"
+#include "mcal_uart.h"
+#include "sys_scheduler.h"
+
+/********** Define **********/
+
+/* 優先度の段階数 */
+#define TASK_PRIORITY_NUM		(TASK_PRIORITY_LOW + 1)
+
+/********** Enum **********/
+
+/********** Type **********/
+
+/********** Constant **********/
+
+static const task_priority_t task_priority[TASK_ID_NUM] = {
+	TASK_PRIORITY_HIGH,		/* TASK_ID_FRAME */
+	TASK_PRIORITY_NORMAL,	/* TASK_ID_TIMER_ALARM */
+	TASK_PRIORITY_LOW,		/* TASK_ID_STORAGE */
+};
+
+static const char* const task_name[TASK_ID_NUM] = {
+	"frame",				/* TASK_ID_FRAME */
+	"timer_alarm",			/* TASK_ID_TIMER_ALARM */
+	"storage",				/* TASK_ID_STORAGE */
+};
+
+/********** Variable **********/
+
+static callback_t task_callback[TASK_ID_NUM];
+static bool_t task_pending[TASK_ID_NUM];
+
+/* 周期起動 */
+static uint32_t task_period[TASK_ID_NUM];
+static uint32_t task_next_time[TASK_ID_NUM];
+
+/* 集計中の統計 */
+static uint32_t stat_start_time;
+static uint32_t stat_idle_time;
+static uint32_t stat_run_count[TASK_ID_NUM];
+static uint32_t stat_run_time[TASK_ID_NUM];
+
+/* 直近の集計周期の統計 */
+static uint32_t idle_percent;
+static task_stat_t task_stat[TASK_ID_NUM];
+
+/********** Function Prototype **********/
+
+static task_id_t findTask(void);
+static void runTask(task_id_t task_id);
+static void updateStat(void);
+static void updatePeriodAlarm(void);
+static void callbackDeferredAlarm(void);
+
+/********** Function **********/
+
+/*
+ * Function: SYS SCHEDULER 初期化
+ * Argument: なし
+ * Return  : なし
+ * Note    : 時刻計測用タイマーを使用するため、MCAL TIMER 初期化後に実行すること
+ *           遅延実行指定のアラーム処理はTASK_ID_TIMER_ALARMとして実行する
+ */
+void InitScheduler(void)
+{
+	for (uint32_t task_id=0; task_id<TASK_ID_NUM; task_id++) {
+		task_callback[task_id] = NULL;
+		task_pending[task_id] = FALSE;
+		task_period[task_id] = 0;
+		task_next_time[task_id] = 0;
+		stat_run_count[task_id] = 0;
+		stat_run_time[task_id] = 0;
+		task_stat[task_id].run_count = 0;
+		task_stat[task_id].run_time = 0;
+		task_stat[task_id].run_time_max = 0;
+	}
+	stat_start_time = GetTimeUs();
+	stat_idle_time = 0;
+	idle_percent = 100;
+
+	SetTaskCallback(TASK_ID_TIMER_ALARM, MainTimerAlarm);
+	SetTimerAlarmDeferredNotify(callbackDeferredAlarm);
+}
+
+/*
+ * Function: スケジューラ実行
+ * Argument: なし
+ * Return  : なし(戻らない)
+ * Note    : 実行要求のあるタスクを優先度順に1つずつ最後まで実行する
+ *           実行要求が無い場合は割り込みまでWFIで待機し、待機時間をアイドル時間として集計する
+ */
+void RunScheduler(void)
+{
+	uint32_t primask;
+	uint32_t idle_start_time;
+	task_id_t task_id;
+
+	while (TRUE) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		task_id = findTask();
+		if (task_id < TASK_ID_NUM) {
+			task_pending[task_id] = FALSE;
+			__set_PRIMASK(primask);
+
+			runTask(task_id);
+		} else {
+			/* 割り込み禁止のまま待機し、判定から待機までの間の実行要求を取りこぼさない */
+			idle_start_time = GetTimeUs();
+			__WFI();
+			stat_idle_time += GetTimeUs() - idle_start_time;
+			__set_PRIMASK(primask);
+		}
+
+		updateStat();
+	}
+}
+
+/*
+ * Function: タスク処理設定
+ * Argument: タスクID、タスク処理関数
+ * Return  : なし
+ * Note    : なし
+ */
+void SetTaskCallback(task_id_t task_id, callback_t callback)
+{
+	if (task_id < TASK_ID_NUM) {
+		task_callback[task_id] = callback;
+	}
+}
+
+/*
+ * Function: タスク周期起動設定
+ * Argument: タスクID、起動周期 [us] (0:周期起動しない)
+ * Return  : なし
+ * Note    : 設定から1周期後に初回の実行要求を行う
+ */
+void SetTaskPeriod(task_id_t task_id, uint32_t period_us)
+{
+	uint32_t primask;
+
+	if (task_id < TASK_ID_NUM) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		task_period[task_id] = period_us;
+		task_next_time[task_id] = GetTimeUs() + period_us;
+		updatePeriodAlarm();
+		__set_PRIMASK(primask);
+	}
+}
+
+/*
+ * Function: タスク実行要求
+ * Argument: タスクID
+ * Return  : なし
+ * Note    : 割り込み処理内からも使用可能、実行前の実行要求は1回にまとめる
+ */
+void PostTask(task_id_t task_id)
+{
+	if (task_id < TASK_ID_NUM) {
+		task_pending[task_id] = TRUE;
+	}
+}
+
+/*
+ * Function: アイドル率取得
+ * Argument: なし
+ * Return  : 直近の集計周期のアイドル率 [%]
+ * Note    : なし
+ */
+uint32_t GetSchedulerIdlePercent(void)
+{
+	return idle_percent;
+}
+
+/*
+ * Function: CPU負荷取得
+ * Argument: なし
+ * Return  : 直近の集計周期のCPU負荷(タスク、割り込み処理の実行時間の割合) [%]
+ * Note    : なし
+ */
+uint32_t GetSchedulerLoadPercent(void)
+{
+	return 100 - idle_percent;
+}
+
+/*
+ * Function: タスク実行統計取得
+ * Argument: タスクID
+ * Return  : タスク実行統計
+ * Note    : なし
+ */
+task_stat_t GetTaskStat(task_id_t task_id)
+{
+	task_stat_t stat = {0, 0, 0};
+
+	if (task_id < TASK_ID_NUM) {
+		stat = task_stat[task_id];
+	}
+
+	return stat;
+}
+
+/*
+ * Function: 実行統計出力
+ * Argument: なし
+ * Return  : なし
+ * Note    : USART2へCSV形式(タスク,実行回数,実行時間[us],最大実行時間[us])で同期送信する
+ *           最終行にアイドル率[%]を出力する
+ */
+void DumpSchedulerStat(void)
+{
+	SendUartString("task,run_count,run_time_us,run_time_max_us\r\n");
+	for (uint32_t task_id=0; task_id<TASK_ID_NUM; task_id++) {
+		SendUartString(task_name[task_id]);
+		SendUartString(",");
+		SendUartNumber(task_stat[task_id].run_count);
+		SendUartString(",");
+		SendUartNumber(task_stat[task_id].run_time);
+		SendUartString(",");
+		SendUartNumber(task_stat[task_id].run_time_max);
+		SendUartString("\r\n");
+	}
+	SendUartString("idle_percent,");
+	SendUartNumber(idle_percent);
+	SendUartString("\r\n");
+}
+
+/*
+ * Function: 実行タスク選択
+ * Argument: なし
+ * Return  : 実行要求のあるタスクのうち最も優先度の高いタスクID(無い場合はTASK_ID_NUM)
+ * Note    : 同じ優先度の場合はタスクIDの小さい方を選択する
+ */
+static task_id_t findTask(void)
+{
+	task_id_t found = TASK_ID_NUM;
+
+	for (uint32_t priority=0; (priority<TASK_PRIORITY_NUM) && (found == TASK_ID_NUM); priority++) {
+		for (uint32_t task_id=0; (task_id<TASK_ID_NUM) && (found == TASK_ID_NUM); task_id++) {
+			if ((task_pending[task_id] == TRUE) && (task_priority[task_id] == priority)) {
+				found = (task_id_t)task_id;
+			}
+		}
+	}
+
+	return found;
+}
+
+/*
+ * Function: タスク実行
+ * Argument: タスクID
+ * Return  : なし
+ * Note    : 実行中に発生した割り込み処理の時間も実行時間に含む
+ */
+static void runTask(task_id_t task_id)
+{
+	uint32_t start_time;
+	uint32_t run_time;
+
+	if (task_callback[task_id] != NULL) {
+		start_time = GetTimeUs();
+		task_callback[task_id]();
+		run_time = GetTimeUs() - start_time;
+
+		stat_run_count[task_id] ++;
+		stat_run_time[task_id] += run_time;
+		if (run_time > task_stat[task_id].run_time_max) {
+			task_stat[task_id].run_time_max = run_time;
+		}
+	}
+}
+
+/*
+ * Function: 実行統計更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 集計周期が経過した場合、集計中の統計を確定して次の集計を開始する
+ */
+static void updateStat(void)
+{
+	uint32_t now = GetTimeUs();
+	uint32_t elapsed = now - stat_start_time;
+
+	if (elapsed >= SCHEDULER_STAT_PERIOD) {
+		idle_percent = (uint32_t)(((uint64_t)stat_idle_time * 100) / elapsed);
+		for (uint32_t task_id=0; task_id<TASK_ID_NUM; task_id++) {
+			task_stat[task_id].run_count = stat_run_count[task_id];
+			task_stat[task_id].run_time = stat_run_time[task_id];
+			stat_run_count[task_id] = 0;
+			stat_run_time[task_id] = 0;
+		}
+		stat_start_time = now;
+		stat_idle_time = 0;
+	}
+}
+
+/*
+ * Function: 周期起動用アラーム更新
+ * Argument: なし
+ * Return  : なし
+ * Note    : 割り込み禁止中またはアラーム割り込み処理内から呼び出すこと
+ *           起動時刻を過ぎたタスクに実行要求を行い、次に起動するタスクの時刻にアラームを設定する
+ */
+static void updatePeriodAlarm(void)
+{
+	uint32_t now = GetTimeUs();
+	bool_t active = FALSE;
+	uint32_t nearest = 0;
+
+	for (uint32_t task_id=0; task_id<TASK_ID_NUM; task_id++) {
+		if (task_period[task_id] > 0) {
+			/* 時刻の周回を考慮して差分で判定 */
+			if ((int32_t)(now - task_next_time[task_id]) >= 0) {
+				task_pending[task_id] = TRUE;
+				task_next_time[task_id] += task_period[task_id];
+				if ((int32_t)(task_next_time[task_id] - now) <= 0) {
+					/* 処理遅れで過ぎた周期は飛ばす */
+					task_next_time[task_id] = now + task_period[task_id];
+				}
+			}
+
+			if ((active == FALSE) || ((int32_t)(task_next_time[task_id] - nearest) < 0)) {
+				nearest = task_next_time[task_id];
+			}
+			active = TRUE;
+		}
+	}
+
+	if (active == TRUE) {
+		SetTimerAlarm(ALARM_ID_SCHEDULER, nearest - now, updatePeriodAlarm);
+	} else {
+		CancelTimerAlarm(ALARM_ID_SCHEDULER);
+	}
+}
+
+/*
+ * Function: 遅延実行アラーム通知コールバック
+ * Argument: なし
+ * Return  : なし
+ * Note    : アラーム割り込み処理
+ */
+static void callbackDeferredAlarm(void)
+{
+	PostTask(TASK_ID_TIMER_ALARM);
+}
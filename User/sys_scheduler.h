@@ -0,0 +1,62 @@
+/*
+ * sys_scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: KimiakiK
+ */
+
+
+#ifndef SYS_SCHEDULER_H_
+#define SYS_SCHEDULER_H_
+
+/********** Include **********/
+
+#include "typedef.h"
+
+/********** Define **********/
+
+/* CPU負荷、タスク実行時間の集計周期 [us] */
+#define SCHEDULER_STAT_PERIOD	(1000000)
+
+/********** Enum **********/
+
+/* タスク(優先度はsys_scheduler.cのtask_priorityで指定) */
+typedef enum {
+	TASK_ID_FRAME = 0,		/* 表示更新毎のメイン周期処理 */
+	TASK_ID_TIMER_ALARM,	/* 遅延実行指定のアラーム処理 */
+	TASK_ID_STORAGE,		/* セーブデータ、EEPROM書き込み */
+	TASK_ID_NUM
+} task_id_t;
+
+typedef enum {
+	TASK_PRIORITY_HIGH = 0,
+	TASK_PRIORITY_NORMAL,
+	TASK_PRIORITY_LOW
+} task_priority_t;
+
+/********** Type **********/
+
+/* タスク実行統計 */
+typedef struct {
+	uint32_t run_count;			/* 直近の集計周期の実行回数 */
+	uint32_t run_time;			/* 直近の集計周期の実行時間合計 [us] */
+	uint32_t run_time_max;		/* 起動からの1回あたりの実行時間最大値 [us] */
+} task_stat_t;
+
+/********** Constant **********/
+
+/********** Variable **********/
+
+/********** Function Prototype **********/
+
+void InitScheduler(void);
+void RunScheduler(void);
+void SetTaskCallback(task_id_t task_id, callback_t callback);
+void SetTaskPeriod(task_id_t task_id, uint32_t period_us);
+void PostTask(task_id_t task_id);
+uint32_t GetSchedulerIdlePercent(void);
+uint32_t GetSchedulerLoadPercent(void);
+task_stat_t GetTaskStat(task_id_t task_id);
+void DumpSchedulerStat(void);
+
+#endif /* SYS_SCHEDULER_H_ */